@@ -3,7 +3,9 @@
 #include "3dmanager/lego3dmanager.h"
 #include "decomp.h"
 #include "isledebug.h"
+#include "isletimedemo.h"
 #include "legoanimationmanager.h"
+#include "legoanimpresenter.h"
 #include "legobuildingmanager.h"
 #include "legogamestate.h"
 #include "legoinputmanager.h"
@@ -14,18 +16,23 @@
 #include "legovideomanager.h"
 #include "legoworldpresenter.h"
 #include "misc.h"
+#include "misc/legocontainer.h"
 #include "mxbackgroundaudiomanager.h"
 #include "mxdirectx/mxdirect3d.h"
+#include "mxdiskstreamprovider.h"
 #include "mxdsaction.h"
 #include "mxmisc.h"
 #include "mxomnicreateflags.h"
 #include "mxomnicreateparam.h"
+#include "mxsmkdecoder.h"
+#include "mxsoundmanager.h"
 #include "mxstreamer.h"
 #include "mxticklemanager.h"
 #include "mxtimer.h"
 #include "mxtransitionmanager.h"
 #include "mxutilities.h"
 #include "mxvariabletable.h"
+#include "profiler.h"
 #include "res/isle_bmp.h"
 #include "res/resource.h"
 #include "roi/legoroi.h"
@@ -83,6 +90,12 @@ SDL_Renderer* renderer = nullptr;
 
 bool running = true;
 
+#ifdef ISLE_PROFILER
+#define SCANCODE_KEY_TRACE SDL_SCANCODE_SCROLLLOCK
+
+const char* g_tracePath = NULL;
+#endif
+
 // FUNCTION: ISLE 0x401000
 IsleApp::IsleApp()
 {
@@ -246,6 +259,9 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char** argv)
 {
 	*appstate = NULL;
 
+	IsleTimedemo_PreInit(argc, argv);
+	PROFILE_THREAD("Main");
+
 	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_JOYSTICK)) {
 		char buffer[256];
 		SDL_snprintf(
@@ -291,12 +307,19 @@ SDL_AppResult SDL_AppInit(void** appstate, int argc, char** argv)
 	return SDL_APP_CONTINUE;
 }
 
+SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event);
+
 SDL_AppResult SDL_AppIterate(void* appstate)
 {
 	if (g_closed) {
 		return SDL_APP_SUCCESS;
 	}
 
+	SDL_Event event;
+	while (IsleTimedemo_NextEvent(&event)) {
+		SDL_AppEvent(appstate, &event);
+	}
+
 	if (!g_isle->Tick()) {
 		SDL_ShowSimpleMessageBox(
 			SDL_MESSAGEBOX_ERROR,
@@ -340,6 +363,11 @@ SDL_AppResult SDL_AppIterate(void* appstate)
 		}
 	}
 
+	if (IsleTimedemo_Finished()) {
+		IsleTimedemo_Finish();
+		return SDL_APP_SUCCESS;
+	}
+
 	return SDL_APP_CONTINUE;
 }
 
@@ -353,6 +381,17 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event)
 		return SDL_APP_CONTINUE;
 	}
 
+#ifdef ISLE_PROFILER
+	if (g_tracePath && event->type == SDL_KEYDOWN && event->key.keysym.scancode == SCANCODE_KEY_TRACE) {
+		Profiler_WriteTrace(g_tracePath);
+		return SDL_APP_CONTINUE;
+	}
+#endif
+
+	if (IsleTimedemo_Event(event)) {
+		return SDL_APP_CONTINUE;
+	}
+
 	// [library:window]
 	// Remaining functionality to be implemented:
 	// Full screen - crashes when minimizing/maximizing, but this will probably be fixed once DirectDraw is replaced
@@ -373,6 +412,7 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event)
 		break;
 	case SDL_WINDOWEVENT_CLOSE:
 		if (!g_closed) {
+			IsleTimedemo_Finish();
 			delete g_isle;
 			g_isle = NULL;
 			g_closed = TRUE;
@@ -412,7 +452,7 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event)
 		if (InputManager()) {
 			InputManager()->QueueEvent(
 				c_notificationButtonDown,
-				IsleApp::MapMouseButtonFlagsToModifier(SDL_GetMouseState(NULL, NULL)),
+				IsleApp::MapMouseButtonFlagsToModifier(IsleTimedemo_MouseState()),
 				event->button.x,
 				event->button.y,
 				0
@@ -425,7 +465,7 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event)
 		if (InputManager()) {
 			InputManager()->QueueEvent(
 				c_notificationButtonUp,
-				IsleApp::MapMouseButtonFlagsToModifier(SDL_GetMouseState(NULL, NULL)),
+				IsleApp::MapMouseButtonFlagsToModifier(IsleTimedemo_MouseState()),
 				event->button.x,
 				event->button.y,
 				0
@@ -433,6 +473,7 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event)
 		}
 		break;
 	case SDL_QUIT:
+		IsleTimedemo_Finish();
 		return SDL_APP_SUCCESS;
 		break;
 	}
@@ -458,6 +499,12 @@ SDL_AppResult SDL_AppEvent(void* appstate, SDL_Event* event)
 
 void SDL_AppQuit(void* appstate, SDL_AppResult result)
 {
+#ifdef ISLE_PROFILER
+	if (g_tracePath) {
+		Profiler_WriteTrace(g_tracePath);
+	}
+#endif
+
 	if (appstate != NULL) {
 		SDL_DestroyWindow((SDL_Window*) appstate);
 	}
@@ -489,6 +536,11 @@ MxResult IsleApp::SetupWindow()
         return FAILURE;
     }
 
+    if (!m_deviceId && IsleTimedemo_DeviceId()) {
+        m_deviceId = new char[strlen(IsleTimedemo_DeviceId()) + 1];
+        strcpy(m_deviceId, IsleTimedemo_DeviceId());
+    }
+
     SetupVideoFlags(
         m_fullScreen,
         m_flipSurfaces,
@@ -503,7 +555,8 @@ MxResult IsleApp::SetupWindow()
 
     MxOmni::SetSound3D(m_use3dSound);
 
-    srand(time(NULL));
+    // Recording and replay must see the same random sequence
+    srand(IsleTimedemo_Active() ? 0 : time(NULL));
 
     // Setup cursors
     m_cursorCurrent = m_cursorArrow = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
@@ -600,6 +653,10 @@ MxResult IsleApp::SetupWindow()
 
     IsleDebug_Init();
 
+    if (!IsleTimedemo_Start()) {
+        return FAILURE;
+    }
+
 	if (!window) {
     	SDL_Log("Failed to create SDL window: %s", SDL_GetError());
     	return FAILURE;
@@ -664,6 +721,7 @@ bool IsleApp::LoadConfig()
 
 		iniparser_set(dict, "isle:3DSound", m_use3dSound ? "true" : "false");
 		iniparser_set(dict, "isle:Music", m_useMusic ? "true" : "false");
+		iniparser_set(dict, "isle:Audio Period", "1024");
 
 		iniparser_set(dict, "isle:UseJoystick", m_useJoystick ? "true" : "false");
 		iniparser_set(dict, "isle:JoystickIndex", m_joystickIndex ? "true" : "false");
@@ -673,6 +731,10 @@ bool IsleApp::LoadConfig()
 
 		iniparser_set(dict, "isle:Island Quality", "1");
 		iniparser_set(dict, "isle:Island Texture", "1");
+		iniparser_set(dict, "isle:Anim Cache KB", "4096");
+		iniparser_set(dict, "isle:Anim Workers", "0");
+		iniparser_set(dict, "isle:Read Ahead KB", "512");
+		iniparser_set(dict, "isle:Decode Video Ahead", "false");
 
 		iniparser_dump_ini(dict, iniFP);
 		SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "New config written at '%s'", iniConfig);
@@ -697,6 +759,7 @@ bool IsleApp::LoadConfig()
 	m_fullScreen = iniparser_getboolean(dict, "isle:Full Screen", m_fullScreen);
 	m_wideViewAngle = iniparser_getboolean(dict, "isle:Wide View Angle", m_wideViewAngle);
 	m_use3dSound = iniparser_getboolean(dict, "isle:3DSound", m_use3dSound);
+	MxSoundManager::SetPeriodFrames(iniparser_getint(dict, "isle:Audio Period", 1024));
 	m_useMusic = iniparser_getboolean(dict, "isle:Music", m_useMusic);
 	m_useJoystick = iniparser_getboolean(dict, "isle:UseJoystick", m_useJoystick);
 	m_joystickIndex = iniparser_getint(dict, "isle:JoystickIndex", m_joystickIndex);
@@ -719,6 +782,11 @@ bool IsleApp::LoadConfig()
 
 	m_islandQuality = iniparser_getint(dict, "isle:Island Quality", 1);
 	m_islandTexture = iniparser_getint(dict, "isle:Island Texture", 1);
+	LegoAnimPresenter::SetAnimCacheLimit(iniparser_getint(dict, "isle:Anim Cache KB", 4096) * 1024);
+	LegoAnimPresenter::SetAnimWorkers(iniparser_getint(dict, "isle:Anim Workers", 0));
+	MxDiskStreamProvider::SetReadAheadLimit(iniparser_getint(dict, "isle:Read Ahead KB", 512) * 1024);
+	MxSmkDecoder::SetDecodeAhead(iniparser_getboolean(dict, "isle:Decode Video Ahead", FALSE));
+	LegoTextureContainer::SetShareIdentical(iniparser_getboolean(dict, "isle:Share Identical Textures", FALSE));
 
 	const char* deviceId = iniparser_getstring(dict, "isle:3D Device ID", NULL);
 	if (deviceId != NULL) {
@@ -768,6 +836,12 @@ inline bool IsleApp::Tick()
 		return true;
 	}
 
+	// Timedemo frames run one step further on the fixed clock each
+	if (!IsleTimedemo_Step()) {
+		SDL_Delay(1);
+		return true;
+	}
+
 	MxLong currentTime = Timer()->GetRealTime();
 	if (currentTime < g_lastFrameTime) {
 		g_lastFrameTime = -m_frameDelta;
@@ -779,7 +853,9 @@ inline bool IsleApp::Tick()
 	}
 
 	if (!Lego()->IsPaused()) {
+		IsleTimedemo_BeginFrame();
 		TickleManager()->Tickle();
+		IsleTimedemo_EndFrame();
 	}
 	g_lastFrameTime = currentTime;
 
@@ -887,6 +963,30 @@ MxResult IsleApp::ParseArguments(int argc, char** argv)
 #endif
 			consumed = 1;
 		}
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+#ifdef ISLE_PROFILER
+			g_tracePath = argv[i + 1];
+#else
+			SDL_Log("isle is built without profiler support. Ignoring --trace argument.");
+#endif
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--headless") == 0) {
+			IsleTimedemo_SetHeadless();
+			consumed = 1;
+		}
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+			IsleTimedemo_SetRecordPath(argv[i + 1]);
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--timedemo") == 0 && i + 1 < argc) {
+			IsleTimedemo_SetReplayPath(argv[i + 1]);
+			consumed = 2;
+		}
+		else if (strcmp(argv[i], "--timedemo-csv") == 0 && i + 1 < argc) {
+			IsleTimedemo_SetCsvPath(argv[i + 1]);
+			consumed = 2;
+		}
 		if (consumed <= 0) {
 			SDL_Log("Invalid argument(s): %s", argv[i]);
 			return FAILURE;
@@ -10,6 +10,8 @@
 #include "legosoundmanager.h"
 #include "legovideomanager.h"
 #include "misc.h"
+#include "mxdiskstreamprovider.h"
+#include "mxdsbuffer.h"
 #include "mxticklemanager.h"
 
 #include <SDL2/SDL.h>
@@ -30,6 +32,33 @@ static SDL_Texture* g_videoPalette;
 
 class DebugViewer {
 public:
+	static void InsideStreamChunks()
+	{
+		// Rates are taken over the last full second, from totals sampled here rather than
+		// on the streaming path
+		static MxDSBuffer::ChunkStats g_last, g_rates;
+		static Uint64 g_lastTicks;
+		MxDSBuffer::ChunkStats stats;
+		MxDSBuffer::GetChunkStats(stats);
+
+		Uint64 now = SDL_GetTicks();
+		if (now - g_lastTicks >= 1000) {
+			g_rates.m_chunks = stats.m_chunks - g_last.m_chunks;
+			g_rates.m_splitChunks = stats.m_splitChunks - g_last.m_splitChunks;
+			g_rates.m_inPlace = stats.m_inPlace - g_last.m_inPlace;
+			g_rates.m_allocations = stats.m_allocations - g_last.m_allocations;
+			g_rates.m_bytesCopied = stats.m_bytesCopied - g_last.m_bytesCopied;
+			g_last = stats;
+			g_lastTicks = now;
+		}
+
+		ImGui::Text("Chunks allocated: %u (%u/s)", stats.m_chunks, g_rates.m_chunks);
+		ImGui::Text("Split chunks: %u (%u/s)", stats.m_splitChunks, g_rates.m_splitChunks);
+		ImGui::Text("Gathered in place: %u (%u/s)", stats.m_inPlace, g_rates.m_inPlace);
+		ImGui::Text("Reassembly allocations: %u (%u/s)", stats.m_allocations, g_rates.m_allocations);
+		ImGui::Text("Bytes copied: %u (%u/s)", stats.m_bytesCopied, g_rates.m_bytesCopied);
+	}
+
 	static void InsidePlantManager()
 	{
 		LegoPlantManager* plantManager = Lego()->GetPlantManager();
@@ -269,6 +298,23 @@ void IsleDebug_Render()
 				if (volume != oldVolume) {
 					soundManager->SetVolume(volume);
 				}
+				ImGui::Text("Period: %u frames", soundManager->GetPeriodFrames());
+				ImGui::Text("Latency: %gms", soundManager->GetLatencyMS());
+				ImGui::Text("Max callback interval: %gms", soundManager->GetMaxCallbackIntervalMS());
+				ImGui::Text("Late callbacks: %u", soundManager->GetLateCallbacks());
+				ImGui::Text("Underruns: %u", soundManager->GetUnderruns());
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Disk Streams")) {
+				ImGui::Text("Reads: %u", MxDiskStreamProvider::GetReadCount());
+				ImGui::Text("Read-ahead hits: %u", MxDiskStreamProvider::GetReadAheadHits());
+				ImGui::Text("Read-ahead misses: %u", MxDiskStreamProvider::GetReadAheadMisses());
+				ImGui::Text("Average read: %gms", MxDiskStreamProvider::GetAverageReadMS());
+				ImGui::Text("Max read: %gms", MxDiskStreamProvider::GetMaxReadMS());
+				ImGui::TreePop();
+			}
+			if (ImGui::TreeNode("Stream Chunks")) {
+				DebugViewer::InsideStreamChunks();
 				ImGui::TreePop();
 			}
 			if (ImGui::TreeNode("Video Manager")) {
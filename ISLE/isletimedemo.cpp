@@ -0,0 +1,461 @@
+#include "isletimedemo.h"
+
+#include "legoinputmanager.h"
+#include "mxframetimings.h"
+#include "mxmisc.h"
+#include "mxtimer.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+// Timer step of one timedemo frame, in milliseconds
+#define TIMEDEMO_STEP 16
+
+// The software renderer's device GUID in the "3D Device ID" format
+#define TIMEDEMO_SOFTWARE_DEVICE "0 0x682656f3 0x0 0x0 0x2000000"
+
+enum {
+	c_timingTotal,
+	c_timingTickle,
+	c_timingStreaming,
+	c_timingVideo,
+	c_timingRender3d,
+	c_timingPresent,
+	c_numTimings
+};
+
+static const char* g_timingNames[c_numTimings] = {"total", "tickle", "streaming", "video", "render3d", "present"};
+
+// The keys LegoInputManager::GetNavigationKeyStates polls. Their state is recorded as a mask
+// of these whenever it changes, releases included.
+static const SDL_Scancode g_navigationKeys[] = {
+	SDL_SCANCODE_KP_8,
+	SDL_SCANCODE_UP,
+	SDL_SCANCODE_KP_2,
+	SDL_SCANCODE_DOWN,
+	SDL_SCANCODE_KP_4,
+	SDL_SCANCODE_LEFT,
+	SDL_SCANCODE_KP_6,
+	SDL_SCANCODE_RIGHT,
+	SDL_SCANCODE_LCTRL,
+	SDL_SCANCODE_RCTRL
+};
+
+static bool g_timedemoHeadless;
+static const char* g_recordPath;
+static const char* g_replayPath;
+static const char* g_csvPath = "timedemo.csv";
+
+static FILE* g_recordFile;
+static FILE* g_replayFile;
+static FILE* g_csvFile;
+static bool g_running;
+static bool g_finished;
+
+static SDL_Event g_pendingEvent;
+static MxLong g_pendingTime;
+static Uint32 g_pendingMouseState;
+static int g_pendingKeys = -1;
+static bool g_hasPending;
+static MxLong g_endTime = -1;
+static bool g_injecting;
+static Uint32 g_mouseState;
+static int g_recordedKeys;
+static Uint64 g_nextStepTicks;
+static Uint8 g_keyboardState[SDL_NUM_SCANCODES];
+
+static Uint64 g_frameStart;
+static MxU32 g_frames;
+static double g_timingTotals[c_numTimings];
+static double g_timingSquares[c_numTimings];
+static double g_timingMax[c_numTimings];
+
+static bool IsInputEvent(SDL_Event* event)
+{
+	switch (event->type) {
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+	case SDL_MOUSEMOTION:
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+	case SDL_MOUSEWHEEL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static int GetNavigationKeys()
+{
+	const Uint8* state = SDL_GetKeyboardState(NULL);
+	int keys = 0;
+
+	for (int i = 0; i < (int) sizeOfArray(g_navigationKeys); i++) {
+		if (state[g_navigationKeys[i]]) {
+			keys |= 1 << i;
+		}
+	}
+
+	return keys;
+}
+
+static void SetNavigationKeys(int p_keys)
+{
+	for (int i = 0; i < (int) sizeOfArray(g_navigationKeys); i++) {
+		g_keyboardState[g_navigationKeys[i]] = p_keys & (1 << i) ? 1 : 0;
+	}
+}
+
+// Reads the next event of the replay into g_pendingEvent, or a keyboard state into
+// g_pendingKeys, or the end marker into g_endTime
+static void ReadPendingEvent()
+{
+	char line[128];
+	g_hasPending = false;
+	g_pendingKeys = -1;
+
+	while (fgets(line, sizeof(line), g_replayFile)) {
+		long time;
+		char type[16];
+		int a = 0, b = 0, c = 0, d = 0;
+
+		if (line[0] == '#' || sscanf(line, "%ld %15s %d %d %d %d", &time, type, &a, &b, &c, &d) < 2) {
+			continue;
+		}
+
+		SDL_zero(g_pendingEvent);
+		g_pendingTime = time;
+
+		if (!strcmp(type, "key")) {
+			g_pendingEvent.type = SDL_KEYDOWN;
+			g_pendingEvent.key.state = SDL_PRESSED;
+			g_pendingEvent.key.keysym.sym = a;
+		}
+		else if (!strcmp(type, "keys")) {
+			g_pendingKeys = a;
+		}
+		else if (!strcmp(type, "motion")) {
+			g_pendingEvent.type = SDL_MOUSEMOTION;
+			g_pendingEvent.motion.state = a;
+			g_pendingEvent.motion.x = b;
+			g_pendingEvent.motion.y = c;
+		}
+		else if (!strcmp(type, "down") || !strcmp(type, "up")) {
+			g_pendingEvent.type = type[0] == 'd' ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+			g_pendingEvent.button.state = type[0] == 'd' ? SDL_PRESSED : SDL_RELEASED;
+			g_pendingEvent.button.button = a;
+			g_pendingMouseState = b;
+			g_pendingEvent.button.x = c;
+			g_pendingEvent.button.y = d;
+		}
+		else if (!strcmp(type, "end")) {
+			g_endTime = time;
+			return;
+		}
+		else {
+			SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Timedemo: skipping unknown event '%s'", type);
+			continue;
+		}
+
+		g_hasPending = true;
+		return;
+	}
+}
+
+void IsleTimedemo_PreInit(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--headless")) {
+			// Hints do not override SDL_VIDEODRIVER or SDL_AUDIODRIVER set in the environment
+			SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+			SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+		}
+	}
+}
+
+void IsleTimedemo_SetHeadless()
+{
+	g_timedemoHeadless = true;
+}
+
+void IsleTimedemo_SetRecordPath(const char* p_path)
+{
+	g_recordPath = p_path;
+}
+
+void IsleTimedemo_SetReplayPath(const char* p_path)
+{
+	g_replayPath = p_path;
+}
+
+void IsleTimedemo_SetCsvPath(const char* p_path)
+{
+	g_csvPath = p_path;
+}
+
+bool IsleTimedemo_Active()
+{
+	return g_recordPath || g_replayPath;
+}
+
+const char* IsleTimedemo_DeviceId()
+{
+	return g_timedemoHeadless ? TIMEDEMO_SOFTWARE_DEVICE : NULL;
+}
+
+bool IsleTimedemo_Start()
+{
+	if (!IsleTimedemo_Active()) {
+		return true;
+	}
+
+	if (g_replayPath) {
+		if (!(g_replayFile = fopen(g_replayPath, "r"))) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timedemo: failed to open '%s'", g_replayPath);
+			return false;
+		}
+
+		if (!(g_csvFile = fopen(g_csvPath, "w"))) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timedemo: failed to create '%s'", g_csvPath);
+			return false;
+		}
+
+		fprintf(g_csvFile, "frame,time");
+		for (int i = 0; i < c_numTimings; i++) {
+			fprintf(g_csvFile, ",%s_ms", g_timingNames[i]);
+		}
+		fprintf(g_csvFile, "\n");
+
+		g_finished = false;
+		g_endTime = -1;
+		g_frames = 0;
+		memset(g_timingTotals, 0, sizeof(g_timingTotals));
+		memset(g_timingSquares, 0, sizeof(g_timingSquares));
+		memset(g_timingMax, 0, sizeof(g_timingMax));
+
+		ReadPendingEvent();
+		MxFrameTimings::SetEnabled(TRUE);
+
+		memset(g_keyboardState, 0, sizeof(g_keyboardState));
+		LegoInputManager::SetKeyboardStateOverride(g_keyboardState);
+	}
+	else {
+		if (!(g_recordFile = fopen(g_recordPath, "w"))) {
+			SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Timedemo: failed to create '%s'", g_recordPath);
+			return false;
+		}
+
+		fprintf(g_recordFile, "# isle timedemo, step %d ms\n", TIMEDEMO_STEP);
+		g_recordedKeys = 0;
+		g_nextStepTicks = SDL_GetTicks();
+	}
+
+	Timer()->SetFixedStep(TIMEDEMO_STEP);
+	g_running = true;
+	return true;
+}
+
+void IsleTimedemo_Finish()
+{
+	if (!g_running) {
+		return;
+	}
+
+	g_running = false;
+
+	if (g_recordFile) {
+		fprintf(g_recordFile, "%ld end\n", (long) Timer()->GetRealTime());
+		fclose(g_recordFile);
+		g_recordFile = NULL;
+		SDL_Log("Timedemo: recorded input to '%s'", g_recordPath);
+	}
+
+	if (g_replayFile) {
+		fclose(g_replayFile);
+		fclose(g_csvFile);
+		g_replayFile = NULL;
+		g_csvFile = NULL;
+
+		SDL_Log("Timedemo: %u frames, per-frame timings written to '%s'", g_frames, g_csvPath);
+
+		for (int i = 0; i < c_numTimings && g_frames; i++) {
+			double mean = g_timingTotals[i] / g_frames;
+			double variance = SDL_max(g_timingSquares[i] / g_frames - mean * mean, 0.0);
+
+			SDL_Log(
+				"Timedemo: %-9s %10.3f ms total, %7.3f ms/frame, %7.3f ms std dev, %7.3f ms max",
+				g_timingNames[i],
+				g_timingTotals[i],
+				mean,
+				SDL_sqrt(variance),
+				g_timingMax[i]
+			);
+		}
+
+		MxFrameTimings::SetEnabled(FALSE);
+		LegoInputManager::SetKeyboardStateOverride(NULL);
+	}
+
+	Timer()->SetFixedStep(0);
+}
+
+bool IsleTimedemo_Finished()
+{
+	return g_finished;
+}
+
+// Drops real input while replaying and logs it while recording. Returns true if the
+// event must not reach the game.
+bool IsleTimedemo_Event(SDL_Event* event)
+{
+	if (!g_running || !IsInputEvent(event)) {
+		return false;
+	}
+
+	if (g_replayFile) {
+		return !g_injecting;
+	}
+
+	long time = Timer()->GetRealTime();
+
+	switch (event->type) {
+	case SDL_KEYDOWN:
+		if (!event->key.repeat) {
+			fprintf(g_recordFile, "%ld key %d\n", time, (int) event->key.keysym.sym);
+		}
+		break;
+	case SDL_MOUSEMOTION:
+		fprintf(g_recordFile, "%ld motion %u %d %d\n", time, event->motion.state, event->motion.x, event->motion.y);
+		break;
+	case SDL_MOUSEBUTTONDOWN:
+	case SDL_MOUSEBUTTONUP:
+		fprintf(
+			g_recordFile,
+			"%ld %s %d %u %d %d\n",
+			time,
+			event->type == SDL_MOUSEBUTTONDOWN ? "down" : "up",
+			event->button.button,
+			SDL_GetMouseState(NULL, NULL),
+			event->button.x,
+			event->button.y
+		);
+		break;
+	}
+
+	return false;
+}
+
+// Hands out the replayed events that are due at the current timer time, one per call.
+// Keyboard states that are due are applied on the way.
+bool IsleTimedemo_NextEvent(SDL_Event* event)
+{
+	g_injecting = false;
+
+	if (!g_running || !g_replayFile) {
+		return false;
+	}
+
+	MxLong time = Timer()->GetRealTime();
+
+	while (g_hasPending && g_pendingTime <= time && g_pendingKeys >= 0) {
+		SetNavigationKeys(g_pendingKeys);
+		ReadPendingEvent();
+	}
+
+	if (!g_hasPending) {
+		if (g_endTime < 0 || g_endTime <= time) {
+			g_finished = true;
+		}
+
+		return false;
+	}
+
+	if (g_pendingTime > time) {
+		return false;
+	}
+
+	*event = g_pendingEvent;
+
+	if (event->type == SDL_MOUSEBUTTONDOWN || event->type == SDL_MOUSEBUTTONUP) {
+		g_mouseState = g_pendingMouseState;
+	}
+
+	ReadPendingEvent();
+	g_injecting = true;
+	return true;
+}
+
+Uint32 IsleTimedemo_MouseState()
+{
+	return g_running && g_replayFile ? g_mouseState : SDL_GetMouseState(NULL, NULL);
+}
+
+// Moves the fixed clock on to the next frame. Recordings keep to real time, so that the game
+// plays at its normal speed: returns false if the step is not due yet. Also records the
+// navigation keys as they are at the end of the frame's events, which is when the replay
+// applies them.
+bool IsleTimedemo_Step()
+{
+	if (!g_running) {
+		return true;
+	}
+
+	if (g_recordFile) {
+		Uint64 now = SDL_GetTicks();
+
+		if (now < g_nextStepTicks) {
+			return false;
+		}
+
+		// A frame that ran long is not made up for with frames back to back
+		g_nextStepTicks = SDL_max(g_nextStepTicks + TIMEDEMO_STEP, now);
+
+		int keys = GetNavigationKeys();
+
+		if (keys != g_recordedKeys) {
+			fprintf(g_recordFile, "%ld keys %d\n", (long) Timer()->GetRealTime(), keys);
+			g_recordedKeys = keys;
+		}
+	}
+
+	MxTimer::Step();
+	return true;
+}
+
+void IsleTimedemo_BeginFrame()
+{
+	if (g_running && g_csvFile) {
+		MxFrameTimings::Reset();
+		g_frameStart = SDL_GetPerformanceCounter();
+	}
+}
+
+void IsleTimedemo_EndFrame()
+{
+	if (!g_running || !g_csvFile) {
+		return;
+	}
+
+	double timings[c_numTimings];
+	timings[c_timingTotal] = (SDL_GetPerformanceCounter() - g_frameStart) * 1000.0 / SDL_GetPerformanceFrequency();
+	timings[c_timingTickle] = MxFrameTimings::GetMilliseconds(MxFrameTimings::e_tickle);
+	timings[c_timingStreaming] = MxFrameTimings::GetMilliseconds(MxFrameTimings::e_streaming);
+	timings[c_timingRender3d] = MxFrameTimings::GetMilliseconds(MxFrameTimings::e_render3d);
+	timings[c_timingPresent] = MxFrameTimings::GetMilliseconds(MxFrameTimings::e_present);
+
+	// Video is reported without the 3D render and present time it contains
+	timings[c_timingVideo] = MxFrameTimings::GetMilliseconds(MxFrameTimings::e_video) - timings[c_timingRender3d] -
+							 timings[c_timingPresent];
+
+	fprintf(g_csvFile, "%u,%ld", g_frames, (long) Timer()->GetTime());
+	for (int i = 0; i < c_numTimings; i++) {
+		fprintf(g_csvFile, ",%.3f", timings[i]);
+		g_timingTotals[i] += timings[i];
+		g_timingSquares[i] += timings[i] * timings[i];
+		g_timingMax[i] = SDL_max(g_timingMax[i], timings[i]);
+	}
+	fprintf(g_csvFile, "\n");
+
+	g_frames++;
+}
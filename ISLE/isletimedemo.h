@@ -0,0 +1,37 @@
+#ifndef ISLETIMEDEMO_H
+#define ISLETIMEDEMO_H
+
+#include <SDL2/SDL_stdinc.h>
+
+typedef union SDL_Event SDL_Event;
+
+// Timedemo support. --record writes the player's input with MxTimer timestamps, and
+// --timedemo replays such a file with no real input, then writes one CSV row of section
+// timings per frame and quits. Both run on a fixed timer step with a fixed random seed,
+// so a replay sees the same input on the same frames as the recording. The replay
+// supplies the keyboard state the game polls as well as its input events.
+// --headless selects SDL's offscreen video and dummy audio drivers and the software renderer.
+
+extern void IsleTimedemo_PreInit(int argc, char** argv);
+
+extern void IsleTimedemo_SetHeadless();
+extern void IsleTimedemo_SetRecordPath(const char* p_path);
+extern void IsleTimedemo_SetReplayPath(const char* p_path);
+extern void IsleTimedemo_SetCsvPath(const char* p_path);
+
+extern bool IsleTimedemo_Active();
+extern const char* IsleTimedemo_DeviceId();
+
+extern bool IsleTimedemo_Start();
+extern void IsleTimedemo_Finish();
+extern bool IsleTimedemo_Finished();
+
+extern bool IsleTimedemo_Event(SDL_Event* event);
+extern bool IsleTimedemo_NextEvent(SDL_Event* event);
+extern Uint32 IsleTimedemo_MouseState();
+
+extern bool IsleTimedemo_Step();
+extern void IsleTimedemo_BeginFrame();
+extern void IsleTimedemo_EndFrame();
+
+#endif // ISLETIMEDEMO_H
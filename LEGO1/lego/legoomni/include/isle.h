@@ -25,7 +25,7 @@ class TowTrack;
 
 // VTABLE: LEGO1 0x100d7028
 // VTABLE: BETA10 0x101b9d40
-// SIZE 0x26c
+// SIZE 0x34c
 class Act1State : public LegoState {
 public:
 	enum ElevatorFloor {
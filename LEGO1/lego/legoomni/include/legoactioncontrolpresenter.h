@@ -7,7 +7,7 @@
 #include "mxstring.h"
 
 // VTABLE: LEGO1 0x100d5118
-// SIZE 0x68
+// SIZE 0x88
 class LegoActionControlPresenter : public MxMediaPresenter {
 public:
 	LegoActionControlPresenter() : m_unk0x50(Extra::ActionType::e_none) {}
@@ -3,6 +3,7 @@
 
 #include "decomp.h"
 #include "lego1_export.h"
+#include "legocharacteranims.h"
 #include "legolocations.h"
 #include "legomain.h"
 #include "legostate.h"
@@ -19,6 +20,7 @@ class LegoPathBoundary;
 class LegoROIList;
 struct LegoOrientedEdge;
 class LegoWorld;
+class LegoWorldInfo;
 class MxDSAction;
 
 // SIZE 0x30
@@ -258,6 +260,7 @@ class LegoAnimationManager : public MxCore {
 	);
 	void FUN_100648f0(LegoTranInfo* p_tranInfo, MxLong p_unk0x404);
 	void FUN_10064b50(MxLong p_time);
+	MxResult ReadWorldInfo(const char* p_path, MxU32 p_size, MxS64 p_modified);
 
 	LegoOmni::World m_worldId;          // 0x08
 	MxU16 m_animCount;                  // 0x0c
@@ -299,6 +302,11 @@ class LegoAnimationManager : public MxCore {
 	MxMatrix m_unk0x43c;                // 0x43c
 	MxMatrix m_unk0x484;                // 0x484
 	MxQuaternionTransformer m_unk0x4cc; // 0x4cc
+
+	LegoCharacterAnims m_characterAnims;
+
+	// Owns m_anims, their models and names
+	LegoWorldInfo* m_worldInfo;
 };
 
 // TEMPLATE: LEGO1 0x10061750
@@ -0,0 +1,54 @@
+#ifndef LEGOANIMCACHE_H
+#define LEGOANIMCACHE_H
+
+#include "mxcriticalsection.h"
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+class LegoAnim;
+
+// Keeps the parsed LegoAnim trees of finished animation actions, keyed by the source action,
+// so a repeated action skips re-reading its chunk. Node data carries per-playback state
+// (ROI map indices and key search positions), so a tree is lent to one presenter at a time
+// and reset before it is lent again. Idle trees are evicted least recently used first once
+// the cached chunk bytes exceed the limit.
+// Owned by LegoOmni, which deletes it after every presenter is gone.
+class LegoAnimCache {
+public:
+	LegoAnimCache(MxU32 p_limit);
+	~LegoAnimCache();
+
+	LegoAnim* Acquire(const char* p_source, MxS32 p_objectId, MxU32 p_length);
+	MxBool Add(const char* p_source, MxS32 p_objectId, MxU32 p_length, LegoAnim* p_anim);
+	MxBool Release(LegoAnim* p_anim);
+	void SetLimit(MxU32 p_limit);
+	void Clear();
+
+	MxU32 GetSize() { return m_size; }
+	MxU32 GetCount() { return (MxU32) m_anims.size(); }
+
+private:
+	struct Entry {
+		char* m_source;
+		MxS32 m_objectId;
+		MxU32 m_length;
+		LegoAnim* m_anim;
+		MxBool m_inUse;
+		list<Entry*>::iterator m_idle; // position in m_idle while not in use
+	};
+
+	static MxU32 Hash(const char* p_source, MxS32 p_objectId);
+
+	Entry* Find(const char* p_source, MxS32 p_objectId);
+	void Remove(Entry* p_entry);
+	void Evict();
+
+	unordered_map<MxU32, vector<Entry*> > m_entries; // by Hash of source and object id
+	unordered_map<LegoAnim*, Entry*> m_anims;
+	list<Entry*> m_idle; // least recently used first
+	MxCriticalSection m_criticalSection;
+	MxU32 m_size;
+	MxU32 m_limit;
+};
+
+#endif // LEGOANIMCACHE_H
@@ -8,7 +8,9 @@
 class LegoAnim;
 class LegoWorld;
 class LegoPathBoundary;
+class MxJobPool;
 class MxMatrix;
+struct LegoAnimFrameNode;
 class Vector3;
 
 struct LegoAnimStructComparator {
@@ -38,6 +40,13 @@ class LegoAnimPresenter : public MxVideoPresenter {
 		c_mustSucceed = 0x02
 	};
 
+	// How PutFrame derives the animation time, used to evaluate frames ahead of it
+	enum FrameMode {
+		e_frameNone = 0,
+		e_frameOnce,
+		e_frameLooping
+	};
+
 	LegoAnimPresenter();
 	~LegoAnimPresenter() override;
 
@@ -97,6 +106,12 @@ class LegoAnimPresenter : public MxVideoPresenter {
 
 	LegoAnim* GetAnimation() { return m_anim; }
 
+	LEGO1_EXPORT static void SetAnimCacheLimit(MxU32 p_limit);
+	static MxU32 GetAnimCacheLimit();
+	LEGO1_EXPORT static void SetAnimWorkers(MxS32 p_workers);
+	static MxS32 GetAnimWorkers();
+	static void PrepareFrames(MxJobPool& p_pool);
+
 protected:
 	void Init();
 	void Destroy(MxBool p_fromDestructor);
@@ -117,6 +132,10 @@ class LegoAnimPresenter : public MxVideoPresenter {
 	void FUN_1006b900(LegoAnim* p_anim, MxLong p_time, Matrix4* p_matrix);
 	void FUN_1006b9a0(LegoAnim* p_anim, MxLong p_time, Matrix4* p_matrix);
 	void FUN_1006c8a0(MxBool p_bool);
+	void SetFrameMode(FrameMode p_mode);
+	MxBool GetFrameTime(MxLong& p_time);
+
+	static void EvaluateFrame(void* p_presenter);
 
 	LegoAnim* m_anim;             // 0x64
 	LegoROI** m_roiMap;           // 0x68
@@ -141,6 +160,15 @@ class LegoAnimPresenter : public MxVideoPresenter {
 public:
 	float m_unk0xa4;          // 0xa4
 	Mx3DPointFloat m_unk0xa8; // 0xa8
+
+private:
+	// Node transforms evaluated by PrepareFrames for m_frameAnim at m_frameTime,
+	// one per node of m_anim (m_frameSize)
+	LegoAnimFrameNode* m_frame;
+	MxU32 m_frameSize;
+	LegoAnim* m_frameAnim;
+	MxLong m_frameTime;
+	FrameMode m_frameMode;
 };
 
 // clang-format off
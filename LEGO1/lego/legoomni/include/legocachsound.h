@@ -9,7 +9,7 @@
 
 // VTABLE: LEGO1 0x100d4718
 // VTABLE: BETA10 0x101bb6f0
-// SIZE 0x88
+// SIZE 0xc8
 class LegoCacheSound : public MxCore {
 public:
 	LegoCacheSound();
@@ -18,7 +18,7 @@ class MxActionNotificationParam;
 
 // VTABLE: LEGO1 0x100d66e0
 // VTABLE: BETA10 0x101bb910
-// SIZE 0x50
+// SIZE 0x70
 class LegoVehicleBuildState : public LegoState {
 public:
 	enum AnimationState {
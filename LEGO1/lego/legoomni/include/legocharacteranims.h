@@ -0,0 +1,46 @@
+#ifndef LEGOCHARACTERANIMS_H
+#define LEGOCHARACTERANIMS_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+struct AnimInfo;
+
+// The anims of a world bucketed by the character that plays them, in ascending index order, so
+// the ambient animation query of LegoAnimationManager::FUN_10062110 only visits the anims of
+// the character it was asked about
+class LegoCharacterAnims {
+public:
+	void Build(const AnimInfo* p_anims, MxU16 p_animCount, MxU32 p_numCharacters);
+	void Clear() { m_buckets.clear(); }
+
+	MxU16 Find(
+		const AnimInfo* p_anims,
+		MxS8 p_characterIndex,
+		MxS32 p_vehicleId,
+		MxU16 p_first,
+		MxU16 p_last,
+		MxU8 p_flags,
+		MxBool p_inVehicle
+	) const;
+
+private:
+	// Indexed by character index + 1, so anims of no character have a bucket too
+	vector<vector<MxU16> > m_buckets;
+};
+
+// Maps the case-folded first two characters of a name to the first character added with that
+// prefix, which is all LegoAnimationManager::GetCharacterIndex compares
+class LegoCharacterPrefixes {
+public:
+	void Add(const char* p_name, MxS8 p_index);
+	MxS8 Find(const char* p_name) const;
+	MxBool IsEmpty() const { return m_indices.empty(); }
+
+private:
+	static MxU16 Prefix(const char* p_name);
+
+	unordered_map<MxU16, MxS8> m_indices;
+};
+
+#endif // LEGOCHARACTERANIMS_H
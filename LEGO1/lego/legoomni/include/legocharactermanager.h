@@ -48,7 +48,7 @@ struct LegoActorInfo;
 typedef map<char*, LegoCharacter*, LegoCharacterComparator> LegoCharacterMap;
 
 // VTABLE: LEGO1 0x100da878
-// SIZE 0x24
+// SIZE 0x64
 class CustomizeAnimFileVariable : public MxVariable {
 public:
 	CustomizeAnimFileVariable(const char* p_key);
@@ -10,6 +10,7 @@
 #include <string.h>
 
 class LegoFile;
+class LegoSaveWriter;
 class LegoState;
 class LegoStorage;
 class MxVariableTable;
@@ -24,7 +25,7 @@ struct ColorStringStruct {
 };
 
 // VTABLE: LEGO1 0x100d74a8
-// SIZE 0x30
+// SIZE 0x70
 class LegoBackgroundColor : public MxVariable {
 public:
 	LegoBackgroundColor();
@@ -44,7 +45,7 @@ class LegoBackgroundColor : public MxVariable {
 };
 
 // VTABLE: LEGO1 0x100d74b8
-// SIZE 0x24
+// SIZE 0x64
 class LegoFullScreenMovie : public MxVariable {
 public:
 	LegoFullScreenMovie(const char* p_key, const char* p_value);
@@ -191,6 +192,7 @@ class LegoGameState {
 
 	LEGO1_EXPORT void SerializeScoreHistory(MxS16 p_flags);
 	LEGO1_EXPORT void SetSavePath(char*);
+	const char* GetSavePath() { return m_savePath; }
 
 	LegoState* GetState(const char* p_stateName);
 	LegoState* CreateState(const char* p_stateName);
@@ -254,6 +256,9 @@ class LegoGameState {
 	Area m_currentArea;                   // 0x424
 	Area m_previousArea;                  // 0x428
 	Area m_unk0x42c;                      // 0x42c
+
+private:
+	LegoSaveWriter* m_saveWriter;
 };
 
 MxBool ROIColorOverride(const char* p_input, char* p_output, MxU32 p_copyLen);
@@ -143,6 +143,10 @@ class LegoInputManager : public MxPresenter {
 	MxBool FUN_1005cdf0(LegoEventNotificationParam& p_param);
 	void GetKeyboardState();
 	MxResult GetNavigationKeyStates(MxU32& p_keyFlags);
+
+	// When set, the navigation keys are read from p_keyboardState instead of SDL's
+	// keyboard state, so that replayed input does not mix with the live keyboard
+	LEGO1_EXPORT static void SetKeyboardStateOverride(const Uint8* p_keyboardState);
 	SDL_TimerID m_autoDragTimerID;        // 0x78
 
 	// SYNTHETIC: LEGO1 0x1005b8d0
@@ -170,6 +174,8 @@ class LegoInputManager : public MxPresenter {
 	MxBool m_useJoystick;  // 0x334
 	MxBool m_unk0x335;     // 0x335
 	MxBool m_unk0x336;     // 0x336
+
+	static const Uint8* g_keyboardStateOverride;
 };
 
 // TEMPLATE: LEGO1 0x10028850
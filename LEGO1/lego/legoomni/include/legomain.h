@@ -11,6 +11,7 @@
 #include <SDL2/SDL_timer.h>
 
 class Isle;
+class LegoAnimCache;
 class LegoAnimationManager;
 class LegoBuildingManager;
 class LegoCharacterManager;
@@ -34,7 +35,7 @@ class ViewLODListManager;
 
 // VTABLE: LEGO1 0x100d8638
 // VTABLE: BETA10 0x101bc8b8
-// SIZE 0x140
+// SIZE 0x160
 class LegoOmni : public MxOmni {
 public:
 	enum {
@@ -134,6 +135,7 @@ class LegoOmni : public MxOmni {
 	LegoROI* FindROI(const char* p_name);
 	void AddWorld(LegoWorld* p_world);
 	void DeleteWorld(LegoWorld* p_world);
+	void UpdateEntityName(LegoEntity* p_entity);
 	void FUN_1005b4f0(MxBool p_disable, MxU16 p_flags);
 	LEGO1_EXPORT void CreateBackgroundAudio();
 	LEGO1_EXPORT void RemoveWorld(const MxAtomId& p_atom, MxLong p_objectId);
@@ -177,6 +179,7 @@ class LegoOmni : public MxOmni {
 	MxDSAction& GetCurrentAction() { return m_action; }
 	LegoCharacterManager* GetCharacterManager() { return m_characterManager; }
 	LegoWorldList* GetWorldList() { return m_worldList; }
+	LegoAnimCache* GetAnimCache() { return m_animCache; }
 
 	void SetNavController(LegoNavController* p_navController) { m_navController = p_navController; }
 	void SetUserActor(LegoPathActor* p_userActor) { m_userActor = p_userActor; }
@@ -224,6 +227,9 @@ class LegoOmni : public MxOmni {
 
 public:
 	MxBool m_unk0x13c; // 0x13c
+
+private:
+	LegoAnimCache* m_animCache;
 };
 
 #endif // LEGOMAIN_H
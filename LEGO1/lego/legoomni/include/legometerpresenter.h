@@ -7,7 +7,7 @@
 
 // VTABLE: LEGO1 0x100d7ac8
 // VTABLE: BETA10 0x101bca68
-// SIZE 0x94
+// SIZE 0xb4
 class LegoMeterPresenter : public MxStillPresenter {
 public:
 	LegoMeterPresenter();
@@ -4,7 +4,7 @@
 #include "legolodlist.h"
 #include "mxstring.h"
 
-// SIZE 0x14
+// SIZE 0x34
 class LegoNamedPart {
 public:
 	LegoNamedPart(const char* p_name, LegoLODList* p_list)
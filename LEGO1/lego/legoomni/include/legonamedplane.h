@@ -5,7 +5,7 @@
 #include "mxgeometry/mxgeometry3d.h"
 #include "mxstring.h"
 
-// SIZE 0x4c
+// SIZE 0x6c
 struct LegoNamedPlane {
 	// FUNCTION: LEGO1 0x10033800
 	LegoNamedPlane() {}
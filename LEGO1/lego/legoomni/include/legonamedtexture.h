@@ -4,7 +4,7 @@
 #include "misc/legotexture.h"
 #include "mxstring.h"
 
-// SIZE 0x14
+// SIZE 0x34
 class LegoNamedTexture {
 public:
 	LegoNamedTexture(const char* p_name, LegoTexture* p_texture)
@@ -7,7 +7,7 @@
 class LegoTextureInfo;
 
 // VTABLE: LEGO1 0x100d7c88
-// SIZE 0x20
+// SIZE 0x40
 class LegoPhoneme {
 public:
 	LegoPhoneme(const char* p_name, undefined4 p_unk0x14)
@@ -9,7 +9,7 @@
 class LegoTextureInfo;
 
 // VTABLE: LEGO1 0x100d8040
-// SIZE 0x88
+// SIZE 0xa8
 class LegoPhonemePresenter : public MxFlcPresenter {
 public:
 	LegoPhonemePresenter();
@@ -0,0 +1,54 @@
+#ifndef LEGOSAVEWRITER_H
+#define LEGOSAVEWRITER_H
+
+#include "misc/legotypes.h"
+#include "mxcriticalsection.h"
+#include "mxsemaphore.h"
+#include "mxstl/stlcompat.h"
+#include "mxstring.h"
+#include "mxthread.h"
+
+// Writes save files on a background thread. Each file is written to a temporary
+// file next to its target, which it then replaces in one step, so a crash mid-write
+// leaves the previous save intact. Callers that read or move save files must Flush first.
+// A failed write is reported by the next Write or Flush.
+class LegoSaveWriter {
+public:
+	LegoSaveWriter();
+	~LegoSaveWriter();
+
+	MxResult Write(const char* p_path, LegoU8* p_data, LegoU32 p_size);
+	MxResult Flush();
+
+private:
+	class Thread : public MxThread {
+	public:
+		Thread(LegoSaveWriter* p_writer) : m_writer(p_writer) {}
+
+		MxResult Run() override;
+
+	private:
+		LegoSaveWriter* m_writer;
+	};
+
+	struct Job {
+		MxString m_path;
+		LegoU8* m_data;
+		LegoU32 m_size;
+	};
+
+	static MxResult WriteFile(const Job& p_job);
+	MxResult TakeResult();
+
+	Thread* m_thread;
+	list<Job> m_jobs;
+	MxU32 m_outstanding;
+	MxBool m_flushing;
+	MxBool m_failed;      // a write failed since the last TakeResult
+	MxBool m_synchronous; // the thread could not be started, write on the caller's thread
+	MxCriticalSection m_criticalSection;
+	MxSemaphore m_jobSemaphore;
+	MxSemaphore m_flushSemaphore;
+};
+
+#endif // LEGOSAVEWRITER_H
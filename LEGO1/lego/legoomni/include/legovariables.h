@@ -19,7 +19,7 @@ extern const char* g_varCURSOR;
 extern const char* g_varWHOAMI;
 
 // VTABLE: LEGO1 0x100d86c8
-// SIZE 0x24
+// SIZE 0x64
 class VisibilityVariable : public MxVariable {
 public:
 	VisibilityVariable() { m_key = g_varVISIBILITY; }
@@ -28,7 +28,7 @@ class VisibilityVariable : public MxVariable {
 };
 
 // VTABLE: LEGO1 0x100d86b8
-// SIZE 0x24
+// SIZE 0x64
 class CameraLocationVariable : public MxVariable {
 public:
 	CameraLocationVariable() { m_key = g_varCAMERALOCATION; }
@@ -37,7 +37,7 @@ class CameraLocationVariable : public MxVariable {
 };
 
 // VTABLE: LEGO1 0x100d86a8
-// SIZE 0x24
+// SIZE 0x64
 class CursorVariable : public MxVariable {
 public:
 	CursorVariable() { m_key = g_varCURSOR; }
@@ -46,7 +46,7 @@ class CursorVariable : public MxVariable {
 };
 
 // VTABLE: LEGO1 0x100d8698
-// SIZE 0x24
+// SIZE 0x64
 class WhoAmIVariable : public MxVariable {
 public:
 	WhoAmIVariable() { m_key = g_varWHOAMI; }
@@ -4,6 +4,7 @@
 #include "decomp.h"
 #include "lego1_export.h"
 #include "legophonemelist.h"
+#include "mxjobpool.h"
 #include "mxvideomanager.h"
 
 #ifdef MINIWIN
@@ -125,6 +126,8 @@ class LegoVideoManager : public MxVideoManager {
 	BOOL m_dither;                        // 0x588
 	DWORD m_bufferCount;                  // 0x58c
 
+	MxJobPool m_animJobs;
+
 	friend class DebugViewer;
 };
 
@@ -10,6 +10,7 @@
 #include "legoentity.h"
 #include "legomain.h"
 #include "legopathcontrollerlist.h"
+#include "legoworldindex.h"
 #include "roi/legoroi.h"
 
 class LegoCameraController;
@@ -44,6 +45,15 @@ class LegoWorld : public LegoEntity {
 		e_four
 	};
 
+	// Lists searched by Find, in the order Find searches them
+	enum IndexCategory {
+		e_entities = 0,
+		e_controlPresenters,
+		e_animPresenters,
+		e_otherPresenters,
+		e_numIndexCategories
+	};
+
 	LegoWorld();
 	~LegoWorld() override; // vtable+0x00
 
@@ -109,6 +119,7 @@ class LegoWorld : public LegoEntity {
 	MxResult GetCurrPathInfo(LegoPathBoundary** p_boundaries, MxS32& p_numL);
 	MxCore* Find(const char* p_class, const char* p_name);
 	MxCore* Find(const MxAtomId& p_atom, MxS32 p_entityId);
+	void UpdateEntityName(LegoEntity* p_entity);
 
 	// FUNCTION: BETA10 0x1002b4f0
 	LegoCameraController* GetCameraController() { return m_cameraController; }
@@ -125,6 +136,9 @@ class LegoWorld : public LegoEntity {
 	// LegoWorld::`scalar deleting destructor'
 
 protected:
+	void AddToIndices(IndexCategory p_category, MxCore* p_object);
+	void RemoveFromIndices(MxCore* p_object);
+
 	LegoPathControllerList m_pathControllerList; // 0x68
 	MxPresenterList m_animPresenters;            // 0x80
 	LegoCameraController* m_cameraController;    // 0x98
@@ -143,6 +157,9 @@ class LegoWorld : public LegoEntity {
 	MxS16 m_startupTicks;  // 0xf4
 	MxBool m_worldStarted; // 0xf6
 	undefined m_unk0xf7;   // 0xf7
+
+	LegoWorldIndex m_atomIndex[e_numIndexCategories];
+	LegoWorldIndex m_nameIndex[e_numIndexCategories];
 };
 
 // clang-format off
@@ -0,0 +1,44 @@
+#ifndef LEGOWORLDINDEX_H
+#define LEGOWORLDINDEX_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+class MxAtomId;
+class MxCore;
+
+// Hash index used by LegoWorld::Find. Objects are bucketed by a 32-bit key and kept
+// in insertion order within each bucket. Re-adding an object under a new key keeps its
+// place in that order. Keys may collide, so callers must check each candidate against
+// the actual search criteria.
+class LegoWorldIndex {
+public:
+	typedef vector<MxCore*> Bucket;
+
+	LegoWorldIndex() : m_nextOrder(0) {}
+
+	static MxU32 HashName(const char* p_name);
+	static MxU32 HashAtom(const MxAtomId& p_atom, MxS32 p_id);
+
+	void Add(MxU32 p_key, MxCore* p_object);
+	void Add(MxU32 p_key, MxCore* p_object, MxU32 p_order);
+	void Remove(MxCore* p_object);
+	void Clear();
+	const Bucket* Find(MxU32 p_key) const;
+	MxBool Contains(MxCore* p_object) const { return m_entries.find(p_object) != m_entries.end(); }
+
+	// Position of p_object in insertion order; p_object must be in the index
+	MxU32 GetOrder(MxCore* p_object) const { return m_entries.find(p_object)->second.m_order; }
+
+private:
+	struct Entry {
+		MxU32 m_key;
+		MxU32 m_order;
+	};
+
+	unordered_map<MxU32, Bucket> m_buckets;
+	unordered_map<MxCore*, Entry> m_entries;
+	MxU32 m_nextOrder;
+};
+
+#endif // LEGOWORLDINDEX_H
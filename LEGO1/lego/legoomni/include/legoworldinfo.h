@@ -0,0 +1,39 @@
+#ifndef LEGOWORLDINFO_H
+#define LEGOWORLDINFO_H
+
+#include "mxtypes.h"
+
+struct AnimInfo;
+class LegoStorage;
+
+// The animation records of one world, as read from its inf.dta. The AnimInfo array, every
+// ModelInfo array and every name (the string pool) live in one block, so a world's records take
+// one allocation and are freed together.
+// The block is also the body of the world's cache file: its pointers are stored as offsets into
+// the block, behind a header naming the cache version, the record layout and the size and
+// modification time of the inf.dta it came from. A cache that matches loads with one read.
+class LegoWorldInfo {
+public:
+	LegoWorldInfo();
+	~LegoWorldInfo();
+
+	MxResult Create(LegoStorage* p_storage, MxU16 p_animCount);
+	void* Alloc(MxU32 p_size);
+
+	MxResult ReadCache(const char* p_path, MxU32 p_sourceSize, MxS64 p_sourceModified);
+	MxResult WriteCache(const char* p_path, MxU32 p_sourceSize, MxS64 p_sourceModified);
+
+	AnimInfo* GetAnims() { return (AnimInfo*) m_block; }
+	MxU16 GetAnimCount() { return m_animCount; }
+	MxU32 GetSize() { return m_size; }
+
+private:
+	void Relocate(MxBool p_toOffsets);
+
+	MxU8* m_block;
+	MxU32 m_size;  // bytes in m_block
+	MxU32 m_used;  // bytes handed out by Alloc
+	MxU16 m_animCount;
+};
+
+#endif // LEGOWORLDINFO_H
@@ -8,7 +8,7 @@
 #include "SDL_RWStreamBuf.h"
 
 class LegoWorld;
-struct ModelDbPart;
+struct ModelDbPartEntry;
 struct ModelDbModel;
 
 // VTABLE: LEGO1 0x100d8ee0
@@ -19,6 +19,7 @@ class LegoWorldPresenter : public LegoEntityPresenter {
 	~LegoWorldPresenter() override; // vtable+0x00
 
 	LEGO1_EXPORT static void configureLegoWorldPresenter(MxS32 p_legoWorldPresenterQuality);
+	static void UnloadWorldDb();
 
 	// FUNCTION: BETA10 0x100e41c0
 	static const char* HandlerClassName()
@@ -52,8 +53,8 @@ class LegoWorldPresenter : public LegoEntityPresenter {
 	// LegoWorldPresenter::`scalar deleting destructor'
 
 private:
-	MxResult LoadWorldPart(ModelDbPart& p_part, SDL_IOStream* p_wdbFile);
-	MxResult LoadWorldModel(ModelDbModel& p_model, SDL_IOStream* p_wdbFile, LegoWorld* p_world);
+	MxResult LoadWorldPart(ModelDbPartEntry& p_part);
+	MxResult LoadWorldModel(ModelDbModel& p_model, LegoWorld* p_world);
 
 	MxU32 m_nextObjectId;
 };
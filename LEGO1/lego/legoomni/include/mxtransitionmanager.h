@@ -4,6 +4,7 @@
 #include "decomp.h"
 #include "lego1_export.h"
 #include "mxcore.h"
+#include "mxstl/stlcompat.h"
 
 #include <SDL2/SDL_stdinc.h>
 #ifdef MINIWIN
@@ -82,10 +83,15 @@ class MxTransitionManager : public MxCore {
 
 	LPDIRECTDRAWSURFACE m_ddSurface; // 0x30
 	MxU16 m_animationTimer;          // 0x34
-	MxU16 m_columnOrder[640];        // 0x36
-	MxU16 m_randomShift[480];        // 0x536
-	Uint64 m_systemTime;             // 0x8f8
-	MxS32 m_animationSpeed;          // 0x8fc
+
+	// The original's MxU16 m_columnOrder[640] at 0x36 and m_randomShift[480] at 0x536 are the
+	// vectors at the end, sized to the surface, so the two offsets below are the original's
+
+	Uint64 m_systemTime;    // 0x8f8
+	MxS32 m_animationSpeed; // 0x8fc
+
+	vector<MxU16> m_columnOrder;
+	vector<MxU16> m_randomShift;
 };
 
 #endif // MXTRANSITIONMANAGER_H
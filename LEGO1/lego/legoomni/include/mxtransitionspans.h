@@ -0,0 +1,36 @@
+#ifndef MXTRANSITIONSPANS_H
+#define MXTRANSITIONSPANS_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+// The pixel work of MxTransitionManager's transitions, one tick at a time, on a locked surface of
+// any size and depth. Kept apart from the manager so the transitions can run offscreen.
+// At 640x480 and 8 or 16 bits, dissolve, mosaic and wipe-down produce the original frames.
+
+struct MxTransitionSurface {
+	MxU8* m_pixels;
+	MxS32 m_pitch;
+	MxS32 m_width;
+	MxS32 m_height;
+	MxS32 m_bytesPerPixel;
+};
+
+#define DISSOLVE_TICKS 40
+#define MOSAIC_TICKS 16
+#define MOSAIC_COLUMNS 64
+#define MOSAIC_ROWS 48
+#define WIPE_DOWN_TICKS 240
+#define WINDOWS_TICKS 240
+
+void ShuffleTransitionColumns(vector<MxU16>& p_order, vector<MxU16>& p_shift, MxS32 p_columns, MxS32 p_rows);
+
+void DissolveTick(const MxTransitionSurface& p_surface, const MxU16* p_order, const MxU16* p_shift, MxS32 p_tick);
+void MosaicTick(const MxTransitionSurface& p_surface, const MxU16* p_order, const MxU16* p_shift, MxS32 p_tick);
+void WipeDownTick(const MxTransitionSurface& p_surface, MxS32 p_tick);
+void WindowsTick(const MxTransitionSurface& p_surface, MxS32 p_tick);
+
+// Sets p_count pixels of p_bytesPerPixel bytes to p_color
+void FillTransitionSpan(MxU8* p_dest, MxS32 p_count, MxS32 p_bytesPerPixel, const MxU8* p_color);
+
+#endif // MXTRANSITIONSPANS_H
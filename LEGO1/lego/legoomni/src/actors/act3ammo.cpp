@@ -4,6 +4,7 @@
 #include "act3actors.h"
 #include "legocachesoundmanager.h"
 #include "legocharactermanager.h"
+#include "legomain.h"
 #include "legopathboundary.h"
 #include "legopathcontroller.h"
 #include "legosoundmanager.h"
@@ -44,6 +45,7 @@ void Act3Ammo::Destroy(MxBool p_fromDestructor)
 	else if (m_roi != NULL) {
 		CharacterManager()->ReleaseActor(m_roi->GetName());
 		m_roi = NULL;
+		Lego()->UpdateEntityName(this);
 	}
 }
 
@@ -56,6 +58,7 @@ MxResult Act3Ammo::Remove()
 
 	CharacterManager()->ReleaseActor(m_roi->GetName());
 	m_roi = NULL;
+	Lego()->UpdateEntityName(this);
 
 	if (m_boundary != NULL) {
 		m_boundary->RemoveActor(this);
@@ -76,6 +79,7 @@ MxResult Act3Ammo::Create(Act3* p_world, MxU32 p_isPizza, MxS32 p_index)
 	if (p_isPizza) {
 		sprintf(name, "pammo%d", p_index);
 		m_roi = CharacterManager()->CreateAutoROI(name, "pizpie", FALSE);
+		Lego()->UpdateEntityName(this);
 		m_roi->SetVisibility(TRUE);
 
 		BoundingSphere sphere;
@@ -90,6 +94,7 @@ MxResult Act3Ammo::Create(Act3* p_world, MxU32 p_isPizza, MxS32 p_index)
 	else {
 		sprintf(name, "dammo%d", p_index);
 		m_roi = CharacterManager()->CreateAutoROI(name, "donut", FALSE);
+		Lego()->UpdateEntityName(this);
 		m_roi->SetVisibility(TRUE);
 
 		BoundingSphere sphere;
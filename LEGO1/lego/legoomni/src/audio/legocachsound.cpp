@@ -6,7 +6,7 @@
 
 #include <assert.h>
 
-DECOMP_SIZE_ASSERT(LegoCacheSound, 0x88)
+DECOMP_SIZE_ASSERT(LegoCacheSound, 0xc8)
 
 // FUNCTION: LEGO1 0x100064d0
 // FUNCTION: BETA10 0x10066340
@@ -67,13 +67,17 @@ MxResult LegoCacheSound::Create(
 		return FAILURE;
 	}
 
-	if (m_cacheSound.Init(
-			ma_sound_init_from_data_source,
-			SoundManager()->GetEngine(),
-			&m_buffer,
-			MxOmni::IsSound3D() ? 0 : MA_SOUND_FLAG_NO_SPATIALIZATION,
-			nullptr
-		) != MA_SUCCESS) {
+	SoundManager()->GetMixLock().Enter();
+	ma_result result = m_cacheSound.Init(
+		ma_sound_init_from_data_source,
+		SoundManager()->GetEngine(),
+		&m_buffer,
+		MxOmni::IsSound3D() ? 0 : MA_SOUND_FLAG_NO_SPATIALIZATION,
+		nullptr
+	);
+	SoundManager()->GetMixLock().Leave();
+
+	if (result != MA_SUCCESS) {
 		return FAILURE;
 	}
 
@@ -108,9 +112,18 @@ void LegoCacheSound::CopyData(MxU8* p_data, MxU32 p_dataSize)
 // FUNCTION: BETA10 0x1006685b
 void LegoCacheSound::Destroy()
 {
+	// The sound may be mixing on the audio thread until it is uninitialized
+	if (SoundManager()) {
+		SoundManager()->GetMixLock().Enter();
+	}
+
 	m_cacheSound.Destroy(ma_sound_uninit);
 	m_buffer.Destroy(ma_audio_buffer_uninit);
 
+	if (SoundManager()) {
+		SoundManager()->GetMixLock().Leave();
+	}
+
 	delete[] m_data;
 	Init();
 }
@@ -78,7 +78,7 @@ void LegoLoadCacheSoundPresenter::StreamingTickle()
 			ProgressTickleState(e_done);
 		}
 		else {
-			memcpy(m_pData, chunk->GetData(), chunk->GetLength());
+			chunk->CopyData(m_pData);
 			m_dataSize += chunk->GetLength();
 			m_pData += chunk->GetLength();
 		}
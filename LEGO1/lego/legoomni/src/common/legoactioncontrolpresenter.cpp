@@ -12,7 +12,7 @@
 #include "mxticklemanager.h"
 #include "mxutilities.h"
 
-DECOMP_SIZE_ASSERT(LegoActionControlPresenter, 0x68)
+DECOMP_SIZE_ASSERT(LegoActionControlPresenter, 0x88)
 
 // FUNCTION: LEGO1 0x10043ce0
 void LegoActionControlPresenter::ReadyTickle()
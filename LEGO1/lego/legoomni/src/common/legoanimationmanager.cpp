@@ -18,6 +18,7 @@
 #include "legosoundmanager.h"
 #include "legovideomanager.h"
 #include "legoworld.h"
+#include "legoworldinfo.h"
 #include "misc.h"
 #include "mxbackgroundaudiomanager.h"
 #include "mxmisc.h"
@@ -331,6 +332,7 @@ LegoAnimationManager::LegoAnimationManager()
 	m_unk0x1c = 0;
 	m_animState = NULL;
 	m_unk0x424 = NULL;
+	m_worldInfo = NULL;
 
 	Init();
 
@@ -534,6 +536,7 @@ void LegoAnimationManager::Init()
 	m_unk0x42c = NULL;
 	m_unk0x408 = m_unk0x40c = m_unk0x404 = Timer()->GetTime();
 	m_unk0x410 = 5000;
+	m_characterAnims.Clear();
 
 	for (i = 0; i < (MxS32) sizeOfArray(g_characters); i++) {
 		g_characters[i].m_active = FALSE;
@@ -623,8 +626,6 @@ MxResult LegoAnimationManager::LoadWorldInfo(LegoOmni::World p_worldId)
 
 		DeleteAnimations();
 
-		LegoFile storage;
-
 		if (p_worldId == LegoOmni::e_undefined) {
 			result = SUCCESS;
 			goto done;
@@ -659,33 +660,34 @@ MxResult LegoAnimationManager::LoadWorldInfo(LegoOmni::World p_worldId)
 			}
 		}
 
-		if (storage.Open(path, LegoFile::c_read) == FAILURE) {
-			goto done;
-		}
+		Uint64 loadStart = SDL_GetPerformanceCounter();
+		MxBool cached = FALSE;
+		MxString cachePath;
+		m_worldInfo = new LegoWorldInfo();
 
-		MxU32 version;
-		if (storage.Read(&version, sizeof(MxU32)) == FAILURE) {
-			goto done;
+		if (GameState()->GetSavePath() != NULL) {
+			cachePath = GameState()->GetSavePath();
+			cachePath += "\\";
+			cachePath += Lego()->GetWorldName(p_worldId);
+			cachePath += "inf.cache";
+			cached = m_worldInfo->ReadCache(cachePath.GetData(), info.st_size, info.st_mtime) == SUCCESS;
 		}
 
-		assert(version == 3);
-		if (version != 3) {
-			OmniError("World animation version mismatch", 0);
-			goto done;
+		if (cached) {
+			m_anims = m_worldInfo->GetAnims();
+			m_animCount = m_worldInfo->GetAnimCount();
 		}
+		else {
+			if (ReadWorldInfo(path, info.st_size, info.st_mtime) != SUCCESS) {
+				goto done;
+			}
 
-		if (storage.Read(&m_animCount, sizeof(MxU16)) == FAILURE) {
-			goto done;
+			if (GameState()->GetSavePath() != NULL) {
+				m_worldInfo->WriteCache(cachePath.GetData(), info.st_size, info.st_mtime);
+			}
 		}
 
-		m_anims = new AnimInfo[m_animCount];
-		memset(m_anims, 0, m_animCount * sizeof(*m_anims));
-
 		for (j = 0; j < m_animCount; j++) {
-			if (ReadAnimInfo(&storage, &m_anims[j]) == FAILURE) {
-				goto done;
-			}
-
 			m_anims[j].m_characterIndex = GetCharacterIndex(m_anims[j].m_name + strlen(m_anims[j].m_name) - 2);
 			m_anims[j].m_unk0x29 = FALSE;
 
@@ -716,6 +718,17 @@ MxResult LegoAnimationManager::LoadWorldInfo(LegoOmni::World p_worldId)
 			}
 		}
 
+		SDL_LogDebug(
+			SDL_LOG_CATEGORY_APPLICATION,
+			"Loaded %s%s in %.3fms, %u bytes",
+			filename,
+			cached ? " from the cache" : "",
+			(SDL_GetPerformanceCounter() - loadStart) * 1000.0 / SDL_GetPerformanceFrequency(),
+			m_worldInfo->GetSize()
+		);
+
+		m_characterAnims.Build(m_anims, m_animCount, sizeOfArray(g_characters));
+
 		m_worldId = p_worldId;
 		m_tranInfoList = new LegoTranInfoList();
 		m_tranInfoList2 = new LegoTranInfoList();
@@ -747,6 +760,53 @@ MxResult LegoAnimationManager::LoadWorldInfo(LegoOmni::World p_worldId)
 	return result;
 }
 
+// Reads the inf.dta at p_path in one piece and parses its records into m_worldInfo
+MxResult LegoAnimationManager::ReadWorldInfo(const char* p_path, MxU32 p_size, MxS64 p_modified)
+{
+	MxResult result = FAILURE;
+	MxU8* image = new MxU8[p_size];
+	LegoMemory storage(image, p_size);
+	LegoFile file;
+	MxU32 version;
+	MxS32 j;
+
+	if (file.Open(p_path, LegoFile::c_read) == FAILURE || file.Read(image, p_size) == FAILURE) {
+		goto done;
+	}
+
+	if (storage.Read(&version, sizeof(MxU32)) == FAILURE) {
+		goto done;
+	}
+
+	assert(version == 3);
+	if (version != 3) {
+		OmniError("World animation version mismatch", 0);
+		goto done;
+	}
+
+	if (storage.Read(&m_animCount, sizeof(MxU16)) == FAILURE) {
+		goto done;
+	}
+
+	if (m_worldInfo->Create(&storage, m_animCount) == FAILURE) {
+		goto done;
+	}
+
+	m_anims = m_worldInfo->GetAnims();
+
+	for (j = 0; j < m_animCount; j++) {
+		if (ReadAnimInfo(&storage, &m_anims[j]) == FAILURE) {
+			goto done;
+		}
+	}
+
+	result = SUCCESS;
+
+done:
+	delete[] image;
+	return result;
+}
+
 // FUNCTION: LEGO1 0x10060140
 MxBool LegoAnimationManager::FindVehicle(const char* p_name, MxU32& p_index)
 {
@@ -765,14 +825,14 @@ MxResult LegoAnimationManager::ReadAnimInfo(LegoStorage* p_storage, AnimInfo* p_
 {
 	MxResult result = FAILURE;
 	MxU8 length;
-	MxS32 i, j;
+	MxS32 j;
 
 	if (p_storage->Read(&length, sizeof(MxU8)) == FAILURE) {
 		goto done;
 	}
 
-	p_info->m_name = new char[length + 1];
-	if (p_storage->Read(p_info->m_name, length) == FAILURE) {
+	p_info->m_name = (char*) m_worldInfo->Alloc(length + 1);
+	if (p_info->m_name == NULL || p_storage->Read(p_info->m_name, length) == FAILURE) {
 		goto done;
 	}
 
@@ -797,18 +857,18 @@ MxResult LegoAnimationManager::ReadAnimInfo(LegoStorage* p_storage, AnimInfo* p_
 		goto done;
 	}
 
-	for (i = 0; i < (MxS32) sizeOfArray(p_info->m_unk0x10); i++) {
-		if (p_storage->Read(&p_info->m_unk0x10[i], sizeof(float)) != SUCCESS) {
-			goto done;
-		}
+	if (p_storage->ReadArray(p_info->m_unk0x10, sizeOfArray(p_info->m_unk0x10)) != SUCCESS) {
+		goto done;
 	}
 
 	if (p_storage->Read(&p_info->m_modelCount, sizeof(MxU8)) == FAILURE) {
 		goto done;
 	}
 
-	p_info->m_models = new ModelInfo[p_info->m_modelCount];
-	memset(p_info->m_models, 0, p_info->m_modelCount * sizeof(*p_info->m_models));
+	p_info->m_models = (ModelInfo*) m_worldInfo->Alloc(p_info->m_modelCount * sizeof(*p_info->m_models));
+	if (p_info->m_models == NULL) {
+		goto done;
+	}
 
 	for (j = 0; j < p_info->m_modelCount; j++) {
 		if (ReadModelInfo(p_storage, &p_info->m_models[j]) == FAILURE) {
@@ -832,8 +892,8 @@ MxResult LegoAnimationManager::ReadModelInfo(LegoStorage* p_storage, ModelInfo*
 		goto done;
 	}
 
-	p_info->m_name = new char[length + 1];
-	if (p_storage->Read(p_info->m_name, length) == FAILURE) {
+	p_info->m_name = (char*) m_worldInfo->Alloc(length + 1);
+	if (p_info->m_name == NULL || p_storage->Read(p_info->m_name, length) == FAILURE) {
 		goto done;
 	}
 
@@ -866,20 +926,10 @@ void LegoAnimationManager::DeleteAnimations()
 {
 	MxBool suspended = m_suspended;
 
-	if (m_anims != NULL) {
-		for (MxS32 i = 0; i < m_animCount; i++) {
-			delete[] m_anims[i].m_name;
-
-			if (m_anims[i].m_models != NULL) {
-				for (MxS32 j = 0; j < m_anims[i].m_modelCount; j++) {
-					delete[] m_anims[i].m_models[j].m_name;
-				}
-
-				delete[] m_anims[i].m_models;
-			}
-		}
-
-		delete[] m_anims;
+	// The records, their models and names are one block
+	if (m_worldInfo != NULL) {
+		delete m_worldInfo;
+		m_worldInfo = NULL;
 	}
 
 	Init();
@@ -1621,39 +1671,16 @@ MxU16 LegoAnimationManager::FUN_10062110(
 				if (len < max && len > min) {
 					MxS8 index = GetCharacterIndex(p_roi->GetName());
 
-					for (MxU16 i = m_unk0x0e; i <= m_unk0x10; i++) {
-						if (m_anims[i].m_characterIndex == index && m_anims[i].m_unk0x0c & p_unk0x0c &&
-							m_anims[i].m_unk0x29) {
-							MxS32 vehicleId = g_characters[index].m_vehicleId;
-							if (vehicleId >= 0) {
-								MxBool found = FALSE;
-
-								for (MxS32 j = 0; j < (MxS32) sizeOfArray(m_anims[i].m_unk0x2a); j++) {
-									if (m_anims[i].m_unk0x2a[j] == vehicleId) {
-										found = TRUE;
-										break;
-									}
-								}
-
-								if (p_unk0x14 != found) {
-									continue;
-								}
-							}
-
-							MxU16 result = i;
-							MxU16 unk0x22 = m_anims[i].m_unk0x22;
-
-							for (i = i + 1; i <= m_unk0x10; i++) {
-								if (m_anims[i].m_characterIndex == index && m_anims[i].m_unk0x0c & p_unk0x0c &&
-									m_anims[i].m_unk0x29 && m_anims[i].m_unk0x22 < unk0x22) {
-									result = i;
-									unk0x22 = m_anims[i].m_unk0x22;
-								}
-							}
-
-							return result;
-						}
-					}
+					// Only anims of this character can match, so just its bucket is scanned
+					return m_characterAnims.Find(
+						m_anims,
+						index,
+						index >= 0 ? g_characters[index].m_vehicleId : -1,
+						m_unk0x0e,
+						m_unk0x10,
+						p_unk0x0c,
+						p_unk0x14
+					);
 				}
 			}
 		}
@@ -1666,15 +1693,17 @@ MxU16 LegoAnimationManager::FUN_10062110(
 // FUNCTION: BETA10 0x100432dd
 MxS8 LegoAnimationManager::GetCharacterIndex(const char* p_name)
 {
-	MxS8 i;
+	// Names are only compared by their first two characters, so the first character
+	// with a given prefix is looked up directly
+	static LegoCharacterPrefixes g_characterPrefixes;
 
-	for (i = 0; i < sizeOfArray(g_characters); i++) {
-		if (!SDL_strncasecmp(p_name, g_characters[i].m_name, 2)) {
-			return i;
+	if (g_characterPrefixes.IsEmpty()) {
+		for (MxS8 i = 0; i < sizeOfArray(g_characters); i++) {
+			g_characterPrefixes.Add(g_characters[i].m_name, i);
 		}
 	}
 
-	return -1;
+	return g_characterPrefixes.Find(p_name);
 }
 
 // FUNCTION: LEGO1 0x100623a0
@@ -0,0 +1,98 @@
+#include "legocharacteranims.h"
+
+#include "decomp.h"
+#include "legoanimationmanager.h"
+
+#include <SDL2/SDL_stdinc.h>
+
+void LegoCharacterAnims::Build(const AnimInfo* p_anims, MxU16 p_animCount, MxU32 p_numCharacters)
+{
+	m_buckets.clear();
+	m_buckets.resize(p_numCharacters + 1);
+
+	for (MxU16 i = 0; i < p_animCount; i++) {
+		m_buckets[p_anims[i].m_characterIndex + 1].push_back(i);
+	}
+}
+
+// Finds the first anim in [p_first, p_last] of the character that has one of p_flags, is
+// enabled and, if the character has a vehicle, is played with it exactly when p_inVehicle is
+// set. Of that anim and the later ones with one of p_flags that are enabled, whatever their
+// vehicle, returns the one with the lowest m_unk0x22. Returns 0 if there is none.
+MxU16 LegoCharacterAnims::Find(
+	const AnimInfo* p_anims,
+	MxS8 p_characterIndex,
+	MxS32 p_vehicleId,
+	MxU16 p_first,
+	MxU16 p_last,
+	MxU8 p_flags,
+	MxBool p_inVehicle
+) const
+{
+	if (p_characterIndex + 1 >= (MxS32) m_buckets.size()) {
+		return 0;
+	}
+
+	const vector<MxU16>& anims = m_buckets[p_characterIndex + 1];
+	vector<MxU16>::const_iterator it = anims.begin();
+
+	while (it != anims.end() && *it < p_first) {
+		it++;
+	}
+
+	for (; it != anims.end() && *it <= p_last; it++) {
+		MxU16 i = *it;
+
+		if (p_anims[i].m_unk0x0c & p_flags && p_anims[i].m_unk0x29) {
+			if (p_vehicleId >= 0) {
+				MxBool found = FALSE;
+
+				for (MxS32 j = 0; j < (MxS32) sizeOfArray(p_anims[i].m_unk0x2a); j++) {
+					if (p_anims[i].m_unk0x2a[j] == p_vehicleId) {
+						found = TRUE;
+						break;
+					}
+				}
+
+				if (p_inVehicle != found) {
+					continue;
+				}
+			}
+
+			MxU16 result = i;
+			MxU16 unk0x22 = p_anims[i].m_unk0x22;
+
+			for (it++; it != anims.end() && *it <= p_last; it++) {
+				i = *it;
+
+				if (p_anims[i].m_unk0x0c & p_flags && p_anims[i].m_unk0x29 && p_anims[i].m_unk0x22 < unk0x22) {
+					result = i;
+					unk0x22 = p_anims[i].m_unk0x22;
+				}
+			}
+
+			return result;
+		}
+	}
+
+	return 0;
+}
+
+// Case-folds the way SDL_strncasecmp does, without reading past a terminator
+MxU16 LegoCharacterPrefixes::Prefix(const char* p_name)
+{
+	MxU8 first = SDL_toupper((MxU8) p_name[0]);
+	MxU8 second = first ? SDL_toupper((MxU8) p_name[1]) : 0;
+	return (first << 8) | second;
+}
+
+void LegoCharacterPrefixes::Add(const char* p_name, MxS8 p_index)
+{
+	m_indices.insert(pair<const MxU16, MxS8>(Prefix(p_name), p_index));
+}
+
+MxS8 LegoCharacterPrefixes::Find(const char* p_name) const
+{
+	unordered_map<MxU16, MxS8>::const_iterator it = m_indices.find(Prefix(p_name));
+	return it != m_indices.end() ? it->second : -1;
+}
@@ -36,6 +36,7 @@
 #include "legomain.h"
 #include "legonavcontroller.h"
 #include "legoplantmanager.h"
+#include "legosavewriter.h"
 #include "legostate.h"
 #include "legoutils.h"
 #include "legovideomanager.h"
@@ -60,7 +61,9 @@
 #include "towtrack.h"
 
 #include <SDL2/SDL_filesystem.h>
+#include <SDL2/SDL_log.h>
 #include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
 #include <assert.h>
 #include <stdio.h>
 
@@ -69,8 +72,8 @@ DECOMP_SIZE_ASSERT(LegoGameState::ScoreItem, 0x2c)
 DECOMP_SIZE_ASSERT(LegoGameState::History, 0x374)
 DECOMP_SIZE_ASSERT(LegoGameState, 0x430)
 DECOMP_SIZE_ASSERT(ColorStringStruct, 0x08)
-DECOMP_SIZE_ASSERT(LegoBackgroundColor, 0x30)
-DECOMP_SIZE_ASSERT(LegoFullScreenMovie, 0x24)
+DECOMP_SIZE_ASSERT(LegoBackgroundColor, 0x70)
+DECOMP_SIZE_ASSERT(LegoFullScreenMovie, 0x64)
 
 // GLOBAL: LEGO1 0x100f3e40
 // STRING: LEGO1 0x100f3e3c
@@ -146,6 +149,8 @@ const char* g_strDisable = "disable";
 // FUNCTION: LEGO1 0x10039550
 LegoGameState::LegoGameState()
 {
+	m_saveWriter = new LegoSaveWriter();
+
 	SetColors();
 	SetROIColorOverride();
 
@@ -191,6 +196,7 @@ LegoGameState::~LegoGameState()
 		delete[] m_stateArray;
 	}
 
+	delete m_saveWriter;
 	delete[] m_savePath;
 }
 
@@ -264,20 +270,19 @@ MxResult LegoGameState::Save(MxULong p_slot)
 	}
 
 	MxResult result = FAILURE;
-	LegoFile storage;
+	LegoGrowableMemory storage;
 	MxVariableTable* variableTable = VariableTable();
 	MxS16 count = 0;
 	MxU32 i;
 	MxS32 j;
 	MxU16 area;
+	MxU64 start = SDL_GetPerformanceCounter();
+	LegoU8* data;
+	LegoU32 size;
 
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
 
-	if (storage.Open(savePath.GetData(), LegoFile::c_write) == FAILURE) {
-		goto done;
-	}
-
 	storage.WriteS32(0x1000c);
 	storage.WriteS16(m_unk0x24);
 	storage.WriteU16(m_currentAct);
@@ -317,9 +322,25 @@ MxResult LegoGameState::Save(MxULong p_slot)
 
 	area = m_unk0x42c;
 	storage.WriteU16(area);
+
+	// Only the snapshot is taken here, the files are written by m_saveWriter
+	data = storage.Detach(size);
+
+	if (m_saveWriter->Write(savePath.GetData(), data, size) != SUCCESS) {
+		// The previous save did not reach the disk
+		result = FAILURE;
+	}
+
 	SerializeScoreHistory(LegoFile::c_write);
 	m_isDirty = FALSE;
 
+	SDL_LogDebug(
+		SDL_LOG_CATEGORY_APPLICATION,
+		"Saved slot %u in %.3f ms",
+		p_slot,
+		(SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency()
+	);
+
 done:
 	return result;
 }
@@ -357,6 +378,7 @@ MxResult LegoGameState::Load(MxULong p_slot)
 
 	MxString savePath;
 	GetFileSavePath(&savePath, p_slot);
+	m_saveWriter->Flush();
 
 	if (storage.Open(savePath.GetData(), LegoFile::c_read) == FAILURE) {
 		goto done;
@@ -584,6 +606,7 @@ void LegoGameState::SerializePlayersInfo(MxS16 p_flags)
 
 	playersGSI += "\\";
 	playersGSI += g_playersGSI;
+	m_saveWriter->Flush();
 
 	if (storage.Open(playersGSI.GetData(), p_flags) == SUCCESS) {
 		if (storage.IsReadMode()) {
@@ -604,6 +627,8 @@ MxResult LegoGameState::AddPlayer(Username& p_player)
 {
 	MxString from, to;
 
+	m_saveWriter->Flush();
+
 	if (m_playerCount == 9) {
 		GetFileSavePath(&from, 8);
 		remove(from.GetData());
@@ -631,6 +656,8 @@ MxResult LegoGameState::AddPlayer(Username& p_player)
 // FUNCTION: BETA10 0x10084fc4
 void LegoGameState::SwitchPlayer(MxS16 p_playerId)
 {
+	m_saveWriter->Flush();
+
 	if (p_playerId > 0) {
 		MxString from, temp, to;
 
@@ -1376,14 +1403,10 @@ LegoGameState::Username::Username()
 MxResult LegoGameState::Username::Serialize(LegoStorage* p_storage)
 {
 	if (p_storage->IsReadMode()) {
-		for (MxS16 i = 0; i < (MxS16) sizeOfArray(m_letters); i++) {
-			p_storage->ReadS16(m_letters[i]);
-		}
+		p_storage->ReadArray(m_letters, sizeOfArray(m_letters));
 	}
 	else if (p_storage->IsWriteMode()) {
-		for (MxS16 i = 0; i < (MxS16) sizeOfArray(m_letters); i++) {
-			p_storage->WriteS16(m_letters[i]);
-		}
+		p_storage->WriteArray(m_letters, sizeOfArray(m_letters));
 	}
 
 	return SUCCESS;
@@ -1404,11 +1427,7 @@ MxResult LegoGameState::ScoreItem::Serialize(LegoStorage* p_storage)
 	if (p_storage->IsReadMode()) {
 		p_storage->ReadS16(m_totalScore);
 
-		for (MxS32 i = 0; i < 5; i++) {
-			for (MxS32 j = 0; j < 5; j++) {
-				p_storage->ReadU8(m_scores[i][j]);
-			}
-		}
+		p_storage->ReadArray(&m_scores[0][0], sizeOfArray(m_scores) * sizeOfArray(m_scores[0]));
 
 		m_name.Serialize(p_storage);
 		p_storage->ReadS16(m_unk0x2a);
@@ -1416,11 +1435,7 @@ MxResult LegoGameState::ScoreItem::Serialize(LegoStorage* p_storage)
 	else if (p_storage->IsWriteMode()) {
 		p_storage->WriteS16(m_totalScore);
 
-		for (MxS32 i = 0; i < 5; i++) {
-			for (MxS32 j = 0; j < 5; j++) {
-				p_storage->WriteU8(m_scores[i][j]);
-			}
-		}
+		p_storage->WriteArray(&m_scores[0][0], sizeOfArray(m_scores) * sizeOfArray(m_scores[0]));
 
 		m_name.Serialize(p_storage);
 		p_storage->WriteS16(m_unk0x2a);
@@ -1579,9 +1594,21 @@ void LegoGameState::SerializeScoreHistory(MxS16 p_flags)
 	savePath += g_historyGSI;
 
 	if (p_flags == LegoFile::c_write) {
+		LegoGrowableMemory memory;
+		LegoU8* data;
+		LegoU32 size;
+
 		m_history.WriteScoreHistory();
+		m_history.Serialize(&memory);
+
+		data = memory.Detach(size);
+		savePath.MapPathToFilesystem();
+		m_saveWriter->Write(savePath.GetData(), data, size);
+		return;
 	}
 
+	m_saveWriter->Flush();
+
 	if (storage.Open(savePath.GetData(), p_flags) == SUCCESS) {
 		m_history.Serialize(&storage);
 	}
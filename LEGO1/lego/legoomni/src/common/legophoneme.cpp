@@ -1,6 +1,6 @@
 #include "legophoneme.h"
 
-DECOMP_SIZE_ASSERT(LegoPhoneme, 0x20)
+DECOMP_SIZE_ASSERT(LegoPhoneme, 0x40)
 
 // FUNCTION: LEGO1 0x10044e50
 LegoPhoneme::~LegoPhoneme()
@@ -0,0 +1,171 @@
+#include "legosavewriter.h"
+
+#include "mxautolock.h"
+
+#include <SDL2/SDL_log.h>
+#include <SDL2/SDL_rwops.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+LegoSaveWriter::LegoSaveWriter()
+{
+	m_thread = NULL;
+	m_outstanding = 0;
+	m_flushing = FALSE;
+	m_failed = FALSE;
+	m_synchronous = FALSE;
+}
+
+LegoSaveWriter::~LegoSaveWriter()
+{
+	Flush();
+
+	if (m_thread) {
+		// An empty queue tells the thread to stop
+		m_jobSemaphore.Release();
+		m_thread->Terminate();
+		delete m_thread;
+	}
+}
+
+// Takes ownership of p_data, which must have been allocated with new[].
+// p_path is expected to be mapped to the filesystem already.
+// Returns FAILURE if an earlier queued write failed, or this one when it is done synchronously.
+MxResult LegoSaveWriter::Write(const char* p_path, LegoU8* p_data, LegoU32 p_size)
+{
+	Job job;
+	job.m_path = p_path;
+	job.m_data = p_data;
+	job.m_size = p_size;
+
+	if (!m_thread && !m_synchronous) {
+		if (m_jobSemaphore.Init(0, 0x100) == SUCCESS && m_flushSemaphore.Init(0, 1) == SUCCESS) {
+			m_thread = new Thread(this);
+
+			if (m_thread->Start(0x1000, 0) != SUCCESS) {
+				delete m_thread;
+				m_thread = NULL;
+			}
+		}
+
+		// Semaphores cannot be initialized twice, so there is no retry
+		m_synchronous = m_thread == NULL;
+	}
+
+	if (m_synchronous) {
+		MxResult result = WriteFile(job);
+		delete[] p_data;
+		return result;
+	}
+
+	{
+		AUTOLOCK(m_criticalSection);
+		m_jobs.push_back(job);
+		m_outstanding++;
+	}
+
+	m_jobSemaphore.Release();
+	return TakeResult();
+}
+
+// Returns once every queued file is on disk, with FAILURE if any write failed
+MxResult LegoSaveWriter::Flush()
+{
+	MxBool wait;
+
+	{
+		AUTOLOCK(m_criticalSection);
+		wait = m_outstanding != 0;
+		m_flushing = wait;
+	}
+
+	if (wait) {
+		m_flushSemaphore.Wait();
+	}
+
+	return TakeResult();
+}
+
+MxResult LegoSaveWriter::TakeResult()
+{
+	AUTOLOCK(m_criticalSection);
+	MxResult result = m_failed ? FAILURE : SUCCESS;
+	m_failed = FALSE;
+	return result;
+}
+
+MxResult LegoSaveWriter::Thread::Run()
+{
+	while (TRUE) {
+		Job job;
+		m_writer->m_jobSemaphore.Wait();
+
+		{
+			AUTOLOCK(m_writer->m_criticalSection);
+
+			if (m_writer->m_jobs.empty()) {
+				break;
+			}
+
+			job = m_writer->m_jobs.front();
+			m_writer->m_jobs.pop_front();
+		}
+
+		MxResult result = WriteFile(job);
+		delete[] job.m_data;
+
+		{
+			AUTOLOCK(m_writer->m_criticalSection);
+
+			if (result != SUCCESS) {
+				m_writer->m_failed = TRUE;
+			}
+
+			if (--m_writer->m_outstanding == 0 && m_writer->m_flushing) {
+				m_writer->m_flushing = FALSE;
+				m_writer->m_flushSemaphore.Release();
+			}
+		}
+	}
+
+	return MxThread::Run();
+}
+
+MxResult LegoSaveWriter::WriteFile(const Job& p_job)
+{
+	MxString temp = p_job.m_path;
+	temp += ".tmp";
+
+	SDL_RWops* file = SDL_RWFromFile(temp.GetData(), "wb");
+
+	if (!file) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create %s: %s", temp.GetData(), SDL_GetError());
+		return FAILURE;
+	}
+
+	MxBool written = SDL_RWwrite(file, p_job.m_data, 1, p_job.m_size) == p_job.m_size;
+
+	if (SDL_RWclose(file) != 0 || !written) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write %s: %s", temp.GetData(), SDL_GetError());
+		remove(temp.GetData());
+		return FAILURE;
+	}
+
+#ifdef _WIN32
+	MxBool replaced = MoveFileExA(temp.GetData(), p_job.m_path.GetData(), MOVEFILE_REPLACE_EXISTING);
+#else
+	MxBool replaced = rename(temp.GetData(), p_job.m_path.GetData()) == 0;
+#endif
+
+	// Both replace the target in one step, so a complete save is at p_path throughout
+	if (!replaced) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to replace %s", p_job.m_path.GetData());
+		remove(temp.GetData());
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
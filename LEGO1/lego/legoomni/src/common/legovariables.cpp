@@ -9,10 +9,10 @@
 
 #include <SDL2/SDL_stdinc.h>
 
-DECOMP_SIZE_ASSERT(VisibilityVariable, 0x24)
-DECOMP_SIZE_ASSERT(CameraLocationVariable, 0x24)
-DECOMP_SIZE_ASSERT(CursorVariable, 0x24)
-DECOMP_SIZE_ASSERT(WhoAmIVariable, 0x24)
+DECOMP_SIZE_ASSERT(VisibilityVariable, 0x64)
+DECOMP_SIZE_ASSERT(CameraLocationVariable, 0x64)
+DECOMP_SIZE_ASSERT(CursorVariable, 0x64)
+DECOMP_SIZE_ASSERT(WhoAmIVariable, 0x64)
 
 // GLOBAL: LEGO1 0x100f7ab0
 // STRING: LEGO1 0x100f09c0
@@ -0,0 +1,243 @@
+#include "legoworldinfo.h"
+
+#include "legoanimationmanager.h"
+#include "misc/legostorage.h"
+
+#include <string.h>
+
+#define CACHE_MAGIC 0x464e4957 // "WINF"
+
+// Bump when the cache layout changes; older and newer files are then rebuilt
+#define CACHE_VERSION 1
+
+struct CacheHeader {
+	MxU32 m_magic;
+	MxU32 m_version;
+	MxU32 m_animInfoSize;
+	MxU32 m_modelInfoSize;
+	MxU32 m_pointerSize;
+	MxU32 m_sourceSize;
+	MxS64 m_sourceModified;
+	MxU32 m_size;
+	MxU32 m_used;
+	MxU16 m_animCount;
+	MxU16 m_reserved;
+};
+
+// Every allocation starts on a pointer boundary, also in Create's measuring pass
+static MxU32 Align(MxU32 p_size)
+{
+	return (p_size + sizeof(void*) - 1) & ~(MxU32) (sizeof(void*) - 1);
+}
+
+static LegoResult Skip(LegoStorage* p_storage, LegoU32 p_size)
+{
+	LegoU32 position;
+
+	if (p_storage->GetPosition(position) != SUCCESS) {
+		return FAILURE;
+	}
+
+	return p_storage->SetPosition(position + p_size);
+}
+
+LegoWorldInfo::LegoWorldInfo()
+{
+	m_block = NULL;
+	m_size = 0;
+	m_used = 0;
+	m_animCount = 0;
+}
+
+LegoWorldInfo::~LegoWorldInfo()
+{
+	delete[] m_block;
+}
+
+// Sizes the block for the p_animCount records that follow in p_storage, without consuming them.
+// Walks the records the way LegoAnimationManager::ReadAnimInfo and ReadModelInfo read them.
+MxResult LegoWorldInfo::Create(LegoStorage* p_storage, MxU16 p_animCount)
+{
+	LegoU32 position;
+	MxU32 size = Align(p_animCount * sizeof(AnimInfo));
+
+	if (p_storage->GetPosition(position) != SUCCESS) {
+		return FAILURE;
+	}
+
+	for (MxU16 i = 0; i < p_animCount; i++) {
+		MxU8 length, modelCount;
+
+		if (p_storage->Read(&length, sizeof(MxU8)) != SUCCESS) {
+			return FAILURE;
+		}
+
+		size += Align(length + 1);
+
+		// Name, object id, location, four flags and four floats
+		if (Skip(p_storage, length + 4 + 2 + 4 + 4 * sizeof(float)) != SUCCESS ||
+			p_storage->Read(&modelCount, sizeof(MxU8)) != SUCCESS) {
+			return FAILURE;
+		}
+
+		size += Align(modelCount * sizeof(ModelInfo));
+
+		for (MxU8 j = 0; j < modelCount; j++) {
+			if (p_storage->Read(&length, sizeof(MxU8)) != SUCCESS) {
+				return FAILURE;
+			}
+
+			size += Align(length + 1);
+
+			// Name, a flag, location, direction and up, and a flag
+			if (Skip(p_storage, length + 1 + 9 * sizeof(float) + 1) != SUCCESS) {
+				return FAILURE;
+			}
+		}
+	}
+
+	if (p_storage->SetPosition(position) != SUCCESS) {
+		return FAILURE;
+	}
+
+	delete[] m_block;
+	m_block = new MxU8[size];
+	memset(m_block, 0, size);
+	m_size = size;
+	m_used = Align(p_animCount * sizeof(AnimInfo));
+	m_animCount = p_animCount;
+	return SUCCESS;
+}
+
+// Hands out zeroed bytes from the block, or NULL if the records outgrew what Create measured
+void* LegoWorldInfo::Alloc(MxU32 p_size)
+{
+	MxU32 size = Align(p_size);
+
+	if (m_block == NULL || size > m_size - m_used) {
+		return NULL;
+	}
+
+	void* result = m_block + m_used;
+	m_used += size;
+	return result;
+}
+
+// Turns the block's pointers into offsets from its start, or back. Offsets read from a file
+// are checked against the block.
+void LegoWorldInfo::Relocate(MxBool p_toOffsets)
+{
+	AnimInfo* anims = GetAnims();
+
+	for (MxU16 i = 0; i < m_animCount; i++) {
+		AnimInfo& anim = anims[i];
+
+		if (p_toOffsets) {
+			for (MxU8 j = 0; j < anim.m_modelCount; j++) {
+				anim.m_models[j].m_name = (char*) (size_t) ((MxU8*) anim.m_models[j].m_name - m_block);
+			}
+
+			anim.m_name = (char*) (size_t) ((MxU8*) anim.m_name - m_block);
+			anim.m_models = (ModelInfo*) (size_t) ((MxU8*) anim.m_models - m_block);
+		}
+		else {
+			anim.m_name = (char*) (m_block + (size_t) anim.m_name);
+			anim.m_models = (ModelInfo*) (m_block + (size_t) anim.m_models);
+
+			for (MxU8 j = 0; j < anim.m_modelCount; j++) {
+				anim.m_models[j].m_name = (char*) (m_block + (size_t) anim.m_models[j].m_name);
+			}
+		}
+	}
+}
+
+// Loads the records from the cache at p_path, if it was written by this build from the same inf.dta
+MxResult LegoWorldInfo::ReadCache(const char* p_path, MxU32 p_sourceSize, MxS64 p_sourceModified)
+{
+	LegoFile file;
+	CacheHeader header;
+
+	if (file.Open(p_path, LegoFile::c_read) != SUCCESS || file.Read(&header, sizeof(header)) != SUCCESS) {
+		return FAILURE;
+	}
+
+	if (header.m_magic != CACHE_MAGIC || header.m_version != CACHE_VERSION ||
+		header.m_animInfoSize != sizeof(AnimInfo) || header.m_modelInfoSize != sizeof(ModelInfo) ||
+		header.m_pointerSize != sizeof(void*) || header.m_sourceSize != p_sourceSize ||
+		header.m_sourceModified != p_sourceModified || header.m_used > header.m_size ||
+		header.m_animCount * sizeof(AnimInfo) > header.m_used) {
+		return FAILURE;
+	}
+
+	MxU8* block = new MxU8[header.m_size];
+
+	if (file.Read(block, header.m_size) != SUCCESS) {
+		delete[] block;
+		return FAILURE;
+	}
+
+	// Offsets must land in the block, with the names' terminators
+	AnimInfo* anims = (AnimInfo*) block;
+
+	for (MxU16 i = 0; i < header.m_animCount; i++) {
+		size_t models = (size_t) anims[i].m_models;
+
+		if ((size_t) anims[i].m_name >= header.m_used ||
+			models + anims[i].m_modelCount * sizeof(ModelInfo) > header.m_used) {
+			delete[] block;
+			return FAILURE;
+		}
+
+		for (MxU8 j = 0; j < anims[i].m_modelCount; j++) {
+			if ((size_t) ((ModelInfo*) (block + models))[j].m_name >= header.m_used) {
+				delete[] block;
+				return FAILURE;
+			}
+		}
+	}
+
+	if (header.m_used && block[header.m_used - 1] != 0) {
+		delete[] block;
+		return FAILURE;
+	}
+
+	delete[] m_block;
+	m_block = block;
+	m_size = header.m_size;
+	m_used = header.m_used;
+	m_animCount = header.m_animCount;
+	Relocate(FALSE);
+	return SUCCESS;
+}
+
+MxResult LegoWorldInfo::WriteCache(const char* p_path, MxU32 p_sourceSize, MxS64 p_sourceModified)
+{
+	LegoFile file;
+	CacheHeader header;
+
+	if (m_block == NULL || file.Open(p_path, LegoFile::c_write) != SUCCESS) {
+		return FAILURE;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.m_magic = CACHE_MAGIC;
+	header.m_version = CACHE_VERSION;
+	header.m_animInfoSize = sizeof(AnimInfo);
+	header.m_modelInfoSize = sizeof(ModelInfo);
+	header.m_pointerSize = sizeof(void*);
+	header.m_sourceSize = p_sourceSize;
+	header.m_sourceModified = p_sourceModified;
+	header.m_size = m_size;
+	header.m_used = m_used;
+	header.m_animCount = m_animCount;
+
+	Relocate(TRUE);
+	MxResult result = SUCCESS;
+
+	if (file.Write(&header, sizeof(header)) != SUCCESS || file.Write(m_block, m_size) != SUCCESS) {
+		result = FAILURE;
+	}
+
+	Relocate(FALSE);
+	return result;
+}
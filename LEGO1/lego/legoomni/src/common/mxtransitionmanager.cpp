@@ -10,6 +10,7 @@
 #include "mxmisc.h"
 #include "mxparam.h"
 #include "mxticklemanager.h"
+#include "mxtransitionspans.h"
 #include "mxvideopresenter.h"
 
 #include <SDL2/SDL_timer.h>
@@ -19,6 +20,22 @@ DECOMP_SIZE_ASSERT(MxTransitionManager, 0x900)
 // GLOBAL: LEGO1 0x100f4378
 RECT g_fullScreenRect = {0, 0, 640, 480};
 
+// Describes the locked surface to the span kernels. Also sizes g_fullScreenRect, which the flip
+// blits copy, to the surface.
+static MxTransitionSurface GetTransitionSurface(const DDSURFACEDESC& p_ddsd)
+{
+	MxTransitionSurface surface;
+	surface.m_pixels = (MxU8*) p_ddsd.lpSurface;
+	surface.m_pitch = p_ddsd.lPitch;
+	surface.m_width = p_ddsd.dwWidth;
+	surface.m_height = p_ddsd.dwHeight;
+	surface.m_bytesPerPixel = p_ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
+
+	g_fullScreenRect.right = surface.m_width;
+	g_fullScreenRect.bottom = surface.m_height;
+	return surface;
+}
+
 // FUNCTION: LEGO1 0x1004b8d0
 MxTransitionManager::MxTransitionManager()
 {
@@ -177,34 +194,12 @@ void MxTransitionManager::NoTransition()
 void MxTransitionManager::DissolveTransition()
 {
 	// If the animation is finished
-	if (m_animationTimer == 40) {
+	if (m_animationTimer == DISSOLVE_TICKS) {
 		m_animationTimer = 0;
 		EndTransition(TRUE);
 		return;
 	}
 
-	// If we are starting the animation
-	if (m_animationTimer == 0) {
-		// Generate the list of columns in order...
-		MxS32 i;
-		for (i = 0; i < 640; i++) {
-			m_columnOrder[i] = i;
-		}
-
-		// ...then shuffle the list (to ensure that we hit each column once)
-		for (i = 0; i < 640; i++) {
-			MxS32 swap = (rand() % 640);
-			MxU16 t = m_columnOrder[i];
-			m_columnOrder[i] = m_columnOrder[swap];
-			m_columnOrder[swap] = t;
-		}
-
-		// For each scanline, pick a random X offset
-		for (i = 0; i < 480; i++) {
-			m_randomShift[i] = (rand() % 640);
-		}
-	}
-
 	// Run one tick of the animation
 	DDSURFACEDESC ddsd;
 	memset(&ddsd, 0, sizeof(ddsd));
@@ -217,36 +212,17 @@ void MxTransitionManager::DissolveTransition()
 	}
 
 	if (res == DD_OK) {
-		SubmitCopyRect(&ddsd);
+		MxTransitionSurface surface = GetTransitionSurface(ddsd);
 
-		for (MxS32 col = 0; col < 640; col++) {
-			// Select 16 columns on each tick
-			if (m_animationTimer * 16 > m_columnOrder[col]) {
-				continue;
-			}
-
-			if (m_animationTimer * 16 + 15 < m_columnOrder[col]) {
-				continue;
-			}
-
-			for (MxS32 row = 0; row < 480; row++) {
-				// Shift the chosen column a different amount at each scanline.
-				// We use the same shift for that scanline each time.
-				// By the end, every pixel gets hit.
-				MxS32 xShift = (m_randomShift[row] + col) % 640;
-
-				// Set the chosen pixel to black
-				if (ddsd.ddpfPixelFormat.dwRGBBitCount == 8) {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift;
-					*surf = 0;
-				}
-				else {
-					MxU8* surf = (MxU8*) ddsd.lpSurface + ddsd.lPitch * row + xShift * 2;
-					*(MxU16*) surf = 0;
-				}
-			}
+		// If we are starting the animation, shuffle the columns (to ensure that we hit each
+		// column once) and pick a random X offset for each scanline
+		if (m_animationTimer == 0 || m_columnOrder.size() != (size_t) surface.m_width ||
+			m_randomShift.size() != (size_t) surface.m_height) {
+			ShuffleTransitionColumns(m_columnOrder, m_randomShift, surface.m_width, surface.m_height);
 		}
 
+		SubmitCopyRect(&ddsd);
+		DissolveTick(surface, &m_columnOrder[0], &m_randomShift[0], m_animationTimer);
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
 
@@ -262,34 +238,12 @@ void MxTransitionManager::DissolveTransition()
 // FUNCTION: LEGO1 0x1004bed0
 void MxTransitionManager::MosaicTransition()
 {
-	if (m_animationTimer == 16) {
+	if (m_animationTimer == MOSAIC_TICKS) {
 		m_animationTimer = 0;
 		EndTransition(TRUE);
 		return;
 	}
 	else {
-		if (m_animationTimer == 0) {
-
-			// Same init/shuffle steps as the dissolve transition, except that
-			// we are using big blocky pixels and only need 64 columns.
-			MxS32 i;
-			for (i = 0; i < 64; i++) {
-				m_columnOrder[i] = i;
-			}
-
-			for (i = 0; i < 64; i++) {
-				MxS32 swap = (rand() % 64);
-				MxU16 t = m_columnOrder[i];
-				m_columnOrder[i] = m_columnOrder[swap];
-				m_columnOrder[swap] = t;
-			}
-
-			// The same is true here. We only need 48 rows.
-			for (i = 0; i < 48; i++) {
-				m_randomShift[i] = (rand() % 64);
-			}
-		}
-
 		// Run one tick of the animation
 		DDSURFACEDESC ddsd;
 		memset(&ddsd, 0, sizeof(ddsd));
@@ -302,54 +256,16 @@ void MxTransitionManager::MosaicTransition()
 		}
 
 		if (res == DD_OK) {
-			SubmitCopyRect(&ddsd);
-
-			for (MxS32 col = 0; col < 64; col++) {
-				// Select 4 columns on each tick
-				if (m_animationTimer * 4 > m_columnOrder[col]) {
-					continue;
-				}
-
-				if (m_animationTimer * 4 + 3 < m_columnOrder[col]) {
-					continue;
-				}
+			MxTransitionSurface surface = GetTransitionSurface(ddsd);
 
-				for (MxS32 row = 0; row < 48; row++) {
-					// To do the mosaic effect, we subdivide the 640x480 surface into
-					// 10x10 pixel blocks. At the chosen block, we sample the top-leftmost
-					// color and set the other 99 pixels to that value.
-
-					// First, get the offset of the 10x10 block that we will sample for this row.
-					MxS32 xShift = 10 * ((m_randomShift[row] + col) % 64);
-
-					// Combine xShift with this value to target the correct location in the buffer.
-					MxS32 bytesPerPixel = ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
-
-					// Seek to the sample position.
-					MxU8* source = (MxU8*) ddsd.lpSurface + 10 * row * ddsd.lPitch + bytesPerPixel * xShift;
-
-					// Sample byte or word depending on display mode.
-					MxU32 sample = bytesPerPixel == 1 ? *source : *(MxU16*) source;
-
-					// For each of the 10 rows in the 10x10 square:
-					for (MxS32 k = 10 * row; k < 10 * row + 10; k++) {
-						if (ddsd.ddpfPixelFormat.dwRGBBitCount == 8) {
-							// Optimization: If the pixel is only one byte, we can use memset
-							MxU8* pos = ((MxU8*) ddsd.lpSurface + k * ddsd.lPitch + xShift);
-							memset(pos, sample, 10);
-						}
-						else {
-							// Need to double xShift because it measures pixels not bytes
-							MxU16* pos = (MxU16*) ((MxU8*) ddsd.lpSurface + k * ddsd.lPitch + 2 * xShift);
-
-							for (MxS32 tt = 0; tt < 10; tt++) {
-								pos[tt] = sample;
-							}
-						}
-					}
-				}
+			// Same init/shuffle steps as the dissolve transition, except that
+			// we are using big blocky pixels on a 64x48 grid.
+			if (m_animationTimer == 0) {
+				ShuffleTransitionColumns(m_columnOrder, m_randomShift, MOSAIC_COLUMNS, MOSAIC_ROWS);
 			}
 
+			SubmitCopyRect(&ddsd);
+			MosaicTick(surface, &m_columnOrder[0], &m_randomShift[0], m_animationTimer);
 			SetupCopyRect(&ddsd);
 			m_ddSurface->Unlock(ddsd.lpSurface);
 
@@ -367,7 +283,7 @@ void MxTransitionManager::MosaicTransition()
 void MxTransitionManager::WipeDownTransition()
 {
 	// If the animation is finished
-	if (m_animationTimer == 240) {
+	if (m_animationTimer == WIPE_DOWN_TICKS) {
 		m_animationTimer = 0;
 		EndTransition(TRUE);
 		return;
@@ -386,14 +302,7 @@ void MxTransitionManager::WipeDownTransition()
 	if (res == DD_OK) {
 		SubmitCopyRect(&ddsd);
 
-		// For each of the 240 animation ticks, blank out two scanlines
-		// starting at the top of the screen.
-		// (dwRGBBitCount / 8) will tell how many bytes are used per pixel.
-		MxU8* line = (MxU8*) ddsd.lpSurface + 2 * ddsd.lPitch * m_animationTimer;
-		memset(line, 0, 640 * ddsd.ddpfPixelFormat.dwRGBBitCount / 8);
-
-		line += ddsd.lPitch;
-		memset(line, 0, 640 * ddsd.ddpfPixelFormat.dwRGBBitCount / 8);
+		WipeDownTick(GetTransitionSurface(ddsd), m_animationTimer);
 
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
@@ -405,7 +314,7 @@ void MxTransitionManager::WipeDownTransition()
 // FUNCTION: LEGO1 0x1004c270
 void MxTransitionManager::WindowsTransition()
 {
-	if (m_animationTimer == 240) {
+	if (m_animationTimer == WINDOWS_TICKS) {
 		m_animationTimer = 0;
 		EndTransition(TRUE);
 		return;
@@ -424,22 +333,7 @@ void MxTransitionManager::WindowsTransition()
 	if (res == DD_OK) {
 		SubmitCopyRect(&ddsd);
 
-		MxU8* line = (MxU8*) ddsd.lpSurface + m_animationTimer * ddsd.lPitch;
-
-		MxS32 bytesPerPixel = ddsd.ddpfPixelFormat.dwRGBBitCount / 8;
-		MxS32 bytesPerLine = bytesPerPixel * 640;
-
-		memset(line, 0, bytesPerLine);
-
-		for (MxS32 i = m_animationTimer + 1; i < 480 - m_animationTimer; i++) {
-			line += ddsd.lPitch;
-
-			memset(line + m_animationTimer * bytesPerPixel, 0, bytesPerPixel);
-			memset(line + 640 + (-1 - m_animationTimer) * bytesPerPixel, 0, bytesPerPixel);
-		}
-
-		line += ddsd.lPitch;
-		memset(line, 0, bytesPerLine);
+		WindowsTick(GetTransitionSurface(ddsd), m_animationTimer);
 
 		SetupCopyRect(&ddsd);
 		m_ddSurface->Unlock(ddsd.lpSurface);
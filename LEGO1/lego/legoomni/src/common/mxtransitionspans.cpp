@@ -0,0 +1,249 @@
+#include "mxtransitionspans.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MXTRANSITIONSPANS_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MXTRANSITIONSPANS_NEON
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define MXTRANSITIONSPANS_WASM
+#endif
+
+// Shuffles p_columns columns exactly like the original transitions did, then stores the
+// inverse permutation so that each tick can read its columns as one contiguous run.
+void ShuffleTransitionColumns(vector<MxU16>& p_order, vector<MxU16>& p_shift, MxS32 p_columns, MxS32 p_rows)
+{
+	vector<MxU16> rank(p_columns);
+	MxS32 i;
+
+	for (i = 0; i < p_columns; i++) {
+		rank[i] = i;
+	}
+
+	for (i = 0; i < p_columns; i++) {
+		MxS32 swap = (rand() % p_columns);
+		MxU16 t = rank[i];
+		rank[i] = rank[swap];
+		rank[swap] = t;
+	}
+
+	p_shift.resize(p_rows);
+	for (i = 0; i < p_rows; i++) {
+		p_shift[i] = (rand() % p_columns);
+	}
+
+	p_order.resize(p_columns);
+	for (i = 0; i < p_columns; i++) {
+		p_order[rank[i]] = i;
+	}
+}
+
+// Stores the 32-bit p_pattern over the whole 16-byte blocks of p_bytes and returns how many
+// bytes that covered
+static inline MxS32 FillBlocks(MxU8* p_dest, MxS32 p_bytes, MxU32 p_pattern)
+{
+	MxS32 i = 0;
+
+#if defined(MXTRANSITIONSPANS_SSE2)
+	__m128i pattern = _mm_set1_epi32(p_pattern);
+	for (; i + 16 <= p_bytes; i += 16) {
+		_mm_storeu_si128((__m128i*) (p_dest + i), pattern);
+	}
+#elif defined(MXTRANSITIONSPANS_NEON)
+	uint8x16_t pattern = vreinterpretq_u8_u32(vdupq_n_u32(p_pattern));
+	for (; i + 16 <= p_bytes; i += 16) {
+		vst1q_u8(p_dest + i, pattern);
+	}
+#elif defined(MXTRANSITIONSPANS_WASM)
+	v128_t pattern = wasm_i32x4_splat(p_pattern);
+	for (; i + 16 <= p_bytes; i += 16) {
+		wasm_v128_store(p_dest + i, pattern);
+	}
+#endif
+
+	return i;
+}
+
+template <class T>
+static inline void FillSpan(MxU8* p_dest, MxS32 p_count, T p_color, MxU32 p_pattern)
+{
+	MxS32 i = FillBlocks(p_dest, p_count * sizeof(T), p_pattern) / sizeof(T);
+	T* dest = (T*) p_dest;
+
+	for (; i < p_count; i++) {
+		dest[i] = p_color;
+	}
+}
+
+void FillTransitionSpan(MxU8* p_dest, MxS32 p_count, MxS32 p_bytesPerPixel, const MxU8* p_color)
+{
+	switch (p_bytesPerPixel) {
+	case 1:
+		memset(p_dest, *p_color, p_count);
+		break;
+	case 2: {
+		MxU16 color;
+		memcpy(&color, p_color, sizeof(color));
+		FillSpan<MxU16>(p_dest, p_count, color, (MxU32) color | ((MxU32) color << 16));
+		break;
+	}
+	case 4: {
+		MxU32 color;
+		memcpy(&color, p_color, sizeof(color));
+		FillSpan<MxU32>(p_dest, p_count, color, color);
+		break;
+	}
+	default: {
+		// Copy the first pixel, then double the filled part until the span is full
+		MxS32 bytes = p_count * p_bytesPerPixel;
+		MxS32 filled = SDL_min(p_bytesPerPixel, bytes);
+		memcpy(p_dest, p_color, filled);
+
+		while (filled < bytes) {
+			MxS32 size = SDL_min(filled, bytes - filled);
+			memcpy(p_dest + filled, p_dest, size);
+			filled += size;
+		}
+		break;
+	}
+	}
+}
+
+template <class T>
+static inline void ClearShiftedPixels(MxU8* p_line, const MxU16* p_columns, MxS32 p_count, MxS32 p_shift, MxS32 p_width)
+{
+	T* line = (T*) p_line;
+
+	for (MxS32 i = 0; i < p_count; i++) {
+		MxS32 x = p_shift + p_columns[i];
+		if (x >= p_width) {
+			x -= p_width;
+		}
+
+		line[x] = 0;
+	}
+}
+
+// Clears 1/40th of the columns, shifted by a fixed amount per scanline so that every pixel is hit
+// once by the last tick. p_order and p_shift come from ShuffleTransitionColumns for the surface.
+void DissolveTick(const MxTransitionSurface& p_surface, const MxU16* p_order, const MxU16* p_shift, MxS32 p_tick)
+{
+	MxS32 width = p_surface.m_width;
+	MxS32 perTick = (width + DISSOLVE_TICKS - 1) / DISSOLVE_TICKS;
+	MxS32 first = p_tick * perTick;
+	MxS32 count = first < width ? SDL_min(perTick, width - first) : 0;
+	const MxU16* columns = p_order + first;
+
+	for (MxS32 row = 0; row < p_surface.m_height && count; row++) {
+		MxU8* line = p_surface.m_pixels + p_surface.m_pitch * row;
+		MxS32 shift = p_shift[row];
+
+		switch (p_surface.m_bytesPerPixel) {
+		case 1:
+			ClearShiftedPixels<MxU8>(line, columns, count, shift, width);
+			break;
+		case 2:
+			ClearShiftedPixels<MxU16>(line, columns, count, shift, width);
+			break;
+		case 4:
+			ClearShiftedPixels<MxU32>(line, columns, count, shift, width);
+			break;
+		default:
+			for (MxS32 i = 0; i < count; i++) {
+				MxS32 x = (shift + columns[i]) % width;
+				memset(line + x * p_surface.m_bytesPerPixel, 0, p_surface.m_bytesPerPixel);
+			}
+			break;
+		}
+	}
+}
+
+// Subdivides the surface into a 64x48 grid of blocks (10x10 pixels at 640x480) and, in four grid
+// columns per tick, sets each block to its top-left pixel. p_order and p_shift come from
+// ShuffleTransitionColumns for the grid.
+void MosaicTick(const MxTransitionSurface& p_surface, const MxU16* p_order, const MxU16* p_shift, MxS32 p_tick)
+{
+	MxS32 perTick = MOSAIC_COLUMNS / MOSAIC_TICKS;
+	MxS32 bytesPerPixel = p_surface.m_bytesPerPixel;
+
+	for (MxS32 i = p_tick * perTick; i < (p_tick + 1) * perTick; i++) {
+		MxS32 col = p_order[i];
+
+		for (MxS32 row = 0; row < MOSAIC_ROWS; row++) {
+			MxS32 block = (p_shift[row] + col) % MOSAIC_COLUMNS;
+			MxS32 left = block * p_surface.m_width / MOSAIC_COLUMNS;
+			MxS32 blockWidth = (block + 1) * p_surface.m_width / MOSAIC_COLUMNS - left;
+			MxS32 top = row * p_surface.m_height / MOSAIC_ROWS;
+			MxS32 bottom = (row + 1) * p_surface.m_height / MOSAIC_ROWS;
+
+			if (blockWidth <= 0 || top >= bottom) {
+				continue;
+			}
+
+			// Fill the first line of the block from the sample, then copy it down
+			MxU8* source = p_surface.m_pixels + top * p_surface.m_pitch + left * bytesPerPixel;
+			MxU8 sample[4];
+			memcpy(sample, source, bytesPerPixel);
+			FillTransitionSpan(source, blockWidth, bytesPerPixel, sample);
+
+			MxU8* pos = source;
+			for (MxS32 k = top + 1; k < bottom; k++) {
+				pos += p_surface.m_pitch;
+				memcpy(pos, source, blockWidth * bytesPerPixel);
+			}
+		}
+	}
+}
+
+// Blanks the next 1/240th of the scanlines (two at 480 lines) from the top
+void WipeDownTick(const MxTransitionSurface& p_surface, MxS32 p_tick)
+{
+	MxS32 first = p_tick * p_surface.m_height / WIPE_DOWN_TICKS;
+	MxS32 last = (p_tick + 1) * p_surface.m_height / WIPE_DOWN_TICKS;
+	MxS32 bytesPerLine = p_surface.m_width * p_surface.m_bytesPerPixel;
+	MxU8* line = p_surface.m_pixels + p_surface.m_pitch * first;
+
+	for (MxS32 i = first; i < last; i++) {
+		memset(line, 0, bytesPerLine);
+		line += p_surface.m_pitch;
+	}
+}
+
+// Shrinks a black frame towards the center, by one pixel per tick at 480 lines
+void WindowsTick(const MxTransitionSurface& p_surface, MxS32 p_tick)
+{
+	MxS32 width = p_surface.m_width;
+	MxS32 height = p_surface.m_height;
+	MxS32 bytesPerPixel = p_surface.m_bytesPerPixel;
+	MxS32 bytesPerLine = bytesPerPixel * width;
+	MxS32 inner = p_tick * height / (2 * WINDOWS_TICKS);
+	MxS32 outer = (p_tick + 1) * height / (2 * WINDOWS_TICKS);
+	MxS32 left = SDL_min(inner, width);
+	MxS32 frameWidth = (SDL_min(outer, width) - left) * bytesPerPixel;
+	MxS32 right = SDL_max(width - outer, 0);
+	MxS32 i;
+
+	MxU8* line = p_surface.m_pixels + inner * p_surface.m_pitch;
+
+	for (i = inner; i < outer; i++) {
+		memset(line, 0, bytesPerLine);
+		line += p_surface.m_pitch;
+	}
+
+	for (; i < height - outer; i++) {
+		memset(line + left * bytesPerPixel, 0, frameWidth);
+		memset(line + right * bytesPerPixel, 0, frameWidth);
+		line += p_surface.m_pitch;
+	}
+
+	for (; i < height - inner; i++) {
+		memset(line, 0, bytesPerLine);
+		line += p_surface.m_pitch;
+	}
+}
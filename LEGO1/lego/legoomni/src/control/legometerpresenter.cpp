@@ -11,7 +11,7 @@
 #include <SDL2/SDL_stdinc.h>
 #include <assert.h>
 
-DECOMP_SIZE_ASSERT(LegoMeterPresenter, 0x94)
+DECOMP_SIZE_ASSERT(LegoMeterPresenter, 0xb4)
 
 // FUNCTION: LEGO1 0x10043430
 // FUNCTION: BETA10 0x10097570
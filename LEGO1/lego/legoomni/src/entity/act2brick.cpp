@@ -2,6 +2,7 @@
 
 #include "legocachesoundmanager.h"
 #include "legocharactermanager.h"
+#include "legomain.h"
 #include "legosoundmanager.h"
 #include "legoworld.h"
 #include "misc.h"
@@ -52,6 +53,7 @@ MxResult Act2Brick::Create(MxS32 p_index)
 	sprintf(name, "chbrick%d", p_index);
 
 	m_roi = CharacterManager()->CreateAutoROI(name, g_lodNames[p_index], FALSE);
+	Lego()->UpdateEntityName(this);
 	assert(m_roi);
 
 #ifndef BETA10
@@ -86,6 +88,7 @@ void Act2Brick::Remove()
 	if (m_roi != NULL) {
 		CharacterManager()->ReleaseActor(m_roi->GetName());
 		m_roi = NULL;
+		Lego()->UpdateEntityName(this);
 	}
 
 	m_unk0x164 = 0;
@@ -130,6 +130,7 @@ void LegoEntity::SetWorld()
 void LegoEntity::SetROI(LegoROI* p_roi, MxBool p_bool1, MxBool p_bool2)
 {
 	m_roi = p_roi;
+	Lego()->UpdateEntityName(this);
 
 	if (m_roi != NULL) {
 		if (p_bool2) {
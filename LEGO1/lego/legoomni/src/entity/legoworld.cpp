@@ -114,6 +114,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 	while (animPresenterCursor.First(presenter)) {
 		animPresenterCursor.Detach();
+		RemoveFromIndices(presenter);
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
@@ -137,6 +138,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 		MxCoreSet::iterator it = m_set0xa8.begin();
 		MxCore* object = *it;
 		m_set0xa8.erase(it);
+		RemoveFromIndices(object);
 
 		if (object->IsA("MxPresenter")) {
 			MxPresenter* presenter = (MxPresenter*) object;
@@ -156,6 +158,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 	while (controlPresenterCursor.First(presenter)) {
 		controlPresenterCursor.Detach();
+		RemoveFromIndices(presenter);
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
@@ -175,6 +178,7 @@ void LegoWorld::Destroy(MxBool p_fromDestructor)
 
 		while (cursor.First(entity)) {
 			cursor.Detach();
+			RemoveFromIndices(entity);
 
 			if (!(entity->GetFlags() & LegoEntity::c_managerOwned)) {
 				delete entity;
@@ -443,6 +447,7 @@ void LegoWorld::Add(MxCore* p_object)
 		}
 
 		m_controlPresenters.Append((MxPresenter*) p_object);
+		AddToIndices(e_controlPresenters, p_object);
 	}
 	else if (p_object->IsA("MxEntity")) {
 		LegoEntityListCursor cursor(m_entityList);
@@ -453,6 +458,7 @@ void LegoWorld::Add(MxCore* p_object)
 		}
 
 		m_entityList->Append((LegoEntity*) p_object);
+		AddToIndices(e_entities, p_object);
 	}
 	else if (p_object->IsA("LegoLocomotionAnimPresenter") || p_object->IsA("LegoHideAnimPresenter") || p_object->IsA("LegoLoopingAnimPresenter")) {
 		MxPresenterListCursor cursor(&m_animPresenters);
@@ -464,6 +470,7 @@ void LegoWorld::Add(MxCore* p_object)
 
 		((MxPresenter*) p_object)->SendToCompositePresenter(Lego());
 		m_animPresenters.Append(((MxPresenter*) p_object));
+		AddToIndices(e_animPresenters, p_object);
 
 		if (p_object->IsA("LegoHideAnimPresenter")) {
 			m_hideAnim = (LegoHideAnimPresenter*) p_object;
@@ -491,6 +498,10 @@ void LegoWorld::Add(MxCore* p_object)
 #endif
 
 			m_set0xa8.insert(p_object);
+
+			if (p_object->IsA("MxPresenter")) {
+				AddToIndices(e_otherPresenters, p_object);
+			}
 		}
 		else {
 			assert(0);
@@ -520,6 +531,7 @@ void LegoWorld::Remove(MxCore* p_object)
 
 		if (cursor.Find((MxControlPresenter*) p_object)) {
 			cursor.Detach();
+			RemoveFromIndices(p_object);
 			((MxControlPresenter*) p_object)->GetAction()->SetOrigin(Lego());
 			((MxControlPresenter*) p_object)->VTable0x68(TRUE);
 		}
@@ -529,6 +541,7 @@ void LegoWorld::Remove(MxCore* p_object)
 
 		if (cursor.Find((MxPresenter*) p_object)) {
 			cursor.Detach();
+			RemoveFromIndices(p_object);
 		}
 
 		if (p_object->IsA("LegoHideAnimPresenter")) {
@@ -545,6 +558,7 @@ void LegoWorld::Remove(MxCore* p_object)
 
 			if (cursor.Find((LegoEntity*) p_object)) {
 				cursor.Detach();
+				RemoveFromIndices(p_object);
 			}
 		}
 	}
@@ -561,6 +575,7 @@ void LegoWorld::Remove(MxCore* p_object)
 		it = m_set0xa8.find(p_object);
 		if (it != m_set0xa8.end()) {
 			m_set0xa8.erase(it);
+			RemoveFromIndices(p_object);
 		}
 	}
 
@@ -574,13 +589,19 @@ void LegoWorld::Remove(MxCore* p_object)
 // FUNCTION: BETA10 0x100db027
 MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 {
+	// Each list keeps a name index in list order. Candidates are checked
+	// against the original criteria so hash collisions never produce a match.
+	const LegoWorldIndex::Bucket* bucket;
+	LegoWorldIndex::Bucket::const_iterator it;
+
 	if (!strcmp(p_class, "MxControlPresenter")) {
-		MxPresenterListCursor cursor(&m_controlPresenters);
-		MxPresenter* presenter;
+		if (p_name && (bucket = m_nameIndex[e_controlPresenters].Find(LegoWorldIndex::HashName(p_name)))) {
+			for (it = bucket->begin(); it != bucket->end(); it++) {
+				MxPresenter* presenter = (MxPresenter*) *it;
 
-		while (cursor.Next(presenter)) {
-			if (!strcmp(presenter->GetAction()->GetObjectName(), p_name)) {
-				return presenter;
+				if (!strcmp(presenter->GetAction()->GetObjectName(), p_name)) {
+					return presenter;
+				}
 			}
 		}
 
@@ -588,17 +609,24 @@ MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 	}
 
 	if (!strcmp(p_class, "MxEntity")) {
-		LegoEntityListCursor cursor(m_entityList);
-		LegoEntity* entity;
+		if (!p_name) {
+			LegoEntityListCursor cursor(m_entityList);
+			LegoEntity* entity;
 
-		while (cursor.Next(entity)) {
-			if (!p_name) {
+			if (cursor.First(entity)) {
 				return entity;
 			}
 
-			LegoROI* roi = entity->GetROI();
-			if (roi && !SDL_strcasecmp(roi->GetName(), p_name)) {
-				return entity;
+			return NULL;
+		}
+
+		if ((bucket = m_nameIndex[e_entities].Find(LegoWorldIndex::HashName(p_name)))) {
+			for (it = bucket->begin(); it != bucket->end(); it++) {
+				LegoROI* roi = ((LegoEntity*) *it)->GetROI();
+
+				if (roi && roi->GetName() && !SDL_strcasecmp(roi->GetName(), p_name)) {
+					return *it;
+				}
 			}
 		}
 
@@ -606,79 +634,136 @@ MxCore* LegoWorld::Find(const char* p_class, const char* p_name)
 	}
 
 	if (!strcmp(p_class, "LegoAnimPresenter")) {
-		MxPresenterListCursor cursor(&m_animPresenters);
-		MxPresenter* presenter;
+		if (p_name && (bucket = m_nameIndex[e_animPresenters].Find(LegoWorldIndex::HashName(p_name)))) {
+			for (it = bucket->begin(); it != bucket->end(); it++) {
+				LegoAnimPresenter* presenter = (LegoAnimPresenter*) *it;
 
-		while (cursor.Next(presenter)) {
-			if (!SDL_strcasecmp(((LegoAnimPresenter*) presenter)->GetActionObjectName(), p_name)) {
-				return presenter;
+				if (presenter->GetAction() && !SDL_strcasecmp(presenter->GetActionObjectName(), p_name)) {
+					return presenter;
+				}
 			}
 		}
 
 		return NULL;
 	}
 
-	for (MxCoreSet::iterator i = m_set0xa8.begin(); i != m_set0xa8.end(); i++) {
-		if ((*i)->IsA(p_class) && (*i)->IsA("MxPresenter")) {
-			assert(((MxPresenter*) (*i))->GetAction());
+	// m_set0xa8 is ordered by address, so the first match is the lowest one
+	MxCore* result = NULL;
+	CoreSetCompare compare;
+
+	if (p_name && (bucket = m_nameIndex[e_otherPresenters].Find(LegoWorldIndex::HashName(p_name)))) {
+		for (it = bucket->begin(); it != bucket->end(); it++) {
+			if ((*it)->IsA(p_class) && (result == NULL || compare(*it, result))) {
+				assert(((MxPresenter*) (*it))->GetAction());
 
-			if (!strcmp(((MxPresenter*) (*i))->GetAction()->GetObjectName(), p_name)) {
-				return *i;
+				if (!strcmp(((MxPresenter*) (*it))->GetAction()->GetObjectName(), p_name)) {
+					result = *it;
+				}
 			}
 		}
 	}
 
-	return NULL;
+	return result;
 }
 
 // FUNCTION: LEGO1 0x10021790
 // FUNCTION: BETA10 0x100db3de
 MxCore* LegoWorld::Find(const MxAtomId& p_atom, MxS32 p_entityId)
 {
-	LegoEntityListCursor entityCursor(m_entityList);
-	LegoEntity* entity;
+	MxU32 key = LegoWorldIndex::HashAtom(p_atom, p_entityId);
+	const LegoWorldIndex::Bucket* bucket;
+	LegoWorldIndex::Bucket::const_iterator it;
+
+	if ((bucket = m_atomIndex[e_entities].Find(key))) {
+		for (it = bucket->begin(); it != bucket->end(); it++) {
+			LegoEntity* entity = (LegoEntity*) *it;
 
-	while (entityCursor.Next(entity)) {
-		if (entity->GetAtomId() == p_atom && entity->GetEntityId() == p_entityId) {
-			return entity;
+			if (entity->GetAtomId() == p_atom && entity->GetEntityId() == p_entityId) {
+				return entity;
+			}
 		}
 	}
 
-	MxPresenterListCursor controlPresenterCursor(&m_controlPresenters);
-	MxPresenter* presenter;
-
-	while (controlPresenterCursor.Next(presenter)) {
-		MxDSAction* action = presenter->GetAction();
+	for (MxS32 category = e_controlPresenters; category <= e_animPresenters; category++) {
+		if ((bucket = m_atomIndex[category].Find(key))) {
+			for (it = bucket->begin(); it != bucket->end(); it++) {
+				MxDSAction* action = ((MxPresenter*) *it)->GetAction();
 
-		if (action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
-			return presenter;
+				if (action && action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
+					return *it;
+				}
+			}
 		}
 	}
 
-	MxPresenterListCursor animPresenterCursor(&m_animPresenters);
+	MxCore* result = NULL;
+	CoreSetCompare compare;
 
-	while (animPresenterCursor.Next(presenter)) {
-		MxDSAction* action = presenter->GetAction();
+	if ((bucket = m_atomIndex[e_otherPresenters].Find(key))) {
+		for (it = bucket->begin(); it != bucket->end(); it++) {
+			if (result == NULL || compare(*it, result)) {
+				MxDSAction* action = ((MxPresenter*) *it)->GetAction();
 
-		if (action && action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
-			return presenter;
+				if (action && action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
+					result = *it;
+				}
+			}
 		}
 	}
 
-	for (MxCoreSet::iterator it = m_set0xa8.begin(); it != m_set0xa8.end(); it++) {
-		MxCore* core = *it;
+	return result;
+}
 
-		if (core->IsA("MxPresenter")) {
-			MxPresenter* presenter = (MxPresenter*) *it;
-			MxDSAction* action = presenter->GetAction();
+void LegoWorld::AddToIndices(IndexCategory p_category, MxCore* p_object)
+{
+	if (p_category == e_entities) {
+		LegoEntity* entity = (LegoEntity*) p_object;
+		m_atomIndex[p_category].Add(LegoWorldIndex::HashAtom(entity->GetAtomId(), entity->GetEntityId()), entity);
 
-			if (action->GetAtomId() == p_atom && action->GetObjectId() == p_entityId) {
-				return *it;
+		UpdateEntityName(entity);
+	}
+	else {
+		MxDSAction* action = ((MxPresenter*) p_object)->GetAction();
+
+		if (action) {
+			m_atomIndex[p_category].Add(LegoWorldIndex::HashAtom(action->GetAtomId(), action->GetObjectId()), p_object);
+
+			if (action->GetObjectName()) {
+				m_nameIndex[p_category].Add(LegoWorldIndex::HashName(action->GetObjectName()), p_object);
 			}
 		}
 	}
+}
 
-	return NULL;
+void LegoWorld::RemoveFromIndices(MxCore* p_object)
+{
+	for (MxS32 i = 0; i < e_numIndexCategories; i++) {
+		m_atomIndex[i].Remove(p_object);
+		m_nameIndex[i].Remove(p_object);
+	}
+}
+
+// Re-keys p_entity in the entity name index after its ROI or the ROI's name changed.
+// The index keeps the order of the entity list, which the atom index shares, so Find
+// still returns the first match. Entities of other worlds are ignored.
+void LegoWorld::UpdateEntityName(LegoEntity* p_entity)
+{
+	if (!m_atomIndex[e_entities].Contains(p_entity)) {
+		return;
+	}
+
+	LegoROI* roi = p_entity->GetROI();
+
+	if (roi && roi->GetName()) {
+		m_nameIndex[e_entities].Add(
+			LegoWorldIndex::HashName(roi->GetName()),
+			p_entity,
+			m_atomIndex[e_entities].GetOrder(p_entity)
+		);
+	}
+	else {
+		m_nameIndex[e_entities].Remove(p_entity);
+	}
 }
 
 // FUNCTION: LEGO1 0x10021a70
@@ -0,0 +1,91 @@
+#include "legoworldindex.h"
+
+#include "mxatom.h"
+#include "mxutilities.h"
+
+// Case-folded, so the same key serves exact and case-insensitive lookups.
+MxU32 LegoWorldIndex::HashName(const char* p_name)
+{
+	return HashStringNoCase(p_name);
+}
+
+// Atoms are interned, so the internal string pointer identifies the atom.
+MxU32 LegoWorldIndex::HashAtom(const MxAtomId& p_atom, MxS32 p_id)
+{
+	MxU32 hash = (MxU32) (size_t) p_atom.GetInternal();
+	hash ^= (MxU32) p_id + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+void LegoWorldIndex::Add(MxU32 p_key, MxCore* p_object)
+{
+	unordered_map<MxCore*, Entry>::iterator entry = m_entries.find(p_object);
+	Add(p_key, p_object, entry != m_entries.end() ? entry->second.m_order : m_nextOrder++);
+}
+
+// Buckets are sorted by order, which is the insertion order unless the caller supplies
+// the order of a related index
+void LegoWorldIndex::Add(MxU32 p_key, MxCore* p_object, MxU32 p_order)
+{
+	Remove(p_object);
+
+	Entry entry;
+	entry.m_key = p_key;
+	entry.m_order = p_order;
+	m_entries[p_object] = entry;
+
+	Bucket& bucket = m_buckets[p_key];
+	Bucket::iterator it = bucket.end();
+
+	while (it != bucket.begin() && m_entries[*(it - 1)].m_order > p_order) {
+		it--;
+	}
+
+	bucket.insert(it, p_object);
+
+	if (p_order >= m_nextOrder) {
+		m_nextOrder = p_order + 1;
+	}
+}
+
+void LegoWorldIndex::Remove(MxCore* p_object)
+{
+	unordered_map<MxCore*, Entry>::iterator entry = m_entries.find(p_object);
+
+	if (entry == m_entries.end()) {
+		return;
+	}
+
+	unordered_map<MxU32, Bucket>::iterator bucket = m_buckets.find(entry->second.m_key);
+	m_entries.erase(entry);
+
+	if (bucket != m_buckets.end()) {
+		for (Bucket::iterator it = bucket->second.begin(); it != bucket->second.end(); it++) {
+			if (*it == p_object) {
+				bucket->second.erase(it);
+				break;
+			}
+		}
+
+		if (bucket->second.empty()) {
+			m_buckets.erase(bucket);
+		}
+	}
+}
+
+void LegoWorldIndex::Clear()
+{
+	m_buckets.clear();
+	m_entries.clear();
+}
+
+const LegoWorldIndex::Bucket* LegoWorldIndex::Find(MxU32 p_key) const
+{
+	unordered_map<MxU32, Bucket>::const_iterator bucket = m_buckets.find(p_key);
+
+	if (bucket == m_buckets.end()) {
+		return NULL;
+	}
+
+	return &bucket->second;
+}
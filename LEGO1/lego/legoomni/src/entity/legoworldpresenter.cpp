@@ -13,6 +13,7 @@
 #include "legovideomanager.h"
 #include "legoworld.h"
 #include "misc.h"
+#include "misc/legocontainer.h"
 #include "modeldb/modeldb.h"
 #include "mxactionnotificationparam.h"
 #include "mxautolock.h"
@@ -28,7 +29,9 @@
 #include "mxutilities.h"
 
 #include "SDL_iostream_compat.h"
+#include <SDL2/SDL_log.h>
 #include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
 #include <stdio.h>
 
 DECOMP_SIZE_ASSERT(LegoWorldPresenter, 0x54)
@@ -39,12 +42,111 @@ MxS32 g_legoWorldPresenterQuality = 1;
 // GLOBAL: LEGO1 0x100f75d8
 Sint64 g_wdbOffset = 0;
 
+// WORLD.WDB is read into memory on the first world load and its index parsed once.
+// Part and model chunks then point straight into its image. Freed by UnloadWorldDb.
+static ModelDb* g_modelDb = NULL;
+
+static MxResult LoadWorldDb()
+{
+	char wdbPath[512];
+	sprintf(wdbPath, "%s", MxOmni::GetHD());
+
+	if (wdbPath[strlen(wdbPath) - 1] != '\\' && wdbPath[strlen(wdbPath) - 1] != '/') {
+		strcat(wdbPath, "\\");
+	}
+
+	strcat(wdbPath, "lego\\data\\world.wdb");
+	MxString::MapPathToFilesystem(wdbPath);
+
+	SDL_IOStream* wdbFile;
+
+	if ((wdbFile = SDL_RWFromFile(wdbPath, "rb")) == NULL) {
+		sprintf(wdbPath, "%s", MxOmni::GetCD());
+
+		if (wdbPath[strlen(wdbPath) - 1] != '\\' && wdbPath[strlen(wdbPath) - 1] != '/') {
+			strcat(wdbPath, "\\");
+		}
+
+		strcat(wdbPath, "lego\\data\\world.wdb");
+		MxString::MapPathToFilesystem(wdbPath);
+
+		if ((wdbFile = SDL_RWFromFile(wdbPath, "rb")) == NULL) {
+			return FAILURE;
+		}
+	}
+
+	Sint64 size = SDL_RWsize(wdbFile);
+	MxU8* data = size > 0 ? new MxU8[size] : NULL;
+
+	if (data == NULL || SDL_RWread(wdbFile, data, 1, size) != size) {
+		delete[] data;
+		SDL_RWclose(wdbFile);
+		return FAILURE;
+	}
+
+	SDL_RWclose(wdbFile);
+
+	Uint64 parseStart = SDL_GetPerformanceCounter();
+	ModelDb* modelDb = new ModelDb();
+
+	if (modelDb->Read(data, size) != SUCCESS) {
+		delete modelDb;
+		return FAILURE;
+	}
+
+	SDL_LogDebug(
+		SDL_LOG_CATEGORY_APPLICATION,
+		"Parsed world.wdb index in %.3fms: %d worlds, %u parts, %u models in a %u byte arena (%u bytes of names)",
+		(SDL_GetPerformanceCounter() - parseStart) * 1000.0 / SDL_GetPerformanceFrequency(),
+		modelDb->GetNumWorlds(),
+		modelDb->GetNumParts(),
+		modelDb->GetNumModels(),
+		modelDb->GetArenaSize(),
+		modelDb->GetPoolSize()
+	);
+
+	g_modelDb = modelDb;
+	return SUCCESS;
+}
+
+// Points p_chunk at the size-prefixed block at p_position and moves past it
+static MxResult ReadWorldDbChunk(MxU32& p_position, MxDSChunk& p_chunk)
+{
+	MxU8* data;
+	MxU32 size;
+
+	if ((data = g_modelDb->GetData(p_position, sizeof(MxU32))) == NULL) {
+		return FAILURE;
+	}
+
+	memcpy(&size, data, sizeof(MxU32));
+	p_position += sizeof(MxU32);
+
+	if ((data = g_modelDb->GetData(p_position, size)) == NULL) {
+		return FAILURE;
+	}
+
+	p_chunk.SetLength(size);
+	p_chunk.SetData(data);
+	p_position += size;
+	return SUCCESS;
+}
+
 // FUNCTION: LEGO1 0x100665b0
 void LegoWorldPresenter::configureLegoWorldPresenter(MxS32 p_legoWorldPresenterQuality)
 {
 	g_legoWorldPresenterQuality = p_legoWorldPresenterQuality;
 }
 
+// Frees the WORLD.WDB image and index. The next LoadWorld reads them again, along with the
+// global textures and parts that follow the index.
+void LegoWorldPresenter::UnloadWorldDb()
+{
+	delete g_modelDb;
+	g_modelDb = NULL;
+	g_wdbOffset = 0;
+}
+
 // FUNCTION: LEGO1 0x100665c0
 LegoWorldPresenter::LegoWorldPresenter()
 {
@@ -165,138 +267,88 @@ void LegoWorldPresenter::StartingTickle()
 // FUNCTION: LEGO1 0x10066b40
 MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 {
-	char wdbPath[512];
-	sprintf(wdbPath, "%s", MxOmni::GetHD());
-
-	if (wdbPath[strlen(wdbPath) - 1] != '\\' && wdbPath[strlen(wdbPath) - 1] != '/') {
-		strcat(wdbPath, "\\");
-	}
-
-	strcat(wdbPath, "lego\\data\\world.wdb");
-	MxString::MapPathToFilesystem(wdbPath);
-
-	SDL_IOStream* wdbFile;
-
-	if ((wdbFile = SDL_RWFromFile(wdbPath, "rb")) == NULL) {
-		sprintf(wdbPath, "%s", MxOmni::GetCD());
-
-		if (wdbPath[strlen(wdbPath) - 1] != '\\' && wdbPath[strlen(wdbPath) - 1] != '/') {
-			strcat(wdbPath, "\\");
-		}
-
-		strcat(wdbPath, "lego\\data\\world.wdb");
-		MxString::MapPathToFilesystem(wdbPath);
-
-		if ((wdbFile = SDL_RWFromFile(wdbPath, "rb")) == NULL) {
-			return FAILURE;
-		}
+	Uint64 loadStart = SDL_GetPerformanceCounter();
+	MxU32 stringAllocations = MxString::GetHeapAllocations();
+	LegoTextureContainer* textures = TextureContainer();
+	MxU32 surfaceCount = textures->GetSurfaceCount();
+	MxU32 surfaceBytes = textures->GetSurfaceBytes();
+	MxU32 sharedCount = textures->GetSharedCount();
+	MxU32 sharedBytes = textures->GetSharedBytes();
+	Uint64 textureTicks = textures->GetCreateTicks();
+
+	if (g_modelDb == NULL && LoadWorldDb() != SUCCESS) {
+		return FAILURE;
 	}
 
-	ModelDbWorld* worlds = NULL;
-	MxS32 numWorlds, i, j;
-	MxU32 size;
-	MxU8* buff;
-
-	ReadModelDbWorlds(wdbFile, worlds, numWorlds);
+	ModelDbWorldEntry* world = g_modelDb->FindWorld(p_worldName);
+	MxS32 j;
 
-	for (i = 0; i < numWorlds; i++) {
-		if (!SDL_strcasecmp(worlds[i].m_worldName, p_worldName)) {
-			break;
-		}
-	}
-
-	if (i == numWorlds) {
+	if (world == NULL) {
 		return FAILURE;
 	}
 
 	if (g_wdbOffset == 0) {
-		if (SDL_RWread(wdbFile, &size, 1, sizeof(MxU32)) != sizeof(MxU32)) {
-			return FAILURE;
-		}
+		MxU32 position = g_modelDb->GetIndexEnd();
+		MxDSChunk chunk;
 
-		buff = new MxU8[size];
-		if (SDL_RWread(wdbFile, buff, 1, size) != size) {
+		if (ReadWorldDbChunk(position, chunk) != SUCCESS) {
 			return FAILURE;
 		}
 
-		MxDSChunk chunk;
-		chunk.SetLength(size);
-		chunk.SetData(buff);
-
 		LegoTexturePresenter texturePresenter;
 		if (texturePresenter.Read(chunk) == SUCCESS) {
 			texturePresenter.Store();
 		}
 
-		delete[] buff;
-
-		if (SDL_RWread(wdbFile, &size, 1, sizeof(MxU32)) != sizeof(MxU32)) {
+		if (ReadWorldDbChunk(position, chunk) != SUCCESS) {
 			return FAILURE;
 		}
 
-		buff = new MxU8[size];
-		if (SDL_RWread(wdbFile, buff, 1, size) != size) {
-			return FAILURE;
-		}
-
-		chunk.SetLength(size);
-		chunk.SetData(buff);
-
 		LegoPartPresenter partPresenter;
 		if (partPresenter.Read(chunk) == SUCCESS) {
 			partPresenter.Store();
 		}
 
-		delete[] buff;
-
-		g_wdbOffset = SDL_RWtell(wdbFile);
+		g_wdbOffset = position;
 	}
-	else {
-		if (SDL_RWseek(wdbFile, g_wdbOffset, RW_SEEK_SET) != g_wdbOffset) {
-			return FAILURE;
-		}
-	}
-
-	ModelDbPartListCursor cursor(worlds[i].m_partList);
-	ModelDbPart* part;
 
-	while (cursor.Next(part)) {
-		if (GetViewLODListManager()->Lookup(part->m_roiName.GetData()) == NULL &&
-			LoadWorldPart(*part, wdbFile) != SUCCESS) {
+	for (j = 0; j < world->m_numParts; j++) {
+		if (GetViewLODListManager()->Lookup(world->m_parts[j].m_roiName) == NULL &&
+			LoadWorldPart(world->m_parts[j]) != SUCCESS) {
 			return FAILURE;
 		}
 	}
 
-	for (j = 0; j < worlds[i].m_numModels; j++) {
-		if (!SDL_strncasecmp(worlds[i].m_models[j].m_modelName, "isle", 4)) {
+	for (j = 0; j < world->m_numModels; j++) {
+		if (!SDL_strncasecmp(world->m_models[j].m_modelName, "isle", 4)) {
 			switch (g_legoWorldPresenterQuality) {
 			case 0:
-				if (SDL_strcasecmp(worlds[i].m_models[j].m_modelName, "isle_lo")) {
+				if (SDL_strcasecmp(world->m_models[j].m_modelName, "isle_lo")) {
 					continue;
 				}
 				break;
 			case 1:
-				if (SDL_strcasecmp(worlds[i].m_models[j].m_modelName, "isle")) {
+				if (SDL_strcasecmp(world->m_models[j].m_modelName, "isle")) {
 					continue;
 				}
 				break;
 			case 2:
-				if (SDL_strcasecmp(worlds[i].m_models[j].m_modelName, "isle_hi")) {
+				if (SDL_strcasecmp(world->m_models[j].m_modelName, "isle_hi")) {
 					continue;
 				}
 			}
 		}
-		else if (g_legoWorldPresenterQuality <= 1 && !SDL_strncasecmp(worlds[i].m_models[j].m_modelName, "haus", 4)) {
-			if (worlds[i].m_models[j].m_modelName[4] == '3') {
-				if (LoadWorldModel(worlds[i].m_models[j], wdbFile, p_world) != SUCCESS) {
+		else if (g_legoWorldPresenterQuality <= 1 && !SDL_strncasecmp(world->m_models[j].m_modelName, "haus", 4)) {
+			if (world->m_models[j].m_modelName[4] == '3') {
+				if (LoadWorldModel(world->m_models[j], p_world) != SUCCESS) {
 					return FAILURE;
 				}
 
-				if (LoadWorldModel(worlds[i].m_models[j - 2], wdbFile, p_world) != SUCCESS) {
+				if (LoadWorldModel(world->m_models[j - 2], p_world) != SUCCESS) {
 					return FAILURE;
 				}
 
-				if (LoadWorldModel(worlds[i].m_models[j - 1], wdbFile, p_world) != SUCCESS) {
+				if (LoadWorldModel(world->m_models[j - 1], p_world) != SUCCESS) {
 					return FAILURE;
 				}
 			}
@@ -304,30 +356,44 @@ MxResult LegoWorldPresenter::LoadWorld(char* p_worldName, LegoWorld* p_world)
 			continue;
 		}
 
-		if (LoadWorldModel(worlds[i].m_models[j], wdbFile, p_world) != SUCCESS) {
+		if (LoadWorldModel(world->m_models[j], p_world) != SUCCESS) {
 			return FAILURE;
 		}
 	}
 
-	FreeModelDbWorlds(worlds, numWorlds);
-	SDL_RWclose(wdbFile);
+	SDL_LogDebug(
+		SDL_LOG_CATEGORY_APPLICATION,
+		"Loaded world %s in %.3fms, %u string heap allocations",
+		p_worldName,
+		(SDL_GetPerformanceCounter() - loadStart) * 1000.0 / SDL_GetPerformanceFrequency(),
+		MxString::GetHeapAllocations() - stringAllocations
+	);
+	SDL_LogDebug(
+		SDL_LOG_CATEGORY_APPLICATION,
+		"Loaded world %s textures: %u surfaces (%u KB) in %.3fms, %u shared (%u KB saved)",
+		p_worldName,
+		textures->GetSurfaceCount() - surfaceCount,
+		(textures->GetSurfaceBytes() - surfaceBytes) / 1024,
+		(textures->GetCreateTicks() - textureTicks) * 1000.0 / SDL_GetPerformanceFrequency(),
+		textures->GetSharedCount() - sharedCount,
+		(textures->GetSharedBytes() - sharedBytes) / 1024
+	);
 	return SUCCESS;
 }
 
 // FUNCTION: LEGO1 0x10067360
-MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, SDL_IOStream* p_wdbFile)
+MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPartEntry& p_part)
 {
 	MxResult result;
-	MxU8* buff = new MxU8[p_part.m_partDataLength];
+	MxU8* data = g_modelDb->GetData(p_part.m_partDataOffset, p_part.m_partDataLength);
 
-	SDL_RWseek(p_wdbFile, p_part.m_partDataOffset, RW_SEEK_SET);
-	if (SDL_RWread(p_wdbFile, buff, 1, p_part.m_partDataLength) != p_part.m_partDataLength) {
+	if (data == NULL) {
 		return FAILURE;
 	}
 
 	MxDSChunk chunk;
 	chunk.SetLength(p_part.m_partDataLength);
-	chunk.SetData(buff);
+	chunk.SetData(data);
 
 	LegoPartPresenter partPresenter;
 	result = partPresenter.Read(chunk);
@@ -336,23 +402,21 @@ MxResult LegoWorldPresenter::LoadWorldPart(ModelDbPart& p_part, SDL_IOStream* p_
 		partPresenter.Store();
 	}
 
-	delete[] buff;
 	return result;
 }
 
 // FUNCTION: LEGO1 0x100674b0
-MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, SDL_IOStream* p_wdbFile, LegoWorld* p_world)
+MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, LegoWorld* p_world)
 {
-	MxU8* buff = new MxU8[p_model.m_modelDataLength];
+	MxU8* data = g_modelDb->GetData(p_model.m_modelDataOffset, p_model.m_modelDataLength);
 
-	SDL_RWseek(p_wdbFile, p_model.m_modelDataOffset, RW_SEEK_SET);
-	if (SDL_RWread(p_wdbFile, buff, 1, p_model.m_modelDataLength) != p_model.m_modelDataLength) {
+	if (data == NULL) {
 		return FAILURE;
 	}
 
 	MxDSChunk chunk;
 	chunk.SetLength(p_model.m_modelDataLength);
-	chunk.SetData(buff);
+	chunk.SetData(data);
 
 	MxDSAction action;
 	MxAtomId atom;
@@ -395,7 +459,6 @@ MxResult LegoWorldPresenter::LoadWorldModel(ModelDbModel& p_model, SDL_IOStream*
 
 	modelPresenter.SetAction(&action);
 	modelPresenter.FUN_1007ff70(chunk, createdEntity, p_model.m_unk0x34, p_world);
-	delete[] buff;
 
 	return SUCCESS;
 }
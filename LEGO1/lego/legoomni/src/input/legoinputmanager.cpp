@@ -99,10 +99,17 @@ void LegoInputManager::Destroy()
 	}
 }
 
+const Uint8* LegoInputManager::g_keyboardStateOverride = NULL;
+
 // FUNCTION: LEGO1 0x1005c0f0
 void LegoInputManager::GetKeyboardState()
 {
-	m_keyboardState = SDL_GetKeyboardState(NULL);
+	m_keyboardState = g_keyboardStateOverride ? g_keyboardStateOverride : SDL_GetKeyboardState(NULL);
+}
+
+void LegoInputManager::SetKeyboardStateOverride(const Uint8* p_keyboardState)
+{
+	g_keyboardStateOverride = p_keyboardState;
 }
 
 // FUNCTION: LEGO1 0x1005c160
@@ -3,6 +3,8 @@
 #include "3dmanager/lego3dmanager.h"
 #include "islepathactor.h"
 #include "legoanimationmanager.h"
+#include "legoanimcache.h"
+#include "legoanimpresenter.h"
 #include "legobuildingmanager.h"
 #include "legocharactermanager.h"
 #include "legogamestate.h"
@@ -15,6 +17,7 @@
 #include "legovideomanager.h"
 #include "legoworld.h"
 #include "legoworldlist.h"
+#include "legoworldpresenter.h"
 #include "misc.h"
 #include "misc/legocontainer.h"
 #include "mxactionnotificationparam.h"
@@ -29,13 +32,14 @@
 #include "mxticklemanager.h"
 #include "mxtransitionmanager.h"
 #include "mxvariabletable.h"
+#include "roi/legoroi.h"
 #include "scripts.h"
 #include "viewmanager/viewmanager.h"
 
 #include <SDL2/SDL_log.h>
 #include <SDL2/SDL_stdinc.h>
 
-DECOMP_SIZE_ASSERT(LegoOmni, 0x140)
+DECOMP_SIZE_ASSERT(LegoOmni, 0x160)
 DECOMP_SIZE_ASSERT(LegoOmni::WorldContainer, 0x1c)
 DECOMP_SIZE_ASSERT(LegoWorldList, 0x18)
 DECOMP_SIZE_ASSERT(LegoWorldListCursor, 0x10)
@@ -44,6 +48,16 @@ DECOMP_SIZE_ASSERT(LegoWorldListCursor, 0x10)
 // STRING: LEGO1 0x100f6710
 const char* g_current = "current";
 
+// Keeps the view manager and world name indices in step with renamed ROIs
+static void ROIRenamed(LegoROI* p_roi, const char* p_oldName)
+{
+	GetViewManager()->RenameROI(p_roi, p_oldName);
+
+	if (p_roi->GetEntity()) {
+		Lego()->UpdateEntityName(p_roi->GetEntity());
+	}
+}
+
 // FUNCTION: LEGO1 0x10058a00
 LegoOmni::LegoOmni()
 {
@@ -76,6 +90,7 @@ void LegoOmni::Init()
 	m_bkgAudioManager = NULL;
 	m_unk0x13c = TRUE;
 	m_transitionManager = NULL;
+	m_animCache = NULL;
 }
 
 // FUNCTION: LEGO1 0x10058c30
@@ -84,6 +99,7 @@ void LegoOmni::Destroy()
 	AUTOLOCK(m_criticalSection);
 
 	m_notificationManager->Unregister(this);
+	LegoROI::SetRenameHandler(NULL);
 
 	if (m_worldList) {
 		delete m_worldList;
@@ -132,6 +148,7 @@ void LegoOmni::Destroy()
 	}
 
 	LegoPathController::Reset();
+	LegoWorldPresenter::UnloadWorldDb();
 
 	if (m_bkgAudioManager) {
 		m_bkgAudioManager->Stop();
@@ -152,6 +169,12 @@ void LegoOmni::Destroy()
 	}
 
 	MxOmni::Destroy();
+
+	// Presenters hand their trees back to the cache when destroyed, so it goes last
+	if (m_animCache) {
+		delete m_animCache;
+		m_animCache = NULL;
+	}
 }
 
 // FUNCTION: LEGO1 0x10058e70
@@ -215,9 +238,11 @@ MxResult LegoOmni::Create(MxOmniCreateParam& p_param)
 	m_buildingManager = new LegoBuildingManager();
 	m_gameState = new LegoGameState();
 	m_worldList = new LegoWorldList(TRUE);
+	m_animCache = new LegoAnimCache(LegoAnimPresenter::GetAnimCacheLimit());
+	LegoROI::SetRenameHandler(&ROIRenamed);
 
 	if (!m_viewLODListManager || !m_textureContainer || !m_worldList || !m_characterManager || !m_plantManager ||
-		!m_animationManager || !m_buildingManager) {
+		!m_animationManager || !m_buildingManager || !m_animCache) {
 		SDL_LogError(
 			SDL_LOG_CATEGORY_APPLICATION,
 			"Failed to create "
@@ -357,6 +382,19 @@ void LegoOmni::DeleteWorld(LegoWorld* p_world)
 	}
 }
 
+// Re-keys the entity in the name index of each world that holds it
+void LegoOmni::UpdateEntityName(LegoEntity* p_entity)
+{
+	if (m_worldList) {
+		LegoWorldListCursor cursor(m_worldList);
+		LegoWorld* world;
+
+		while (cursor.Next(world)) {
+			world->UpdateEntityName(p_entity);
+		}
+	}
+}
+
 // FUNCTION: LEGO1 0x1005af10
 void LegoOmni::RemoveWorld(const MxAtomId& p_atom, MxLong p_objectId)
 {
@@ -433,23 +471,8 @@ void LegoOmni::DeleteObject(MxDSAction& p_dsAction)
 // FUNCTION: BETA10 0x1008ea6d
 LegoROI* LegoOmni::FindROI(const char* p_name)
 {
-	const CompoundObject& rois =
-		((LegoVideoManager*) m_videoManager)->Get3DManager()->GetLego3DView()->GetViewManager()->GetROIs();
-
-	if (p_name != NULL && *p_name != '\0' && rois.size() > 0) {
-		for (CompoundObject::const_iterator it = rois.begin(); it != rois.end(); it++) {
-			LegoROI* roi = (LegoROI*) *it;
-			const char* name = roi->GetName();
-
-			if (name != NULL) {
-				if (!SDL_strcasecmp(name, p_name)) {
-					return roi;
-				}
-			}
-		}
-	}
-
-	return NULL;
+	ViewManager* viewManager = ((LegoVideoManager*) m_videoManager)->Get3DManager()->GetLego3DView()->GetViewManager();
+	return (LegoROI*) viewManager->FindROI(p_name);
 }
 
 // FUNCTION: LEGO1 0x1005b2f0
@@ -7,6 +7,7 @@
 #include "mxtimer.h"
 
 #include <SDL2/SDL_stdinc.h>
+#include <limits.h>
 
 DECOMP_SIZE_ASSERT(LegoPathController, 0x40)
 DECOMP_SIZE_ASSERT(LegoPathCtrlEdge, 0x40)
@@ -557,54 +558,34 @@ MxResult LegoPathController::ReadEdges(LegoStorage* p_storage)
 {
 	for (MxS32 i = 0; i < m_numE; i++) {
 		LegoPathCtrlEdge& edge = m_edges[i];
-		MxU16 s;
+		MxU16 indices[3];
 
 		if (p_storage->Read(&edge.m_flags, sizeof(LegoU16)) != SUCCESS) {
 			return FAILURE;
 		}
 
-		if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
-			return FAILURE;
-		}
-		edge.m_pointA = &m_unk0x10[s];
-
-		if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
+		if (p_storage->ReadArray(indices, 2) != SUCCESS) {
 			return FAILURE;
 		}
-		edge.m_pointB = &m_unk0x10[s];
+		edge.m_pointA = &m_unk0x10[indices[0]];
+		edge.m_pointB = &m_unk0x10[indices[1]];
 
 		if (edge.m_flags & LegoOrientedEdge::c_hasFaceA) {
-			if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
+			if (p_storage->ReadArray(indices, sizeOfArray(indices)) != SUCCESS) {
 				return FAILURE;
 			}
-			edge.m_faceA = &m_boundaries[s];
-
-			if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
-				return FAILURE;
-			}
-			edge.m_ccwA = &m_edges[s];
-
-			if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
-				return FAILURE;
-			}
-			edge.m_cwA = &m_edges[s];
+			edge.m_faceA = &m_boundaries[indices[0]];
+			edge.m_ccwA = &m_edges[indices[1]];
+			edge.m_cwA = &m_edges[indices[2]];
 		}
 
 		if (edge.m_flags & LegoOrientedEdge::c_hasFaceB) {
-			if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
-				return FAILURE;
-			}
-			edge.m_faceB = &m_boundaries[s];
-
-			if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
-				return FAILURE;
-			}
-			edge.m_ccwB = &m_edges[s];
-
-			if (p_storage->Read(&s, sizeof(MxU16)) != SUCCESS) {
+			if (p_storage->ReadArray(indices, sizeOfArray(indices)) != SUCCESS) {
 				return FAILURE;
 			}
-			edge.m_cwB = &m_edges[s];
+			edge.m_faceB = &m_boundaries[indices[0]];
+			edge.m_ccwB = &m_edges[indices[1]];
+			edge.m_cwB = &m_edges[indices[2]];
 		}
 
 		if (ReadVector(p_storage, edge.m_dir) != SUCCESS) {
@@ -627,6 +608,7 @@ MxResult LegoPathController::ReadBoundaries(LegoStorage* p_storage)
 		LegoPathBoundary& boundary = m_boundaries[i];
 		MxU8 numE;
 		MxU16 s;
+		MxU16 edgeIndices[UCHAR_MAX];
 		MxU8 j;
 
 		if (p_storage->Read(&numE, sizeof(numE)) != SUCCESS) {
@@ -638,12 +620,12 @@ MxResult LegoPathController::ReadBoundaries(LegoStorage* p_storage)
 		LegoOrientedEdge** edges = new LegoOrientedEdge*[numE];
 		boundary.SetEdges(edges, numE);
 
-		for (j = 0; j < numE; j++) {
-			if (p_storage->Read(&s, sizeof(s)) != SUCCESS) {
-				return FAILURE;
-			}
+		if (p_storage->ReadArray(edgeIndices, numE) != SUCCESS) {
+			return FAILURE;
+		}
 
-			edges[j] = &m_edges[s];
+		for (j = 0; j < numE; j++) {
+			edges[j] = &m_edges[edgeIndices[j]];
 		}
 
 		if (p_storage->Read(&boundary.m_flags, sizeof(boundary.m_flags)) != SUCCESS) {
@@ -728,7 +710,7 @@ MxResult LegoPathController::ReadBoundaries(LegoStorage* p_storage)
 // FUNCTION: BETA10 0x100b8864
 MxResult LegoPathController::ReadVector(LegoStorage* p_storage, Mx3DPointFloat& p_vec)
 {
-	if (p_storage->Read(p_vec.GetData(), sizeof(float) * 3) != SUCCESS) {
+	if (p_storage->ReadArray(p_vec.GetData(), 3) != SUCCESS) {
 		return FAILURE;
 	}
 
@@ -739,7 +721,7 @@ MxResult LegoPathController::ReadVector(LegoStorage* p_storage, Mx3DPointFloat&
 // FUNCTION: BETA10 0x100b88a1
 MxResult LegoPathController::ReadVector(LegoStorage* p_storage, Mx4DPointFloat& p_vec)
 {
-	if (p_storage->Read(p_vec.GetData(), sizeof(float) * 4) != SUCCESS) {
+	if (p_storage->ReadArray(p_vec.GetData(), 4) != SUCCESS) {
 		return FAILURE;
 	}
 
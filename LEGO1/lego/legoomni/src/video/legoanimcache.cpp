@@ -0,0 +1,181 @@
+#include "legoanimcache.h"
+
+#include "anim/legoanim.h"
+#include "mxautolock.h"
+#include "mxutilities.h"
+
+#include <string.h>
+
+// Restores the node state a freshly read tree starts out with
+static void ResetNodes(LegoTreeNode* p_node)
+{
+	LegoAnimNodeData* data = (LegoAnimNodeData*) p_node->GetData();
+	data->SetUnknown0x20(0);
+	data->SetUnknown0x22(0);
+	data->SetTranslationIndex(0);
+	data->SetRotationIndex(0);
+	data->SetScaleIndex(0);
+	data->SetMorphIndex(0);
+
+	for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
+		ResetNodes(p_node->GetChild(i));
+	}
+}
+
+LegoAnimCache::LegoAnimCache(MxU32 p_limit)
+{
+	m_size = 0;
+	m_limit = p_limit;
+}
+
+// Trees still lent out belong to their presenters
+LegoAnimCache::~LegoAnimCache()
+{
+	Clear();
+
+	for (unordered_map<LegoAnim*, Entry*>::iterator it = m_anims.begin(); it != m_anims.end(); it++) {
+		delete[] it->second->m_source;
+		delete it->second;
+	}
+}
+
+MxU32 LegoAnimCache::Hash(const char* p_source, MxS32 p_objectId)
+{
+	MxU32 hash = HashStringNoCase(p_source);
+	hash ^= (MxU32) p_objectId + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+LegoAnimCache::Entry* LegoAnimCache::Find(const char* p_source, MxS32 p_objectId)
+{
+	unordered_map<MxU32, vector<Entry*> >::iterator bucket = m_entries.find(Hash(p_source, p_objectId));
+
+	if (bucket == m_entries.end()) {
+		return NULL;
+	}
+
+	for (vector<Entry*>::iterator it = bucket->second.begin(); it != bucket->second.end(); it++) {
+		if ((*it)->m_objectId == p_objectId && !SDL_strcasecmp((*it)->m_source, p_source)) {
+			return *it;
+		}
+	}
+
+	return NULL;
+}
+
+LegoAnim* LegoAnimCache::Acquire(const char* p_source, MxS32 p_objectId, MxU32 p_length)
+{
+	AUTOLOCK(m_criticalSection);
+
+	if (p_source == NULL) {
+		return NULL;
+	}
+
+	Entry* entry = Find(p_source, p_objectId);
+
+	if (entry == NULL || entry->m_inUse || entry->m_length != p_length) {
+		return NULL;
+	}
+
+	ResetNodes(entry->m_anim->GetRoot());
+
+	LegoAnimScene* camAnim = entry->m_anim->GetCamAnim();
+	if (camAnim != NULL) {
+		camAnim->SetUnknown0x18(0);
+		camAnim->SetUnknown0x1c(0);
+		camAnim->SetUnknown0x20(0);
+	}
+
+	m_idle.erase(entry->m_idle);
+	entry->m_inUse = TRUE;
+	return entry->m_anim;
+}
+
+// Returns FALSE if the tree was not taken over, in which case the caller still owns it
+MxBool LegoAnimCache::Add(const char* p_source, MxS32 p_objectId, MxU32 p_length, LegoAnim* p_anim)
+{
+	AUTOLOCK(m_criticalSection);
+
+	if (p_source == NULL || p_length > m_limit || Find(p_source, p_objectId) != NULL) {
+		return FALSE;
+	}
+
+	Entry* entry = new Entry;
+	entry->m_source = new char[strlen(p_source) + 1];
+	strcpy(entry->m_source, p_source);
+	entry->m_objectId = p_objectId;
+	entry->m_length = p_length;
+	entry->m_anim = p_anim;
+	entry->m_inUse = TRUE;
+
+	m_entries[Hash(p_source, p_objectId)].push_back(entry);
+	m_anims[p_anim] = entry;
+	m_size += p_length;
+	return TRUE;
+}
+
+// Returns FALSE if the tree is not cached, in which case the caller must delete it
+MxBool LegoAnimCache::Release(LegoAnim* p_anim)
+{
+	AUTOLOCK(m_criticalSection);
+
+	unordered_map<LegoAnim*, Entry*>::iterator it = m_anims.find(p_anim);
+
+	if (it == m_anims.end() || !it->second->m_inUse) {
+		return FALSE;
+	}
+
+	it->second->m_inUse = FALSE;
+	it->second->m_idle = m_idle.insert(m_idle.end(), it->second);
+	Evict();
+	return TRUE;
+}
+
+void LegoAnimCache::SetLimit(MxU32 p_limit)
+{
+	AUTOLOCK(m_criticalSection);
+	m_limit = p_limit;
+	Evict();
+}
+
+// Deletes every idle tree
+void LegoAnimCache::Clear()
+{
+	AUTOLOCK(m_criticalSection);
+
+	while (!m_idle.empty()) {
+		Remove(m_idle.front());
+	}
+}
+
+// Deletes the idle tree of p_entry
+void LegoAnimCache::Remove(Entry* p_entry)
+{
+	MxU32 hash = Hash(p_entry->m_source, p_entry->m_objectId);
+	vector<Entry*>& bucket = m_entries[hash];
+
+	for (vector<Entry*>::iterator it = bucket.begin(); it != bucket.end(); it++) {
+		if (*it == p_entry) {
+			bucket.erase(it);
+			break;
+		}
+	}
+
+	if (bucket.empty()) {
+		m_entries.erase(hash);
+	}
+
+	m_idle.erase(p_entry->m_idle);
+	m_anims.erase(p_entry->m_anim);
+	m_size -= p_entry->m_length;
+	delete p_entry->m_anim;
+	delete[] p_entry->m_source;
+	delete p_entry;
+}
+
+void LegoAnimCache::Evict()
+{
+	while (m_size > m_limit && !m_idle.empty()) {
+		Remove(m_idle.front());
+	}
+}
@@ -4,10 +4,12 @@
 #include "anim/legoanim.h"
 #include "define.h"
 #include "legoanimationmanager.h"
+#include "legoanimcache.h"
 #include "legoanimmmpresenter.h"
 #include "legocameracontroller.h"
 #include "legocharactermanager.h"
 #include "legoendanimnotificationparam.h"
+#include "legomain.h"
 #include "legopathboundary.h"
 #include "legovideomanager.h"
 #include "legoworld.h"
@@ -16,6 +18,7 @@
 #include "mxcompositepresenter.h"
 #include "mxdsanim.h"
 #include "mxdssubscriber.h"
+#include "mxjobpool.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
 #include "mxstreamchunk.h"
@@ -31,6 +34,23 @@
 
 DECOMP_SIZE_ASSERT(LegoAnimPresenter, 0xbc)
 
+static MxU32 g_animCacheLimit = 4 * 1024 * 1024;
+static MxS32 g_animWorkers = 0;
+
+// Presenters whose PutFrame evaluates m_anim, see SetFrameMode
+static vector<LegoAnimPresenter*> g_framePresenters;
+
+static MxU32 CountNodes(LegoTreeNode* p_node)
+{
+	MxU32 count = 1;
+
+	for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
+		count += CountNodes(p_node->GetChild(i));
+	}
+
+	return count;
+}
+
 // FUNCTION: LEGO1 0x10068420
 // FUNCTION: BETA10 0x1004e5f0
 LegoAnimPresenter::LegoAnimPresenter()
@@ -67,6 +87,11 @@ void LegoAnimPresenter::Init()
 	m_unk0x94 = 0;
 	m_unk0x96 = TRUE;
 	m_unk0xa0 = NULL;
+	m_frame = NULL;
+	m_frameSize = 0;
+	m_frameAnim = NULL;
+	m_frameTime = 0;
+	m_frameMode = e_frameNone;
 }
 
 // FUNCTION: LEGO1 0x10068770
@@ -76,7 +101,9 @@ void LegoAnimPresenter::Destroy(MxBool p_fromDestructor)
 	{
 		AUTOLOCK(m_criticalSection);
 
-		if (m_anim != NULL) {
+		LegoAnimCache* animCache = Lego() ? Lego()->GetAnimCache() : NULL;
+
+		if (m_anim != NULL && (animCache == NULL || !animCache->Release(m_anim))) {
 			delete m_anim;
 		}
 
@@ -128,6 +155,17 @@ void LegoAnimPresenter::Destroy(MxBool p_fromDestructor)
 			delete m_unk0xa0;
 		}
 
+		if (m_frameMode != e_frameNone) {
+			for (vector<LegoAnimPresenter*>::iterator it = g_framePresenters.begin(); it != g_framePresenters.end();
+				 it++) {
+				if (*it == this) {
+					g_framePresenters.erase(it);
+					break;
+				}
+			}
+		}
+
+		delete[] m_frame;
 		Init();
 	}
 
@@ -144,6 +182,7 @@ MxResult LegoAnimPresenter::CreateAnim(MxStreamChunk* p_chunk)
 	MxS32 magicSig;
 	LegoS32 parseScene = 0;
 	MxS32 val3;
+	LegoAnimCache* animCache;
 
 	if (storage.Read(&magicSig, sizeof(MxS32)) != SUCCESS || magicSig != 0x11) {
 		goto done;
@@ -167,6 +206,18 @@ MxResult LegoAnimPresenter::CreateAnim(MxStreamChunk* p_chunk)
 		goto done;
 	}
 
+	// The car build presenter edits the keys of its tree, so it always parses its own copy
+	animCache = IsA("LegoCarBuildAnimPresenter") ? NULL : Lego()->GetAnimCache();
+
+	if (animCache != NULL) {
+		m_anim = animCache->Acquire(m_action->GetAtomId().GetInternal(), m_action->GetObjectId(), p_chunk->GetLength());
+
+		if (m_anim != NULL) {
+			result = SUCCESS;
+			goto done;
+		}
+	}
+
 	m_anim = new LegoAnim();
 	if (!m_anim) {
 		goto done;
@@ -176,6 +227,10 @@ MxResult LegoAnimPresenter::CreateAnim(MxStreamChunk* p_chunk)
 		goto done;
 	}
 
+	if (animCache != NULL) {
+		animCache->Add(m_action->GetAtomId().GetInternal(), m_action->GetObjectId(), p_chunk->GetLength(), m_anim);
+	}
+
 	result = SUCCESS;
 
 done:
@@ -187,6 +242,100 @@ MxResult LegoAnimPresenter::CreateAnim(MxStreamChunk* p_chunk)
 	return result;
 }
 
+void LegoAnimPresenter::SetAnimCacheLimit(MxU32 p_limit)
+{
+	g_animCacheLimit = p_limit;
+
+	if (Lego() && Lego()->GetAnimCache()) {
+		Lego()->GetAnimCache()->SetLimit(p_limit);
+	}
+}
+
+MxU32 LegoAnimPresenter::GetAnimCacheLimit()
+{
+	return g_animCacheLimit;
+}
+
+void LegoAnimPresenter::SetAnimWorkers(MxS32 p_workers)
+{
+	g_animWorkers = p_workers;
+}
+
+MxS32 LegoAnimPresenter::GetAnimWorkers()
+{
+	return g_animWorkers;
+}
+
+// Evaluates the node transforms of every presenter that is about to put a frame, spread over
+// p_pool. FUN_1006b9a0 then only applies them to the ROIs, in the usual presenter order.
+// Frames whose time turns out different by then are simply evaluated again there.
+void LegoAnimPresenter::PrepareFrames(MxJobPool& p_pool)
+{
+	for (vector<LegoAnimPresenter*>::iterator it = g_framePresenters.begin(); it != g_framePresenters.end(); it++) {
+		LegoAnimPresenter* presenter = *it;
+		presenter->m_frameAnim = NULL;
+
+		if (presenter->GetFrameTime(presenter->m_frameTime)) {
+			presenter->m_frameAnim = presenter->m_anim;
+			p_pool.AddJob(EvaluateFrame, presenter);
+		}
+	}
+
+	p_pool.RunJobs();
+}
+
+void LegoAnimPresenter::EvaluateFrame(void* p_presenter)
+{
+	LegoAnimPresenter* presenter = (LegoAnimPresenter*) p_presenter;
+	LegoAnim::EvaluateFrame(presenter->m_frameAnim->GetRoot(), presenter->m_frameTime, presenter->m_frame);
+}
+
+void LegoAnimPresenter::SetFrameMode(FrameMode p_mode)
+{
+	if (g_animWorkers <= 0) {
+		return;
+	}
+
+	if (m_frameMode == e_frameNone) {
+		// m_anim stays the same until Destroy, so its nodes are counted once
+		m_frameSize = CountNodes(m_anim->GetRoot());
+		m_frame = new LegoAnimFrameNode[m_frameSize];
+		g_framePresenters.push_back(this);
+	}
+
+	m_frameMode = p_mode;
+}
+
+// Predicts the time the next PutFrame will pass to FUN_1006b9a0
+MxBool LegoAnimPresenter::GetFrameTime(MxLong& p_time)
+{
+	if (m_anim == NULL || m_action == NULL || !IsEnabled() || m_currentTickleState < e_streaming ||
+		m_currentTickleState > e_freezing) {
+		return FALSE;
+	}
+
+	if (m_action->GetStartTime() <= m_action->GetElapsedTime()) {
+		p_time = m_action->GetElapsedTime() - m_action->GetStartTime();
+	}
+	else {
+		p_time = 0;
+	}
+
+	switch (m_frameMode) {
+	case e_frameOnce:
+		return m_currentTickleState == e_streaming;
+	case e_frameLooping:
+		if (m_anim->GetDuration() == 0) {
+			return FALSE;
+		}
+
+		p_time %= m_anim->GetDuration();
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
+
 // FUNCTION: LEGO1 0x10069150
 LegoChar* LegoAnimPresenter::FUN_10069150(const LegoChar* p_und1)
 {
@@ -635,6 +784,7 @@ void LegoAnimPresenter::PutFrame()
 			time = 0;
 		}
 
+		SetFrameMode(e_frameOnce);
 		FUN_1006b9a0(m_anim, time, m_unk0x78);
 
 		if (m_unk0x8c != NULL && m_currentWorld != NULL && m_currentWorld->GetCameraController() != NULL) {
@@ -940,7 +1090,14 @@ void LegoAnimPresenter::FUN_1006b9a0(LegoAnim* p_anim, MxLong p_time, Matrix4* p
 		}
 	}
 
-	LegoROI::FUN_100a8e80(root, mat, p_time, m_roiMap);
+	if (m_frameAnim == p_anim && m_frameTime == p_time) {
+		LegoROI::ApplyFrame(root, mat, m_roiMap, m_frame);
+	}
+	else {
+		LegoROI::FUN_100a8e80(root, mat, p_time, m_roiMap);
+	}
+
+	m_frameAnim = NULL;
 }
 
 // FUNCTION: LEGO1 0x1006bac0
@@ -55,7 +55,8 @@ void LegoFlcTexturePresenter::LoadFrame(MxStreamChunk* p_chunk)
 		m_frameBitmap->GetImage(),
 		m_flcHeader,
 		(FLIC_FRAME*) data,
-		&decodedColorMap
+		&decodedColorMap,
+		NULL
 	);
 }
 
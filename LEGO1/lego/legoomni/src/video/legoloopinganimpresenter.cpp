@@ -48,6 +48,7 @@ void LegoLoopingAnimPresenter::PutFrame()
 		time = 0;
 	}
 
+	SetFrameMode(e_frameLooping);
 	FUN_1006b9a0(m_anim, time, m_unk0x78);
 
 	if (m_unk0x8c != NULL && m_currentWorld != NULL && m_currentWorld->GetCameraController() != NULL) {
@@ -134,13 +134,11 @@ MxResult LegoModelPresenter::CreateROI(MxDSChunk* p_chunk)
 
 		if (!skipTextures) {
 			if (TextureContainer()->Get(textureName) == NULL) {
-				textureInfo = LegoTextureInfo::Create(textureName, texture);
+				textureInfo = TextureContainer()->Create(textureName, texture, TRUE);
 
 				if (textureInfo == NULL) {
 					goto done;
 				}
-
-				TextureContainer()->Add(textureName, textureInfo);
 			}
 
 			delete[] textureName;
@@ -260,6 +258,9 @@ void LegoModelPresenter::ReadyTickle()
 
 		if (chunk != NULL && chunk->GetTime() <= m_action->GetElapsedTime()) {
 			chunk = m_subscriber->PopData();
+
+			// CreateROI reads it as an MxDSChunk, so a split chunk is joined first
+			chunk->GetData();
 			MxResult result = CreateROI(chunk);
 			m_subscriber->FreeDataChunk(chunk);
 
@@ -13,7 +13,7 @@
 #include <SDL2/SDL_stdinc.h>
 
 DECOMP_SIZE_ASSERT(LegoLODList, 0x18)
-DECOMP_SIZE_ASSERT(LegoNamedPart, 0x14)
+DECOMP_SIZE_ASSERT(LegoNamedPart, 0x34)
 DECOMP_SIZE_ASSERT(LegoNamedPartList, 0x18)
 
 // GLOBAL: LEGO1 0x100f7aa0
@@ -126,13 +126,11 @@ MxResult LegoPartPresenter::Read(MxDSChunk& p_chunk)
 		}
 
 		if (TextureContainer()->Get(textureName) == NULL) {
-			textureInfo = LegoTextureInfo::Create(textureName, texture);
+			textureInfo = TextureContainer()->Create(textureName, texture, TRUE);
 
 			if (textureInfo == NULL) {
 				goto done;
 			}
-
-			TextureContainer()->Add(textureName, textureInfo);
 		}
 
 		delete[] textureName;
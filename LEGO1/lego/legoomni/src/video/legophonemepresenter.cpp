@@ -7,7 +7,7 @@
 #include "mxcompositepresenter.h"
 #include "mxdsaction.h"
 
-DECOMP_SIZE_ASSERT(LegoPhonemePresenter, 0x88)
+DECOMP_SIZE_ASSERT(LegoPhonemePresenter, 0xa8)
 
 // FUNCTION: LEGO1 0x1004e180
 LegoPhonemePresenter::LegoPhonemePresenter()
@@ -105,7 +105,8 @@ void LegoPhonemePresenter::LoadFrame(MxStreamChunk* p_chunk)
 		m_frameBitmap->GetImage(),
 		m_flcHeader,
 		(FLIC_FRAME*) data,
-		&decodedColorMap
+		&decodedColorMap,
+		NULL
 	);
 }
 
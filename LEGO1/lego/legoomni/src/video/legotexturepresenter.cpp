@@ -12,7 +12,7 @@
 #include <SDL2/SDL_stdinc.h>
 
 DECOMP_SIZE_ASSERT(LegoTexturePresenter, 0x54)
-DECOMP_SIZE_ASSERT(LegoNamedTexture, 0x14)
+DECOMP_SIZE_ASSERT(LegoNamedTexture, 0x34)
 DECOMP_SIZE_ASSERT(LegoNamedTextureList, 0x18)
 DECOMP_SIZE_ASSERT(LegoNamedTextureListCursor, 0x10)
 
@@ -99,11 +99,7 @@ MxResult LegoTexturePresenter::Store()
 		LegoTextureInfo* textureInfo = TextureContainer()->Get(namedTexture->GetName()->GetData());
 
 		if (textureInfo == NULL) {
-			textureInfo = LegoTextureInfo::Create(namedTexture->GetName()->GetData(), texture);
-
-			if (textureInfo != NULL) {
-				TextureContainer()->Add(namedTexture->GetName()->GetData(), textureInfo);
-			}
+			TextureContainer()->Create(namedTexture->GetName()->GetData(), texture, FALSE);
 		}
 		else {
 			textureInfo->FUN_10066010(texture->GetImage()->GetBits());
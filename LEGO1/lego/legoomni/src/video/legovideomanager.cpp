@@ -1,6 +1,7 @@
 #include "legovideomanager.h"
 
 #include "3dmanager/lego3dmanager.h"
+#include "legoanimpresenter.h"
 #include "legoinputmanager.h"
 #include "legomain.h"
 #include "misc.h"
@@ -8,17 +9,20 @@
 #include "mxdirectx/mxdirect3d.h"
 #include "mxdirectx/mxstopwatch.h"
 #include "mxdisplaysurface.h"
+#include "mxframetimings.h"
 #include "mxgeometry/mxmatrix.h"
 #include "mxmisc.h"
 #include "mxpalette.h"
 #include "mxregion.h"
 #include "mxtimer.h"
 #include "mxtransitionmanager.h"
+#include "profiler.h"
 #include "realtime/realtime.h"
 #include "roi/legoroi.h"
 #include "tgl/d3drm/impl.h"
 #include "viewmanager/viewroi.h"
 
+#include <SDL2/SDL_cpuinfo.h>
 #include <SDL2/SDL_log.h>
 #include <SDL2/SDL_stdinc.h>
 #include <stdio.h>
@@ -221,6 +225,15 @@ MxResult LegoVideoManager::Create(MxVideoParam& p_videoParam, MxU32 p_frequencyM
 	m_stopWatch = new MxStopWatch;
 	m_stopWatch->Start();
 
+	{
+		// Animation workers only pay off with a spare core each
+		MxS32 animWorkers = SDL_min(LegoAnimPresenter::GetAnimWorkers(), SDL_GetCPUCount() - 1);
+
+		if (animWorkers > 0) {
+			m_animJobs.Create(animWorkers);
+		}
+	}
+
 	result = SUCCESS;
 
 done:
@@ -236,6 +249,8 @@ MxResult LegoVideoManager::Create(MxVideoParam& p_videoParam, MxU32 p_frequencyM
 // FUNCTION: BETA10 0x100d6816
 void LegoVideoManager::Destroy()
 {
+	m_animJobs.Destroy();
+
 	if (m_cursorSurface != NULL) {
 		m_cursorSurface->Release();
 		m_cursorSurface = NULL;
@@ -299,6 +314,8 @@ void LegoVideoManager::ToggleFPS(MxBool p_visible)
 // FUNCTION: LEGO1 0x1007b770
 MxResult LegoVideoManager::Tickle()
 {
+	PROFILE_ZONE("LegoVideoManager::Tickle");
+
 	if (m_unk0x554 && !m_videoParam.Flags().GetFlipSurfaces() &&
 		TransitionManager()->GetTransitionType() == MxTransitionManager::e_idle) {
 		Sleep(30);
@@ -309,6 +326,12 @@ MxResult LegoVideoManager::Tickle()
 	m_stopWatch->Reset();
 	m_stopWatch->Start();
 
+	// Under a fixed timer step the frame time must not depend on the host, or the
+	// extras budget in LegoAnimationManager would differ between runs
+	if (MxTimer::GetFixedStep()) {
+		m_elapsedSeconds = MxTimer::GetFixedStep() / 1000.0;
+	}
+
 	m_direct3d->RestoreSurfaces();
 
 	SortPresenterList();
@@ -328,6 +351,10 @@ MxResult LegoVideoManager::Tickle()
 	InvalidateRect(rect);
 
 	if (!m_paused && (m_render3d || m_unk0xe5)) {
+		if (m_animJobs.GetWorkerCount() > 0) {
+			LegoAnimPresenter::PrepareFrames(m_animJobs);
+		}
+
 		cursor.Reset();
 
 		while (cursor.Next(presenter) && presenter->GetDisplayZ() >= 0) {
@@ -335,6 +362,7 @@ MxResult LegoVideoManager::Tickle()
 		}
 
 		if (!m_unk0xe5) {
+			MxFrameTimingScope timing(MxFrameTimings::e_render3d);
 			m_3dManager->Render(0.0);
 			m_3dManager->GetLego3DView()->GetDevice()->Update();
 		}
@@ -363,6 +391,8 @@ MxResult LegoVideoManager::Tickle()
 	}
 
 	if (!m_paused) {
+		MxFrameTimingScope timing(MxFrameTimings::e_present);
+
 		if (m_render3d && m_videoParam.Flags().GetFlipSurfaces()) {
 			m_3dManager->GetLego3DView()
 				->GetView()
@@ -1444,6 +1444,7 @@ void Infocenter::StartCredits()
 		MxCoreSet::iterator it = m_set0xa8.begin();
 		MxCore* object = *it;
 		m_set0xa8.erase(it);
+		RemoveFromIndices(object);
 
 		if (object->IsA("MxPresenter")) {
 			presenter = (MxPresenter*) object;
@@ -1463,6 +1464,7 @@ void Infocenter::StartCredits()
 
 	while (cursor.First(presenter)) {
 		cursor.Detach();
+		RemoveFromIndices(presenter);
 
 		MxDSAction* action = presenter->GetAction();
 		if (action) {
@@ -38,8 +38,8 @@
 #include "towtrack.h"
 #include "viewmanager/viewmanager.h"
 
-DECOMP_SIZE_ASSERT(Act1State, 0x26c)
-DECOMP_SIZE_ASSERT(LegoNamedPlane, 0x4c)
+DECOMP_SIZE_ASSERT(Act1State, 0x34c)
+DECOMP_SIZE_ASSERT(LegoNamedPlane, 0x6c)
 DECOMP_SIZE_ASSERT(Isle, 0x140)
 
 // GLOBAL: LEGO1 0x100f1198
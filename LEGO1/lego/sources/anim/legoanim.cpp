@@ -335,17 +335,14 @@ LegoResult LegoTranslationKey::Read(LegoStorage* p_storage)
 		return result;
 	}
 
-	if ((result = p_storage->Read(&m_x, sizeof(LegoFloat))) != SUCCESS) {
+	LegoFloat values[3];
+	if ((result = p_storage->ReadArray(values, sizeOfArray(values))) != SUCCESS) {
 		return result;
 	}
 
-	if ((result = p_storage->Read(&m_y, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-
-	if ((result = p_storage->Read(&m_z, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
+	m_x = values[0];
+	m_y = values[1];
+	m_z = values[2];
 
 	if (m_x > 1e-05F || m_x < -1e-05F || m_y > 1e-05F || m_y < -1e-05F || m_z > 1e-05F || m_z < -1e-05F) {
 		m_flags |= c_bit1;
@@ -398,21 +395,15 @@ LegoResult LegoRotationKey::Read(LegoStorage* p_storage)
 		return result;
 	}
 
-	if ((result = p_storage->Read(&m_angle, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-
-	if ((result = p_storage->Read(&m_x, sizeof(LegoFloat))) != SUCCESS) {
+	LegoFloat values[4];
+	if ((result = p_storage->ReadArray(values, sizeOfArray(values))) != SUCCESS) {
 		return result;
 	}
 
-	if ((result = p_storage->Read(&m_y, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-
-	if ((result = p_storage->Read(&m_z, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
+	m_angle = values[0];
+	m_x = values[1];
+	m_y = values[2];
+	m_z = values[3];
 
 	if (m_angle != 1.0F) {
 		m_flags |= c_bit1;
@@ -467,17 +458,14 @@ LegoResult LegoScaleKey::Read(LegoStorage* p_storage)
 		return result;
 	}
 
-	if ((result = p_storage->Read(&m_x, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-
-	if ((result = p_storage->Read(&m_y, sizeof(LegoFloat))) != SUCCESS) {
+	LegoFloat values[3];
+	if ((result = p_storage->ReadArray(values, sizeOfArray(values))) != SUCCESS) {
 		return result;
 	}
 
-	if ((result = p_storage->Read(&m_z, sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
+	m_x = values[0];
+	m_y = values[1];
+	m_z = values[2];
 
 	if (m_x > 1.00001 || m_x < 0.99999 || m_y > 1.00001 || m_y < 0.99999 || m_z > 1.00001 || m_z < 0.99999) {
 		m_flags |= c_bit1;
@@ -1167,6 +1155,25 @@ undefined4 LegoAnim::GetActorUnknown0x04(LegoU32 p_index)
 	return 0;
 }
 
+// Evaluates the subtree at p_node into p_frame in depth-first order, the way
+// LegoROI::FUN_100a8e80 does but without touching any ROI. Returns the number of nodes written.
+LegoU32 LegoAnim::EvaluateFrame(LegoTreeNode* p_node, LegoTime p_time, LegoAnimFrameNode* p_frame)
+{
+	Matrix4 mat(p_frame->m_local);
+
+	LegoAnimNodeData* data = (LegoAnimNodeData*) p_node->GetData();
+	mat.SetIdentity();
+	data->CreateLocalTransform(p_time, mat);
+	p_frame->m_visible = data->FUN_100a0990(p_time);
+
+	LegoU32 count = 1;
+	for (LegoU32 i = 0; i < p_node->GetNumChildren(); i++) {
+		count += EvaluateFrame(p_node->GetChild(i), p_time, p_frame + count);
+	}
+
+	return count;
+}
+
 // FUNCTION: LEGO1 0x100a0f60
 // FUNCTION: BETA10 0x1018027c
 LegoMorphKey::LegoMorphKey()
@@ -323,6 +323,12 @@ class LegoAnimScene {
 	LegoU32 m_unk0x20;             // 0x20
 };
 
+// Local transform and visibility of one animation node at a given time
+struct LegoAnimFrameNode {
+	float m_local[4][4];
+	LegoBool m_visible;
+};
+
 // VTABLE: LEGO1 0x100db8d8
 // SIZE 0x18
 class LegoAnim : public LegoTree {
@@ -343,6 +349,8 @@ class LegoAnim : public LegoTree {
 	// FUNCTION: BETA10 0x1005abf0
 	LegoAnimScene* GetCamAnim() { return m_camAnim; }
 
+	static LegoU32 EvaluateFrame(LegoTreeNode* p_node, LegoTime p_time, LegoAnimFrameNode* p_frame);
+
 	// SYNTHETIC: LEGO1 0x100a0ba0
 	// LegoAnim::`scalar deleting destructor'
 
@@ -2,18 +2,185 @@
 
 #include "lego/legoomni/include/legovideomanager.h"
 #include "lego/legoomni/include/misc.h"
+#include "legoimage.h"
 #include "mxdirectx/mxdirect3d.h"
 #include "tgl/d3drm/impl.h"
 
-DECOMP_SIZE_ASSERT(LegoContainerInfo<LegoTexture>, 0x10);
-// DECOMP_SIZE_ASSERT(LegoContainer<LegoTexture>, 0x18);
-DECOMP_SIZE_ASSERT(LegoTextureContainer, 0x24);
+#include <SDL2/SDL_timer.h>
+
+static LegoBool g_shareIdenticalTextures = FALSE;
+
+LegoTextureContainer::LegoTextureContainer()
+{
+	m_surfaceCount = 0;
+	m_surfaceBytes = 0;
+	m_sharedCount = 0;
+	m_sharedBytes = 0;
+	m_createTicks = 0;
+}
 
 // FUNCTION: LEGO1 0x10099870
 LegoTextureContainer::~LegoTextureContainer()
 {
 }
 
+// Byte-identical part and model textures then share one surface, palette and renderer texture.
+// Off by default: texture presenters rewrite textures by name, and such a write would reach every
+// texture sharing the surface.
+void LegoTextureContainer::SetShareIdentical(LegoBool p_shareIdentical)
+{
+	g_shareIdenticalTextures = p_shareIdentical;
+}
+
+static LegoU32 HashPayload(LegoU32 p_hash, const LegoU8* p_data, LegoU32 p_size)
+{
+	for (LegoU32 i = 0; i < p_size; i++) {
+		p_hash ^= p_data[i];
+		p_hash *= 16777619u;
+	}
+
+	return p_hash;
+}
+
+// Creates the texture p_name and adds it to the container, which must not hold that name yet.
+// With p_share, a texture whose size, palette and pixels match an earlier shareable one reuses
+// that one's surface.
+LegoTextureInfo* LegoTextureContainer::Create(const char* p_name, LegoTexture* p_texture, LegoBool p_share)
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+	LegoImage* image = p_texture->GetImage();
+	LegoU32 size = image->GetWidth() * image->GetHeight();
+	LegoTextureInfo* textureInfo = NULL;
+	LegoU32 hash = 0;
+
+	p_share = p_share && g_shareIdenticalTextures;
+
+	if (p_share) {
+		LegoU32 header[3] = {image->GetWidth(), image->GetHeight(), image->GetCount()};
+		hash = HashPayload(2166136261u, (const LegoU8*) header, sizeof(header));
+
+		for (LegoU32 i = 0; i < image->GetCount(); i++) {
+			SDL_Color& color = image->GetPalette()->colors[i];
+			LegoU8 rgb[3] = {color.r, color.g, color.b};
+			hash = HashPayload(hash, rgb, sizeof(rgb));
+		}
+
+		hash = HashPayload(hash, image->GetBits(), size);
+
+		LegoTextureInfo* source = FindIdentical(p_texture, hash);
+
+		if (source != NULL) {
+			textureInfo = new LegoTextureInfo();
+			textureInfo->m_name = new char[strlen(p_name) + 1];
+			strcpy(textureInfo->m_name, p_name);
+
+			textureInfo->m_surface = source->m_surface;
+			textureInfo->m_surface->AddRef();
+			textureInfo->m_palette = source->m_palette;
+			textureInfo->m_palette->AddRef();
+			textureInfo->m_texture = source->m_texture;
+			textureInfo->m_texture->AddRef();
+
+			LegoTextureInfoBucket& sharers = m_sharers[source->m_texture];
+
+			if (sharers.empty()) {
+				sharers.push_back(source);
+			}
+
+			sharers.push_back(textureInfo);
+			m_sharedCount++;
+			m_sharedBytes += size;
+		}
+	}
+
+	if (textureInfo == NULL) {
+		textureInfo = LegoTextureInfo::Create(p_name, p_texture);
+
+		if (textureInfo == NULL) {
+			return NULL;
+		}
+
+		m_surfaceCount++;
+		m_surfaceBytes += size;
+	}
+
+	Add(p_name, textureInfo);
+
+	if (p_share) {
+		// The container owns its keys until it is destroyed, so they can stand for the texture
+		m_payloads[hash].push_back((*m_map.find(p_name)).first);
+	}
+
+	m_createTicks += SDL_GetPerformanceCounter() - start;
+	return textureInfo;
+}
+
+// Returns the shareable texture that holds exactly the payload of p_texture, if any
+LegoTextureInfo* LegoTextureContainer::FindIdentical(LegoTexture* p_texture, LegoU32 p_hash)
+{
+	unordered_map<LegoU32, vector<const char*> >::iterator payload = m_payloads.find(p_hash);
+
+	if (payload == m_payloads.end()) {
+		return NULL;
+	}
+
+	LegoImage* image = p_texture->GetImage();
+	vector<const char*>& names = payload->second;
+
+	for (vector<const char*>::iterator it = names.begin(); it != names.end(); it++) {
+		LegoTextureInfo* candidate = Get(*it);
+
+		if (candidate == NULL || candidate->m_surface == NULL || candidate->m_palette == NULL) {
+			continue;
+		}
+
+		PALETTEENTRY entries[256];
+		LegoU32 i;
+
+		if (candidate->m_palette->GetEntries(0, 0, image->GetCount(), entries) != DD_OK) {
+			continue;
+		}
+
+		for (i = 0; i < image->GetCount(); i++) {
+			SDL_Color& color = image->GetPalette()->colors[i];
+
+			if (entries[i].peRed != color.r || entries[i].peGreen != color.g || entries[i].peBlue != color.b) {
+				break;
+			}
+		}
+
+		if (i < image->GetCount()) {
+			continue;
+		}
+
+		DDSURFACEDESC desc;
+		memset(&desc, 0, sizeof(desc));
+		desc.dwSize = sizeof(desc);
+
+		if (candidate->m_surface->Lock(NULL, &desc, DDLOCK_SURFACEMEMORYPTR, NULL) != DD_OK) {
+			continue;
+		}
+
+		LegoBool identical = desc.dwWidth == image->GetWidth() && desc.dwHeight == image->GetHeight();
+		const LegoU8* surface = (const LegoU8*) desc.lpSurface;
+		const LegoU8* bits = image->GetBits();
+
+		for (i = 0; identical && i < desc.dwHeight; i++) {
+			identical = !memcmp(surface, bits, desc.dwWidth);
+			surface += desc.lPitch;
+			bits += desc.dwWidth;
+		}
+
+		candidate->m_surface->Unlock(desc.lpSurface);
+
+		if (identical) {
+			return candidate;
+		}
+	}
+
+	return NULL;
+}
+
 // FUNCTION: LEGO1 0x100998e0
 LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 {
@@ -28,25 +195,35 @@ LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 		p_textureInfo->m_surface->Unlock(desc.lpSurface);
 	}
 
-	for (LegoCachedTextureList::iterator it = m_cached.begin(); it != m_cached.end(); it++) {
-		if ((*it).second == FALSE && (*it).first->m_texture->AddRef() != 0 && (*it).first->m_texture->Release() == 1) {
-			if (!strcmp((*it).first->m_name, p_textureInfo->m_name)) {
-				LPDIRECTDRAWSURFACE surface = (*it).first->m_surface;
-				memset(&newDesc, 0, sizeof(newDesc));
-				newDesc.dwSize = sizeof(newDesc);
-
-				if (surface->Lock(NULL, &newDesc, DDLOCK_SURFACEMEMORYPTR, NULL) == DD_OK) {
-					BOOL und = FALSE;
-					if (newDesc.dwWidth == width && newDesc.dwHeight == height) {
-						und = TRUE;
-					}
+	LegoU32 nameHash = LegoContainerInfoHash()(p_textureInfo->m_name);
+	unordered_map<LegoU32, LegoTextureInfoBucket>::iterator bucket = m_idleCached.find(nameHash);
+
+	if (bucket != m_idleCached.end()) {
+		LegoTextureInfoBucket& idle = bucket->second;
+
+		for (LegoTextureInfoBucket::iterator it = idle.begin(); it != idle.end(); it++) {
+			LegoTextureInfo* cached = *it;
 
-					surface->Unlock(newDesc.lpSurface);
+			if (cached->m_texture->AddRef() != 0 && cached->m_texture->Release() == 1) {
+				if (!strcmp(cached->m_name, p_textureInfo->m_name)) {
+					LPDIRECTDRAWSURFACE surface = cached->m_surface;
+					memset(&newDesc, 0, sizeof(newDesc));
+					newDesc.dwSize = sizeof(newDesc);
 
-					if (und) {
-						(*it).second = TRUE;
-						(*it).first->m_texture->AddRef();
-						return (*it).first;
+					if (surface->Lock(NULL, &newDesc, DDLOCK_SURFACEMEMORYPTR, NULL) == DD_OK) {
+						BOOL und = FALSE;
+						if (newDesc.dwWidth == width && newDesc.dwHeight == height) {
+							und = TRUE;
+						}
+
+						surface->Unlock(newDesc.lpSurface);
+
+						if (und) {
+							(*m_cachedIndex[cached]).second = TRUE;
+							idle.erase(it);
+							cached->m_texture->AddRef();
+							return cached;
+						}
 					}
 				}
 			}
@@ -94,6 +271,7 @@ LegoTextureInfo* LegoTextureContainer::GetCached(LegoTextureInfo* p_textureInfo)
 			else {
 				textureInfo->m_texture->SetAppData((LPD3DRM_APPDATA) textureInfo);
 				m_cached.push_back(LegoCachedTexture(textureInfo, TRUE));
+				m_cachedIndex[textureInfo] = --m_cached.end();
 
 				textureInfo->m_texture->AddRef();
 
@@ -118,21 +296,86 @@ void LegoTextureContainer::EraseCached(LegoTextureInfo* p_textureInfo)
 		return;
 	}
 
-#ifdef COMPAT_MODE
-	LegoCachedTextureList::iterator it;
-	for (it = m_cached.begin(); it != m_cached.end(); it++) {
-#else
-	for (LegoCachedTextureList::iterator it = m_cached.begin(); it != m_cached.end(); it++) {
-#endif
-		if ((*it).first == p_textureInfo) {
-			(*it).second = FALSE;
-
-			if (p_textureInfo->m_texture->Release() == TRUE) {
-				delete p_textureInfo;
-				m_cached.erase(it);
+	unordered_map<LegoTextureInfo*, LegoCachedTextureList::iterator>::iterator index =
+		m_cachedIndex.find(p_textureInfo);
+
+	if (index != m_cachedIndex.end()) {
+		LegoCachedTextureList::iterator it = index->second;
+		BOOL inUse = (*it).second;
+		(*it).second = FALSE;
+
+		if (p_textureInfo->m_texture->Release() == TRUE) {
+			if (!inUse) {
+				RemoveIdle(p_textureInfo);
+			}
+
+			m_cachedIndex.erase(index);
+			m_cached.erase(it);
+			delete p_textureInfo;
+		}
+		else if (inUse) {
+			m_idleCached[LegoContainerInfoHash()(p_textureInfo->m_name)].push_back(p_textureInfo);
+		}
+	}
+}
+
+// Deletes every texture in the container, which keeps their names
+void LegoTextureContainer::Clear()
+{
+	for (LegoContainerInfo<LegoTextureInfo>::iterator it = m_map.begin(); it != m_map.end(); it++) {
+		Delete((*it).second);
+		(*it).second = NULL;
+	}
+
+	m_payloads.clear();
+	m_sharers.clear();
+}
+
+// Deletes p_textureInfo. The renderer texture it shares, if any, still lives in the others, and
+// GetGroupTexture finds the texture through the app data, so that moves on to one of them.
+void LegoTextureContainer::Delete(LegoTextureInfo* p_textureInfo)
+{
+	unordered_map<LPDIRECT3DRMTEXTURE2, LegoTextureInfoBucket>::iterator sharers =
+		p_textureInfo != NULL ? m_sharers.find(p_textureInfo->m_texture) : m_sharers.end();
+
+	if (sharers != m_sharers.end()) {
+		LegoTextureInfoBucket& infos = sharers->second;
+
+		for (LegoTextureInfoBucket::iterator it = infos.begin(); it != infos.end(); it++) {
+			if (*it == p_textureInfo) {
+				infos.erase(it);
+				break;
+			}
+		}
+
+		if (infos.empty()) {
+			m_sharers.erase(sharers);
+		}
+		else if ((LegoTextureInfo*) p_textureInfo->m_texture->GetAppData() == p_textureInfo) {
+			p_textureInfo->m_texture->SetAppData((LPD3DRM_APPDATA) infos.front());
+		}
+	}
+
+	delete p_textureInfo;
+}
+
+void LegoTextureContainer::RemoveIdle(LegoTextureInfo* p_textureInfo)
+{
+	unordered_map<LegoU32, LegoTextureInfoBucket>::iterator bucket =
+		m_idleCached.find(LegoContainerInfoHash()(p_textureInfo->m_name));
+
+	if (bucket != m_idleCached.end()) {
+		LegoTextureInfoBucket& idle = bucket->second;
+
+		for (LegoTextureInfoBucket::iterator it = idle.begin(); it != idle.end(); it++) {
+			if (*it == p_textureInfo) {
+				idle.erase(it);
+				break;
 			}
+		}
 
-			return;
+		if (idle.empty()) {
+			m_idleCached.erase(bucket);
 		}
 	}
 }
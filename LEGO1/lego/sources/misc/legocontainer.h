@@ -3,27 +3,44 @@
 
 #include "compat.h"
 #include "decomp.h"
+#include "lego1_export.h"
 #include "legotexture.h"
 #include "legotypes.h"
 #include "mxstl/stlcompat.h"
 
+#include <SDL2/SDL_stdinc.h>
+
 // Note: dependency on LegoOmni
 #include "lego/legoomni/include/legotextureinfo.h"
 
 #pragma warning(disable : 4237)
 
-struct LegoContainerInfoComparator {
+struct LegoContainerInfoHash {
+	size_t operator()(const char* const& p_key) const
+	{
+		LegoU32 hash = 2166136261u;
+
+		for (const char* p = p_key; *p; p++) {
+			hash ^= (LegoU8) *p;
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+};
+
+struct LegoContainerInfoEqual {
 	LegoBool operator()(const char* const& p_key0, const char* const& p_key1) const
 	{
-		return strcmp(p_key0, p_key1) > 0;
+		return strcmp(p_key0, p_key1) == 0;
 	}
 };
 
-// SIZE 0x10
+// The original's strcmp-ordered map was 0x10, a hashed one's size depends on the STL
 template <class T>
-class LegoContainerInfo : public map<const char*, T*, LegoContainerInfoComparator> {};
+class LegoContainerInfo : public unordered_map<const char*, T*, LegoContainerInfoHash, LegoContainerInfoEqual> {};
 
-// SIZE 0x18
+// The original's 0x18, with its map at 0x08
 template <class T>
 class LegoContainer {
 public:
@@ -114,76 +131,61 @@ typedef pair<LegoTextureInfo*, BOOL> LegoCachedTexture;
 typedef list<LegoCachedTexture> LegoCachedTextureList;
 
 // VTABLE: LEGO1 0x100d86fc
-// SIZE 0x24
+// The original's 0x24, then the indexes and counters
 class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 public:
+	LegoTextureContainer();
 	~LegoTextureContainer() override;
 
+	LegoTextureInfo* Create(const char* p_name, LegoTexture* p_texture, LegoBool p_share);
 	LegoTextureInfo* GetCached(LegoTextureInfo* p_textureInfo);
 	void EraseCached(LegoTextureInfo* p_textureInfo);
+	void Clear();
 
-protected:
-	LegoCachedTextureList m_cached; // 0x18
-};
-
-// TEMPLATE: LEGO1 0x10059c50
-// allocator<LegoTextureInfo *>::_Charalloc
+	LegoU32 GetSurfaceCount() { return m_surfaceCount; }
+	LegoU32 GetSurfaceBytes() { return m_surfaceBytes; }
+	LegoU32 GetSharedCount() { return m_sharedCount; }
+	LegoU32 GetSharedBytes() { return m_sharedBytes; }
+	Uint64 GetCreateTicks() { return m_createTicks; }
 
-// clang-format off
-// TEMPLATE: LEGO1 0x10001cc0
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Lbound
-
-// TEMPLATE: LEGO1 0x1004f740
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::find
-
-// TEMPLATE: LEGO1 0x1004f800
-// map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::insert
-
-// TEMPLATE: LEGO1 0x1004f960
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::iterator::_Dec
-
-// TEMPLATE: LEGO1 0x1004f9b0
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Insert
-
-// TEMPLATE: LEGO1 0x10059c70
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Color
+	LEGO1_EXPORT static void SetShareIdentical(LegoBool p_shareIdentical);
 
-// TEMPLATE: LEGO1 0x10059c80
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Left
+protected:
+	LegoTextureInfo* FindIdentical(LegoTexture* p_texture, LegoU32 p_hash);
+	void RemoveIdle(LegoTextureInfo* p_textureInfo);
+	void Delete(LegoTextureInfo* p_textureInfo);
 
-// TEMPLATE: LEGO1 0x10059c90
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Parent
+	typedef vector<LegoTextureInfo*> LegoTextureInfoBucket;
 
-// TEMPLATE: LEGO1 0x10059ca0
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Right
+	LegoCachedTextureList m_cached;
 
-// TEMPLATE: LEGO1 0x10059cb0
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::~_Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >
+	// Every m_cached entry by texture, and the unused ones by name hash
+	unordered_map<LegoTextureInfo*, LegoCachedTextureList::iterator> m_cachedIndex;
+	unordered_map<LegoU32, LegoTextureInfoBucket> m_idleCached;
 
-// TEMPLATE: LEGO1 0x10059d80
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::iterator::_Inc
+	// Names of shareable textures by payload hash
+	unordered_map<LegoU32, vector<const char*> > m_payloads;
 
-// TEMPLATE: LEGO1 0x10059dc0
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::erase
+	LegoU32 m_surfaceCount;
+	LegoU32 m_surfaceBytes;
+	LegoU32 m_sharedCount;
+	LegoU32 m_sharedBytes;
+	Uint64 m_createTicks;
 
-// TEMPLATE: LEGO1 0x1005a210
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Erase
+	// The textures holding each shared renderer texture, the one its app data points at first
+	unordered_map<LPDIRECT3DRMTEXTURE2, LegoTextureInfoBucket> m_sharers;
+};
 
+// clang-format off
 // TEMPLATE: LEGO1 0x1005a250
 // list<pair<LegoTextureInfo *,int>,allocator<pair<LegoTextureInfo *,int> > >::~list<pair<LegoTextureInfo *,int>,allocator<pair<LegoTextureInfo *,int> > >
 
-// TEMPLATE: LEGO1 0x1005a2c0
-// map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::~map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >
-
 // TEMPLATE: LEGO1 0x1005a310
 // LegoContainer<LegoTextureInfo>::`scalar deleting destructor'
 
 // TEMPLATE: LEGO1 0x1005a400
 // LegoContainerInfo<LegoTextureInfo>::~LegoContainerInfo<LegoTextureInfo>
 
-// TEMPLATE: LEGO1 0x1005a450
-// Map<char const *,LegoTextureInfo *,LegoContainerInfoComparator>::~Map<char const *,LegoTextureInfo *,LegoContainerInfoComparator>
-
 // SYNTHETIC: LEGO1 0x1005a580
 // LegoTextureContainer::`scalar deleting destructor'
 
@@ -193,8 +195,6 @@ class LegoTextureContainer : public LegoContainer<LegoTextureInfo> {
 // TEMPLATE: LEGO1 0x1005b660
 // LegoContainer<LegoTextureInfo>::~LegoContainer<LegoTextureInfo>
 
-// GLOBAL: LEGO1 0x100f0100
-// _Tree<char const *,pair<char const * const,LegoTextureInfo *>,map<char const *,LegoTextureInfo *,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Kfn,LegoContainerInfoComparator,allocator<LegoTextureInfo *> >::_Nil
 // clang-format on
 
 // TEMPLATE: BETA10 0x1007bc00
@@ -20,7 +20,10 @@ LegoMemory::LegoMemory(void* p_buffer, LegoU32 p_size) : LegoStorage()
 // FUNCTION: LEGO1 0x10099160
 LegoResult LegoMemory::Read(void* p_buffer, LegoU32 p_size)
 {
-	assert(m_position + p_size <= m_size);
+	if (m_position + p_size > m_size) {
+		return FAILURE;
+	}
+
 	memcpy(p_buffer, m_buffer + m_position, p_size);
 	m_position += p_size;
 	return SUCCESS;
@@ -35,18 +38,60 @@ LegoResult LegoMemory::Write(const void* p_buffer, LegoU32 p_size)
 	return SUCCESS;
 }
 
+LegoResult LegoGrowableMemory::Write(const void* p_buffer, LegoU32 p_size)
+{
+	if (m_position + p_size > m_size) {
+		LegoU32 size = m_size ? m_size : 0x1000;
+
+		while (m_position + p_size > size) {
+			size *= 2;
+		}
+
+		LegoU8* buffer = new LegoU8[size];
+
+		if (m_buffer) {
+			memcpy(buffer, m_buffer, m_position);
+			delete[] m_buffer;
+		}
+
+		m_buffer = buffer;
+		m_size = size;
+	}
+
+	return LegoMemory::Write(p_buffer, p_size);
+}
+
+// Hands the written bytes over to the caller, who must delete[] them, and empties the storage.
+LegoU8* LegoGrowableMemory::Detach(LegoU32& p_size)
+{
+	LegoU8* buffer = m_buffer;
+	p_size = m_position;
+
+	m_buffer = NULL;
+	m_position = 0;
+	m_size = 0;
+	return buffer;
+}
+
 // FUNCTION: LEGO1 0x100991c0
 LegoFile::LegoFile()
 {
 	m_file = NULL;
+	m_buffer = NULL;
+	m_bufferPosition = 0;
+	m_bufferLength = 0;
+	m_bufferDirty = FALSE;
 }
 
 // FUNCTION: LEGO1 0x10099250
 LegoFile::~LegoFile()
 {
 	if (m_file) {
+		Flush();
 		SDL_RWclose(m_file);
 	}
+
+	delete[] m_buffer;
 }
 
 // FUNCTION: LEGO1 0x100992c0
@@ -55,9 +100,46 @@ LegoResult LegoFile::Read(void* p_buffer, LegoU32 p_size)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (SDL_RWread(m_file, p_buffer, 1, p_size) != p_size) {
+	if (m_bufferDirty && Flush() != SUCCESS) {
+		return FAILURE;
+	}
+
+	LegoU8* dest = (LegoU8*) p_buffer;
+	LegoU32 available = m_bufferLength - m_bufferPosition;
+
+	if (p_size <= available) {
+		memcpy(dest, m_buffer + m_bufferPosition, p_size);
+		m_bufferPosition += p_size;
+		return SUCCESS;
+	}
+
+	if (available) {
+		memcpy(dest, m_buffer + m_bufferPosition, available);
+		dest += available;
+		p_size -= available;
+	}
+
+	m_bufferPosition = m_bufferLength = 0;
+
+	if (p_size >= c_bufferSize) {
+		if (SDL_RWread(m_file, dest, 1, p_size) != p_size) {
+			return FAILURE;
+		}
+		return SUCCESS;
+	}
+
+	if (!m_buffer) {
+		m_buffer = new LegoU8[c_bufferSize];
+	}
+
+	m_bufferLength = SDL_RWread(m_file, m_buffer, 1, c_bufferSize);
+	if (m_bufferLength < p_size) {
+		m_bufferPosition = m_bufferLength;
 		return FAILURE;
 	}
+
+	memcpy(dest, m_buffer, p_size);
+	m_bufferPosition = p_size;
 	return SUCCESS;
 }
 
@@ -67,9 +149,24 @@ LegoResult LegoFile::Write(const void* p_buffer, LegoU32 p_size)
 	if (!m_file) {
 		return FAILURE;
 	}
-	if (SDL_RWwrite(m_file, p_buffer, 1, p_size) != p_size) {
+	if ((!m_bufferDirty || m_bufferPosition + p_size > c_bufferSize) && Flush() != SUCCESS) {
 		return FAILURE;
 	}
+
+	if (p_size >= c_bufferSize) {
+		if (SDL_RWwrite(m_file, p_buffer, 1, p_size) != p_size) {
+			return FAILURE;
+		}
+		return SUCCESS;
+	}
+
+	if (!m_buffer) {
+		m_buffer = new LegoU8[c_bufferSize];
+	}
+
+	memcpy(m_buffer + m_bufferPosition, p_buffer, p_size);
+	m_bufferPosition += p_size;
+	m_bufferDirty = TRUE;
 	return SUCCESS;
 }
 
@@ -83,7 +180,12 @@ LegoResult LegoFile::GetPosition(LegoU32& p_position)
 	if (position == -1) {
 		return FAILURE;
 	}
-	p_position = position;
+	if (m_bufferDirty) {
+		p_position = position + m_bufferPosition;
+	}
+	else {
+		p_position = position - (m_bufferLength - m_bufferPosition);
+	}
 	return SUCCESS;
 }
 
@@ -93,18 +195,61 @@ LegoResult LegoFile::SetPosition(LegoU32 p_position)
 	if (!m_file) {
 		return FAILURE;
 	}
+
+	// Seeks within the read-ahead just move the cursor
+	if (!m_bufferDirty && m_bufferLength) {
+		Sint64 end = SDL_RWtell(m_file);
+
+		if (end != -1 && p_position + (Sint64) m_bufferLength >= end && p_position <= end) {
+			m_bufferPosition = p_position + m_bufferLength - end;
+			return SUCCESS;
+		}
+	}
+
+	if (m_bufferDirty && Flush() != SUCCESS) {
+		return FAILURE;
+	}
+
+	m_bufferPosition = m_bufferLength = 0;
+
 	if (SDL_RWseek(m_file, p_position, RW_SEEK_SET) != p_position) {
 		return FAILURE;
 	}
 	return SUCCESS;
 }
 
+// Passes buffered writes to the stream, or drops the read-ahead and moves the stream back
+// to the logical position
+LegoResult LegoFile::Flush()
+{
+	LegoResult result = SUCCESS;
+
+	if (m_file) {
+		if (m_bufferDirty) {
+			if (SDL_RWwrite(m_file, m_buffer, 1, m_bufferPosition) != m_bufferPosition) {
+				result = FAILURE;
+			}
+		}
+		else if (m_bufferPosition < m_bufferLength) {
+			if (SDL_RWseek(m_file, (Sint64) m_bufferPosition - m_bufferLength, RW_SEEK_CUR) == -1) {
+				result = FAILURE;
+			}
+		}
+	}
+
+	m_bufferPosition = m_bufferLength = 0;
+	m_bufferDirty = FALSE;
+	return result;
+}
+
 // FUNCTION: LEGO1 0x100993a0
 LegoResult LegoFile::Open(const char* p_name, LegoU32 p_mode)
 {
 	if (m_file) {
+		Flush();
 		SDL_RWclose(m_file);
 	}
+
 	char mode[4];
 	mode[0] = '\0';
 	if (p_mode & c_read) {
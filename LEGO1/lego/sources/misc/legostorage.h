@@ -168,6 +168,21 @@ class LegoStorage {
 		return this;
 	}
 
+	// Reads p_count values in one call. Like Read and the scalar readers above, values are taken
+	// in host byte order, which matches the little-endian data files on every supported platform.
+	template <class T>
+	LegoResult ReadArray(T* p_data, LegoU32 p_count)
+	{
+		return Read(p_data, p_count * sizeof(T));
+	}
+
+	// Writes p_count values in one call, in host byte order like the scalar writers
+	template <class T>
+	LegoResult WriteArray(const T* p_data, LegoU32 p_count)
+	{
+		return Write(p_data, p_count * sizeof(T));
+	}
+
 	// FUNCTION: LEGO1 0x10034470
 	LegoStorage* ReadMxString(MxString& p_data)
 	{
@@ -225,6 +240,18 @@ class LegoMemory : public LegoStorage {
 	LegoU32 m_size;
 };
 
+// In-memory write storage that grows as needed. Used to snapshot data that is
+// written to disk later, away from the main thread.
+class LegoGrowableMemory : public LegoMemory {
+public:
+	LegoGrowableMemory() : LegoMemory(NULL, 0) { m_mode = c_write; }
+	~LegoGrowableMemory() override { delete[] m_buffer; }
+
+	LegoResult Write(const void* p_buffer, LegoU32 p_size) override; // vtable+0x08
+
+	LegoU8* Detach(LegoU32& p_size);
+};
+
 // VTABLE: LEGO1 0x100db730
 // SIZE 0x0c
 class LegoFile : public LegoStorage {
@@ -237,12 +264,24 @@ class LegoFile : public LegoStorage {
 	LegoResult GetPosition(LegoU32& p_position) override;            // vtable+0x0c
 	LegoResult SetPosition(LegoU32 p_position) override;             // vtable+0x10
 	LegoResult Open(const char* p_name, LegoU32 p_mode);
+	LegoResult Flush();
 
 	// SYNTHETIC: LEGO1 0x10099230
 	// LegoFile::`scalar deleting destructor'
 
 protected:
+	enum {
+		c_bufferSize = 0x1000
+	};
+
 	SDL_IOStream* m_file; // 0x08
+
+	// Either read-ahead (m_bufferPosition..m_bufferLength not yet consumed) or,
+	// if m_bufferDirty, writes not yet passed to m_file (0..m_bufferPosition)
+	LegoU8* m_buffer;
+	LegoU32 m_bufferPosition;
+	LegoU32 m_bufferLength;
+	LegoBool m_bufferDirty;
 };
 
 #endif // __LEGOSTORAGE_H
@@ -111,21 +111,21 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 
 	if (numVerts > 0) {
 		vertices = new float[numVerts][sizeOfArray(*vertices)];
-		if (p_storage->Read(vertices, numVerts * 3 * sizeof(float)) != SUCCESS) {
+		if (p_storage->ReadArray((float*) vertices, numVerts * 3) != SUCCESS) {
 			goto done;
 		}
 	}
 
 	if (numNormals > 0) {
 		normals = new float[numNormals][sizeOfArray(*normals)];
-		if (p_storage->Read(normals, numNormals * 3 * sizeof(float)) != SUCCESS) {
+		if (p_storage->ReadArray((float*) normals, numNormals * 3) != SUCCESS) {
 			goto done;
 		}
 	}
 
 	if (numTextureVertices > 0) {
 		textureVertices = new float[numTextureVertices][sizeOfArray(*textureVertices)];
-		if (p_storage->Read(textureVertices, numTextureVertices * 2 * sizeof(float)) != SUCCESS) {
+		if (p_storage->ReadArray((float*) textureVertices, numTextureVertices * 2) != SUCCESS) {
 			goto done;
 		}
 	}
@@ -146,7 +146,7 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 		}
 
 		polyIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*polyIndices)];
-		if (p_storage->Read(polyIndices, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
+		if (p_storage->ReadArray((LegoU32*) polyIndices, (numPolys & USHRT_MAX) * 3) != SUCCESS) {
 			goto done;
 		}
 
@@ -156,7 +156,7 @@ LegoResult LegoLOD::Read(Tgl::Renderer* p_renderer, LegoTextureContainer* p_text
 
 		if (numTextureIndices > 0) {
 			textureIndices = new LegoU32[numPolys & USHRT_MAX][sizeOfArray(*textureIndices)];
-			if (p_storage->Read(textureIndices, (numPolys & USHRT_MAX) * 3 * sizeof(LegoU32)) != SUCCESS) {
+			if (p_storage->ReadArray((LegoU32*) textureIndices, (numPolys & USHRT_MAX) * 3) != SUCCESS) {
 				goto done;
 			}
 		}
@@ -58,6 +58,8 @@ ColorOverride g_colorOverride = NULL;
 // GLOBAL: LEGO1 0x101013b0
 TextureHandler g_textureHandler = NULL;
 
+RenameHandler g_renameHandler = NULL;
+
 // FUNCTION: LEGO1 0x100a81b0
 void LegoROI::FUN_100a81b0(const LegoChar* p_error, const LegoChar* p_name)
 {
@@ -120,7 +122,7 @@ LegoResult LegoROI::Read(
 	LegoROI* roi;
 	LegoLOD* lod;
 	LegoU32 length, roiLength;
-	LegoChar *roiName, *textureName;
+	LegoChar *name, *roiName, *textureName;
 	LegoTextureInfo* textureInfo;
 	ViewLODList* lodList;
 	LegoU32 numROIs;
@@ -132,12 +134,14 @@ LegoResult LegoROI::Read(
 	if (p_storage->Read(&length, sizeof(LegoU32)) != SUCCESS) {
 		goto done;
 	}
-	m_name = new LegoChar[length + 1];
-	if (p_storage->Read(m_name, length) != SUCCESS) {
+	name = new LegoChar[length + 1];
+	if (p_storage->Read(name, length) != SUCCESS) {
+		delete[] name;
 		goto done;
 	}
-	m_name[length] = '\0';
-	SDL_strlwr(m_name);
+	name[length] = '\0';
+	SetName(name);
+	delete[] name;
 
 	if (sphere.Read(p_storage) != SUCCESS) {
 		goto done;
@@ -441,6 +445,41 @@ void LegoROI::FUN_100a8e80(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_t
 	}
 }
 
+// Same as FUN_100a8e80, with the node transforms taken from a frame filled by LegoAnim::EvaluateFrame.
+// Returns the number of nodes consumed.
+LegoU32 LegoROI::ApplyFrame(
+	LegoTreeNode* p_node,
+	Matrix4& p_matrix,
+	LegoROI** p_roiMap,
+	const LegoAnimFrameNode* p_frame
+)
+{
+	Matrix4 mat((float (*)[4]) p_frame->m_local);
+	LegoU32 i, count = 1;
+
+	LegoAnimNodeData* data = (LegoAnimNodeData*) p_node->GetData();
+	LegoROI* roi = p_roiMap[data->GetUnknown0x20()];
+	if (roi != NULL) {
+		roi->m_local2world.Product(mat, p_matrix);
+		roi->UpdateWorldData();
+		roi->SetVisibility(p_frame->m_visible);
+
+		for (i = 0; i < p_node->GetNumChildren(); i++) {
+			count += ApplyFrame(p_node->GetChild(i), roi->m_local2world, p_roiMap, p_frame + count);
+		}
+	}
+	else {
+		MxMatrix local2world;
+		local2world.Product(mat, p_matrix);
+
+		for (i = 0; i < p_node->GetNumChildren(); i++) {
+			count += ApplyFrame(p_node->GetChild(i), local2world, p_roiMap, p_frame + count);
+		}
+	}
+
+	return count;
+}
+
 // FUNCTION: LEGO1 0x100a8fd0
 // FUNCTION: BETA10 0x1018ac81
 void LegoROI::FUN_100a8fd0(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_time, LegoROI** p_roiMap)
@@ -811,12 +850,15 @@ void LegoROI::SetColorOverride(ColorOverride p_colorOverride)
 	g_colorOverride = p_colorOverride;
 }
 
+void LegoROI::SetRenameHandler(RenameHandler p_renameHandler)
+{
+	g_renameHandler = p_renameHandler;
+}
+
 // FUNCTION: LEGO1 0x100a9d40
 void LegoROI::SetName(const LegoChar* p_name)
 {
-	if (m_name != NULL) {
-		delete[] m_name;
-	}
+	LegoChar* oldName = m_name;
 
 	if (p_name != NULL) {
 		m_name = new LegoChar[strlen(p_name) + 1];
@@ -826,6 +868,14 @@ void LegoROI::SetName(const LegoChar* p_name)
 	else {
 		m_name = NULL;
 	}
+
+	if (g_renameHandler != NULL) {
+		g_renameHandler(this, oldName);
+	}
+
+	if (oldName != NULL) {
+		delete[] oldName;
+	}
 }
 
 // FUNCTION: LEGO1 0x100a9dd0
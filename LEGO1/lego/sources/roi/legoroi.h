@@ -9,6 +9,7 @@ typedef unsigned char (*ColorOverride)(const char*, char*, unsigned int);
 typedef unsigned char (*TextureHandler)(const char*, unsigned char*, unsigned int);
 
 class LegoEntity;
+class LegoROI;
 class LegoTextureContainer;
 class LegoTextureInfo;
 class LegoStorage;
@@ -16,6 +17,9 @@ class LegoAnim;
 class LegoAnimNodeData;
 class LegoTreeNode;
 struct LegoAnimActorEntry;
+struct LegoAnimFrameNode;
+
+typedef void (*RenameHandler)(LegoROI*, const char*);
 
 // VTABLE: LEGO1 0x100dbe38
 // SIZE 0x108
@@ -36,6 +40,12 @@ class LegoROI : public ViewROI {
 	LegoResult FUN_100a8da0(LegoTreeNode* p_node, const Matrix4& p_matrix, LegoTime p_time, LegoROI* p_roi);
 	static void FUN_100a8e80(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_time, LegoROI** p_roiMap);
 	static void FUN_100a8fd0(LegoTreeNode* p_node, Matrix4& p_matrix, LegoTime p_time, LegoROI** p_roiMap);
+	static LegoU32 ApplyFrame(
+		LegoTreeNode* p_node,
+		Matrix4& p_matrix,
+		LegoROI** p_roiMap,
+		const LegoAnimFrameNode* p_frame
+	);
 	LegoResult SetFrame(LegoAnim* p_anim, LegoTime p_time);
 	LegoResult SetLodColor(LegoFloat p_red, LegoFloat p_green, LegoFloat p_blue, LegoFloat p_alpha);
 	LegoResult SetTextureInfo(LegoTextureInfo* p_textureInfo);
@@ -56,6 +66,9 @@ class LegoROI : public ViewROI {
 	static void FUN_100a81b0(const LegoChar* p_error, const LegoChar* p_name);
 	LEGO1_EXPORT static void configureLegoROI(int p_roi);
 	static void SetColorOverride(ColorOverride p_colorOverride);
+
+	// Called after SetName renames an ROI, with the previous name
+	static void SetRenameHandler(RenameHandler p_renameHandler);
 	static LegoBool GetRGBAColor(const LegoChar* p_name, float& p_red, float& p_green, float& p_blue, float& p_alpha);
 	static LegoBool ColorAliasLookup(
 		const LegoChar* p_param,
@@ -78,14 +91,18 @@ class LegoROI : public ViewROI {
 	void SetEntity(LegoEntity* p_entity) { m_entity = p_entity; }
 
 	void SetComp(CompoundObject* p_comp) { comp = p_comp; }
-	void SetBoundingSphere(const BoundingSphere& p_sphere) { m_sphere = m_world_bounding_sphere = p_sphere; }
+	void SetBoundingSphere(const BoundingSphere& p_sphere)
+	{
+		ResolveWorldBoundingVolumes();
+		m_sphere = m_world_bounding_sphere = p_sphere;
+	}
 	void SetUnknown0x80(const BoundingBox& p_unk0x80) { m_unk0x80 = p_unk0x80; }
 
 	// SYNTHETIC: LEGO1 0x100a82b0
 	// LegoROI::`scalar deleting destructor'
 
 private:
-	LegoChar* m_name;        // 0xe4
+	// m_name is inherited from ViewROI at 0xe4
 	BoundingSphere m_sphere; // 0xe8
 	undefined m_unk0x100;    // 0x100
 	LegoEntity* m_entity;    // 0x104
@@ -9,14 +9,12 @@ DECOMP_SIZE_ASSERT(LegoColor, 0x03)
 LegoResult LegoColor::Read(LegoStorage* p_storage)
 {
 	LegoResult result;
-	if ((result = p_storage->Read(&m_red, sizeof(LegoU8))) != SUCCESS) {
-		return result;
-	}
-	if ((result = p_storage->Read(&m_green, sizeof(LegoU8))) != SUCCESS) {
-		return result;
-	}
-	if ((result = p_storage->Read(&m_blue, sizeof(LegoU8))) != SUCCESS) {
+	LegoU8 rgb[3];
+	if ((result = p_storage->ReadArray(rgb, sizeOfArray(rgb))) != SUCCESS) {
 		return result;
 	}
+	m_red = rgb[0];
+	m_green = rgb[1];
+	m_blue = rgb[2];
 	return SUCCESS;
 }
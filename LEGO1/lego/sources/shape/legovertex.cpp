@@ -16,15 +16,5 @@ LegoVertex::LegoVertex()
 // FUNCTION: LEGO1 0x100d37c0
 LegoResult LegoVertex::Read(LegoStorage* p_storage)
 {
-	LegoResult result;
-	if ((result = p_storage->Read(&m_coordinates[0], sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-	if ((result = p_storage->Read(&m_coordinates[1], sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-	if ((result = p_storage->Read(&m_coordinates[2], sizeof(LegoFloat))) != SUCCESS) {
-		return result;
-	}
-	return SUCCESS;
+	return p_storage->ReadArray(m_coordinates, sizeOfArray(m_coordinates));
 }
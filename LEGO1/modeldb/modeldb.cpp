@@ -1,8 +1,10 @@
 #include "SDL_iostream_compat.h"
 #include "modeldb.h"
 
+#include <string.h>
+
 DECOMP_SIZE_ASSERT(ModelDbWorld, 0x18)
-DECOMP_SIZE_ASSERT(ModelDbPart, 0x18)
+DECOMP_SIZE_ASSERT(ModelDbPart, 0x38)
 DECOMP_SIZE_ASSERT(ModelDbModel, 0x38)
 DECOMP_SIZE_ASSERT(ModelDbPartList, 0x1c)
 DECOMP_SIZE_ASSERT(ModelDbPartListCursor, 0x10)
@@ -175,3 +177,273 @@ void FreeModelDbWorlds(ModelDbWorld*& p_worlds, MxS32 p_numWorlds)
 	delete[] p_worlds;
 	p_worlds = NULL;
 }
+
+// Bounds-checked reads from the WORLD.WDB image
+class ModelDbReader {
+public:
+	ModelDbReader(MxU8* p_data, MxU32 p_size) : m_data(p_data), m_size(p_size), m_position(0) {}
+
+	MxBool Read(void* p_dest, MxU32 p_length)
+	{
+		if (m_size - m_position < p_length) {
+			return FALSE;
+		}
+
+		memcpy(p_dest, m_data + m_position, p_length);
+		m_position += p_length;
+		return TRUE;
+	}
+
+	// A length-prefixed name, left in place. p_length stops at its terminator, if it has one.
+	const char* ReadName(MxU32& p_length)
+	{
+		MxU32 length;
+
+		if (!Read(&length, sizeof(length)) || m_size - m_position < length) {
+			return NULL;
+		}
+
+		const char* name = (const char*) m_data + m_position;
+		const char* end = (const char*) memchr(name, '\0', length);
+		p_length = end ? end - name : length;
+		m_position += length;
+		return name;
+	}
+
+	MxU32 GetPosition() { return m_position; }
+
+private:
+	MxU8* m_data;
+	MxU32 m_size;
+	MxU32 m_position;
+};
+
+// Arrays in the arena start on a pointer boundary
+static MxU32 Align(MxU32 p_size)
+{
+	return (p_size + sizeof(void*) - 1) & ~(MxU32) (sizeof(void*) - 1);
+}
+
+// FNV-1a over p_length bytes. Names are interned as they are, not case-folded.
+static MxU32 HashName(const char* p_name, MxU32 p_length)
+{
+	MxU32 hash = 2166136261u;
+
+	for (MxU32 i = 0; i < p_length; i++) {
+		hash ^= (MxU8) p_name[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+ModelDb::ModelDb()
+{
+	m_data = NULL;
+	m_size = 0;
+	m_indexEnd = 0;
+	m_arena = NULL;
+	m_arenaSize = 0;
+	m_poolSize = 0;
+	m_worlds = NULL;
+	m_numWorlds = 0;
+	m_numParts = 0;
+	m_numModels = 0;
+	m_numNames = 0;
+	m_used = 0;
+	m_names = NULL;
+	m_namesMask = 0;
+}
+
+ModelDb::~ModelDb()
+{
+	delete[] m_arena;
+	delete[] m_data;
+}
+
+// Takes over p_data, allocated with new[], also when its index does not parse
+MxResult ModelDb::Read(MxU8* p_data, MxU32 p_size)
+{
+	delete[] m_arena;
+	delete[] m_data;
+	m_arena = NULL;
+	m_worlds = NULL;
+	m_data = p_data;
+	m_size = p_size;
+
+	if (Parse() != SUCCESS) {
+		return FAILURE;
+	}
+
+	MxU32 numSlots = 16;
+	while (numSlots < m_numNames * 2) {
+		numSlots <<= 1;
+	}
+
+	// m_poolSize counted every name; interning only shrinks it
+	m_arenaSize = Align(m_numWorlds * sizeof(ModelDbWorldEntry)) + Align(m_numParts * sizeof(ModelDbPartEntry)) +
+				  Align(m_numModels * sizeof(ModelDbModel)) + m_poolSize;
+	m_arena = new MxU8[m_arenaSize];
+	memset(m_arena, 0, m_arenaSize);
+
+	m_names = new char*[numSlots];
+	memset(m_names, 0, numSlots * sizeof(char*));
+	m_namesMask = numSlots - 1;
+
+	MxResult result = Parse();
+
+	delete[] m_names;
+	m_names = NULL;
+
+	if (result != SUCCESS) {
+		delete[] m_arena;
+		m_arena = NULL;
+		m_worlds = NULL;
+	}
+
+	return result;
+}
+
+// Walks the index. Without an arena it only counts the worlds, parts, models and name bytes the
+// arena needs; with one it fills it.
+MxResult ModelDb::Parse()
+{
+	ModelDbReader reader(m_data, m_size);
+	MxBool fill = m_arena != NULL;
+	ModelDbPartEntry* parts = NULL;
+	ModelDbModel* models = NULL;
+	ModelDbWorldEntry world;
+	ModelDbPartEntry part;
+	ModelDbModel model;
+	MxS32 numWorlds, numParts, numModels, i, j;
+	MxU32 length;
+	const char* name;
+
+	if (fill) {
+		m_worlds = (ModelDbWorldEntry*) m_arena;
+		parts = (ModelDbPartEntry*) (m_arena + Align(m_numWorlds * sizeof(ModelDbWorldEntry)));
+		models = (ModelDbModel*) ((MxU8*) parts + Align(m_numParts * sizeof(ModelDbPartEntry)));
+		m_used = (MxU8*) models - m_arena + Align(m_numModels * sizeof(ModelDbModel));
+	}
+
+	m_numParts = 0;
+	m_numModels = 0;
+	m_numNames = 0;
+	m_poolSize = 0;
+
+	if (!reader.Read(&numWorlds, sizeof(numWorlds)) || numWorlds < 0) {
+		return FAILURE;
+	}
+
+	for (i = 0; i < numWorlds; i++) {
+		ModelDbWorldEntry& w = fill ? m_worlds[i] : world;
+
+		if ((name = reader.ReadName(length)) == NULL || !reader.Read(&numParts, sizeof(numParts)) || numParts < 0) {
+			return FAILURE;
+		}
+
+		w.m_worldName = fill ? Intern(name, length) : NULL;
+		w.m_parts = fill ? parts + m_numParts : NULL;
+		w.m_numParts = numParts;
+		m_numNames++;
+		m_poolSize += fill ? 0 : length + 1;
+
+		for (j = 0; j < numParts; j++) {
+			ModelDbPartEntry& p = fill ? parts[m_numParts] : part;
+
+			if ((name = reader.ReadName(length)) == NULL ||
+				!reader.Read(&p.m_partDataLength, sizeof(p.m_partDataLength)) ||
+				!reader.Read(&p.m_partDataOffset, sizeof(p.m_partDataOffset))) {
+				return FAILURE;
+			}
+
+			p.m_roiName = fill ? Intern(name, length) : NULL;
+			m_numParts++;
+			m_numNames++;
+			m_poolSize += fill ? 0 : length + 1;
+		}
+
+		if (!reader.Read(&numModels, sizeof(numModels)) || numModels < 0) {
+			return FAILURE;
+		}
+
+		w.m_models = fill ? models + m_numModels : NULL;
+		w.m_numModels = numModels;
+
+		for (j = 0; j < numModels; j++) {
+			ModelDbModel& m = fill ? models[m_numModels] : model;
+
+			if ((name = reader.ReadName(length)) == NULL) {
+				return FAILURE;
+			}
+
+			m.m_modelName = fill ? Intern(name, length) : NULL;
+			m_poolSize += fill ? 0 : length + 1;
+
+			if (!reader.Read(&m.m_modelDataLength, sizeof(m.m_modelDataLength)) ||
+				!reader.Read(&m.m_modelDataOffset, sizeof(m.m_modelDataOffset)) ||
+				(name = reader.ReadName(length)) == NULL) {
+				return FAILURE;
+			}
+
+			m.m_presenterName = fill ? Intern(name, length) : NULL;
+			m_poolSize += fill ? 0 : length + 1;
+
+			if (!reader.Read(m.m_location, sizeof(m.m_location)) ||
+				!reader.Read(m.m_direction, sizeof(m.m_direction)) || !reader.Read(m.m_up, sizeof(m.m_up)) ||
+				!reader.Read(&m.m_unk0x34, sizeof(m.m_unk0x34))) {
+				return FAILURE;
+			}
+
+			m_numModels++;
+			m_numNames += 2;
+		}
+	}
+
+	m_numWorlds = numWorlds;
+	m_indexEnd = reader.GetPosition();
+	return SUCCESS;
+}
+
+// Returns the pool's copy of the name, adding it the first time it is seen
+char* ModelDb::Intern(const char* p_name, MxU32 p_length)
+{
+	MxU32 slot = HashName(p_name, p_length) & m_namesMask;
+
+	while (m_names[slot] != NULL) {
+		if (!strncmp(m_names[slot], p_name, p_length) && m_names[slot][p_length] == '\0') {
+			return m_names[slot];
+		}
+
+		slot = (slot + 1) & m_namesMask;
+	}
+
+	char* name = (char*) m_arena + m_used;
+	memcpy(name, p_name, p_length);
+	name[p_length] = '\0';
+	m_used += p_length + 1;
+	m_poolSize += p_length + 1;
+	m_names[slot] = name;
+	return name;
+}
+
+ModelDbWorldEntry* ModelDb::FindWorld(const char* p_worldName)
+{
+	for (MxS32 i = 0; i < m_numWorlds; i++) {
+		if (!SDL_strcasecmp(m_worlds[i].m_worldName, p_worldName)) {
+			return &m_worlds[i];
+		}
+	}
+
+	return NULL;
+}
+
+// The p_length bytes at p_offset in the file image, or NULL if they run past its end
+MxU8* ModelDb::GetData(MxU32 p_offset, MxU32 p_length)
+{
+	if (p_offset > m_size || m_size - p_offset < p_length) {
+		return NULL;
+	}
+
+	return m_data + p_offset;
+}
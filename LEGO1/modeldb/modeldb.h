@@ -10,7 +10,7 @@
 #include "SDL_RWStreamBuf.h"
 #include <SDL2/SDL_stdinc.h>
 
-// SIZE 0x18
+// SIZE 0x38
 struct ModelDbPart {
 	MxResult Read(SDL_IOStream* p_file);
 
@@ -118,4 +118,63 @@ struct ModelDbWorld {
 MxResult ReadModelDbWorlds(SDL_IOStream* p_file, ModelDbWorld*& p_worlds, MxS32& p_numWorlds);
 void FreeModelDbWorlds(ModelDbWorld*& p_worlds, MxS32 p_numWorlds);
 
+// A part as ModelDb indexes it. The name points into the index's string pool.
+struct ModelDbPartEntry {
+	const char* m_roiName;
+	MxU32 m_partDataLength;
+	MxU32 m_partDataOffset;
+};
+
+// A world as ModelDb indexes it. Its models' names point into the string pool, so the models
+// are not Free'd.
+struct ModelDbWorldEntry {
+	const char* m_worldName;
+	ModelDbPartEntry* m_parts;
+	MxS32 m_numParts;
+	ModelDbModel* m_models;
+	MxS32 m_numModels;
+};
+
+// WORLD.WDB held in memory. Read walks the index twice: once to size it, then to fill one
+// arena with the world, part and model arrays followed by a string pool that stores each
+// distinct name once. Part and model payloads are served straight from the file image.
+class ModelDb {
+public:
+	ModelDb();
+	~ModelDb();
+
+	MxResult Read(MxU8* p_data, MxU32 p_size);
+	ModelDbWorldEntry* FindWorld(const char* p_worldName);
+	MxU8* GetData(MxU32 p_offset, MxU32 p_length);
+
+	MxU32 GetSize() { return m_size; }
+	MxU32 GetIndexEnd() { return m_indexEnd; }
+	MxS32 GetNumWorlds() { return m_numWorlds; }
+	MxU32 GetNumParts() { return m_numParts; }
+	MxU32 GetNumModels() { return m_numModels; }
+	MxU32 GetArenaSize() { return m_arenaSize; }
+	MxU32 GetPoolSize() { return m_poolSize; }
+
+private:
+	MxResult Parse();
+	char* Intern(const char* p_name, MxU32 p_length);
+
+	MxU8* m_data;     // the file image
+	MxU32 m_size;     // bytes in m_data
+	MxU32 m_indexEnd; // offset of the first chunk after the index
+	MxU8* m_arena;
+	MxU32 m_arenaSize;
+	MxU32 m_poolSize; // bytes of the arena taken by names
+	ModelDbWorldEntry* m_worlds;
+	MxS32 m_numWorlds;
+	MxU32 m_numParts;
+	MxU32 m_numModels;
+	MxU32 m_numNames; // names in the index, before interning
+
+	// Only while Read fills the arena
+	MxU32 m_used;
+	char** m_names;
+	MxU32 m_namesMask;
+};
+
 #endif // MODELDB_H
@@ -12,6 +12,7 @@
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 using std::list;
@@ -19,6 +20,7 @@ using std::map;
 using std::multiset;
 using std::pair;
 using std::set;
+using std::unordered_map;
 using std::vector;
 #endif
 
@@ -52,7 +52,8 @@ void DecodeFLCFrame(
 	BYTE* p_pixelData,
 	FLIC_HEADER* p_flcHeader,
 	FLIC_FRAME* p_flcFrame,
-	BYTE* p_decodedColorMap
+	BYTE* p_decodedColorMap,
+	RECT* p_bounds
 );
 
 #endif // FLIC_H
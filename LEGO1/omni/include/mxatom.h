@@ -15,7 +15,7 @@
 // Also: the increment/decrement methods suggest a custom type was used
 // for the combined key_value_pair, which doesn't seem possible with <map>.
 
-// SIZE 0x14
+// SIZE 0x34
 class MxAtom {
 public:
 	// always inlined
@@ -0,0 +1,45 @@
+#ifndef MXAUDIOLATENCY_H
+#define MXAUDIOLATENCY_H
+
+#include "mxtypes.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_stdinc.h>
+
+// Measures the output queue of a pull-mode audio device from the callbacks that fill it: the
+// frames mixed so far, less the frames the device has played since it started, as timed by the
+// performance counter. When the device ran dry the count restarts.
+// The device asks for more at about the same fill level every time, so the emptiest point of
+// each window of callbacks is held where it was in the first window. That removes the slow drift
+// between the performance counter and the device clock.
+// Mixed is called on the audio thread only; the getters may be called from any thread.
+class MxAudioLatency {
+public:
+	MxAudioLatency();
+
+	void Reset(MxU32 p_sampleRate);
+	void Mixed(Uint64 p_now, MxU32 p_frames);
+
+	MxU32 GetQueuedFrames() { return SDL_AtomicGet(&m_queuedFrames); }
+	MxU32 GetLateCallbacks() { return SDL_AtomicGet(&m_lateCallbacks); }
+	MxU32 GetUnderruns() { return SDL_AtomicGet(&m_underruns); }
+	MxU32 GetMaxIntervalUS() { return SDL_AtomicGet(&m_maxIntervalUS); }
+
+private:
+	MxU32 m_sampleRate;
+
+	// Used by the audio thread only
+	Uint64 m_start;        // performance counter when the device started playing what we mixed
+	Uint64 m_framesMixed;  // frames mixed since m_start, less drift corrections
+	Uint64 m_lastCallback; // performance counter at the last callback
+	Uint64 m_windowEnd;    // m_framesMixed at which the current window ends
+	MxS64 m_windowMin;     // emptiest queue before mixing in the current window
+	MxS64 m_baseline;      // emptiest queue before mixing in the first window, or -1
+
+	SDL_atomic_t m_queuedFrames;
+	SDL_atomic_t m_lateCallbacks;
+	SDL_atomic_t m_underruns;
+	SDL_atomic_t m_maxIntervalUS;
+};
+
+#endif // MXAUDIOLATENCY_H
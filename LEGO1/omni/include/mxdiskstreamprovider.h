@@ -5,10 +5,13 @@
 #include "decomp.h"
 #include "mxcriticalsection.h"
 #include "mxdsaction.h"
+#include "mxreadaheadcache.h"
+#include "mxstl/stlcompat.h"
 #include "mxstreamprovider.h"
 #include "mxthread.h"
 
 class MxDiskStreamProvider;
+class MxDSBuffer;
 class MxDSStreamingAction;
 
 // VTABLE: LEGO1 0x100dd130
@@ -56,13 +59,27 @@ class MxDiskStreamProvider : public MxStreamProvider {
 	MxU32 GetLengthInDWords() override;                                 // vtable+0x24
 	MxU32* GetBufferForDWords() override;                               // vtable+0x28
 
+	LEGO1_EXPORT static void SetReadAheadLimit(MxU32 p_limit);
+
+	// Totals over every provider since startup, safe to read from any thread
+	LEGO1_EXPORT static MxU32 GetReadCount();
+	LEGO1_EXPORT static MxU32 GetReadAheadHits();
+	LEGO1_EXPORT static MxU32 GetReadAheadMisses();
+	LEGO1_EXPORT static float GetAverageReadMS();
+	LEGO1_EXPORT static float GetMaxReadMS();
+
 private:
+	static MxBool IsRequestQueued(void* p_provider);
+	static void RecordRead(MxU64 p_ticks, MxBool p_cached);
+
 	MxDiskStreamProviderThread m_thread; // 0x10
 	MxSemaphore m_busySemaphore;         // 0x2c
 	MxBool m_remainingWork;              // 0x34
 	MxBool m_unk0x35;                    // 0x35
 	MxCriticalSection m_criticalSection; // 0x38
 	MxDSObjectList m_list;               // 0x54
+
+	MxReadAheadCache m_readAhead; // only touched by m_thread
 };
 
 // SYNTHETIC: LEGO1 0x100d10a0
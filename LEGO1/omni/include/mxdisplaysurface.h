@@ -118,6 +118,8 @@ class MxDisplaySurface : public MxCore {
 private:
 	MxU8 CountTotalBitsSetTo1(MxU32 p_param);
 	MxU8 CountContiguousBitsSetTo1(MxU32 p_param);
+	MxU32 Convert565To32(MxU16 p_color);
+	void ExpandRun(MxU8*& p_surfaceData, MxU8*& p_bitmapData, MxS32 p_count, MxU8 p_bpp);
 
 	void Init();
 
@@ -128,6 +130,7 @@ class MxDisplaySurface : public MxCore {
 	MxBool m_initialized;             // 0x38
 	DDSURFACEDESC m_surfaceDesc;      // 0x3c
 	MxU16* m_16bitPal;                // 0xa8
+	MxU32* m_32bitPal;                // 0xac
 };
 
 // SYNTHETIC: LEGO1 0x100ba580
@@ -2,7 +2,9 @@
 #define MXDSBUFFER_H
 
 #include "decomp.h"
+#include "lego1_export.h"
 #include "mxcore.h"
+#include "mxstl/stlcompat.h"
 
 class MxStreamController;
 class MxDSAction;
@@ -58,6 +60,10 @@ class MxDSBuffer : public MxCore {
 	MxU8 ReleaseRef(MxDSChunk*);
 	void AddRef(MxDSChunk* p_chunk);
 	MxResult CalcBytesRemaining(MxU8* p_data);
+	MxResult StartPieces(MxDSBuffer* p_source, MxU8* p_data);
+	MxResult AddPiece(MxDSBuffer* p_source, MxU8* p_data);
+	void CopyPieces(MxU8* p_dest);
+	MxU8* JoinPieces();
 	void FUN_100c6f80(MxU32 p_writeOffset);
 	MxU8* FUN_100c6fa0(MxU8* p_data);
 	MxResult FUN_100c7090(MxDSBuffer* p_buf);
@@ -65,6 +71,16 @@ class MxDSBuffer : public MxCore {
 	static MxCore* ReadChunk(MxDSBuffer* p_buffer, MxU32* p_chunkData, MxU16 p_flags);
 	static MxResult Append(MxU8* p_buffer1, MxU8* p_buffer2);
 
+	struct ChunkStats {
+		MxU32 m_chunks;       // MxStreamChunks allocated for parsed chunks
+		MxU32 m_splitChunks;  // chunks that spanned buffers
+		MxU32 m_inPlace;      // split chunks gathered without copying
+		MxU32 m_allocations;  // reassembly buffers allocated
+		MxU32 m_bytesCopied;  // bytes copied to join split chunks
+	};
+
+	LEGO1_EXPORT static void GetChunkStats(ChunkStats& p_stats);
+
 	// FUNCTION: BETA10 0x10148c60
 	MxU8* GetBuffer() { return m_pBuffer; }
 
@@ -74,6 +90,8 @@ class MxDSBuffer : public MxCore {
 	// FUNCTION: BETA10 0x10156420
 	MxBool HasRef() { return m_referenceCount != 0; }
 
+	MxBool HasPieces() { return !m_pieces.empty(); }
+
 	MxU16 GetRefCount() { return m_referenceCount; }
 	Type GetMode() { return m_mode; }
 
@@ -107,6 +125,19 @@ class MxDSBuffer : public MxCore {
 	MxU32 m_writeOffset;            // 0x28
 	MxU32 m_bytesRemaining;         // 0x2c
 	MxDSStreamingAction* m_unk0x30; // 0x30
+
+private:
+	struct Piece {
+		MxDSBuffer* m_buffer;
+		MxU8* m_data;
+		MxU32 m_length;
+	};
+
+	void ReleasePieces();
+
+	// A buffer gathering a split chunk in place holds only the chunk's header, and a
+	// reference on each buffer that a piece of the payload was read into
+	vector<Piece> m_pieces;
 };
 
 #endif // MXDSBUFFER_H
@@ -13,7 +13,7 @@
 
 // VTABLE: LEGO1 0x100dc890
 // VTABLE: BETA10 0x101c2418
-// SIZE 0x7c
+// SIZE 0x9c
 class MxDSFile : public MxDSSource {
 public:
 	MxDSFile(const char* p_filename, MxULong p_skipReadingChunks);
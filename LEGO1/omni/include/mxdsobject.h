@@ -4,6 +4,7 @@
 #include "decomp.h"
 #include "mxatom.h"
 #include "mxcore.h"
+#include "mxobjectidindex.h"
 #include "mxutilitylist.h"
 
 class MxDSFile;
@@ -23,6 +24,22 @@ class MxDSObjectList : public MxUtilityList<MxDSObject*> {
 	MxDSObject* FindInternal(MxDSObject* p_action, MxBool p_delete);
 };
 
+// MxDSObjectList with an object id index, for the in-flight action lists of MxStreamController.
+// Only PushBack, PopFront and FindAndErase may add or remove objects.
+class MxIndexedDSObjectList : public MxDSObjectList {
+public:
+	MxDSObject* FindAndErase(MxDSObject* p_action) { return FindInternal(p_action, TRUE); }
+	MxDSObject* Find(MxDSObject* p_action) { return FindInternal(p_action, FALSE); }
+
+	void PushBack(MxDSObject* p_object);
+	MxBool PopFront(MxDSObject*& p_object);
+
+private:
+	MxDSObject* FindInternal(MxDSObject* p_action, MxBool p_delete);
+
+	MxObjectIdIndex<MxDSObject*> m_index;
+};
+
 // VTABLE: LEGO1 0x100dc868
 // VTABLE: BETA10 0x101c23f0
 // SIZE 0x2c
@@ -7,7 +7,7 @@
 
 // VTABLE: LEGO1 0x100dcfc8
 // VTABLE: BETA10 0x101c29d0
-// SIZE 0xb0
+// SIZE 0xd0
 class MxDSSelectAction : public MxDSParallelAction {
 public:
 	MxDSSelectAction();
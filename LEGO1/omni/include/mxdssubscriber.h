@@ -3,6 +3,7 @@
 
 #include "decomp.h"
 #include "mxcore.h"
+#include "mxobjectidindex.h"
 #include "mxstreamchunklist.h"
 #include "mxutilitylist.h"
 
@@ -14,6 +15,15 @@ class MxStreamController;
 class MxDSSubscriberList : public MxUtilityList<MxDSSubscriber*> {
 public:
 	MxDSSubscriber* Find(MxDSObject* p_object);
+	MxDSSubscriber* Find(MxU32 p_objectId, MxS16 p_unk0x48);
+
+	// Subscribers must be added and removed through these, so the index stays in sync
+	void PushBack(MxDSSubscriber* p_subscriber);
+	MxBool PopFront(MxDSSubscriber*& p_subscriber);
+	void Remove(MxDSSubscriber* p_subscriber);
+
+private:
+	MxObjectIdIndex<MxDSSubscriber*> m_index;
 };
 
 // VTABLE: LEGO1 0x100dc698
@@ -43,6 +53,7 @@ class MxDSSubscriber : public MxCore {
 	MxResult AddData(MxStreamChunk* p_chunk, MxBool p_append);
 	MxStreamChunk* PopData();
 	MxStreamChunk* PeekData();
+	MxStreamChunk* PeekData(MxU32 p_index);
 	void FreeDataChunk(MxStreamChunk* p_chunk);
 
 	// FUNCTION: BETA10 0x101354f0
@@ -0,0 +1,51 @@
+#ifndef MXFRAMETIMINGS_H
+#define MXFRAMETIMINGS_H
+
+#include "lego1_export.h"
+#include "mxtypes.h"
+
+#include <SDL2/SDL_stdinc.h>
+
+// Main-thread time per frame, split by engine section. Collection is off unless a client
+// such as the timedemo enables it. Sections nest: e_video includes e_render3d and e_present.
+class MxFrameTimings {
+public:
+	enum Section {
+		e_tickle,
+		e_streaming,
+		e_video,
+		e_render3d,
+		e_present,
+		e_numSections
+	};
+
+	LEGO1_EXPORT static void SetEnabled(MxBool p_enabled);
+	LEGO1_EXPORT static void Reset();
+	LEGO1_EXPORT static double GetMilliseconds(Section p_section);
+
+	// Returns 0 while disabled, in which case End must not be called
+	static Uint64 Begin();
+	static void End(Section p_section, Uint64 p_start);
+};
+
+class MxFrameTimingScope {
+public:
+	MxFrameTimingScope(MxFrameTimings::Section p_section)
+	{
+		m_section = p_section;
+		m_start = MxFrameTimings::Begin();
+	}
+
+	~MxFrameTimingScope()
+	{
+		if (m_start) {
+			MxFrameTimings::End(m_section, m_start);
+		}
+	}
+
+private:
+	MxFrameTimings::Section m_section;
+	Uint64 m_start;
+};
+
+#endif // MXFRAMETIMINGS_H
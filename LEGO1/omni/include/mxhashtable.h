@@ -5,46 +5,34 @@
 #include "mxcore.h"
 #include "mxtypes.h"
 
+#include <string.h>
+
 #define HASH_TABLE_INIT_SIZE 128
 
 template <class T>
 class MxHashTableCursor;
 
+// Open-addressing slot. m_distance is the probe distance from the home slot plus one,
+// so zero marks an empty slot. The hash is kept next to the object so probing and
+// growing never call Hash again.
 template <class T>
 class MxHashTableNode {
 public:
-	MxHashTableNode(T p_obj, MxU32 p_hash, MxHashTableNode* p_prev, MxHashTableNode* p_next)
-	{
-		m_obj = p_obj;
-		m_hash = p_hash;
-		m_prev = p_prev;
-		m_next = p_next;
-	}
-
-	// DECOMP: Should use getter and setter methods here per the style guide.
-	// However, LEGO1D (with no functions inlined) does not use them.
 	T m_obj;
 	MxU32 m_hash;
-	MxHashTableNode* m_prev;
-	MxHashTableNode* m_next;
+	MxU32 m_distance;
 };
 
+// Robin Hood hash table with linear probing. The slot count is a power of two and
+// doubles once the table is three quarters full.
 template <class T>
 class MxHashTable : protected MxCollection<T> {
 public:
-	enum Option {
-		e_noExpand = 0,
-		e_expandAll,
-		e_expandMultiply,
-	};
-
 	MxHashTable()
 	{
 		m_numSlots = HASH_TABLE_INIT_SIZE;
-		MxU32 unused = 0;
-		m_slots = new MxHashTableNode<T>*[m_numSlots];
-		memset(m_slots, 0, sizeof(MxHashTableNode<T>*) * m_numSlots);
-		m_resizeOption = e_noExpand;
+		m_slots = new MxHashTableNode<T>[m_numSlots];
+		memset(m_slots, 0, sizeof(MxHashTableNode<T>) * m_numSlots);
 	}
 
 	~MxHashTable() override;
@@ -58,19 +46,34 @@ class MxHashTable : protected MxCollection<T> {
 	friend class MxHashTableCursor<T>;
 
 protected:
-	void NodeInsert(MxHashTableNode<T>*);
-
-	MxHashTableNode<T>** m_slots; // 0x10
-	MxU32 m_numSlots;             // 0x14
-	MxU32 m_autoResizeRatio;      // 0x18
-	Option m_resizeOption;        // 0x1c
-	// FIXME: or FIXME? This qword is used as an integer or double depending
-	// on the value of m_resizeOption. Hard to say whether this is how the devs
-	// did it, but a simple cast in either direction doesn't match.
-	union {
-		MxU32 m_increaseAmount;  // 0x20
-		double m_increaseFactor; // 0x20
-	};
+	void NodeInsert(T p_obj, MxU32 p_hash);
+	void NodeDelete(MxS32 p_slot);
+
+	// Returns the slot of the first object with hash p_hash that p_match accepts, or -1
+	template <class Match>
+	MxS32 FindSlot(MxU32 p_hash, Match p_match)
+	{
+		MxU32 mask = m_numSlots - 1;
+		MxU32 slot = p_hash & mask;
+
+		for (MxU32 distance = 1;; distance++) {
+			MxHashTableNode<T>& node = m_slots[slot];
+
+			// Robin Hood order: once a slot is closer to home than we are, the object is absent
+			if (node.m_distance < distance) {
+				return -1;
+			}
+
+			if (node.m_hash == p_hash && p_match(node.m_obj)) {
+				return slot;
+			}
+
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	MxHashTableNode<T>* m_slots; // 0x10
+	MxU32 m_numSlots;            // 0x14
 };
 
 template <class T>
@@ -79,63 +82,50 @@ class MxHashTableCursor : public MxCore {
 	MxHashTableCursor(MxHashTable<T>* p_table)
 	{
 		m_table = p_table;
-		m_match = NULL;
+		m_match = -1;
 	}
 
 	MxBool Find(T p_obj);
 	MxBool Current(T& p_obj);
 	void DeleteMatch();
 
+	// Looks up an object by a key other than T. p_hash must equal what Hash returns for
+	// the object, and p_match tells whether a candidate is the one wanted.
+	template <class Match>
+	MxBool Find(MxU32 p_hash, Match p_match)
+	{
+		m_match = m_table->FindSlot(p_hash, p_match);
+		return m_match != -1;
+	}
+
 private:
 	MxHashTable<T>* m_table;
-	MxHashTableNode<T>* m_match;
+	MxS32 m_match;
 };
 
 template <class T>
 MxBool MxHashTableCursor<T>::Find(T p_obj)
 {
-	MxU32 hash = m_table->Hash(p_obj);
-
-	for (MxHashTableNode<T>* t = m_table->m_slots[hash % m_table->m_numSlots]; t; t = t->m_next) {
-		if (t->m_hash == hash && !m_table->Compare(t->m_obj, p_obj)) {
-			m_match = t;
-		}
-	}
-
-	return m_match != NULL;
+	MxHashTable<T>* table = m_table;
+	return Find(table->Hash(p_obj), [table, p_obj](T p_candidate) { return !table->Compare(p_candidate, p_obj); });
 }
 
 template <class T>
 MxBool MxHashTableCursor<T>::Current(T& p_obj)
 {
-	if (m_match) {
-		p_obj = m_match->m_obj;
+	if (m_match != -1) {
+		p_obj = m_table->m_slots[m_match].m_obj;
 	}
 
-	return m_match != NULL;
+	return m_match != -1;
 }
 
 template <class T>
 void MxHashTableCursor<T>::DeleteMatch()
 {
-	// Cut the matching node out of the linked list
-	// by updating pointer references.
-	if (m_match) {
-		if (m_match->m_prev) {
-			m_match->m_prev->m_next = m_match->m_next;
-		}
-		else {
-			// No "prev" node, so move "next" to the head of the list.
-			m_table->m_slots[m_match->m_hash % m_table->m_numSlots] = m_match->m_next;
-		}
-
-		if (m_match->m_next) {
-			m_match->m_next->m_prev = m_match->m_prev;
-		}
-
-		m_table->m_customDestructor(m_match->m_obj);
-		delete m_match;
-		m_table->m_count--;
+	if (m_match != -1) {
+		m_table->NodeDelete(m_match);
+		m_match = -1;
 	}
 }
 
@@ -149,46 +139,30 @@ MxHashTable<T>::~MxHashTable()
 template <class T>
 void MxHashTable<T>::DeleteAll()
 {
-	for (MxS32 i = 0; i < m_numSlots; i++) {
-		MxHashTableNode<T>* next;
-		for (MxHashTableNode<T>* t = m_slots[i]; t != NULL; t = next) {
-			next = t->m_next;
-			this->m_customDestructor(t->m_obj);
-			delete t;
+	for (MxU32 i = 0; i < m_numSlots; i++) {
+		if (m_slots[i].m_distance) {
+			this->m_customDestructor(m_slots[i].m_obj);
 		}
 	}
 
 	this->m_count = 0;
-	memset(m_slots, 0, sizeof(MxHashTableNode<T>*) * m_numSlots);
+	memset(m_slots, 0, sizeof(MxHashTableNode<T>) * m_numSlots);
 }
 
 template <class T>
 inline void MxHashTable<T>::Resize()
 {
-	// Save a reference to the current table
-	// so we can walk nodes and re-insert
 	MxU32 oldSize = m_numSlots;
-	MxHashTableNode<T>** oldTable = m_slots;
-
-	switch (m_resizeOption) {
-	case e_expandAll:
-		m_numSlots += m_increaseAmount;
-		break;
-	case e_expandMultiply:
-		m_numSlots *= m_increaseFactor;
-		break;
-	}
+	MxHashTableNode<T>* oldTable = m_slots;
 
-	MxU32 unused = 0;
-	m_slots = new MxHashTableNode<T>*[m_numSlots];
-	memset(m_slots, 0, sizeof(MxHashTableNode<T>*) * m_numSlots);
+	m_numSlots *= 2;
+	m_slots = new MxHashTableNode<T>[m_numSlots];
+	memset(m_slots, 0, sizeof(MxHashTableNode<T>) * m_numSlots);
 	this->m_count = 0;
 
-	for (MxS32 i = 0; i < oldSize; i++) {
-		MxHashTableNode<T>* next;
-		for (MxHashTableNode<T>* t = oldTable[i]; t != NULL; t = next) {
-			next = t->m_next;
-			NodeInsert(t);
+	for (MxU32 i = 0; i < oldSize; i++) {
+		if (oldTable[i].m_distance) {
+			NodeInsert(oldTable[i].m_obj, oldTable[i].m_hash);
 		}
 	}
 
@@ -196,33 +170,73 @@ inline void MxHashTable<T>::Resize()
 }
 
 template <class T>
-inline void MxHashTable<T>::NodeInsert(MxHashTableNode<T>* p_node)
+inline void MxHashTable<T>::NodeInsert(T p_obj, MxU32 p_hash)
 {
-	MxS32 bucket = p_node->m_hash % m_numSlots;
+	MxU32 mask = m_numSlots - 1;
+	MxU32 slot = p_hash & mask;
+	MxU32 distance = 1;
+
+	for (;;) {
+		MxHashTableNode<T>& node = m_slots[slot];
+
+		if (!node.m_distance) {
+			node.m_obj = p_obj;
+			node.m_hash = p_hash;
+			node.m_distance = distance;
+			break;
+		}
 
-	p_node->m_next = m_slots[bucket];
+		// Take the slot from an object that is closer to its home and carry that one on
+		if (node.m_distance < distance) {
+			T obj = node.m_obj;
+			MxU32 hash = node.m_hash;
+			MxU32 nodeDistance = node.m_distance;
 
-	if (m_slots[bucket]) {
-		m_slots[bucket]->m_prev = p_node;
+			node.m_obj = p_obj;
+			node.m_hash = p_hash;
+			node.m_distance = distance;
+
+			p_obj = obj;
+			p_hash = hash;
+			distance = nodeDistance;
+		}
+
+		slot = (slot + 1) & mask;
+		distance++;
 	}
 
-	m_slots[bucket] = p_node;
 	this->m_count++;
 }
 
 template <class T>
-inline void MxHashTable<T>::Add(T p_newobj)
+inline void MxHashTable<T>::NodeDelete(MxS32 p_slot)
 {
-	if (m_resizeOption && ((this->m_count + 1) / m_numSlots) > m_autoResizeRatio) {
-		MxHashTable<T>::Resize();
+	MxU32 mask = m_numSlots - 1;
+	MxU32 slot = p_slot;
+	MxU32 next = (slot + 1) & mask;
+
+	this->m_customDestructor(m_slots[slot].m_obj);
+
+	// Shift the following run back by one, so no tombstone is needed
+	while (m_slots[next].m_distance > 1) {
+		m_slots[slot] = m_slots[next];
+		m_slots[slot].m_distance--;
+		slot = next;
+		next = (next + 1) & mask;
 	}
 
-	MxU32 hash = Hash(p_newobj);
-	MxU32 unused = 0;
+	m_slots[slot].m_distance = 0;
+	this->m_count--;
+}
 
-	MxHashTableNode<T>* node = new MxHashTableNode<T>(p_newobj, hash, NULL, NULL);
+template <class T>
+inline void MxHashTable<T>::Add(T p_newobj)
+{
+	if ((this->m_count + 1) * 4 > m_numSlots * 3) {
+		MxHashTable<T>::Resize();
+	}
 
-	MxHashTable<T>::NodeInsert(node);
+	MxHashTable<T>::NodeInsert(p_newobj, Hash(p_newobj));
 }
 
 #undef HASH_TABLE_INIT_SIZE
@@ -0,0 +1,55 @@
+#ifndef MXJOBPOOL_H
+#define MXJOBPOOL_H
+
+#include "mxcriticalsection.h"
+#include "mxsemaphore.h"
+#include "mxstl/stlcompat.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+typedef void (*MxJobFunction)(void* p_data);
+
+// Runs batches of independent jobs on a fixed set of worker threads.
+// The calling thread takes part in each batch, so a pool without workers
+// (or one whose threads could not be started) still runs every job.
+class MxJobPool {
+public:
+	MxJobPool();
+	~MxJobPool();
+
+	MxResult Create(MxS32 p_workerCount);
+	void Destroy();
+
+	void AddJob(MxJobFunction p_function, void* p_data);
+	void RunJobs();
+
+	MxS32 GetWorkerCount() { return m_workers.size(); }
+
+private:
+	class Worker : public MxThread {
+	public:
+		Worker(MxJobPool* p_pool) : m_pool(p_pool) {}
+
+		MxResult Run() override;
+
+	private:
+		MxJobPool* m_pool;
+	};
+
+	struct Job {
+		MxJobFunction m_function;
+		void* m_data;
+	};
+
+	void RunQueuedJobs();
+
+	vector<Worker*> m_workers;
+	vector<Job> m_jobs;
+	MxU32 m_nextJob;
+	MxBool m_shutdown;
+	MxCriticalSection m_criticalSection;
+	MxSemaphore m_startSemaphore;
+	MxSemaphore m_doneSemaphore;
+};
+
+#endif // MXJOBPOOL_H
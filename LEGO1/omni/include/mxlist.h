@@ -3,6 +3,7 @@
 
 #include "mxcollection.h"
 #include "mxcore.h"
+#include "mxlistpool.h"
 #include "mxtypes.h"
 
 #include <type_traits>
@@ -12,6 +13,15 @@ class MxList;
 template <class T>
 class MxListCursor;
 
+// Specialize with value TRUE, before the list type is first used, to have the entries of
+// lists of T allocated from MxListNodePool. Worth it only for lists that churn every frame.
+template <class T>
+struct MxListPooled {
+	enum {
+		value = FALSE
+	};
+};
+
 template <class T>
 class MxListEntry {
 public:
@@ -37,6 +47,20 @@ class MxListEntry {
 	void SetNext(MxListEntry* p_next) { m_next = p_next; }
 	void SetPrev(MxListEntry* p_prev) { m_prev = p_prev; }
 
+	static void* operator new(size_t p_size)
+	{
+		return MxListPooled<T>::value ? MxListNodePool::Allocate(p_size) : ::operator new(p_size);
+	}
+	static void operator delete(void* p_entry, size_t p_size)
+	{
+		if (MxListPooled<T>::value) {
+			MxListNodePool::Free(p_entry, p_size);
+		}
+		else {
+			::operator delete(p_entry);
+		}
+	}
+
 private:
 	T m_obj;
 	MxListEntry* m_prev;
@@ -0,0 +1,34 @@
+#ifndef MXLISTPOOL_H
+#define MXLISTPOOL_H
+
+#include "lego1_export.h"
+#include "mxtypes.h"
+
+#include <stddef.h>
+
+// Free-list allocator for the entries of lists whose type opts in through MxListPooled, and for
+// MxStreamChunk. Nodes are carved from slabs per size class and recycled through a spin-locked
+// free list, so steady-state list and chunk churn never reaches the heap. Trim returns the slabs
+// of every size class without live nodes. Sizes above c_maxNodeSize fall back to operator new.
+class MxListNodePool {
+public:
+	enum {
+		c_maxNodeSize = 64,
+		c_slabNodes = 64
+	};
+
+	struct Stats {
+		MxU32 m_allocations; // total node allocations
+		MxU32 m_hits;        // allocations served from a free list
+		MxU32 m_slabs;       // slabs taken from the heap
+		MxU32 m_liveNodes;
+		MxU32 m_peakNodes;
+	};
+
+	LEGO1_EXPORT static void* Allocate(size_t p_size);
+	LEGO1_EXPORT static void Free(void* p_node, size_t p_size);
+	LEGO1_EXPORT static void GetStats(Stats& p_stats);
+	LEGO1_EXPORT static MxU32 Trim();
+};
+
+#endif // MXLISTPOOL_H
@@ -0,0 +1,67 @@
+#ifndef MXOBJECTIDINDEX_H
+#define MXOBJECTIDINDEX_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+// Buckets the entries of a list by object id. Lists only grow at the back, so each bucket
+// stays in list order and a scan of one bucket returns the same first match as a scan of
+// the whole list. Callers still apply any further criteria (such as the instance value).
+template <class T>
+class MxObjectIdIndex {
+public:
+	typedef typename list<T>::iterator Entry;
+	typedef vector<Entry> Bucket;
+
+	void Add(MxU32 p_id, Entry p_entry) { m_buckets[p_id].push_back(p_entry); }
+
+	void Remove(MxU32 p_id, Entry p_entry)
+	{
+		if (!RemoveFrom(m_buckets.find(p_id), p_entry)) {
+			// The object id changed while the entry was listed
+			for (typename Buckets::iterator it = m_buckets.begin(); it != m_buckets.end(); it++) {
+				if (RemoveFrom(it, p_entry)) {
+					break;
+				}
+			}
+		}
+	}
+
+	void Clear() { m_buckets.clear(); }
+
+	Bucket* Find(MxU32 p_id)
+	{
+		typename Buckets::iterator it = m_buckets.find(p_id);
+		return it != m_buckets.end() ? &it->second : NULL;
+	}
+
+private:
+	typedef unordered_map<MxU32, Bucket> Buckets;
+
+	MxBool RemoveFrom(typename Buckets::iterator p_bucket, Entry p_entry)
+	{
+		if (p_bucket == m_buckets.end()) {
+			return FALSE;
+		}
+
+		Bucket& bucket = p_bucket->second;
+
+		for (typename Bucket::iterator it = bucket.begin(); it != bucket.end(); it++) {
+			if (*it == p_entry) {
+				bucket.erase(it);
+
+				if (bucket.empty()) {
+					m_buckets.erase(p_bucket);
+				}
+
+				return TRUE;
+			}
+		}
+
+		return FALSE;
+	}
+
+	Buckets m_buckets;
+};
+
+#endif // MXOBJECTIDINDEX_H
@@ -4,6 +4,7 @@
 #include "lego1_export.h"
 #include "mxcore.h"
 #include "mxcriticalsection.h"
+#include "mxpathindex.h"
 #include "mxstl/stlcompat.h"
 #include "mxstring.h"
 
@@ -32,7 +33,7 @@ class MxVariableTable;
 class MxVideoManager;
 
 // VTABLE: LEGO1 0x100dc168
-// SIZE 0x68
+// SIZE 0x88
 class MxOmni : public MxCore {
 public:
 	LEGO1_EXPORT static void DestroyInstance();
@@ -45,6 +46,8 @@ class MxOmni : public MxCore {
 	LEGO1_EXPORT static void SetSound3D(MxBool p_use3dSound);
 	static const vector<MxString>& GetHDFiles() { return g_hdFiles; }
 	static const vector<MxString>& GetCDFiles() { return g_cdFiles; }
+	static const MxPathIndex& GetHDIndex() { return g_hdIndex; }
+	static const MxPathIndex& GetCDIndex() { return g_cdIndex; }
 
 	MxOmni();
 	~MxOmni() override;
@@ -109,6 +112,8 @@ class MxOmni : public MxCore {
 	static MxOmni* g_instance;
 	static vector<MxString> g_hdFiles;
 	static vector<MxString> g_cdFiles;
+	static MxPathIndex g_hdIndex;
+	static MxPathIndex g_cdIndex;
 
 	static vector<MxString> GlobIsleFiles(const MxString& p_path);
 
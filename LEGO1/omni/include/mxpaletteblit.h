@@ -0,0 +1,27 @@
+#ifndef MXPALETTEBLIT_H
+#define MXPALETTEBLIT_H
+
+#include "mxtypes.h"
+
+// Row kernels used by MxDisplaySurface to copy 8-bit bitmaps and expand them through a palette.
+// Source index 0 is the transparent color. Every SIMD path produces exactly the pixels of the
+// scalar fallback. 16-bit palettes hold PALETTE16_SIZE entries; the last one is padding that
+// lets the vector lookups read whole 32-bit words.
+
+#define PALETTE16_SIZE 257
+
+void CopyRowTransparent8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count);
+void CopyRowDoubled8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count);
+
+void ExpandRow16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette);
+void ExpandRowTransparent16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette);
+void ExpandRowDoubled16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette);
+
+void ExpandRow32(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette);
+void ExpandRowTransparent32(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette);
+void ExpandRowDoubled32(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette);
+
+// Converts 16-bit pixels through one table for their low byte and one for their high byte
+void ConvertRow16To32(MxU32* p_dest, const MxU16* p_src, MxS32 p_count, const MxU32* p_low, const MxU32* p_high);
+
+#endif // MXPALETTEBLIT_H
@@ -0,0 +1,30 @@
+#ifndef MXPATHINDEX_H
+#define MXPATHINDEX_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+#include <stddef.h>
+
+class MxString;
+
+// Case-insensitive suffix index over a list of file names, used by MxString::MapPathToFilesystem.
+// Names are inserted reversed into a trie, so every name that is a suffix of a path is found
+// in a single backwards walk over the path. When several names match, the one that appears
+// first in the list wins, as with a linear scan.
+class MxPathIndex {
+public:
+	MxPathIndex() { Clear(); }
+
+	void Build(const vector<MxString>& p_files);
+	void Clear();
+	MxS32 Find(const char* p_path, size_t p_length) const;
+
+private:
+	static MxU64 EdgeKey(MxU32 p_node, char p_char);
+
+	vector<MxS32> m_files;               // per node: first name ending here, or -1
+	unordered_map<MxU64, MxU32> m_edges; // (node, folded char) -> child node
+};
+
+#endif // MXPATHINDEX_H
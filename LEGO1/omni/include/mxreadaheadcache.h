@@ -0,0 +1,44 @@
+#ifndef MXREADAHEADCACHE_H
+#define MXREADAHEADCACHE_H
+
+#include "mxstl/stlcompat.h"
+#include "mxtypes.h"
+
+class MxDSBuffer;
+class MxDSSource;
+
+// Buffers of a stream source read ahead of the requests for them, most recently used first, up
+// to a byte limit. Used by MxDiskStreamProvider from its thread only, so it needs no lock.
+class MxReadAheadCache {
+public:
+	// Returns TRUE when a speculative read should give way to a request
+	typedef MxBool (*AbortCallback)(void* p_data);
+
+	enum {
+		c_sliceSize = 0x8000
+	};
+
+	MxReadAheadCache() : m_size(0) {}
+	~MxReadAheadCache() { Clear(); }
+
+	static MxBool ReadFromFile(MxDSSource* p_source, MxDSBuffer* p_buffer, MxU32 p_offset);
+	MxBool ReadFromCache(MxDSBuffer* p_buffer, MxU32 p_offset);
+	MxBool ReadAhead(
+		MxDSSource* p_source,
+		MxU32 p_offset,
+		MxU32 p_size,
+		MxU32 p_limit,
+		AbortCallback p_abort,
+		void* p_data
+	);
+	void Clear();
+
+	MxU32 GetSize() const { return m_size; }
+	MxU32 GetCount() const { return m_buffers.size(); }
+
+private:
+	list<MxDSBuffer*> m_buffers;
+	MxU32 m_size;
+};
+
+#endif // MXREADAHEADCACHE_H
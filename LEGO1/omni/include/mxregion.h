@@ -34,6 +34,14 @@ class MxSegment {
 	MxBool operator!=(MxSegment& p_seg) { return !operator==(p_seg); }
 };
 
+// Regions are rebuilt from spans and segments for every invalidated rect
+template <>
+struct MxListPooled<MxSegment*> {
+	enum {
+		value = TRUE
+	};
+};
+
 // VTABLE: LEGO1 0x100dcc40
 // VTABLE: BETA10 0x101c2628
 // class MxCollection<MxSegment *>
@@ -117,6 +125,13 @@ class MxSpan {
 	// MxSpan::`scalar deleting destructor'
 };
 
+template <>
+struct MxListPooled<MxSpan*> {
+	enum {
+		value = TRUE
+	};
+};
+
 // VTABLE: LEGO1 0x100dcb10
 // VTABLE: BETA10 0x101c24f8
 // class MxCollection<MxSpan *>
@@ -8,13 +8,17 @@
 #include <smacker.h>
 
 struct MxBITMAPINFO;
+class MxSmkDecoder;
 
 // SIZE 0x6b8
 struct MxSmk {
 	smk m_smk;
+	MxSmkDecoder* m_decoder; // decodes frames ahead of LoadFrame, or NULL
 
 	static MxResult LoadHeader(MxU8* p_data, MxU32 p_length, MxSmk* p_mxSmk);
 	static void Destroy(MxSmk* p_mxSmk);
+	static MxResult CreateDecoder(MxSmk* p_mxSmk);
+	static MxBool DecodeFrame(smk p_smk, MxU8* p_chunkData, MxU32 p_currentFrame);
 	static MxResult LoadFrame(
 		MxBITMAPINFO* p_bitmapInfo,
 		MxU8* p_bitmapData,
@@ -24,6 +28,17 @@ struct MxSmk {
 		MxU32 p_currentFrame,
 		MxRect32List* p_list
 	);
+
+private:
+	static void CopyChangedBlocks(MxU8* p_dest, const MxU8* p_src, MxS32 p_width, MxS32 p_height, MxRect32List* p_list);
+	static MxBool BlockChanged(
+		const MxU8* p_dest,
+		const MxU8* p_src,
+		MxS32 p_width,
+		MxS32 p_left,
+		MxS32 p_top,
+		MxS32 p_rows
+	);
 };
 
 #endif // MXSMK_H
@@ -0,0 +1,77 @@
+#ifndef MXSMKDECODER_H
+#define MXSMKDECODER_H
+
+#include "lego1_export.h"
+#include "mxsemaphore.h"
+#include "mxstl/stlcompat.h"
+#include "mxthread.h"
+#include "mxtypes.h"
+
+#include <SDL2/SDL_atomic.h>
+
+// Frames decoded ahead, at most
+#define MXSMK_RING_SIZE 4
+
+// A queued Smacker frame. The chunk is copied, so the stream may free its own before the frame is decoded.
+struct MxSmkFrame {
+	const MxU8* m_source;   // chunk data the frame was queued from, only compared
+	MxU32 m_frame;          // index within the stream
+	MxU8* m_chunk;          // copy of the compressed chunk
+	MxU32 m_chunkCapacity;  // bytes allocated at m_chunk
+	MxU8* m_video;          // decoded frame, one byte per pixel
+	MxU8 m_palette[256 * 3];
+	MxBool m_paletteChanged;
+};
+
+// A frame taken from the ring, kept to bring the decoder state back to it
+struct MxSmkTakenFrame {
+	MxU8* m_chunk;
+	MxU32 m_frame;
+};
+
+// Decodes Smacker frames on a worker thread into a ring of frame buffers, ahead of the presenter.
+// Frames are queued in stream order as soon as their chunks arrive, and taken with Wait and
+// Release in the same order. Decoding depends on the previous frame, so once frames are queued
+// the subclass' decoder state belongs to the worker until they are taken or flushed. If the
+// caller asks for a frame other than the next queued one, the state is rewound to the last frame
+// taken and decoding ahead stops for good.
+class MxSmkDecoder : public MxThread {
+public:
+	MxSmkDecoder();
+	~MxSmkDecoder() override;
+
+	MxResult Run() override;
+
+	MxResult Create(MxU32 p_videoSize);
+	void Stop();
+	MxBool Queue(const MxU8* p_chunk, MxU32 p_length, MxU32 p_frame);
+	MxSmkFrame* Wait(const MxU8* p_chunk, MxU32 p_frame);
+	void Release();
+	void Flush();
+
+	MxU32 GetQueued() { return m_count; }
+
+	LEGO1_EXPORT static void SetDecodeAhead(MxBool p_decodeAhead);
+	static MxBool GetDecodeAhead();
+
+protected:
+	// Called on the worker thread, one frame at a time in queue order, and on the caller's to
+	// replay the frames taken once the worker is stopped. Frame 0 starts the stream over.
+	// Subclasses must call Stop in their destructor.
+	virtual void Decode(MxSmkFrame& p_frame) = 0;
+
+private:
+	void Rewind();
+	void ClearTaken();
+
+	MxSmkFrame m_frames[MXSMK_RING_SIZE];
+	MxU32 m_head;                 // next frame to take
+	MxU32 m_count;                // frames queued and not taken
+	MxU32 m_decodeIndex;          // next frame to decode, used by the worker only
+	SDL_atomic_t m_remainingWork; // cleared to stop the worker
+	MxSemaphore m_workSemaphore;  // released per queued frame
+	MxSemaphore m_readySemaphore; // released per decoded frame
+	vector<MxSmkTakenFrame> m_taken; // chunks of the frames taken since frame 0, in order
+};
+
+#endif // MXSMKDECODER_H
@@ -46,6 +46,7 @@ class MxSmkPresenter : public MxVideoPresenter {
 private:
 	void Init();
 	void Destroy(MxBool p_fromDestructor);
+	void DecodeAhead(MxStreamChunk* p_chunk);
 
 protected:
 	MxSmk m_mxSmk;        // 0x64
@@ -3,6 +3,7 @@
 
 #include "decomp.h"
 #include "mxatom.h"
+#include "mxaudiolatency.h"
 #include "mxaudiomanager.h"
 #include "mxminiaudio.h"
 
@@ -27,6 +28,20 @@ class MxSoundManager : public MxAudioManager {
 	float GetAttenuation(MxU32 p_volume);
 
 	MxPresenter* FUN_100aebd0(const MxAtomId& p_atomId, MxU32 p_objectId);
+
+	LEGO1_EXPORT static void SetPeriodFrames(MxU32 p_periodFrames);
+
+	MxU32 GetPeriodFrames() { return m_periodFrames; }
+	MxU32 GetLateCallbacks() { return m_latency.GetLateCallbacks(); }
+	MxU32 GetUnderruns() { return m_latency.GetUnderruns(); }
+	float GetLatencyMS();
+	float GetMaxCallbackIntervalMS();
+
+	// The audio callback mixes under this lock, so sounds and their data sources must be
+	// created and destroyed under it too. It is separate from the manager's lock, which the
+	// tickle thread holds for a whole tickle, and must only be held for those short steps.
+	MxCriticalSection& GetMixLock() { return m_mixLock; }
+
 	SDL_AudioDeviceID m_device = 0;
 
 protected:
@@ -38,11 +53,15 @@ class MxSoundManager : public MxAudioManager {
 	// Not sure how DirectSound handles this when different buffers have different rates.
 	static const MxU32 g_sampleRate = 44100;
 
-	static void AudioStreamCallback();
+	static void AudioCallback(void* p_userdata, Uint8* p_stream, int p_len);
 
 	MxMiniaudio<ma_engine> m_engine;
 	SDL_AudioStream* m_stream;
 	undefined m_unk0x38[4];
+
+	MxU32 m_periodFrames;
+	MxAudioLatency m_latency;
+	MxCriticalSection m_mixLock;
 };
 
 // SYNTHETIC: LEGO1 0x100ae7b0
@@ -2,6 +2,7 @@
 #define MXSTREAMCHUNK_H
 
 #include "mxdschunk.h"
+#include "mxlistpool.h"
 
 class MxDSBuffer;
 class MxDSSubscriberList;
@@ -32,6 +33,11 @@ class MxStreamChunk : public MxDSChunk {
 
 	MxDSBuffer* GetBuffer() { return m_buffer; }
 
+	// A split chunk read from disk may still be in pieces in the buffers they were read into.
+	// GetData joins them on first use; consumers that copy the payload anyway use CopyData.
+	MxU8* GetData();
+	void CopyData(MxU8* p_dest);
+
 	MxResult ReadChunk(MxDSBuffer* p_buffer, MxU8* p_chunkData);
 	MxU32 ReadChunkHeader(MxU8* p_chunkData);
 	MxResult SendChunk(MxDSSubscriberList& p_subscriberList, MxBool p_append, MxS16 p_obj24val);
@@ -42,6 +48,9 @@ class MxStreamChunk : public MxDSChunk {
 	static MxLong* IntoTime(MxU8* p_buffer);
 	static MxU32* IntoLength(MxU8* p_buffer);
 
+	static void* operator new(size_t p_size) { return MxListNodePool::Allocate(p_size); }
+	static void operator delete(void* p_chunk, size_t p_size) { MxListNodePool::Free(p_chunk, p_size); }
+
 private:
 	MxDSBuffer* m_buffer; // 0x1c
 };
@@ -5,6 +5,14 @@
 #include "mxlist.h"
 #include "mxstreamchunk.h"
 
+// Chunks are queued and dropped for every frame of every stream
+template <>
+struct MxListPooled<MxStreamChunk*> {
+	enum {
+		value = TRUE
+	};
+};
+
 // VTABLE: LEGO1 0x100dc5d0
 // class MxCollection<MxStreamChunk *>
 
@@ -19,6 +19,15 @@ class MxNextActionDataStartList : public MxUtilityList<MxNextActionDataStart*> {
 public:
 	MxNextActionDataStart* Find(MxU32 p_id, MxS16 p_value);
 	MxNextActionDataStart* FindAndErase(MxU32 p_id, MxS16 p_value);
+
+	// Entries must be added and removed through these, so the index stays in sync
+	void PushBack(MxNextActionDataStart* p_data);
+	iterator erase(iterator p_it);
+
+private:
+	typedef MxObjectIdIndex<MxNextActionDataStart*>::Bucket Bucket;
+
+	MxObjectIdIndex<MxNextActionDataStart*> m_index;
 };
 
 // VTABLE: LEGO1 0x100dc968
@@ -72,8 +81,8 @@ class MxStreamController : public MxCore {
 
 	MxAtomId& GetAtom() { return m_atom; }
 	MxStreamProvider* GetProvider() { return m_provider; }
-	MxDSObjectList& GetUnk0x3c() { return m_unk0x3c; }
-	MxDSObjectList& GetUnk0x54() { return m_unk0x54; }
+	MxIndexedDSObjectList& GetUnk0x3c() { return m_unk0x3c; }
+	MxIndexedDSObjectList& GetUnk0x54() { return m_unk0x54; }
 	MxDSSubscriberList& GetSubscriberList() { return m_subscribers; }
 
 protected:
@@ -82,9 +91,9 @@ class MxStreamController : public MxCore {
 	MxStreamProvider* m_provider;               // 0x28
 	undefined4* m_unk0x2c;                      // 0x2c
 	MxDSSubscriberList m_subscribers;           // 0x30
-	MxDSObjectList m_unk0x3c;                   // 0x3c
+	MxIndexedDSObjectList m_unk0x3c;            // 0x3c
 	MxNextActionDataStartList m_nextActionList; // 0x48
-	MxDSObjectList m_unk0x54;                   // 0x54
+	MxIndexedDSObjectList m_unk0x54;            // 0x54
 	MxDSAction* m_action0x60;                   // 0x60
 };
 
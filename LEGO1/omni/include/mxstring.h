@@ -6,7 +6,7 @@
 
 // VTABLE: LEGO1 0x100dc110
 // VTABLE: BETA10 0x101c1be0
-// SIZE 0x10
+// SIZE 0x30
 class MxString : public MxCore {
 public:
 	MxString();
@@ -28,6 +28,7 @@ class MxString : public MxCore {
 
 	static void CharSwap(char* p_a, char* p_b);
 	static void MapPathToFilesystem(char* p_path);
+	LEGO1_EXPORT static MxU32 GetHeapAllocations();
 
 	// FUNCTION: BETA10 0x10017c50
 	char* GetData() const { return m_data; }
@@ -46,8 +47,17 @@ class MxString : public MxCore {
 	// MxString::`scalar deleting destructor'
 
 private:
-	char* m_data;   // 0x08
-	MxU16 m_length; // 0x0c
+	// Strings shorter than c_inlineSize are stored in m_inline and never touch the heap
+	enum {
+		c_inlineSize = 32
+	};
+
+	char* Reserve(MxU32 p_length);
+	void Assign(const char* p_str, MxU16 p_length);
+
+	char* m_data;                // 0x08
+	MxU16 m_length;              // 0x0c
+	char m_inline[c_inlineSize]; // 0x0e
 };
 
 #endif // MXSTRING_H
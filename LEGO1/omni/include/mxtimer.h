@@ -17,6 +17,11 @@ class MxTimer : public MxCore {
 	void Stop();
 
 	LEGO1_EXPORT MxLong GetRealTime();
+	LEGO1_EXPORT void SetFixedStep(MxLong p_step);
+
+	// Advances the fixed clock by one step. Only meaningful while a fixed step is set.
+	LEGO1_EXPORT static void Step();
+	LEGO1_EXPORT static MxLong GetFixedStep();
 
 	// FUNCTION: BETA10 0x1012bf50
 	void InitLastTimeCalculated() { g_lastTimeCalculated = m_startTime; }
@@ -43,6 +48,10 @@ class MxTimer : public MxCore {
 
 	static MxLong g_lastTimeCalculated;
 	static MxLong g_lastTimeTimerStarted;
+
+	// When g_fixedStep is set, time comes from g_fixedTicks instead of SDL_GetTicks
+	static Uint64 g_fixedTicks;
+	static MxLong g_fixedStep;
 };
 
 // SYNTHETIC: BETA10 0x1012bfc0
@@ -3,6 +3,7 @@
 
 #include "mxtypes.h"
 
+#include <SDL2/SDL_stdinc.h>
 #include <string.h>
 
 class MxDSFile;
@@ -59,6 +60,19 @@ inline void GetDouble(MxU8*& p_source, T& p_dest)
 	p_source += sizeof(double);
 }
 
+// Case-folded FNV-1a, for hash indices over names that are compared case-insensitively
+inline MxU32 HashStringNoCase(const char* p_string)
+{
+	MxU32 hash = 2166136261u;
+
+	while (*p_string) {
+		hash ^= (MxU8) SDL_tolower((MxU8) *p_string++);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
 template <class T>
 inline void GetString(MxU8*& p_source, char*& p_dest, T* p_obj, void (T::*p_setter)(const char*))
 {
@@ -6,7 +6,7 @@
 
 // VTABLE: LEGO1 0x100d7498
 // VTABLE: BETA10 0x101bc038
-// SIZE 0x24
+// SIZE 0x64
 class MxVariable {
 public:
 	MxVariable() {}
@@ -24,6 +24,10 @@ class MxVariableTable : public MxHashTable<MxVariable*> {
 	MxS8 Compare(MxVariable*, MxVariable*) override; // vtable+0x14
 	MxU32 Hash(MxVariable*) override;                // vtable+0x18
 
+private:
+	static MxU32 HashKey(const char* p_key);
+	static MxBool KeyEquals(MxVariable* p_var, const char* p_key);
+
 	// SYNTHETIC: LEGO1 0x100afdd0
 	// SYNTHETIC: BETA10 0x10130f20
 	// MxVariableTable::`scalar deleting destructor'
@@ -81,10 +85,6 @@ class MxVariableTable : public MxHashTable<MxVariable*> {
 // TEMPLATE: BETA10 0x1012adc0
 // MxHashTable<MxVariable *>::Resize
 
-// TEMPLATE: LEGO1 0x100b7b80
-// TEMPLATE: BETA10 0x1012af10
-// MxHashTable<MxVariable *>::NodeInsert
-
 // TEMPLATE: BETA10 0x1012a900
 // MxHashTableCursor<MxVariable *>::MxHashTableCursor<MxVariable *>
 
@@ -100,9 +100,6 @@ class MxVariableTable : public MxHashTable<MxVariable*> {
 // TEMPLATE: BETA10 0x1012ad00
 // MxHashTableCursor<MxVariable *>::Find
 
-// TEMPLATE: BETA10 0x1012af90
-// MxHashTableNode<MxVariable *>::MxHashTableNode<MxVariable *>
-
 // TEMPLATE: BETA10 0x10132890
 // MxHashTable<MxVariable *>::MxHashTable<MxVariable *>
 
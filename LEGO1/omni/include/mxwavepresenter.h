@@ -75,7 +75,7 @@ class MxWavePresenter : public MxSoundPresenter {
 protected:
 	void Init();
 	void Destroy(MxBool p_fromDestructor);
-	MxBool WriteToSoundBuffer(void* p_audioPtr, MxU32 p_length);
+	MxBool WriteToSoundBuffer(MxStreamChunk* p_chunk);
 
 	// [library:audio] One chunk has up to 1 second worth of frames
 	static const MxU32 g_millisecondsPerChunk = 1000;
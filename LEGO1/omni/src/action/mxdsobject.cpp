@@ -205,6 +205,69 @@ MxDSObject* MxDSObjectList::FindInternal(MxDSObject* p_action, MxBool p_delete)
 	return found;
 }
 
+void MxIndexedDSObjectList::PushBack(MxDSObject* p_object)
+{
+	m_index.Add(p_object->GetObjectId(), insert(end(), p_object));
+}
+
+MxBool MxIndexedDSObjectList::PopFront(MxDSObject*& p_object)
+{
+	if (empty()) {
+		return FALSE;
+	}
+
+	p_object = front();
+	m_index.Remove(p_object->GetObjectId(), begin());
+	pop_front();
+	return TRUE;
+}
+
+// Same matching rules as MxDSObjectList::FindInternal, but only the bucket of the requested
+// object id is scanned. An object id of -1 still matches any object and walks the whole list.
+MxDSObject* MxIndexedDSObjectList::FindInternal(MxDSObject* p_action, MxBool p_delete)
+{
+	MxS16 unk0x24 = p_action->GetUnknown24();
+	iterator found = end();
+
+	if (p_action->GetObjectId() == -1) {
+		for (iterator it = begin(); it != end(); it++) {
+			if (unk0x24 == -2 || unk0x24 == -3 || unk0x24 == (*it)->GetUnknown24()) {
+				found = it;
+				if (unk0x24 != -3) {
+					break;
+				}
+			}
+		}
+	}
+	else {
+		MxObjectIdIndex<MxDSObject*>::Bucket* bucket = m_index.Find(p_action->GetObjectId());
+
+		if (bucket) {
+			for (MxObjectIdIndex<MxDSObject*>::Bucket::iterator it = bucket->begin(); it != bucket->end(); it++) {
+				if (unk0x24 == -2 || unk0x24 == -3 || unk0x24 == (**it)->GetUnknown24()) {
+					found = *it;
+					if (unk0x24 != -3) {
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	if (found == end()) {
+		return NULL;
+	}
+
+	MxDSObject* object = *found;
+
+	if (p_delete) {
+		m_index.Remove(object->GetObjectId(), found);
+		erase(found);
+	}
+
+	return object;
+}
+
 // FUNCTION: LEGO1 0x100bfb30
 // FUNCTION: BETA10 0x10147f35
 MxDSObject* DeserializeDSObjectDispatch(MxU8*& p_source, MxS16 p_flags)
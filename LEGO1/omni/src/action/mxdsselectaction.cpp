@@ -7,10 +7,10 @@
 
 #include <SDL2/SDL_stdinc.h>
 
-DECOMP_SIZE_ASSERT(MxDSSelectAction, 0xb0)
+DECOMP_SIZE_ASSERT(MxDSSelectAction, 0xd0)
 DECOMP_SIZE_ASSERT(MxStringList, 0x18)
 DECOMP_SIZE_ASSERT(MxStringListCursor, 0x10)
-DECOMP_SIZE_ASSERT(MxListEntry<MxString>, 0x18)
+DECOMP_SIZE_ASSERT(MxListEntry<MxString>, 0x38)
 
 // FUNCTION: LEGO1 0x100cb2b0
 // FUNCTION: BETA10 0x1015a515
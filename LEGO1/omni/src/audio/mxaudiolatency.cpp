@@ -0,0 +1,88 @@
+#include "mxaudiolatency.h"
+
+#include <SDL2/SDL_timer.h>
+
+// Seconds of audio per drift correction window
+#define WINDOW_SECONDS 10
+
+MxAudioLatency::MxAudioLatency()
+{
+	Reset(0);
+}
+
+void MxAudioLatency::Reset(MxU32 p_sampleRate)
+{
+	m_sampleRate = p_sampleRate;
+	m_start = 0;
+	m_framesMixed = 0;
+	m_lastCallback = 0;
+	m_windowEnd = 0;
+	m_windowMin = -1;
+	m_baseline = -1;
+	SDL_AtomicSet(&m_queuedFrames, 0);
+	SDL_AtomicSet(&m_lateCallbacks, 0);
+	SDL_AtomicSet(&m_underruns, 0);
+	SDL_AtomicSet(&m_maxIntervalUS, 0);
+}
+
+// Records a callback at p_now that mixed p_frames for the device
+void MxAudioLatency::Mixed(Uint64 p_now, MxU32 p_frames)
+{
+	Uint64 frequency = SDL_GetPerformanceFrequency();
+
+	if (m_lastCallback) {
+		Uint64 interval = p_now - m_lastCallback;
+		MxU32 intervalUS = (MxU32) (interval * 1000000 / frequency);
+
+		if (intervalUS > (MxU32) SDL_AtomicGet(&m_maxIntervalUS)) {
+			SDL_AtomicSet(&m_maxIntervalUS, intervalUS);
+		}
+
+		// The device drained more than one extra period before asking for more
+		if (interval * m_sampleRate > 2 * (Uint64) p_frames * frequency) {
+			SDL_AtomicAdd(&m_lateCallbacks, 1);
+		}
+	}
+
+	m_lastCallback = p_now;
+
+	Uint64 played = m_start ? (p_now - m_start) * m_sampleRate / frequency : 0;
+
+	// Everything mixed before was played and the device waited on us, so it restarts now
+	if (!m_start || played > m_framesMixed) {
+		if (m_start) {
+			SDL_AtomicAdd(&m_underruns, 1);
+		}
+
+		m_start = p_now;
+		m_framesMixed = 0;
+		m_windowEnd = (Uint64) m_sampleRate * WINDOW_SECONDS;
+		m_windowMin = -1;
+		m_baseline = -1;
+		played = 0;
+	}
+	else {
+		MxS64 queued = (MxS64) (m_framesMixed - played);
+
+		if (m_windowMin < 0 || queued < m_windowMin) {
+			m_windowMin = queued;
+		}
+
+		if (m_framesMixed >= m_windowEnd) {
+			if (m_baseline < 0) {
+				m_baseline = m_windowMin;
+			}
+			else {
+				// The device seemed fuller or emptier at its emptiest than in the first window:
+				// the clocks drifted apart
+				m_framesMixed += m_baseline - m_windowMin;
+			}
+
+			m_windowEnd += (Uint64) m_sampleRate * WINDOW_SECONDS;
+			m_windowMin = -1;
+		}
+	}
+
+	m_framesMixed += p_frames;
+	SDL_AtomicSet(&m_queuedFrames, (int) (m_framesMixed - played));
+}
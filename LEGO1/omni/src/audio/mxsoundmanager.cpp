@@ -8,10 +8,17 @@
 #include "mxticklemanager.h"
 #include "mxticklethread.h"
 #include "mxwavepresenter.h"
-#include <SDL_audio.h>
+#include "profiler.h"
+
+#include <SDL2/SDL_log.h>
+#include <SDL2/SDL_timer.h>
 
 DECOMP_SIZE_ASSERT(MxSoundManager, 0x3c);
 
+// Device buffer size in sample frames. Mixing happens on demand in the audio callback,
+// so this bounds the output latency: 1024 frames at 44.1KHz is about 23ms.
+MxU32 g_audioPeriodFrames = 1024;
+
 // GLOBAL LEGO1 0x10101420
 MxS32 g_volumeAttenuation[100] = {-6643, -5643, -5058, -4643, -4321, -4058, -3836, -3643, -3473, -3321, -3184, -3058,
 								  -2943, -2836, -2736, -2643, -2556, -2473, -2395, -2321, -2251, -2184, -2120, -2058,
@@ -40,6 +47,9 @@ void MxSoundManager::Init()
 {
 	SDL_zero(m_engine);
 	m_stream = NULL;
+	m_device = 0;
+	m_periodFrames = 0;
+	m_latency.Reset(g_sampleRate);
 }
 
 // FUNCTION: LEGO1 0x100ae840
@@ -53,13 +63,21 @@ void MxSoundManager::Destroy(MxBool p_fromDestructor)
 		TickleManager()->UnregisterClient(this);
 	}
 
+	// Closing the device waits for a running callback, so the engine is no longer read afterwards
+	if (m_device) {
+		SDL_CloseAudioDevice(m_device);
+	}
+
 	m_criticalSection.Enter();
 
 	if (m_stream) {
 		SDL_FreeAudioStream(m_stream);
 	}
 
+	// Sounds are created under the mix lock only, so the engine goes under it too
+	m_mixLock.Enter();
 	m_engine.Destroy(ma_engine_uninit);
+	m_mixLock.Leave();
 
 	Init();
 	m_criticalSection.Leave();
@@ -93,22 +111,28 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 		goto done;
 	}
 
-	SDL_AudioSpec spec;
+	SDL_AudioSpec spec, obtained;
 	SDL_zero(spec);
 	spec.freq = ma_engine_get_sample_rate(m_engine);
-	spec.format = AUDIO_F32; // SDL2 macro for 32-bit float
+	spec.format = AUDIO_F32SYS;
 	spec.channels = ma_engine_get_channels(m_engine);
-	spec.samples = 4096;
-	spec.callback = NULL; // NULL for push mode
+	spec.samples = 256;
+	spec.callback = AudioCallback;
+	spec.userdata = this;
 
-	m_device = SDL_OpenAudioDevice(NULL, 0, &spec, NULL, 0);
-	if (m_device == 0) {
-    	SDL_log("Failed to open audio device: %s", SDL_GetError());
-    	goto done;
+	// SDL expects a power of two here
+	while (spec.samples < g_audioPeriodFrames && spec.samples < 8192) {
+		spec.samples <<= 1;
 	}
 
-	SDL_PauseAudioDevice(m_device, 0); // Unpause (start) audio playback
+	m_device = SDL_OpenAudioDevice(NULL, 0, &spec, &obtained, SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+	if (m_device == 0) {
+		SDL_Log("Failed to open audio device: %s", SDL_GetError());
+		goto done;
+	}
 
+	m_periodFrames = obtained.samples;
+	SDL_PauseAudioDevice(m_device, 0);
 
 	if (p_createThread) {
 		m_thread = new MxTickleThread(this, p_frequencyMS);
@@ -134,26 +158,46 @@ MxResult MxSoundManager::Create(MxU32 p_frequencyMS, MxBool p_createThread)
 	return status;
 }
 
-void MxSoundManager::AudioStreamCallback(
-    void* p_userdata,
-    Uint8* stream,
-    int len
-) {
-    static std::vector<MxU8> g_buffer;
-    g_buffer.reserve(len);
-
-    MxSoundManager* manager = static_cast<MxSoundManager*>(p_userdata);
-    ma_uint32 channels = ma_engine_get_channels(manager->m_engine);
-    ma_uint32 bytesPerFrame = ma_get_bytes_per_frame(ma_format_f32, channels);
-    ma_uint32 bufferSizeInFrames = static_cast<ma_uint32>(len) / bytesPerFrame;
-    ma_uint64 framesRead;
-
-    if (ma_engine_read_pcm_frames(manager->m_engine, g_buffer.data(), bufferSizeInFrames, &framesRead) == MA_SUCCESS) {
-        SDL_QueueAudio(manager->m_device, g_buffer.data(), static_cast<Uint32>(framesRead * bytesPerFrame));
-    }
+// Runs on the SDL audio thread. The engine mixes straight into the device buffer.
+void MxSoundManager::AudioCallback(void* p_userdata, Uint8* p_stream, int p_len)
+{
+	PROFILE_THREAD("SDL audio");
+	PROFILE_ZONE("MxSoundManager::AudioCallback");
+	MxSoundManager* manager = (MxSoundManager*) p_userdata;
+	ma_uint32 bytesPerFrame = ma_get_bytes_per_frame(ma_format_f32, ma_engine_get_channels(manager->m_engine));
+	ma_uint64 frameCount = (ma_uint32) p_len / bytesPerFrame;
+	ma_uint64 framesRead = 0;
+
+	{
+		AUTOLOCK(manager->m_mixLock);
+
+		if (ma_engine_read_pcm_frames(manager->m_engine, p_stream, frameCount, &framesRead) != MA_SUCCESS) {
+			framesRead = 0;
+		}
+	}
+
+	if (framesRead < frameCount) {
+		memset(p_stream + framesRead * bytesPerFrame, 0, (size_t) ((frameCount - framesRead) * bytesPerFrame));
+	}
+
+	manager->m_latency.Mixed(SDL_GetPerformanceCounter(), (MxU32) frameCount);
+}
+
+// Time between mixing a frame and the device playing it, measured at the last callback
+float MxSoundManager::GetLatencyMS()
+{
+	return m_latency.GetQueuedFrames() * 1000.0f / g_sampleRate;
 }
 
+float MxSoundManager::GetMaxCallbackIntervalMS()
+{
+	return m_latency.GetMaxIntervalUS() / 1000.0f;
+}
 
+void MxSoundManager::SetPeriodFrames(MxU32 p_periodFrames)
+{
+	g_audioPeriodFrames = p_periodFrames;
+}
 
 // FUNCTION: LEGO1 0x100aeab0
 void MxSoundManager::Destroy()
@@ -40,11 +40,20 @@ MxResult MxWavePresenter::AddToManager()
 // FUNCTION: LEGO1 0x100b1b10
 void MxWavePresenter::Destroy(MxBool p_fromDestructor)
 {
+	// The sound may be mixing on the audio thread until it is uninitialized
+	if (MSoundManager()) {
+		MSoundManager()->GetMixLock().Enter();
+	}
+
 	m_sound.Destroy(ma_sound_uninit);
 	m_rb.Destroy(ma_pcm_rb_uninit);
 	m_ab.m_buffer.Destroy(ma_audio_buffer_uninit);
 	delete[] m_ab.m_data;
 
+	if (MSoundManager()) {
+		MSoundManager()->GetMixLock().Leave();
+	}
+
 	if (m_waveFormat) {
 		delete[] ((MxU8*) m_waveFormat);
 	}
@@ -57,12 +66,14 @@ void MxWavePresenter::Destroy(MxBool p_fromDestructor)
 }
 
 // FUNCTION: LEGO1 0x100b1bd0
-MxBool MxWavePresenter::WriteToSoundBuffer(void* p_audioPtr, MxU32 p_length)
+MxBool MxWavePresenter::WriteToSoundBuffer(MxStreamChunk* p_chunk)
 {
+	MxU32 length = p_chunk->GetLength();
+
 	if (m_action->IsLooping()) {
-		assert(m_ab.m_offset + p_length <= m_ab.m_length);
-		memcpy(m_ab.m_data + m_ab.m_offset, p_audioPtr, p_length);
-		m_ab.m_offset += p_length;
+		assert(m_ab.m_offset + length <= m_ab.m_length);
+		p_chunk->CopyData(m_ab.m_data + m_ab.m_offset);
+		m_ab.m_offset += length;
 		return TRUE;
 	}
 	else {
@@ -80,13 +91,13 @@ MxBool MxWavePresenter::WriteToSoundBuffer(void* p_audioPtr, MxU32 p_length)
 		}
 
 		ma_uint32 acquiredBytes = acquiredFrames * ma_get_bytes_per_frame(m_rb->format, m_rb->channels);
-		assert(p_length <= acquiredBytes);
+		assert(length <= acquiredBytes);
 
-		memcpy(bufferOut, p_audioPtr, p_length);
+		p_chunk->CopyData((MxU8*) bufferOut);
 
 		// [library:audio] Pad with silence data if we don't have a full chunk.
-		if (p_length < acquiredBytes) {
-			memset((ma_uint8*) bufferOut + p_length, m_silenceData, acquiredBytes - p_length);
+		if (length < acquiredBytes) {
+			memset((ma_uint8*) bufferOut + length, m_silenceData, acquiredBytes - length);
 		}
 
 		ma_pcm_rb_commit_write(m_rb, acquiredFrames);
@@ -101,7 +112,7 @@ void MxWavePresenter::ReadyTickle()
 
 	if (chunk) {
 		m_waveFormat = (WaveFormat*) new MxU8[chunk->GetLength()];
-		memcpy(m_waveFormat, chunk->GetData(), chunk->GetLength());
+		chunk->CopyData((MxU8*) m_waveFormat);
 		m_subscriber->FreeDataChunk(chunk);
 		ParseExtra();
 		ProgressTickleState(e_starting);
@@ -164,14 +175,18 @@ void MxWavePresenter::StartingTickle()
 			ma_pcm_rb_set_sample_rate(m_rb, sampleRate);
 		}
 
-		if (m_sound.Init(
-				ma_sound_init_from_data_source,
-				MSoundManager()->GetEngine(),
-				m_action->IsLooping() ? (ma_data_source*) m_ab.m_buffer : (ma_data_source*) m_rb,
-				m_is3d ? 0 : MA_SOUND_FLAG_NO_SPATIALIZATION,
-				nullptr
-			) != MA_SUCCESS) {
-			goto done;
+		{
+			AUTOLOCK(MSoundManager()->GetMixLock());
+
+			if (m_sound.Init(
+					ma_sound_init_from_data_source,
+					MSoundManager()->GetEngine(),
+					m_action->IsLooping() ? (ma_data_source*) m_ab.m_buffer : (ma_data_source*) m_rb,
+					m_is3d ? 0 : MA_SOUND_FLAG_NO_SPATIALIZATION,
+					nullptr
+				) != MA_SUCCESS) {
+				goto done;
+			}
 		}
 
 		// [library:audio]
@@ -231,7 +246,7 @@ void MxWavePresenter::DoneTickle()
 // FUNCTION: LEGO1 0x100b2130
 void MxWavePresenter::LoopChunk(MxStreamChunk* p_chunk)
 {
-	WriteToSoundBuffer(p_chunk->GetData(), p_chunk->GetLength());
+	WriteToSoundBuffer(p_chunk);
 	if (IsEnabled()) {
 		m_subscriber->FreeDataChunk(p_chunk);
 	}
@@ -245,7 +260,7 @@ MxResult MxWavePresenter::PutData()
 	if (IsEnabled()) {
 		switch (m_currentTickleState) {
 		case e_streaming:
-			if (m_currentChunk && WriteToSoundBuffer(m_currentChunk->GetData(), m_currentChunk->GetLength())) {
+			if (m_currentChunk && WriteToSoundBuffer(m_currentChunk)) {
 				m_subscriber->FreeDataChunk(m_currentChunk);
 				m_currentChunk = NULL;
 			}
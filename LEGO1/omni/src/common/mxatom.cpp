@@ -7,7 +7,7 @@
 #include <assert.h>
 
 DECOMP_SIZE_ASSERT(MxAtomId, 0x04);
-DECOMP_SIZE_ASSERT(MxAtom, 0x14);
+DECOMP_SIZE_ASSERT(MxAtom, 0x34);
 DECOMP_SIZE_ASSERT(MxAtomSet, 0x10);
 
 // FUNCTION: LEGO1 0x100acf90
@@ -0,0 +1,34 @@
+#include "mxframetimings.h"
+
+#include <SDL2/SDL_timer.h>
+
+MxBool g_frameTimingsEnabled = FALSE;
+Uint64 g_frameTimings[MxFrameTimings::e_numSections];
+
+void MxFrameTimings::SetEnabled(MxBool p_enabled)
+{
+	g_frameTimingsEnabled = p_enabled;
+	Reset();
+}
+
+void MxFrameTimings::Reset()
+{
+	for (MxS32 i = 0; i < e_numSections; i++) {
+		g_frameTimings[i] = 0;
+	}
+}
+
+double MxFrameTimings::GetMilliseconds(Section p_section)
+{
+	return g_frameTimings[p_section] * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+Uint64 MxFrameTimings::Begin()
+{
+	return g_frameTimingsEnabled ? SDL_GetPerformanceCounter() : 0;
+}
+
+void MxFrameTimings::End(Section p_section, Uint64 p_start)
+{
+	g_frameTimings[p_section] += SDL_GetPerformanceCounter() - p_start;
+}
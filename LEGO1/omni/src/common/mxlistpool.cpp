@@ -0,0 +1,133 @@
+#include "mxlistpool.h"
+
+#include <SDL2/SDL_atomic.h>
+
+struct FreeNode {
+	FreeNode* m_next;
+};
+
+// Zero-initialized, so lists built during static initialization can already use the pool.
+// Each slab links to the previous one through a pointer after its last node.
+struct SizeClass {
+	SDL_SpinLock m_lock;
+	FreeNode* m_free;
+	char* m_slabs;
+	MxListNodePool::Stats m_stats;
+};
+
+static const size_t c_granularity = sizeof(void*);
+static const size_t c_classCount = MxListNodePool::c_maxNodeSize / c_granularity;
+
+static SizeClass g_sizeClasses[c_classCount];
+
+void* MxListNodePool::Allocate(size_t p_size)
+{
+	if (p_size == 0 || p_size > c_maxNodeSize) {
+		return ::operator new(p_size);
+	}
+
+	size_t index = (p_size - 1) / c_granularity;
+	SizeClass& sizeClass = g_sizeClasses[index];
+	FreeNode* node;
+
+	SDL_AtomicLock(&sizeClass.m_lock);
+
+	if (sizeClass.m_free) {
+		sizeClass.m_stats.m_hits++;
+	}
+	else {
+		size_t nodeSize = (index + 1) * c_granularity;
+		char* slab = (char*) ::operator new(nodeSize * c_slabNodes + sizeof(char*));
+		*(char**) (slab + nodeSize * c_slabNodes) = sizeClass.m_slabs;
+		sizeClass.m_slabs = slab;
+
+		for (MxS32 i = c_slabNodes - 1; i >= 0; i--) {
+			FreeNode* entry = (FreeNode*) (slab + i * nodeSize);
+			entry->m_next = sizeClass.m_free;
+			sizeClass.m_free = entry;
+		}
+
+		sizeClass.m_stats.m_slabs++;
+	}
+
+	node = sizeClass.m_free;
+	sizeClass.m_free = node->m_next;
+	sizeClass.m_stats.m_allocations++;
+
+	if (++sizeClass.m_stats.m_liveNodes > sizeClass.m_stats.m_peakNodes) {
+		sizeClass.m_stats.m_peakNodes = sizeClass.m_stats.m_liveNodes;
+	}
+
+	SDL_AtomicUnlock(&sizeClass.m_lock);
+	return node;
+}
+
+void MxListNodePool::Free(void* p_node, size_t p_size)
+{
+	if (!p_node) {
+		return;
+	}
+
+	if (p_size == 0 || p_size > c_maxNodeSize) {
+		::operator delete(p_node);
+		return;
+	}
+
+	SizeClass& sizeClass = g_sizeClasses[(p_size - 1) / c_granularity];
+	FreeNode* node = (FreeNode*) p_node;
+
+	SDL_AtomicLock(&sizeClass.m_lock);
+	node->m_next = sizeClass.m_free;
+	sizeClass.m_free = node;
+	sizeClass.m_stats.m_liveNodes--;
+	SDL_AtomicUnlock(&sizeClass.m_lock);
+}
+
+// Sums the statistics of all size classes
+void MxListNodePool::GetStats(Stats& p_stats)
+{
+	p_stats.m_allocations = 0;
+	p_stats.m_hits = 0;
+	p_stats.m_slabs = 0;
+	p_stats.m_liveNodes = 0;
+	p_stats.m_peakNodes = 0;
+
+	for (size_t i = 0; i < c_classCount; i++) {
+		SDL_AtomicLock(&g_sizeClasses[i].m_lock);
+		p_stats.m_allocations += g_sizeClasses[i].m_stats.m_allocations;
+		p_stats.m_hits += g_sizeClasses[i].m_stats.m_hits;
+		p_stats.m_slabs += g_sizeClasses[i].m_stats.m_slabs;
+		p_stats.m_liveNodes += g_sizeClasses[i].m_stats.m_liveNodes;
+		p_stats.m_peakNodes += g_sizeClasses[i].m_stats.m_peakNodes;
+		SDL_AtomicUnlock(&g_sizeClasses[i].m_lock);
+	}
+}
+
+// Frees the slabs of every size class whose nodes have all been returned, and returns how many
+// slabs were freed. Classes with live nodes keep theirs, as the free list threads through them.
+MxU32 MxListNodePool::Trim()
+{
+	MxU32 freed = 0;
+
+	for (size_t i = 0; i < c_classCount; i++) {
+		SizeClass& sizeClass = g_sizeClasses[i];
+		size_t slabSize = (i + 1) * c_granularity * c_slabNodes;
+
+		SDL_AtomicLock(&sizeClass.m_lock);
+
+		if (sizeClass.m_stats.m_liveNodes == 0) {
+			while (sizeClass.m_slabs) {
+				char* slab = sizeClass.m_slabs;
+				sizeClass.m_slabs = *(char**) (slab + slabSize);
+				::operator delete(slab);
+				freed++;
+			}
+
+			sizeClass.m_free = NULL;
+		}
+
+		SDL_AtomicUnlock(&sizeClass.m_lock);
+	}
+
+	return freed;
+}
@@ -239,7 +239,7 @@ void MxMediaPresenter::LoopChunk(MxStreamChunk* p_chunk)
 	chunk->SetData(new MxU8[length]);
 	chunk->SetTime(p_chunk->GetTime());
 
-	memcpy(chunk->GetData(), p_chunk->GetData(), chunk->GetLength());
+	p_chunk->CopyData(chunk->GetData());
 	m_loopingChunks->Append(chunk);
 }
 
@@ -0,0 +1,67 @@
+#include "mxpathindex.h"
+
+#include "mxstring.h"
+
+#include <SDL2/SDL_stdinc.h>
+
+MxU64 MxPathIndex::EdgeKey(MxU32 p_node, char p_char)
+{
+	return ((MxU64) p_node << 8) | (MxU8) SDL_tolower((MxU8) p_char);
+}
+
+void MxPathIndex::Build(const vector<MxString>& p_files)
+{
+	Clear();
+
+	for (size_t i = 0; i < p_files.size(); i++) {
+		const char* name = p_files[i].GetData();
+		MxU32 node = 0;
+
+		for (size_t j = p_files[i].GetLength(); j != 0; j--) {
+			MxU64 key = EdgeKey(node, name[j - 1]);
+			unordered_map<MxU64, MxU32>::const_iterator edge = m_edges.find(key);
+
+			if (edge != m_edges.end()) {
+				node = edge->second;
+			}
+			else {
+				m_files.push_back(-1);
+				node = (MxU32) m_files.size() - 1;
+				m_edges[key] = node;
+			}
+		}
+
+		if (node != 0 && m_files[node] == -1) {
+			m_files[node] = (MxS32) i;
+		}
+	}
+}
+
+void MxPathIndex::Clear()
+{
+	m_files.assign(1, -1);
+	m_edges.clear();
+}
+
+// Returns the index of the first name that is a case-insensitive suffix of p_path, or -1.
+MxS32 MxPathIndex::Find(const char* p_path, size_t p_length) const
+{
+	MxS32 result = -1;
+	MxU32 node = 0;
+
+	for (size_t i = p_length; i != 0; i--) {
+		unordered_map<MxU64, MxU32>::const_iterator edge = m_edges.find(EdgeKey(node, p_path[i - 1]));
+
+		if (edge == m_edges.end()) {
+			break;
+		}
+
+		node = edge->second;
+
+		if (m_files[node] != -1 && (result == -1 || m_files[node] < result)) {
+			result = m_files[node];
+		}
+	}
+
+	return result;
+}
@@ -3,20 +3,23 @@
 #include "decomp.h"
 #include "mxomni.h"
 
+#include <SDL2/SDL_atomic.h>
 #include <SDL2/SDL_log.h>
 #include <SDL2/SDL_platform.h>
 #include <SDL2/SDL_stdinc.h>
 #include <stdlib.h>
 #include <string.h>
 
-DECOMP_SIZE_ASSERT(MxString, 0x10)
+// 0x10 in the original, before the inline buffer
+DECOMP_SIZE_ASSERT(MxString, 0x30)
+
+static SDL_atomic_t g_stringHeapAllocations = {0};
 
 // FUNCTION: LEGO1 0x100ae200
 // FUNCTION: BETA10 0x1012c110
 MxString::MxString()
 {
-	// Set string to one char in length and set that char to null terminator
-	this->m_data = new char[1];
+	this->m_data = this->m_inline;
 	this->m_data[0] = 0;
 	this->m_length = 0;
 }
@@ -25,22 +28,20 @@ MxString::MxString()
 // FUNCTION: BETA10 0x1012c1a1
 MxString::MxString(const MxString& p_str)
 {
-	this->m_length = p_str.m_length;
-	this->m_data = new char[this->m_length + 1];
-	strcpy(this->m_data, p_str.m_data);
+	this->m_data = this->m_inline;
+	Assign(p_str.m_data, p_str.m_length);
 }
 
 // FUNCTION: LEGO1 0x100ae350
 // FUNCTION: BETA10 0x1012c24f
 MxString::MxString(const char* p_str)
 {
+	this->m_data = this->m_inline;
+
 	if (p_str) {
-		this->m_length = strlen(p_str);
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str);
+		Assign(p_str, strlen(p_str));
 	}
 	else {
-		this->m_data = new char[1];
 		this->m_data[0] = 0;
 		this->m_length = 0;
 	}
@@ -49,21 +50,13 @@ MxString::MxString(const char* p_str)
 // FUNCTION: BETA10 0x1012c330
 MxString::MxString(const char* p_str, MxU16 p_maxlen)
 {
-	if (p_str) {
-		if (strlen(p_str) <= p_maxlen) {
-			this->m_length = strlen(p_str);
-		}
-		else {
-			this->m_length = p_maxlen;
-		}
+	this->m_data = this->m_inline;
 
-		// Basically strncpy
-		this->m_data = new char[this->m_length + 1];
-		memcpy(this->m_data, p_str, this->m_length);
-		this->m_data[this->m_length] = '\0';
+	if (p_str) {
+		size_t length = strlen(p_str);
+		Assign(p_str, length <= p_maxlen ? length : p_maxlen);
 	}
 	else {
-		this->m_data = new char[1];
 		this->m_data[0] = 0;
 		this->m_length = 0;
 	}
@@ -73,7 +66,59 @@ MxString::MxString(const char* p_str, MxU16 p_maxlen)
 // FUNCTION: BETA10 0x1012c45b
 MxString::~MxString()
 {
-	delete[] this->m_data;
+	if (this->m_data != this->m_inline) {
+		delete[] this->m_data;
+	}
+}
+
+// Replaces the buffer with one holding p_length characters plus the terminator.
+// The old contents are discarded.
+char* MxString::Reserve(MxU32 p_length)
+{
+	if (this->m_data != this->m_inline) {
+		delete[] this->m_data;
+	}
+
+	if (p_length < c_inlineSize) {
+		this->m_data = this->m_inline;
+	}
+	else {
+		this->m_data = new char[p_length + 1];
+		SDL_AtomicAdd(&g_stringHeapAllocations, 1);
+	}
+
+	this->m_length = p_length;
+	return this->m_data;
+}
+
+// Copies p_length characters of p_str, which may point into this string's own buffer.
+// Lengths are MxU16 as in the original, so longer strings are cut short to fit.
+void MxString::Assign(const char* p_str, MxU16 p_length)
+{
+	char* data;
+
+	if (p_length < c_inlineSize) {
+		data = this->m_inline;
+	}
+	else {
+		data = new char[p_length + 1];
+		SDL_AtomicAdd(&g_stringHeapAllocations, 1);
+	}
+
+	memmove(data, p_str, p_length);
+	data[p_length] = '\0';
+
+	if (this->m_data != this->m_inline && this->m_data != data) {
+		delete[] this->m_data;
+	}
+
+	this->m_data = data;
+	this->m_length = p_length;
+}
+
+MxU32 MxString::GetHeapAllocations()
+{
+	return SDL_AtomicGet(&g_stringHeapAllocations);
 }
 
 // FUNCTION: BETA10 0x1012c4de
@@ -108,10 +153,7 @@ void MxString::ToLowerCase()
 MxString& MxString::operator=(const MxString& p_str)
 {
 	if (this->m_data != p_str.m_data) {
-		delete[] this->m_data;
-		this->m_length = p_str.m_length;
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str.m_data);
+		Assign(p_str.m_data, p_str.m_length);
 	}
 
 	return *this;
@@ -122,10 +164,7 @@ MxString& MxString::operator=(const MxString& p_str)
 const MxString& MxString::operator=(const char* p_str)
 {
 	if (this->m_data != p_str) {
-		delete[] this->m_data;
-		this->m_length = strlen(p_str);
-		this->m_data = new char[this->m_length + 1];
-		strcpy(this->m_data, p_str);
+		Assign(p_str, strlen(p_str));
 	}
 
 	return *this;
@@ -135,15 +174,12 @@ const MxString& MxString::operator=(const char* p_str)
 MxString MxString::operator+(const MxString& p_str) const
 {
 	MxString tmp;
-	delete[] tmp.m_data;
-
-	tmp.m_length = p_str.m_length + this->m_length;
-	tmp.m_data = new char[tmp.m_length + 1];
+	char* data = tmp.Reserve(this->m_length + p_str.m_length);
 
-	strcpy(tmp.m_data, this->m_data);
-	strcpy(tmp.m_data + this->m_length, p_str.m_data);
+	memcpy(data, this->m_data, this->m_length);
+	memcpy(data + this->m_length, p_str.m_data, p_str.m_length + 1);
 
-	return MxString(tmp);
+	return tmp;
 }
 
 // Return type is intentionally just MxString, not MxString&.
@@ -152,33 +188,41 @@ MxString MxString::operator+(const MxString& p_str) const
 // FUNCTION: BETA10 0x1012c78d
 MxString MxString::operator+(const char* p_str) const
 {
-	// MxString constructor allocates 1 byte for m_data, so free that first
 	MxString tmp;
-	delete[] tmp.m_data;
-
-	tmp.m_length = strlen(p_str) + this->m_length;
-	tmp.m_data = new char[tmp.m_length + 1];
+	size_t length = strlen(p_str);
+	char* data = tmp.Reserve(this->m_length + length);
 
-	strcpy(tmp.m_data, this->m_data);
-	strcpy(tmp.m_data + this->m_length, p_str);
+	memcpy(data, this->m_data, this->m_length);
+	memcpy(data + this->m_length, p_str, length + 1);
 
-	return MxString(tmp);
+	return tmp;
 }
 
 // FUNCTION: LEGO1 0x100ae690
 // FUNCTION: BETA10 0x1012c92f
 MxString& MxString::operator+=(const char* p_str)
 {
-	int newlen = this->m_length + strlen(p_str);
+	int length = strlen(p_str);
+	int newlen = this->m_length + length;
 
-	char* tmp = new char[newlen + 1];
-	strcpy(tmp, this->m_data);
-	strcpy(tmp + this->m_length, p_str);
+	if (this->m_data == this->m_inline && newlen < c_inlineSize) {
+		// Still fits inline, so append in place. p_str may be this string's own data.
+		memmove(this->m_data + this->m_length, p_str, length + 1);
+	}
+	else {
+		char* tmp = new char[newlen + 1];
+		SDL_AtomicAdd(&g_stringHeapAllocations, 1);
+		memcpy(tmp, this->m_data, this->m_length);
+		memcpy(tmp + this->m_length, p_str, length + 1);
 
-	delete[] this->m_data;
-	this->m_data = tmp;
-	this->m_length = newlen;
+		if (this->m_data != this->m_inline) {
+			delete[] this->m_data;
+		}
+
+		this->m_data = tmp;
+	}
 
+	this->m_length = newlen;
 	return *this;
 }
 
@@ -207,27 +251,23 @@ void MxString::MapPathToFilesystem(char* p_path)
 
 	size_t pathLen = SDL_strlen(p_path);
 
-	auto mapPath = [p_path, pathLen](const vector<MxString>& p_files) -> bool {
-		for (const MxString& file : p_files) {
-			// Test whether file is a suffix of the provided path (case insensitive)
-			// If yes, copy the original file system path into p_path.
-			for (size_t i = pathLen, j = file.GetLength(); i != 0 && j != 0; i--, j--) {
-				if (SDL_tolower(p_path[i - 1]) != SDL_tolower(file.GetData()[j - 1])) {
-					break;
-				}
-				else if (j == 1) {
-					SDL_strlcpy(&p_path[i - 1], file.GetData(), file.GetLength() + 1);
-					SDL_pow("Resolved file path to %s", p_path);
-					return true;
-				}
-			}
+	auto mapPath = [p_path, pathLen](const vector<MxString>& p_files, const MxPathIndex& p_index) -> bool {
+		// Find the first file that is a suffix of the provided path (case insensitive)
+		// and copy its original file system path into p_path.
+		MxS32 index = p_index.Find(p_path, pathLen);
+
+		if (index == -1) {
+			return false;
 		}
 
-		return false;
+		const MxString& file = p_files[index];
+		SDL_strlcpy(&p_path[pathLen - file.GetLength()], file.GetData(), file.GetLength() + 1);
+		SDL_pow("Resolved file path to %s", p_path);
+		return true;
 	};
 
-	if (!mapPath(MxOmni::GetHDFiles())) {
-		mapPath(MxOmni::GetCDFiles());
+	if (!mapPath(MxOmni::GetHDFiles(), MxOmni::GetHDIndex())) {
+		mapPath(MxOmni::GetCDFiles(), MxOmni::GetCDIndex());
 	}
 #endif
 }
@@ -1,9 +1,13 @@
 #include "mxticklemanager.h"
 
 #include "decomp.h"
+#include "mxframetimings.h"
 #include "mxmisc.h"
+#include "mxstreamer.h"
 #include "mxtimer.h"
 #include "mxtypes.h"
+#include "mxvideomanager.h"
+#include "profiler.h"
 
 #include <assert.h>
 
@@ -12,6 +16,19 @@
 DECOMP_SIZE_ASSERT(MxTickleClient, 0x10);
 DECOMP_SIZE_ASSERT(MxTickleManager, 0x14);
 
+static MxFrameTimings::Section GetTimingSection(MxCore* p_client)
+{
+	if (p_client == Streamer()) {
+		return MxFrameTimings::e_streaming;
+	}
+
+	if (p_client == MVideoManager()) {
+		return MxFrameTimings::e_video;
+	}
+
+	return MxFrameTimings::e_tickle;
+}
+
 // FUNCTION: LEGO1 0x100bdd10
 MxTickleClient::MxTickleClient(MxCore* p_client, MxTime p_interval)
 {
@@ -35,6 +52,7 @@ MxTickleManager::~MxTickleManager()
 // FUNCTION: BETA10 0x1013eb1f
 MxResult MxTickleManager::Tickle()
 {
+	PROFILE_ZONE("MxTickleManager::Tickle");
 	MxTime time = Timer()->GetTime();
 	MxTickleClientPtrList::iterator it;
 
@@ -53,7 +71,14 @@ MxResult MxTickleManager::Tickle()
 			}
 
 			if ((client->GetTickleInterval() + client->GetLastUpdateTime()) < time) {
+				PROFILE_ZONE(client->GetClient()->ClassName());
+				Uint64 start = MxFrameTimings::Begin();
 				client->GetClient()->Tickle();
+
+				if (start) {
+					MxFrameTimings::End(GetTimingSection(client->GetClient()), start);
+				}
+
 				client->SetLastUpdateTime(time);
 			}
 		}
@@ -9,6 +9,9 @@ MxLong MxTimer::g_lastTimeCalculated = 0;
 // GLOBAL: LEGO1 0x10101418
 MxLong MxTimer::g_lastTimeTimerStarted = 0;
 
+Uint64 MxTimer::g_fixedTicks = 0;
+MxLong MxTimer::g_fixedStep = 0;
+
 // FUNCTION: LEGO1 0x100ae060
 // FUNCTION: BETA10 0x1012bea0
 MxTimer::MxTimer()
@@ -22,10 +25,35 @@ MxTimer::MxTimer()
 // FUNCTION: BETA10 0x1012bf23
 MxLong MxTimer::GetRealTime()
 {
-	MxTimer::g_lastTimeCalculated = SDL_GetTicks();
+	MxTimer::g_lastTimeCalculated = g_fixedStep ? g_fixedTicks : SDL_GetTicks();
 	return MxTimer::g_lastTimeCalculated - m_startTime;
 }
 
+// Switches between the real clock and a fixed clock that only moves on Step, for
+// reproducible runs. The fixed clock starts at the timer's zero, so it should be set
+// before the first tickle. Returning to the real clock keeps the time continuous.
+void MxTimer::SetFixedStep(MxLong p_step)
+{
+	if (p_step && !g_fixedStep) {
+		g_fixedTicks = m_startTime;
+	}
+	else if (!p_step && g_fixedStep) {
+		m_startTime += SDL_GetTicks() - g_fixedTicks;
+	}
+
+	g_fixedStep = p_step;
+}
+
+void MxTimer::Step()
+{
+	g_fixedTicks += g_fixedStep;
+}
+
+MxLong MxTimer::GetFixedStep()
+{
+	return g_fixedStep;
+}
+
 // FUNCTION: LEGO1 0x100ae160
 void MxTimer::Start()
 {
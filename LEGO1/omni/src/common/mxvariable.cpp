@@ -3,4 +3,4 @@
 #include "decomp.h"
 #include "mxstring.h"
 
-DECOMP_SIZE_ASSERT(MxVariable, 0x24)
+DECOMP_SIZE_ASSERT(MxVariable, 0x64)
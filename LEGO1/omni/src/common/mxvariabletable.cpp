@@ -1,5 +1,9 @@
 #include "mxvariabletable.h"
 
+#include "mxutilities.h"
+
+#include <SDL2/SDL_stdinc.h>
+
 // FUNCTION: LEGO1 0x100b7330
 // FUNCTION: BETA10 0x1012a470
 MxS8 MxVariableTable::Compare(MxVariable* p_var0, MxVariable* p_var1)
@@ -11,14 +15,25 @@ MxS8 MxVariableTable::Compare(MxVariable* p_var0, MxVariable* p_var1)
 // FUNCTION: BETA10 0x1012a4a0
 MxU32 MxVariableTable::Hash(MxVariable* p_var)
 {
-	const char* str = p_var->GetKey()->GetData();
-	MxU32 value = 0;
+	return HashKey(p_var->GetKey()->GetData());
+}
+
+// Keys are stored upper case, so fold here and raw lookup keys hash like the stored ones
+MxU32 MxVariableTable::HashKey(const char* p_key)
+{
+	return HashStringNoCase(p_key);
+}
+
+MxBool MxVariableTable::KeyEquals(MxVariable* p_var, const char* p_key)
+{
+	const char* key = p_var->GetKey()->GetData();
 
-	for (MxS32 i = 0; str[i]; i++) {
-		value += str[i];
+	while (*key && *key == (char) SDL_toupper((MxU8) *p_key)) {
+		key++;
+		p_key++;
 	}
 
-	return value;
+	return *key == '\0' && *p_key == '\0';
 }
 
 // FUNCTION: LEGO1 0x100b73a0
@@ -26,15 +41,14 @@ MxU32 MxVariableTable::Hash(MxVariable* p_var)
 void MxVariableTable::SetVariable(const char* p_key, const char* p_value)
 {
 	MxHashTableCursor<MxVariable*> cursor(this);
-	MxVariable* var = new MxVariable(p_key, p_value);
+	MxVariable* var;
 
-	if (cursor.Find(var)) {
-		delete var;
+	if (cursor.Find(HashKey(p_key), [p_key](MxVariable* p_var) { return KeyEquals(p_var, p_key); })) {
 		cursor.Current(var);
 		var->SetValue(p_value);
 	}
 	else {
-		MxHashTable<MxVariable*>::Add(var);
+		MxHashTable<MxVariable*>::Add(new MxVariable(p_key, p_value));
 	}
 }
 
@@ -59,12 +73,9 @@ const char* MxVariableTable::GetVariable(const char* p_key)
 	// STRING: LEGO1 0x100f01d4
 	const char* value = "";
 	MxHashTableCursor<MxVariable*> cursor(this);
-	MxVariable* var = new MxVariable(p_key);
-
-	MxBool found = cursor.Find(var);
-	delete var;
+	MxVariable* var;
 
-	if (found) {
+	if (cursor.Find(HashKey(p_key), [p_key](MxVariable* p_var) { return KeyEquals(p_var, p_key); })) {
 		cursor.Current(var);
 		value = var->GetValue()->GetData();
 	}
@@ -65,7 +65,7 @@ void MxEventPresenter::Destroy()
 void MxEventPresenter::CopyData(MxStreamChunk* p_chunk)
 {
 	m_data = new MxU8[p_chunk->GetLength()];
-	memcpy(m_data, p_chunk->GetData(), p_chunk->GetLength());
+	p_chunk->CopyData(m_data);
 }
 
 // FUNCTION: LEGO1 0x100c2e70
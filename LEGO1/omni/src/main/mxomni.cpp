@@ -5,6 +5,7 @@
 #include "mxautolock.h"
 #include "mxdsmultiaction.h"
 #include "mxeventmanager.h"
+#include "mxlistpool.h"
 #include "mxmisc.h"
 #include "mxnotificationmanager.h"
 #include "mxobjectfactory.h"
@@ -39,6 +40,8 @@ MxOmni* MxOmni::g_instance = NULL;
 
 vector<MxString> MxOmni::g_hdFiles;
 vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
 
 // FUNCTION: LEGO1 0x100aef10
 MxOmni::MxOmni()
@@ -218,6 +221,20 @@ void MxOmni::Destroy()
 		delete m_atomSet;
 	}
 
+	// Everything the streams and presenters held is gone by now, so most slabs can go too
+	MxListNodePool::Stats stats;
+	MxListNodePool::GetStats(stats);
+	MxU32 freed = MxListNodePool::Trim();
+	SDL_LogDebug(
+		SDL_LOG_CATEGORY_APPLICATION,
+		"List nodes: %u allocations, %u from free lists, %u slabs (%u freed), peak %u",
+		stats.m_allocations,
+		stats.m_hits,
+		stats.m_slabs,
+		freed,
+		stats.m_peakNodes
+	);
+
 	Init();
 }
 
@@ -369,6 +386,7 @@ void MxOmni::SetHD(const char* p_hd)
 {
 	g_hdPath = p_hd;
 	g_hdFiles = GlobIsleFiles(g_hdPath);
+	g_hdIndex.Build(g_hdFiles);
 }
 
 // FUNCTION: LEGO1 0x100b0940
@@ -382,6 +400,7 @@ void MxOmni::SetCD(const char* p_cd)
 {
 	g_cdPath = p_cd;
 	g_cdFiles = GlobIsleFiles(g_cdPath);
+	g_cdIndex.Build(g_cdFiles);
 }
 
 // FUNCTION: LEGO1 0x100b0980
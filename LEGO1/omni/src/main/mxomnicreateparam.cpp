@@ -2,7 +2,7 @@
 
 #include "decomp.h"
 
-DECOMP_SIZE_ASSERT(MxOmniCreateParam, 0x40)
+DECOMP_SIZE_ASSERT(MxOmniCreateParam, 0x60)
 
 // FUNCTION: LEGO1 0x100b0b00
 // FUNCTION: BETA10 0x10130b6b
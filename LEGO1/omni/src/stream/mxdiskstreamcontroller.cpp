@@ -60,6 +60,11 @@ MxDiskStreamController::~MxDiskStreamController()
 		FUN_100c7cb0((MxDSStreamingAction*) object);
 	}
 
+	// Split chunks still being gathered hold references on buffers in m_list0x74
+	while (m_list0x90.PopFront(object)) {
+		FUN_100c7cb0((MxDSStreamingAction*) object);
+	}
+
 	while (!m_list0x74.empty()) {
 		MxDSBuffer* buffer = m_list0x74.front();
 		m_list0x74.pop_front();
@@ -10,6 +10,10 @@
 #include "mxstreamcontroller.h"
 #include "mxstring.h"
 #include "mxthread.h"
+#include "profiler.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_timer.h>
 
 DECOMP_SIZE_ASSERT(MxDiskStreamProviderThread, 0x1c)
 DECOMP_SIZE_ASSERT(MxDiskStreamProvider, 0x60);
@@ -17,9 +21,20 @@ DECOMP_SIZE_ASSERT(MxDiskStreamProvider, 0x60);
 // GLOBAL: LEGO1 0x10102878
 MxU32 g_unk0x10102878 = 0;
 
+static MxU32 g_readAheadLimit = 512 * 1024;
+
+// Read statistics of every provider, updated by the provider threads and shown by the debug UI
+static SDL_atomic_t g_readCount;
+static SDL_atomic_t g_readAheadHits;
+static SDL_atomic_t g_readAheadMisses;
+static SDL_atomic_t g_readUS;
+static SDL_atomic_t g_maxReadUS;
+
 // FUNCTION: LEGO1 0x100d0f30
 MxResult MxDiskStreamProviderThread::Run()
 {
+	PROFILE_THREAD("MxDiskStreamProvider");
+
 	if (m_target) {
 		((MxDiskStreamProvider*) m_target)->WaitForWorkToComplete();
 	}
@@ -74,6 +89,8 @@ MxDiskStreamProvider::~MxDiskStreamProvider()
 		m_thread.Terminate();
 	}
 
+	m_readAhead.Clear();
+
 	if (m_pFile) {
 		delete m_pFile;
 	}
@@ -244,12 +261,15 @@ void MxDiskStreamProvider::PerformWork()
 
 	buffer = ((MxDSStreamingAction*) streamingAction)->GetUnknowna0();
 
-	if (m_pFile->GetPosition() == ((MxDSStreamingAction*) streamingAction)->GetBufferOffset() ||
-		m_pFile->Seek(((MxDSStreamingAction*) streamingAction)->GetBufferOffset(), RW_SEEK_SET) == 0) {
-		buffer->SetUnknown14(m_pFile->GetPosition());
+	{
+		PROFILE_ZONE("MxDiskStreamProvider::PerformWork");
+		MxU32 offset = ((MxDSStreamingAction*) streamingAction)->GetBufferOffset();
+		MxU64 start = SDL_GetPerformanceCounter();
+		MxBool cached = m_readAhead.ReadFromCache(buffer, offset);
 
-		if (m_pFile->ReadToBuffer(buffer) == SUCCESS) {
-			buffer->SetUnknown1c(m_pFile->GetPosition());
+		if (cached || MxReadAheadCache::ReadFromFile(m_pFile, buffer, offset)) {
+			MxU32 next = offset + buffer->GetWriteOffset();
+			RecordRead(SDL_GetPerformanceCounter() - start, cached);
 
 			if (((MxDSStreamingAction*) streamingAction)->GetUnknown9c() > 0) {
 				FUN_100d1b20(((MxDSStreamingAction*) streamingAction));
@@ -264,6 +284,11 @@ void MxDiskStreamProvider::PerformWork()
 			}
 
 			streamingAction = NULL;
+
+			// Streams are mostly read sequentially, so while no request is queued the next
+			// buffer is read into the cache for the following request. A request queued during
+			// the read waits for the slice in flight, not the whole buffer.
+			m_readAhead.ReadAhead(m_pFile, next, GetFileSize(), g_readAheadLimit, IsRequestQueued, this);
 		}
 	}
 
@@ -275,6 +300,61 @@ void MxDiskStreamProvider::PerformWork()
 	m_thread.Sleep(0);
 }
 
+MxBool MxDiskStreamProvider::IsRequestQueued(void* p_provider)
+{
+	MxDiskStreamProvider* provider = (MxDiskStreamProvider*) p_provider;
+	AUTOLOCK(provider->m_criticalSection);
+	return !provider->m_list.empty();
+}
+
+void MxDiskStreamProvider::SetReadAheadLimit(MxU32 p_limit)
+{
+	g_readAheadLimit = p_limit;
+}
+
+void MxDiskStreamProvider::RecordRead(MxU64 p_ticks, MxBool p_cached)
+{
+	MxU32 us = (MxU32) (p_ticks * 1000000 / SDL_GetPerformanceFrequency());
+
+	SDL_AtomicAdd(&g_readCount, 1);
+	SDL_AtomicAdd(p_cached ? &g_readAheadHits : &g_readAheadMisses, 1);
+	SDL_AtomicAdd(&g_readUS, us);
+
+	// Only the provider threads raise the maximum, so a lost race costs at most one sample
+	if (us > (MxU32) SDL_AtomicGet(&g_maxReadUS)) {
+		SDL_AtomicSet(&g_maxReadUS, us);
+	}
+
+	PROFILE_COUNTER("Read-ahead hits", SDL_AtomicGet(&g_readAheadHits));
+	PROFILE_COUNTER("Stream read us", us);
+}
+
+MxU32 MxDiskStreamProvider::GetReadCount()
+{
+	return SDL_AtomicGet(&g_readCount);
+}
+
+MxU32 MxDiskStreamProvider::GetReadAheadHits()
+{
+	return SDL_AtomicGet(&g_readAheadHits);
+}
+
+MxU32 MxDiskStreamProvider::GetReadAheadMisses()
+{
+	return SDL_AtomicGet(&g_readAheadMisses);
+}
+
+float MxDiskStreamProvider::GetAverageReadMS()
+{
+	MxU32 count = SDL_AtomicGet(&g_readCount);
+	return count ? (MxU32) SDL_AtomicGet(&g_readUS) / 1000.0f / count : 0.0f;
+}
+
+float MxDiskStreamProvider::GetMaxReadMS()
+{
+	return (MxU32) SDL_AtomicGet(&g_maxReadUS) / 1000.0f;
+}
+
 // FUNCTION: LEGO1 0x100d1af0
 MxBool MxDiskStreamProvider::FUN_100d1af0(MxDSStreamingAction* p_action)
 {
@@ -10,8 +10,20 @@
 #include "mxstreamer.h"
 #include "mxstreamprovider.h"
 #include "mxutilities.h"
+#include "profiler.h"
 
-DECOMP_SIZE_ASSERT(MxDSBuffer, 0x34);
+// The original's 0x34, then the pieces of a split chunk
+DECOMP_SIZE_ASSERT(MxDSBuffer, 0x34 + sizeof(vector<void*>));
+
+// Chunk parsing statistics, shown by the debug UI. Only updated by the stream controllers
+// and presenters, which all run from the tickle thread.
+static MxDSBuffer::ChunkStats g_chunkStats;
+
+// A buffer gathering a split chunk in place holds only this much of it
+static inline MxU32 PieceHeaderSize()
+{
+	return MxStreamChunk::GetHeaderSize() + 8;
+}
 
 // FUNCTION: LEGO1 0x100c6470
 // FUNCTION: BETA10 0x10156f00
@@ -35,6 +47,7 @@ MxDSBuffer::MxDSBuffer()
 MxDSBuffer::~MxDSBuffer()
 {
 	assert(m_referenceCount == 0);
+	ReleasePieces();
 
 	if (m_pBuffer != NULL) {
 		switch (m_mode) {
@@ -118,7 +131,7 @@ MxResult MxDSBuffer::FUN_100c67b0(
 		if (*p_streamingAction != NULL) {
 			MxDSBuffer* buffer = (*p_streamingAction)->GetUnknowna0();
 
-			if (buffer->CalcBytesRemaining(data)) {
+			if (buffer->AddPiece(this, data)) {
 				goto done;
 			}
 
@@ -258,9 +271,21 @@ MxResult MxDSBuffer::ParseChunk(
 	if (p_header->GetChunkFlags() & DS_CHUNK_SPLIT) {
 		MxU32 length = p_header->GetLength() + MxDSChunk::GetHeaderSize() + 8;
 		MxDSBuffer* buffer = new MxDSBuffer();
+		MxResult gathered;
+
+		// The pieces stay in the stream buffers they were read into if the chunk spans at most
+		// two of them and one more is left to read on with. Else they are joined as they arrive.
+		if (m_mode == e_chunk && p_header->GetLength() <= m_writeOffset &&
+			p_controller->GetProvider()->GetStreamBuffersNum() > 2) {
+			gathered = buffer ? buffer->StartPieces(this, (MxU8*) p_data) : FAILURE;
+		}
+		else {
+			gathered = buffer && buffer->AllocateBuffer(length, e_allocate) == SUCCESS
+						   ? buffer->CalcBytesRemaining((MxU8*) p_data)
+						   : FAILURE;
+		}
 
-		if (!buffer || buffer->AllocateBuffer(length, e_allocate) != SUCCESS ||
-			buffer->CalcBytesRemaining((MxU8*) p_data) != SUCCESS ||
+		if (gathered != SUCCESS ||
 			(*p_streamingAction = new MxDSStreamingAction((MxDSStreamingAction&) *p_action)) == NULL) {
 			delete buffer;
 			delete p_header;
@@ -272,6 +297,12 @@ MxResult MxDSBuffer::ParseChunk(
 
 		delete p_header;
 		(*p_streamingAction)->SetUnknowna0(buffer);
+
+		g_chunkStats.m_splitChunks++;
+		g_chunkStats.m_allocations++;
+		if (buffer->HasPieces()) {
+			g_chunkStats.m_inPlace++;
+		}
 	}
 	else {
 		if (p_header->GetChunkFlags() & DS_CHUNK_END_OF_STREAM) {
@@ -335,6 +366,8 @@ MxCore* MxDSBuffer::ReadChunk(MxDSBuffer* p_buffer, MxU32* p_chunkData, MxU16 p_
 	}
 	case FOURCC('M', 'x', 'C', 'h'): {
 		MxStreamChunk* chunk = new MxStreamChunk();
+		g_chunkStats.m_chunks++;
+
 		if (chunk && chunk->ReadChunk(p_buffer, (MxU8*) p_chunkData) != SUCCESS) {
 			delete chunk;
 			chunk = NULL;
@@ -402,6 +435,11 @@ MxU8 MxDSBuffer::ReleaseRef(MxDSChunk*)
 {
 	if (m_referenceCount != 0) {
 		m_referenceCount--;
+
+		// The chunk gathered here is gone, so its pieces need not wait for this buffer's deletion
+		if (m_referenceCount == 0) {
+			ReleasePieces();
+		}
 	}
 	return 0;
 }
@@ -435,6 +473,8 @@ MxResult MxDSBuffer::CalcBytesRemaining(MxU8* p_data)
 
 		if (bytesRead <= m_bytesRemaining) {
 			memcpy(m_pBuffer + m_writeOffset - m_bytesRemaining, ptr, bytesRead);
+			g_chunkStats.m_bytesCopied += bytesRead;
+			PROFILE_COUNTER("Chunk bytes copied", g_chunkStats.m_bytesCopied);
 
 			if (m_writeOffset == m_bytesRemaining) {
 				MxU32 length =
@@ -450,6 +490,115 @@ MxResult MxDSBuffer::CalcBytesRemaining(MxU8* p_data)
 	return result;
 }
 
+// Starts gathering the split chunk whose first piece is at p_data in p_source. Only the header
+// is copied; the payload is referenced where it was read.
+MxResult MxDSBuffer::StartPieces(MxDSBuffer* p_source, MxU8* p_data)
+{
+	MxU32 headerSize = PieceHeaderSize();
+	MxU32 payload = UnalignedRead<MxU32>(p_data + 4) - MxStreamChunk::GetHeaderSize();
+	MxU32 length = UnalignedRead<MxU32>((MxU8*) MxStreamChunk::IntoLength(p_data));
+
+	if (payload > length) {
+		return FAILURE;
+	}
+
+	m_pBuffer = new MxU8[headerSize];
+	m_pIntoBuffer = m_pBuffer;
+	m_pIntoBuffer2 = m_pBuffer;
+	m_mode = e_allocate;
+	m_writeOffset = headerSize;
+	m_bytesRemaining = length;
+
+	memcpy(m_pBuffer, p_data, headerSize);
+	length += MxStreamChunk::GetHeaderSize();
+	memcpy(m_pBuffer + 4, &length, sizeof(length));
+
+	return AddPiece(p_source, p_data);
+}
+
+// Adds the piece at p_data, read into p_source, to the split chunk gathered here. Joins the
+// pieces gathered so far if p_source is not a stream buffer, as those are refilled.
+MxResult MxDSBuffer::AddPiece(MxDSBuffer* p_source, MxU8* p_data)
+{
+	// Buffers that join the pieces as they arrive hold the whole chunk
+	if (m_writeOffset != PieceHeaderSize()) {
+		return CalcBytesRemaining(p_data);
+	}
+
+	MxU32 length = UnalignedRead<MxU32>(p_data + 4) - MxStreamChunk::GetHeaderSize();
+
+	if (length > m_bytesRemaining) {
+		return FAILURE;
+	}
+
+	if (!p_source || p_source->m_mode != e_chunk) {
+		JoinPieces();
+		return CalcBytesRemaining(p_data);
+	}
+
+	Piece piece;
+	piece.m_buffer = p_source;
+	piece.m_data = p_data + MxStreamChunk::GetHeaderSize() + 8;
+	piece.m_length = length;
+	m_pieces.push_back(piece);
+
+	p_source->m_referenceCount++;
+	m_bytesRemaining -= length;
+	return SUCCESS;
+}
+
+// Copies the payload of the split chunk gathered here to p_dest
+void MxDSBuffer::CopyPieces(MxU8* p_dest)
+{
+	for (MxU32 i = 0; i < m_pieces.size(); i++) {
+		memcpy(p_dest, m_pieces[i].m_data, m_pieces[i].m_length);
+		p_dest += m_pieces[i].m_length;
+	}
+}
+
+// Copies the pieces gathered here after the header in one buffer, releases them and returns
+// the payload. Room is left for the bytes still to come.
+MxU8* MxDSBuffer::JoinPieces()
+{
+	MxU32 headerSize = PieceHeaderSize();
+	MxU32 length = m_bytesRemaining;
+
+	for (MxU32 i = 0; i < m_pieces.size(); i++) {
+		length += m_pieces[i].m_length;
+	}
+
+	MxU8* buffer = new MxU8[headerSize + length];
+	memcpy(buffer, m_pBuffer, headerSize);
+	CopyPieces(buffer + headerSize);
+
+	g_chunkStats.m_allocations++;
+	g_chunkStats.m_bytesCopied += length - m_bytesRemaining;
+	PROFILE_COUNTER("Chunk bytes copied", g_chunkStats.m_bytesCopied);
+
+	delete[] m_pBuffer;
+	m_pBuffer = buffer;
+	m_pIntoBuffer = buffer;
+	m_pIntoBuffer2 = buffer;
+	m_writeOffset = headerSize + length;
+	ReleasePieces();
+
+	return m_pBuffer + headerSize;
+}
+
+void MxDSBuffer::ReleasePieces()
+{
+	for (MxU32 i = 0; i < m_pieces.size(); i++) {
+		m_pieces[i].m_buffer->ReleaseRef(NULL);
+	}
+
+	m_pieces.clear();
+}
+
+void MxDSBuffer::GetChunkStats(ChunkStats& p_stats)
+{
+	p_stats = g_chunkStats;
+}
+
 // FUNCTION: LEGO1 0x100c6f80
 void MxDSBuffer::FUN_100c6f80(MxU32 p_writeOffset)
 {
@@ -11,7 +11,7 @@
 
 DECOMP_SIZE_ASSERT(MxDSSource, 0x14)
 DECOMP_SIZE_ASSERT(MxDSFile::ChunkHeader, 0x0c)
-DECOMP_SIZE_ASSERT(MxDSFile, 0x7c)
+DECOMP_SIZE_ASSERT(MxDSFile, 0x9c)
 
 // FUNCTION: LEGO1 0x100cc4b0
 // FUNCTION: BETA10 0x1015db90
@@ -121,6 +121,23 @@ MxStreamChunk* MxDSSubscriber::PeekData()
 	return chunk;
 }
 
+// Returns the pending chunk p_index places after the next one, without popping anything
+MxStreamChunk* MxDSSubscriber::PeekData(MxU32 p_index)
+{
+	if (m_pendingChunkCursor) {
+		MxStreamChunkListCursor cursor(&m_pendingChunks);
+		MxStreamChunk* chunk;
+
+		while (cursor.Next(chunk)) {
+			if (!p_index--) {
+				return chunk;
+			}
+		}
+	}
+
+	return NULL;
+}
+
 // FUNCTION: LEGO1 0x100b8390
 void MxDSSubscriber::FreeDataChunk(MxStreamChunk* p_chunk)
 {
@@ -141,13 +158,73 @@ void MxDSSubscriber::FreeDataChunk(MxStreamChunk* p_chunk)
 // FUNCTION: BETA10 0x10134c1d
 MxDSSubscriber* MxDSSubscriberList::Find(MxDSObject* p_object)
 {
-	for (iterator it = begin(); it != end(); it++) {
-		if (p_object->GetObjectId() == -1 || p_object->GetObjectId() == (*it)->GetObjectId()) {
+	if (p_object->GetObjectId() == -1) {
+		for (iterator it = begin(); it != end(); it++) {
 			if (p_object->GetUnknown24() == -2 || p_object->GetUnknown24() == (*it)->GetUnknown48()) {
 				return *it;
 			}
 		}
+
+		return NULL;
+	}
+
+	MxObjectIdIndex<MxDSSubscriber*>::Bucket* bucket = m_index.Find(p_object->GetObjectId());
+
+	if (bucket) {
+		for (MxObjectIdIndex<MxDSSubscriber*>::Bucket::iterator it = bucket->begin(); it != bucket->end(); it++) {
+			if (p_object->GetUnknown24() == -2 || p_object->GetUnknown24() == (**it)->GetUnknown48()) {
+				return **it;
+			}
+		}
 	}
 
 	return NULL;
 }
+
+MxDSSubscriber* MxDSSubscriberList::Find(MxU32 p_objectId, MxS16 p_unk0x48)
+{
+	MxObjectIdIndex<MxDSSubscriber*>::Bucket* bucket = m_index.Find(p_objectId);
+
+	if (bucket) {
+		for (MxObjectIdIndex<MxDSSubscriber*>::Bucket::iterator it = bucket->begin(); it != bucket->end(); it++) {
+			if ((**it)->GetUnknown48() == p_unk0x48) {
+				return **it;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+void MxDSSubscriberList::PushBack(MxDSSubscriber* p_subscriber)
+{
+	m_index.Add(p_subscriber->GetObjectId(), insert(end(), p_subscriber));
+}
+
+MxBool MxDSSubscriberList::PopFront(MxDSSubscriber*& p_subscriber)
+{
+	if (empty()) {
+		return FALSE;
+	}
+
+	p_subscriber = front();
+	m_index.Remove(p_subscriber->GetObjectId(), begin());
+	pop_front();
+	return TRUE;
+}
+
+void MxDSSubscriberList::Remove(MxDSSubscriber* p_subscriber)
+{
+	MxObjectIdIndex<MxDSSubscriber*>::Bucket* bucket = m_index.Find(p_subscriber->GetObjectId());
+
+	if (bucket) {
+		for (MxObjectIdIndex<MxDSSubscriber*>::Bucket::iterator it = bucket->begin(); it != bucket->end(); it++) {
+			if (**it == p_subscriber) {
+				iterator entry = *it;
+				m_index.Remove(p_subscriber->GetObjectId(), entry);
+				erase(entry);
+				return;
+			}
+		}
+	}
+}
@@ -0,0 +1,121 @@
+#include "mxreadaheadcache.h"
+
+#include "mxdsbuffer.h"
+#include "mxdssource.h"
+
+#include <string.h>
+
+// Reads the source's buffer size at p_offset, seeking only if the source is elsewhere
+MxBool MxReadAheadCache::ReadFromFile(MxDSSource* p_source, MxDSBuffer* p_buffer, MxU32 p_offset)
+{
+	if (p_source->GetPosition() != p_offset && p_source->Seek(p_offset, RW_SEEK_SET) != 0) {
+		return FALSE;
+	}
+
+	p_buffer->SetUnknown14(p_source->GetPosition());
+
+	if (p_source->ReadToBuffer(p_buffer) != SUCCESS) {
+		return FALSE;
+	}
+
+	p_buffer->SetUnknown1c(p_source->GetPosition());
+	return TRUE;
+}
+
+// Serves a request from a buffer read ahead earlier, if one starts at the same offset and holds enough bytes
+MxBool MxReadAheadCache::ReadFromCache(MxDSBuffer* p_buffer, MxU32 p_offset)
+{
+	for (list<MxDSBuffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); it++) {
+		MxDSBuffer* cached = *it;
+
+		if (cached->GetUnknown14() == p_offset && cached->GetWriteOffset() >= p_buffer->GetWriteOffset()) {
+			memcpy(p_buffer->GetBuffer(), cached->GetBuffer(), p_buffer->GetWriteOffset());
+			p_buffer->SetUnknown14(p_offset);
+			p_buffer->SetUnknown1c(p_offset + p_buffer->GetWriteOffset());
+
+			m_buffers.erase(it);
+			m_buffers.push_front(cached);
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+// Reads the p_size bytes at p_offset into the cache, evicting the least recently used buffers
+// beyond p_limit bytes. The read goes a slice at a time and is dropped as soon as p_abort
+// asks for it, so a request queued meanwhile waits for one slice at most. Returns TRUE if the
+// buffer was cached.
+MxBool MxReadAheadCache::ReadAhead(
+	MxDSSource* p_source,
+	MxU32 p_offset,
+	MxU32 p_size,
+	MxU32 p_limit,
+	AbortCallback p_abort,
+	void* p_data
+)
+{
+	if (p_size == 0 || p_size > p_limit || p_abort(p_data)) {
+		return FALSE;
+	}
+
+	for (list<MxDSBuffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); it++) {
+		if ((*it)->GetUnknown14() == p_offset) {
+			return FALSE;
+		}
+	}
+
+	if (p_source->GetPosition() != p_offset && p_source->Seek(p_offset, RW_SEEK_SET) != 0) {
+		return FALSE;
+	}
+
+	MxDSBuffer* buffer = new MxDSBuffer();
+
+	if (buffer->AllocateBuffer(p_size, MxDSBuffer::e_allocate) != SUCCESS) {
+		delete buffer;
+		return FALSE;
+	}
+
+	for (MxU32 read = 0; read < p_size;) {
+		// The source's position stays valid after each whole slice
+		if (read != 0 && p_abort(p_data)) {
+			delete buffer;
+			return FALSE;
+		}
+
+		MxU32 slice = p_size - read < c_sliceSize ? p_size - read : c_sliceSize;
+
+		if (p_source->Read(buffer->GetBuffer() + read, slice) != SUCCESS) {
+			// A short read at the end of the file leaves the position stale
+			delete buffer;
+			p_source->Seek(p_offset, RW_SEEK_SET);
+			return FALSE;
+		}
+
+		read += slice;
+	}
+
+	buffer->SetUnknown14(p_offset);
+	buffer->SetUnknown1c(p_offset + p_size);
+	m_buffers.push_front(buffer);
+	m_size += p_size;
+
+	while (m_size > p_limit) {
+		MxDSBuffer* oldest = m_buffers.back();
+		m_buffers.pop_back();
+		m_size -= oldest->GetWriteOffset();
+		delete oldest;
+	}
+
+	return TRUE;
+}
+
+void MxReadAheadCache::Clear()
+{
+	for (list<MxDSBuffer*>::iterator it = m_buffers.begin(); it != m_buffers.end(); it++) {
+		delete *it;
+	}
+
+	m_buffers.clear();
+	m_size = 0;
+}
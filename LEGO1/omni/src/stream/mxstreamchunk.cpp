@@ -60,22 +60,41 @@ MxU32 MxStreamChunk::ReadChunkHeader(MxU8* p_chunkData)
 // FUNCTION: BETA10 0x10151517
 MxResult MxStreamChunk::SendChunk(MxDSSubscriberList& p_subscriberList, MxBool p_append, MxS16 p_obj24val)
 {
-	for (MxDSSubscriberList::iterator it = p_subscriberList.begin(); it != p_subscriberList.end(); it++) {
-		if ((*it)->GetObjectId() == m_objectId && (*it)->GetUnknown48() == p_obj24val) {
-			if (m_flags & DS_CHUNK_END_OF_STREAM && m_buffer) {
-				m_buffer->ReleaseRef(this);
-				m_buffer = NULL;
-			}
-
-			(*it)->AddData(this, p_append);
+	MxDSSubscriber* subscriber = p_subscriberList.Find(m_objectId, p_obj24val);
 
-			return SUCCESS;
+	if (subscriber) {
+		if (m_flags & DS_CHUNK_END_OF_STREAM && m_buffer) {
+			m_buffer->ReleaseRef(this);
+			m_buffer = NULL;
 		}
+
+		subscriber->AddData(this, p_append);
+
+		return SUCCESS;
 	}
 
 	return FAILURE;
 }
 
+MxU8* MxStreamChunk::GetData()
+{
+	if (m_buffer && m_buffer->HasPieces()) {
+		m_data = m_buffer->JoinPieces();
+	}
+
+	return m_data;
+}
+
+void MxStreamChunk::CopyData(MxU8* p_dest)
+{
+	if (m_buffer && m_buffer->HasPieces()) {
+		m_buffer->CopyPieces(p_dest);
+	}
+	else {
+		memcpy(p_dest, m_data, m_length);
+	}
+}
+
 // FUNCTION: LEGO1 0x100c3170
 void MxStreamChunk::SetBuffer(MxDSBuffer* p_buffer)
 {
@@ -87,7 +87,7 @@ void MxStreamController::AddSubscriber(MxDSSubscriber* p_subscriber)
 // FUNCTION: BETA10 0x1014e7b4
 void MxStreamController::RemoveSubscriber(MxDSSubscriber* p_subscriber)
 {
-	m_subscribers.remove(p_subscriber);
+	m_subscribers.Remove(p_subscriber);
 }
 
 // FUNCTION: LEGO1 0x100c1690
@@ -348,9 +348,13 @@ MxBool MxStreamController::IsStoped(MxDSObject* p_obj)
 // FUNCTION: BETA10 0x1014f4e6
 MxNextActionDataStart* MxNextActionDataStartList::Find(MxU32 p_id, MxS16 p_value)
 {
-	for (iterator it = begin(); it != end(); it++) {
-		if (p_id == (*it)->GetObjectId() && p_value == (*it)->GetUnknown24()) {
-			return *it;
+	Bucket* bucket = m_index.Find(p_id);
+
+	if (bucket) {
+		for (Bucket::iterator it = bucket->begin(); it != bucket->end(); it++) {
+			if (p_value == (**it)->GetUnknown24()) {
+				return **it;
+			}
 		}
 	}
 
@@ -362,14 +366,28 @@ MxNextActionDataStart* MxNextActionDataStartList::Find(MxU32 p_id, MxS16 p_value
 MxNextActionDataStart* MxNextActionDataStartList::FindAndErase(MxU32 p_id, MxS16 p_value)
 {
 	MxNextActionDataStart* match = NULL;
-
-	for (iterator it = begin(); it != end(); it++) {
-		if (p_id == (*it)->GetObjectId() && (p_value == -2 || p_value == (*it)->GetUnknown24())) {
-			match = *it;
-			erase(it);
-			break;
+	Bucket* bucket = m_index.Find(p_id);
+
+	if (bucket) {
+		for (Bucket::iterator it = bucket->begin(); it != bucket->end(); it++) {
+			if (p_value == -2 || p_value == (**it)->GetUnknown24()) {
+				match = **it;
+				erase(*it);
+				break;
+			}
 		}
 	}
 
 	return match;
 }
+
+void MxNextActionDataStartList::PushBack(MxNextActionDataStart* p_data)
+{
+	m_index.Add(p_data->GetObjectId(), insert(end(), p_data));
+}
+
+MxNextActionDataStartList::iterator MxNextActionDataStartList::erase(iterator p_it)
+{
+	m_index.Remove((*p_it)->GetObjectId(), p_it);
+	return MxUtilityList<MxNextActionDataStart*>::erase(p_it);
+}
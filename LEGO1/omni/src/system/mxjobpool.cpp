@@ -0,0 +1,125 @@
+#include "mxjobpool.h"
+
+#include "mxautolock.h"
+
+#include <SDL2/SDL_stdinc.h>
+
+MxJobPool::MxJobPool()
+{
+	m_nextJob = 0;
+	m_shutdown = FALSE;
+}
+
+MxJobPool::~MxJobPool()
+{
+	Destroy();
+}
+
+// Must only be called once per pool
+MxResult MxJobPool::Create(MxS32 p_workerCount)
+{
+	if (m_startSemaphore.Init(0, p_workerCount) != SUCCESS || m_doneSemaphore.Init(0, p_workerCount) != SUCCESS) {
+		return FAILURE;
+	}
+
+	m_shutdown = FALSE;
+
+	for (MxS32 i = 0; i < p_workerCount; i++) {
+		Worker* worker = new Worker(this);
+
+		if (worker->Start(0x1000, 0) != SUCCESS) {
+			delete worker;
+			break;
+		}
+
+		m_workers.push_back(worker);
+	}
+
+	return SUCCESS;
+}
+
+void MxJobPool::Destroy()
+{
+	if (m_workers.empty()) {
+		return;
+	}
+
+	m_shutdown = TRUE;
+
+	for (MxU32 i = 0; i < m_workers.size(); i++) {
+		m_startSemaphore.Release();
+	}
+
+	for (MxU32 i = 0; i < m_workers.size(); i++) {
+		m_workers[i]->Terminate();
+		delete m_workers[i];
+	}
+
+	m_workers.clear();
+	m_jobs.clear();
+}
+
+void MxJobPool::AddJob(MxJobFunction p_function, void* p_data)
+{
+	Job job;
+	job.m_function = p_function;
+	job.m_data = p_data;
+	m_jobs.push_back(job);
+}
+
+// Returns once every queued job has finished
+void MxJobPool::RunJobs()
+{
+	if (m_jobs.empty()) {
+		return;
+	}
+
+	MxU32 i, wake = SDL_min(m_workers.size(), m_jobs.size() - 1);
+	m_nextJob = 0;
+
+	for (i = 0; i < wake; i++) {
+		m_startSemaphore.Release();
+	}
+
+	RunQueuedJobs();
+
+	for (i = 0; i < wake; i++) {
+		m_doneSemaphore.Wait();
+	}
+
+	m_jobs.clear();
+}
+
+void MxJobPool::RunQueuedJobs()
+{
+	while (TRUE) {
+		MxU32 index;
+
+		{
+			AUTOLOCK(m_criticalSection);
+			index = m_nextJob++;
+		}
+
+		if (index >= m_jobs.size()) {
+			break;
+		}
+
+		m_jobs[index].m_function(m_jobs[index].m_data);
+	}
+}
+
+MxResult MxJobPool::Worker::Run()
+{
+	while (TRUE) {
+		m_pool->m_startSemaphore.Wait();
+
+		if (m_pool->m_shutdown) {
+			break;
+		}
+
+		m_pool->RunQueuedJobs();
+		m_pool->m_doneSemaphore.Release();
+	}
+
+	return MxThread::Run();
+}
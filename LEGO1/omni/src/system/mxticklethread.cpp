@@ -3,6 +3,7 @@
 #include "decomp.h"
 #include "mxmisc.h"
 #include "mxtimer.h"
+#include "profiler.h"
 
 DECOMP_SIZE_ASSERT(MxTickleThread, 0x20)
 
@@ -19,6 +20,7 @@ MxResult MxTickleThread::Run()
 {
 	MxTimer* timer = Timer();
 	MxS32 lastTickled = -m_frequencyMS;
+	PROFILE_THREAD(m_target->ClassName());
 
 	while (IsRunning()) {
 		MxLong currentTime = timer->GetTime();
@@ -29,6 +31,7 @@ MxResult MxTickleThread::Run()
 
 		MxS32 timeRemainingMS = (m_frequencyMS - currentTime) + lastTickled;
 		if (timeRemainingMS <= 0) {
+			PROFILE_ZONE(m_target->ClassName());
 			m_target->Tickle();
 			timeRemainingMS = 0;
 			lastTickled = currentTime;
@@ -36,17 +36,48 @@ short DecodeChunks(
 	FLIC_HEADER* p_flcHeader,
 	FLIC_FRAME* p_flcFrame,
 	BYTE* p_flcSubchunks,
-	BYTE* p_decodedColorMap
+	BYTE* p_decodedColorMap,
+	RECT* p_bounds
 );
 void DecodeColors256(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_data);
 void DecodeColorPackets(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_data);
 void DecodeColorPacket(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_data, short p_index, short p_count);
 void DecodeColors64(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_data);
-void DecodeBrun(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
-void DecodeLC(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
-void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
-void DecodeBlack(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
-void DecodeCopy(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader);
+void DecodeBrun(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+);
+void DecodeLC(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+);
+void DecodeSS2(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+);
+void DecodeBlack(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+);
+void DecodeCopy(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+);
 
 // FUNCTION: LEGO1 0x100bd530
 // FUNCTION: BETA10 0x1013dd80
@@ -171,6 +202,174 @@ void WritePixelPairs(
 	}
 }
 
+// A bitmap row resolved once per decoded line. Spans written to it are clipped against the
+// bitmap width only, and the touched columns are accumulated for the changed-rect output.
+struct FlicLine {
+	BYTE* m_pixels; // NULL if the row is outside the bitmap
+	short m_row;
+	short m_left;
+	short m_right;
+};
+
+// Same clipping as ClampLine, for a row that has already been checked
+static inline int ClampColumns(LPBITMAPINFOHEADER p_bitmapHeader, short& p_column, short& p_count)
+{
+	short column = p_column;
+	short f_count = p_count;
+	short end = column + f_count;
+
+	if (end < 0 || p_bitmapHeader->biWidth <= column) {
+		return 0;
+	}
+
+	if (column < 0) {
+		f_count += column;
+		p_count = f_count;
+		p_column = 0;
+	}
+
+	if (p_bitmapHeader->biWidth < end) {
+		f_count -= end - (short) p_bitmapHeader->biWidth;
+		p_count = f_count;
+	}
+
+	if (f_count < 0) {
+		return 0;
+	}
+
+	return 1;
+}
+
+// Adds columns [p_left, p_right) of a bitmap row to p_bounds, in top-down display coordinates
+static void ExtendBounds(LPBITMAPINFOHEADER p_bitmapHeader, RECT* p_bounds, short p_row, short p_left, short p_right)
+{
+	if (p_bounds == NULL || p_left >= p_right) {
+		return;
+	}
+
+	LONG top = p_bitmapHeader->biHeight - 1 - p_row;
+
+	if (p_bounds->left >= p_bounds->right) {
+		p_bounds->left = p_left;
+		p_bounds->top = top;
+		p_bounds->right = p_right;
+		p_bounds->bottom = top + 1;
+		return;
+	}
+
+	if (p_left < p_bounds->left) {
+		p_bounds->left = p_left;
+	}
+	if (p_right > p_bounds->right) {
+		p_bounds->right = p_right;
+	}
+	if (top < p_bounds->top) {
+		p_bounds->top = top;
+	}
+	if (top + 1 > p_bounds->bottom) {
+		p_bounds->bottom = top + 1;
+	}
+}
+
+static inline void BeginLine(FlicLine& p_line, LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, short p_row)
+{
+	if (p_row < 0 || p_bitmapHeader->biHeight <= p_row) {
+		p_line.m_pixels = NULL;
+	}
+	else {
+		p_line.m_pixels = ((p_bitmapHeader->biWidth + 3) & -4) * p_row + p_pixelData;
+	}
+
+	p_line.m_row = p_row;
+	p_line.m_left = 0x7fff;
+	p_line.m_right = 0;
+}
+
+static inline void EndLine(FlicLine& p_line, LPBITMAPINFOHEADER p_bitmapHeader, RECT* p_bounds)
+{
+	ExtendBounds(p_bitmapHeader, p_bounds, p_line.m_row, p_line.m_left, p_line.m_right);
+}
+
+static inline void TouchLine(FlicLine& p_line, short p_column, short p_count)
+{
+	short right = p_column + p_count;
+	p_line.m_left = p_column < p_line.m_left ? p_column : p_line.m_left;
+	p_line.m_right = right > p_line.m_right ? right : p_line.m_right;
+}
+
+static inline void WriteLinePixel(FlicLine& p_line, LPBITMAPINFOHEADER p_bitmapHeader, short p_column, byte p_pixel)
+{
+	if (p_line.m_pixels == NULL || p_column < 0 || p_column >= p_bitmapHeader->biWidth) {
+		return;
+	}
+
+	p_line.m_pixels[p_column] = p_pixel;
+	TouchLine(p_line, p_column, 1);
+}
+
+static inline void WriteLinePixels(
+	FlicLine& p_line,
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	short p_column,
+	BYTE* p_data,
+	short p_count
+)
+{
+	short zcol = p_column;
+
+	if (p_line.m_pixels == NULL || !ClampColumns(p_bitmapHeader, p_column, p_count)) {
+		return;
+	}
+
+	memcpy(p_line.m_pixels + p_column, p_data + (p_column - zcol), p_count);
+	TouchLine(p_line, p_column, p_count);
+}
+
+static inline void WriteLinePixelRun(
+	FlicLine& p_line,
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	short p_column,
+	byte p_pixel,
+	short p_count
+)
+{
+	if (p_line.m_pixels == NULL || !ClampColumns(p_bitmapHeader, p_column, p_count)) {
+		return;
+	}
+
+	memset(p_line.m_pixels + p_column, p_pixel, p_count);
+	TouchLine(p_line, p_column, p_count);
+}
+
+static inline void WriteLinePixelPairs(
+	FlicLine& p_line,
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	short p_column,
+	WORD p_pixel,
+	short p_count
+)
+{
+	p_count <<= 1;
+
+	if (p_line.m_pixels == NULL || !ClampColumns(p_bitmapHeader, p_column, p_count)) {
+		return;
+	}
+
+	BYTE* dst = p_line.m_pixels + p_column;
+	BYTE* end = dst + (p_count & ~1);
+
+	while (dst < end) {
+		memcpy(dst, &p_pixel, sizeof(WORD));
+		dst += sizeof(WORD);
+	}
+
+	if (p_count & 1) {
+		*dst = (BYTE) p_pixel;
+	}
+
+	TouchLine(p_line, p_column, p_count);
+}
+
 // FUNCTION: LEGO1 0x100bd760
 // FUNCTION: BETA10 0x1013e097
 short DecodeChunks(
@@ -179,7 +378,8 @@ short DecodeChunks(
 	FLIC_HEADER* p_flcHeader,
 	FLIC_FRAME* p_flcFrame,
 	BYTE* p_flcSubchunks,
-	BYTE* p_decodedColorMap
+	BYTE* p_decodedColorMap,
+	RECT* p_bounds
 )
 {
 	*p_decodedColorMap = FALSE;
@@ -194,23 +394,23 @@ short DecodeChunks(
 			*p_decodedColorMap = TRUE;
 			break;
 		case FLI_CHUNK_SS2:
-			DecodeSS2(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			DecodeSS2(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader, p_bounds);
 			break;
 		case FLI_CHUNK_COLOR64:
 			DecodeColors64(p_bitmapHeader, (BYTE*) (chunk + 1));
 			*p_decodedColorMap = TRUE;
 			break;
 		case FLI_CHUNK_LC:
-			DecodeLC(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			DecodeLC(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader, p_bounds);
 			break;
 		case FLI_CHUNK_BLACK:
-			DecodeBlack(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			DecodeBlack(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader, p_bounds);
 			break;
 		case FLI_CHUNK_BRUN:
-			DecodeBrun(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			DecodeBrun(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader, p_bounds);
 			break;
 		case FLI_CHUNK_COPY:
-			DecodeCopy(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			DecodeCopy(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader, p_bounds);
 			break;
 		default:
 			break;
@@ -276,7 +476,13 @@ void DecodeColors64(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_data)
 
 // FUNCTION: LEGO1 0x100bd960
 // FUNCTION: BETA10 0x1013e384
-void DecodeBrun(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+void DecodeBrun(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+)
 {
 	short width = p_flcHeader->width;
 	short height = p_flcHeader->height;
@@ -286,6 +492,10 @@ void DecodeBrun(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_da
 	short line = height;
 	short width2 = width;
 
+	// Every line of the frame is written
+	ExtendBounds(p_bitmapHeader, p_bounds, 0, 0, width);
+	ExtendBounds(p_bitmapHeader, p_bounds, height - 1, 0, width);
+
 	while (--line >= 0) {
 		short column = 0;
 		data++;
@@ -315,7 +525,13 @@ void DecodeBrun(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_da
 
 // FUNCTION: LEGO1 0x100bda10
 // FUNCTION: BETA10 0x1013e4ca
-void DecodeLC(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+void DecodeLC(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+)
 {
 	short xofs = 0;
 	short yofs = 0;
@@ -326,35 +542,46 @@ void DecodeLC(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data
 	word_data++;
 	short lines = *word_data;
 
+	FlicLine line;
+
 	while (--lines >= 0) {
 		short column = xofs;
 		BYTE packets = *data++;
 
+		BeginLine(line, p_bitmapHeader, p_pixelData, row);
+
 		while (packets > 0) {
 			column += *data++; // skip byte
 			char type = *((char*) data++);
 
 			if (type < 0) {
 				type = -type;
-				WritePixelRun(p_bitmapHeader, p_pixelData, column, row, *data++, type);
+				WriteLinePixelRun(line, p_bitmapHeader, column, *data++, type);
 				column += type;
 				packets = packets - 1;
 			}
 			else {
-				WritePixels(p_bitmapHeader, p_pixelData, column, row, data, type);
+				WriteLinePixels(line, p_bitmapHeader, column, data, type);
 				data += type;
 				column += type;
 				packets = packets - 1;
 			}
 		}
 
+		EndLine(line, p_bitmapHeader, p_bounds);
 		row--;
 	}
 }
 
 // FUNCTION: LEGO1 0x100bdac0
 // FUNCTION: BETA10 0x1013e61d
-void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+void DecodeSS2(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+)
 {
 	short xofs = 0;
 	short yofs = 0;
@@ -378,6 +605,8 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 	// LINE: BETA10 0x1013e666
 	short row = p_flcHeader->height - yofs - 1;
 
+	FlicLine line;
+
 	goto start_packet;
 
 skip_lines:
@@ -388,6 +617,7 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 start_packet:
 	// LINE: BETA10 0x1013e692
 	token = *(short*) data.word++;
+	BeginLine(line, p_bitmapHeader, p_pixelData, row);
 
 	if (token >= 0) {
 		goto column_loop;
@@ -397,11 +627,12 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 		goto skip_lines;
 	}
 
-	WritePixel(p_bitmapHeader, p_pixelData, xmax, row, token);
+	WriteLinePixel(line, p_bitmapHeader, xmax, token);
 	token = *(short*) data.word++;
 
 	// LINE: BETA10 0x1013e6ef
 	if (!token) {
+		EndLine(line, p_bitmapHeader, p_bounds);
 		row--;
 		if (--lines > 0) {
 			goto start_packet;
@@ -422,13 +653,14 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 		type += type;
 
 		if (type >= 0) {
-			WritePixels(p_bitmapHeader, p_pixelData, column, row, data.byte, type);
+			WriteLinePixels(line, p_bitmapHeader, column, data.byte, type);
 			column += type;
 			data.byte += type;
 			// LINE: BETA10 0x1013e797
 			if (--token != 0) {
 				goto column_loop_inner;
 			}
+			EndLine(line, p_bitmapHeader, p_bounds);
 			row--;
 			if (--lines > 0) {
 				goto start_packet;
@@ -438,12 +670,13 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 
 		type = -type;
 		WORD* p_pixel = data.word++;
-		WritePixelPairs(p_bitmapHeader, p_pixelData, column, row, *p_pixel, type >> 1);
+		WriteLinePixelPairs(line, p_bitmapHeader, column, *p_pixel, type >> 1);
 		column += type;
 		// LINE: BETA10 0x1013e813
 		if (--token != 0) {
 			goto column_loop_inner;
 		}
+		EndLine(line, p_bitmapHeader, p_bounds);
 		row--;
 		if (--lines > 0) {
 			goto start_packet;
@@ -454,36 +687,49 @@ void DecodeSS2(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_dat
 
 // FUNCTION: LEGO1 0x100bdc00
 // FUNCTION: BETA10 0x1013e85a
-void DecodeBlack(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+void DecodeBlack(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+)
 {
 	short height = p_flcHeader->height;
 	short width = p_flcHeader->width;
 	short t_col = 0;
 	short t_row = 0;
 
-	BYTE pixel[2];
-	pixel[0] = pixel[1] = 0;
+	FlicLine line;
 
 	for (short i = height - 1; i >= 0; i--) {
-		WritePixelPairs(p_bitmapHeader, p_pixelData, t_col, t_row + i, *(WORD*) pixel, width / 2);
-
-		if (width & 1) {
-			WritePixel(p_bitmapHeader, p_pixelData, t_col + width - 1, t_row + i, 0);
-		}
+		BeginLine(line, p_bitmapHeader, p_pixelData, t_row + i);
+		WriteLinePixelRun(line, p_bitmapHeader, t_col, 0, width);
+		EndLine(line, p_bitmapHeader, p_bounds);
 	}
 }
 
 // FUNCTION: LEGO1 0x100bdc90
 // FUNCTION: BETA10 0x1013e91f
-void DecodeCopy(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, BYTE* p_data, FLIC_HEADER* p_flcHeader)
+void DecodeCopy(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader,
+	RECT* p_bounds
+)
 {
 	short height = p_flcHeader->height;
 	short width = p_flcHeader->width;
 	short t_col = 0;
 	short t_row = 0;
 
+	FlicLine line;
+
 	for (short i = height - 1; i >= 0; i--) {
-		WritePixels(p_bitmapHeader, p_pixelData, t_col, t_row + i, p_data, width);
+		BeginLine(line, p_bitmapHeader, p_pixelData, t_row + i);
+		WriteLinePixels(line, p_bitmapHeader, t_col, p_data, width);
+		EndLine(line, p_bitmapHeader, p_bounds);
 		p_data += width;
 	}
 }
@@ -495,15 +741,28 @@ void DecodeFLCFrame(
 	BYTE* p_pixelData,
 	FLIC_HEADER* p_flcHeader,
 	FLIC_FRAME* p_flcFrame,
-	BYTE* p_decodedColorMap
+	BYTE* p_decodedColorMap,
+	RECT* p_bounds
 )
 {
+	if (p_bounds != NULL) {
+		p_bounds->left = p_bounds->top = p_bounds->right = p_bounds->bottom = 0;
+	}
+
 	FLIC_FRAME* frame = p_flcFrame;
 	if (frame->type != FLI_CHUNK_FRAME) {
 		return;
 	}
 
-	if (DecodeChunks(p_bitmapHeader, p_pixelData, p_flcHeader, frame, (BYTE*) (p_flcFrame + 1), p_decodedColorMap)) {
+	if (DecodeChunks(
+			p_bitmapHeader,
+			p_pixelData,
+			p_flcHeader,
+			frame,
+			(BYTE*) (p_flcFrame + 1),
+			p_decodedColorMap,
+			p_bounds
+		)) {
 		return;
 	}
 }
@@ -5,6 +5,7 @@
 #include "mxmisc.h"
 #include "mxomni.h"
 #include "mxpalette.h"
+#include "mxpaletteblit.h"
 #include "mxutilities.h"
 #include "mxvideomanager.h"
 
@@ -42,6 +43,7 @@ void MxDisplaySurface::Init()
 	m_ddSurface2 = NULL;
 	m_ddClipper = NULL;
 	m_16bitPal = NULL;
+	m_32bitPal = NULL;
 	m_initialized = FALSE;
 	memset(&m_surfaceDesc, 0, sizeof(m_surfaceDesc));
 }
@@ -115,6 +117,31 @@ MxU8 MxDisplaySurface::CountContiguousBitsSetTo1(MxU32 p_param)
 	return count;
 }
 
+// Converts the color channels of an RGB565 color to the 32-bit surface format, the way SetPalette
+// converts palette entries. Each output bit comes from one byte of p_color, so converting the two
+// bytes separately and OR-ing the results gives the conversion of the whole color.
+MxU32 MxDisplaySurface::Convert565To32(MxU16 p_color)
+{
+	MxU32 red = (p_color >> 11) & 0x1f;
+	MxU32 green = (p_color >> 5) & 0x3f;
+	MxU32 blue = p_color & 0x1f;
+
+	red = (red << 3) | (red >> 2);
+	green = (green << 2) | (green >> 4);
+	blue = (blue << 3) | (blue >> 2);
+
+	MxU8 contiguousBitsRed = CountContiguousBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwRBitMask);
+	MxU8 totalBitsRed = CountTotalBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwRBitMask);
+	MxU8 contiguousBitsGreen = CountContiguousBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwGBitMask);
+	MxU8 totalBitsGreen = CountTotalBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwGBitMask);
+	MxU8 contiguousBitsBlue = CountContiguousBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwBBitMask);
+	MxU8 totalBitsBlue = CountTotalBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwBBitMask);
+
+	return ((red >> (8 - totalBitsRed)) << contiguousBitsRed) |
+		   ((green >> (8 - totalBitsGreen)) << contiguousBitsGreen) |
+		   ((blue >> (8 - totalBitsBlue)) << contiguousBitsBlue);
+}
+
 // FUNCTION: LEGO1 0x100ba790
 MxResult MxDisplaySurface::Init(
 	MxVideoParam& p_videoParam,
@@ -287,6 +314,10 @@ void MxDisplaySurface::Destroy()
 		delete[] m_16bitPal;
 	}
 
+	if (m_32bitPal) {
+		delete[] m_32bitPal;
+	}
+
 	Init();
 }
 
@@ -321,7 +352,7 @@ void MxDisplaySurface::SetPalette(MxPalette* p_palette)
 		break;
 	case 16: {
 		if (!m_16bitPal) {
-			m_16bitPal = new MxU16[256];
+			m_16bitPal = new MxU16[PALETTE16_SIZE];
 		}
 
 		PALETTEENTRY palette[256];
@@ -340,6 +371,35 @@ void MxDisplaySurface::SetPalette(MxPalette* p_palette)
 							((palette[i].peBlue >> (8 - totalBitsBlue)) << contiguousBitsBlue);
 		}
 
+		m_16bitPal[256] = 0;
+
+		break;
+	}
+	case 32: {
+		if (!m_32bitPal) {
+			m_32bitPal = new MxU32[256];
+		}
+
+		PALETTEENTRY palette[256];
+		p_palette->GetEntries(palette);
+
+		MxU8 contiguousBitsRed = CountContiguousBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwRBitMask);
+		MxU8 totalBitsRed = CountTotalBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwRBitMask);
+		MxU8 contiguousBitsGreen = CountContiguousBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwGBitMask);
+		MxU8 totalBitsGreen = CountTotalBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwGBitMask);
+		MxU8 contiguousBitsBlue = CountContiguousBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwBBitMask);
+		MxU8 totalBitsBlue = CountTotalBitsSetTo1(m_surfaceDesc.ddpfPixelFormat.dwBBitMask);
+
+		// Bits outside the color masks hold alpha or padding; keep them set so pixels stay opaque
+		MxU32 alpha = ~(m_surfaceDesc.ddpfPixelFormat.dwRBitMask | m_surfaceDesc.ddpfPixelFormat.dwGBitMask |
+						m_surfaceDesc.ddpfPixelFormat.dwBBitMask);
+
+		for (MxS32 i = 0; i < 256; i++) {
+			m_32bitPal[i] = ((palette[i].peRed >> (8 - totalBitsRed)) << contiguousBitsRed) |
+							((palette[i].peGreen >> (8 - totalBitsGreen)) << contiguousBitsGreen) |
+							((palette[i].peBlue >> (8 - totalBitsBlue)) << contiguousBitsBlue) | alpha;
+		}
+
 		break;
 	}
 	default:
@@ -396,74 +456,40 @@ void MxDisplaySurface::VTable0x28(
 		switch (m_surfaceDesc.ddpfPixelFormat.dwRGBBitCount) {
 		case 8: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + p_right + (p_bottom * ddsd.lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-			MxLong length = -2 * p_width + ddsd.lPitch;
 			while (p_height--) {
-				MxU8* surfaceBefore = surface;
-
-				for (MxS32 i = 0; p_width > i; i++) {
-					*surface++ = *data;
-					*surface++ = *data++;
-				}
+				CopyRowDoubled8(surface, data, p_width);
+				memcpy(surface + ddsd.lPitch, surface, 2 * p_width);
 
 				data += stride;
-				surface += length;
-
-				memcpy(surface, surfaceBefore, 2 * p_width);
-				surface += ddsd.lPitch;
+				surface += 2 * ddsd.lPitch;
 			}
 			break;
 		}
 		case 16: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + (2 * p_right) + (p_bottom * ddsd.lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxS32 length = -4 * p_width + ddsd.lPitch;
-			MxS32 height = p_height;
-			MxS32 width = p_width;
-			MxS32 copyWidth = width * 4;
-			MxU16* p16bitPal = m_16bitPal;
-
-			MxS32 i;
-			if (!stride && !length) {
-				while (height--) {
-					MxU8* surfaceBefore = surface;
-
-					for (i = 0; i < width; i++) {
-						MxU16 element = p16bitPal[*data];
-						*(MxU16*) surface = element;
-						surface += 2;
-						*(MxU16*) surface = element;
-
-						data++;
-						surface += 2;
-					}
-
-					memcpy(surface, surfaceBefore, copyWidth);
-					surface += ddsd.lPitch;
-				}
-			}
-			else {
-				while (height--) {
-					MxU8* surfaceBefore = surface;
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-					for (i = 0; i < width; i++) {
-						MxU16 element = p16bitPal[*data];
-						*(MxU16*) surface = element;
-						surface += 2;
-						*(MxU16*) surface = element;
+			while (p_height--) {
+				ExpandRowDoubled16((MxU16*) surface, data, p_width, m_16bitPal);
+				memcpy(surface + ddsd.lPitch, surface, 4 * p_width);
 
-						data++;
-						surface += 2;
-					}
+				data += stride;
+				surface += 2 * ddsd.lPitch;
+			}
+			break;
+		}
+		case 32: {
+			MxU8* surface = (MxU8*) ddsd.lpSurface + (4 * p_right) + (p_bottom * ddsd.lPitch);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-					data += stride;
-					surface += length;
+			while (p_height--) {
+				ExpandRowDoubled32((MxU32*) surface, data, p_width, m_32bitPal);
+				memcpy(surface + ddsd.lPitch, surface, 8 * p_width);
 
-					memcpy(surface, surfaceBefore, p_width * 4);
-					surface += ddsd.lPitch;
-				}
+				data += stride;
+				surface += 2 * ddsd.lPitch;
 			}
 			break;
 		}
@@ -487,15 +513,23 @@ void MxDisplaySurface::VTable0x28(
 		}
 		case 16: {
 			MxU8* surface = (MxU8*) ddsd.lpSurface + (2 * p_right) + (p_bottom * ddsd.lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-			MxLong length = -2 * p_width + ddsd.lPitch;
-			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					*(MxU16*) surface = m_16bitPal[*data++];
-					surface += 2;
-				}
+			MxLong length = ddsd.lPitch;
+			while (p_height--) {
+				ExpandRow16((MxU16*) surface, data, p_width, m_16bitPal);
+				data += stride;
+				surface += length;
+			}
+			break;
+		}
+		case 32: {
+			MxU8* surface = (MxU8*) ddsd.lpSurface + (4 * p_right) + (p_bottom * ddsd.lPitch);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
+			MxLong length = ddsd.lPitch;
+			while (p_height--) {
+				ExpandRow32((MxU32*) surface, data, p_width, m_32bitPal);
 				data += stride;
 				surface += length;
 			}
@@ -560,19 +594,11 @@ void MxDisplaySurface::VTable0x30(
 			DrawTransparentRLE(data, surface, size, p_width, p_height, ddsd.lPitch, 8);
 		}
 		else {
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-			MxLong length = -p_width + ddsd.lPitch;
+			MxLong length = ddsd.lPitch;
 			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					if (*data != 0) {
-						*surface = *data;
-					}
-
-					data++;
-					surface++;
-				}
-
+				CopyRowTransparent8(surface, data, p_width);
 				data += stride;
 				surface += length;
 			}
@@ -586,19 +612,29 @@ void MxDisplaySurface::VTable0x30(
 			DrawTransparentRLE(data, surface, size, p_width, p_height, ddsd.lPitch, 16);
 		}
 		else {
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-			MxLong length = -2 * p_width + ddsd.lPitch;
+			MxLong length = ddsd.lPitch;
 			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					if (*data != 0) {
-						*(MxU16*) surface = m_16bitPal[*data];
-					}
-
-					data++;
-					surface += 2;
-				}
+				ExpandRowTransparent16((MxU16*) surface, data, p_width, m_16bitPal);
+				data += stride;
+				surface += length;
+			}
+		}
+		break;
+	}
+	case 32: {
+		MxU8* surface = (MxU8*) ddsd.lpSurface + (4 * p_right) + (p_bottom * ddsd.lPitch);
+		if (p_RLE) {
+			MxS32 size = p_bitmap->GetBmiHeader()->biSizeImage;
+			DrawTransparentRLE(data, surface, size, p_width, p_height, ddsd.lPitch, 32);
+		}
+		else {
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
+			MxLong length = ddsd.lPitch;
+			for (MxS32 i = 0; i < p_height; i++) {
+				ExpandRowTransparent32((MxU32*) surface, data, p_width, m_32bitPal);
 				data += stride;
 				surface += length;
 			}
@@ -636,14 +672,15 @@ void MxDisplaySurface::DrawTransparentRLE(
 	// The total number of pixels drawn or skipped
 	MxU32 count = 0;
 
-	// Used in both 8 and 16 bit branches
+	// Used in both 8 and 16/32 bit branches
 	MxU32 skipCount;
 	MxU32 drawCount;
 	MxU32 t;
+	MxS32 bytesPerPixel = p_bpp / 8;
 
-	if (p_bpp == 16) {
+	if (p_bpp != 8) {
 		// DECOMP: why goto?
-		goto sixteen_bit;
+		goto expand_palette;
 	}
 
 	while (p_bitmapData < end) {
@@ -703,7 +740,7 @@ void MxDisplaySurface::DrawTransparentRLE(
 	}
 	return;
 
-sixteen_bit:
+expand_palette:
 	while (p_bitmapData < end) {
 		skipCount = *p_bitmapData++;
 		t = *p_bitmapData++;
@@ -715,13 +752,13 @@ void MxDisplaySurface::DrawTransparentRLE(
 		count += skipCount;
 
 		if (skipCount >= rowRemainder) {
-			p_surfaceData += 2 * rowRemainder;
+			p_surfaceData += bytesPerPixel * rowRemainder;
 			skipCount -= rowRemainder;
-			p_surfaceData += p_pitch - 2 * p_width;
+			p_surfaceData += p_pitch - bytesPerPixel * p_width;
 			p_surfaceData += p_pitch * (skipCount / p_width);
 		}
 
-		p_surfaceData += 2 * (skipCount % p_width);
+		p_surfaceData += bytesPerPixel * (skipCount % p_width);
 		if (p_bitmapData >= end) {
 			break;
 		}
@@ -736,35 +773,35 @@ void MxDisplaySurface::DrawTransparentRLE(
 		count += drawCount;
 
 		if (drawCount >= rowRemainder) {
-			// memcpy
-			for (MxU32 j = 0; j < rowRemainder; j++) {
-				*((MxU16*) p_surfaceData) = m_16bitPal[*p_bitmapData++];
-				p_surfaceData += 2;
-			}
-
+			ExpandRun(p_surfaceData, p_bitmapData, rowRemainder, p_bpp);
 			drawCount -= rowRemainder;
 
-			p_surfaceData += p_pitch - 2 * p_width;
+			p_surfaceData += p_pitch - bytesPerPixel * p_width;
 			MxS32 rows = drawCount / p_width;
 
 			for (MxU32 i = 0; i < rows; i++) {
-				// memcpy
-				for (MxS32 j = 0; j < p_width; j++) {
-					*((MxU16*) p_surfaceData) = m_16bitPal[*p_bitmapData++];
-					p_surfaceData += 2;
-				}
-
-				p_surfaceData += p_pitch - 2 * p_width;
+				ExpandRun(p_surfaceData, p_bitmapData, p_width, p_bpp);
+				p_surfaceData += p_pitch - bytesPerPixel * p_width;
 			}
 		}
 
-		MxS32 tail = drawCount % p_width;
-		// memcpy
-		for (MxS32 j = 0; j < tail; j++) {
-			*((MxU16*) p_surfaceData) = m_16bitPal[*p_bitmapData++];
-			p_surfaceData += 2;
-		}
+		ExpandRun(p_surfaceData, p_bitmapData, drawCount % p_width, p_bpp);
+	}
+}
+
+// Expands p_count palette indices to 16 or 32 bit pixels and advances both pointers
+void MxDisplaySurface::ExpandRun(MxU8*& p_surfaceData, MxU8*& p_bitmapData, MxS32 p_count, MxU8 p_bpp)
+{
+	if (p_bpp == 32) {
+		ExpandRow32((MxU32*) p_surfaceData, p_bitmapData, p_count, m_32bitPal);
+		p_surfaceData += 4 * p_count;
+	}
+	else {
+		ExpandRow16((MxU16*) p_surfaceData, p_bitmapData, p_count, m_16bitPal);
+		p_surfaceData += 2 * p_count;
 	}
+
+	p_bitmapData += p_count;
 }
 
 // FUNCTION: LEGO1 0x100bb850
@@ -822,15 +859,46 @@ void MxDisplaySurface::VTable0x34(MxU8* p_pixels, MxS32 p_bpp, MxS32 p_width, Mx
 				MxLong length = -2 * p_width + surfaceDesc.lPitch;
 
 				for (MxS32 i = 0; i < p_height; i++) {
-					for (MxS32 j = 0; j < p_width; j++) {
-						*(MxU16*) dst = m_16bitPal[*pixels++];
-						dst += 2;
-					}
+					ExpandRow16((MxU16*) dst, pixels, p_width, m_16bitPal);
+					pixels += p_width;
+					dst += 2 * p_width;
 
 					pixels += stride;
 					dst += length;
 				}
 			}
+			break;
+		}
+		case 32: {
+			MxU8* dst = (MxU8*) surfaceDesc.lpSurface + p_y * surfaceDesc.lPitch + 4 * p_x;
+			MxLong length = surfaceDesc.lPitch;
+
+			if (p_bpp == 16) {
+				// Each byte of a 16-bit pixel converts on its own, so two tables cover all colors.
+				// As in SetPalette, bits outside the color masks are set so pixels stay opaque.
+				MxU32 alpha = ~(m_surfaceDesc.ddpfPixelFormat.dwRBitMask | m_surfaceDesc.ddpfPixelFormat.dwGBitMask |
+								m_surfaceDesc.ddpfPixelFormat.dwBBitMask);
+				MxU32 lowTable[256], highTable[256];
+
+				for (MxS32 i = 0; i < 256; i++) {
+					lowTable[i] = Convert565To32(i) | alpha;
+					highTable[i] = Convert565To32(i << 8);
+				}
+
+				while (p_height--) {
+					ConvertRow16To32((MxU32*) dst, (MxU16*) pixels, p_width, lowTable, highTable);
+					pixels += 2 * p_width;
+					dst += length;
+				}
+			}
+			else {
+				while (p_height--) {
+					ExpandRow32((MxU32*) dst, pixels, p_width, m_32bitPal);
+					pixels += p_width;
+					dst += length;
+				}
+			}
+			break;
 		}
 		}
 
@@ -1036,6 +1104,42 @@ LPDIRECTDRAWSURFACE MxDisplaySurface::VTable0x44(
 				surface->Unlock(ddsd.lpSurface);
 				break;
 			}
+			case 32: {
+				if (m_32bitPal == NULL) {
+					goto error;
+				}
+
+				MxU32* surfaceData32 = (MxU32*) ddsd.lpSurface;
+
+				if (p_transparent) {
+					MxU32 colorKey = ddsd.ddpfPixelFormat.dwRBitMask | ddsd.ddpfPixelFormat.dwBBitMask |
+									 ~(ddsd.ddpfPixelFormat.dwRBitMask | ddsd.ddpfPixelFormat.dwGBitMask |
+									   ddsd.ddpfPixelFormat.dwBBitMask);
+
+					for (MxS32 y = 0; y < heightAbs; y++) {
+						for (MxS32 x = 0; x < widthNormal; x++) {
+							surfaceData32[x] = bitmapSrcPtr[x] == 0 ? colorKey : m_32bitPal[bitmapSrcPtr[x]];
+						}
+
+						bitmapSrcPtr += rowSeek;
+						surfaceData32 = (MxU32*) ((MxU8*) surfaceData32 + newPitch);
+					}
+
+					DDCOLORKEY key;
+					key.dwColorSpaceLowValue = key.dwColorSpaceHighValue = colorKey;
+					surface->SetColorKey(DDCKEY_SRCBLT, &key);
+				}
+				else {
+					for (MxS32 y = 0; y < heightAbs; y++) {
+						ExpandRow32(surfaceData32, bitmapSrcPtr, widthNormal, m_32bitPal);
+						bitmapSrcPtr += rowSeek;
+						surfaceData32 = (MxU32*) ((MxU8*) surfaceData32 + newPitch);
+					}
+				}
+
+				surface->Unlock(ddsd.lpSurface);
+				break;
+			}
 			}
 		}
 	}
@@ -1091,7 +1195,7 @@ LPDIRECTDRAWSURFACE MxDisplaySurface::CreateCursorSurface()
 		return NULL;
 	}
 
-	if (ddsd.ddpfPixelFormat.dwRGBBitCount != 16) {
+	if (ddsd.ddpfPixelFormat.dwRGBBitCount != 16 && ddsd.ddpfPixelFormat.dwRGBBitCount != 32) {
 		return NULL;
 	}
 
@@ -1115,6 +1219,39 @@ LPDIRECTDRAWSURFACE MxDisplaySurface::CreateCursorSurface()
 	if (newSurface->Lock(NULL, &ddsd, DDLOCK_WAIT, NULL) != DD_OK) {
 		goto done;
 	}
+	else if (ddsd.ddpfPixelFormat.dwRGBBitCount == 32) {
+		MxU8* surface = (MxU8*) ddsd.lpSurface;
+		MxLong pitch = ddsd.lPitch;
+		MxU32 key = ddsd.ddpfPixelFormat.dwRBitMask | ddsd.ddpfPixelFormat.dwBBitMask;
+
+		// Same cursor as the 16-bit one below, with the color key in 32-bit magenta
+		for (MxS32 x = 0; x < 16; x++) {
+			MxU32* surface2 = (MxU32*) surface;
+			for (MxS32 y = 0; y < 16; y++) {
+				if ((y > 10 || x) && (x > 10 || y) && x + y != 10) {
+					if (x + y > 10) {
+						*surface2 = key;
+					}
+					else {
+						*surface2 = -1;
+					}
+				}
+				else {
+					*surface2 = 0;
+				}
+				surface2++;
+			}
+			surface += pitch;
+		}
+
+		newSurface->Unlock(ddsd.lpSurface);
+		DDCOLORKEY colorkey;
+		colorkey.dwColorSpaceHighValue = key;
+		colorkey.dwColorSpaceLowValue = key;
+		newSurface->SetColorKey(DDCKEY_SRCBLT, &colorkey);
+
+		return newSurface;
+	}
 	else {
 		MxU16* surface = (MxU16*) ddsd.lpSurface;
 		MxLong pitch = ddsd.lPitch;
@@ -1194,74 +1331,40 @@ void MxDisplaySurface::VTable0x24(
 		switch (m_surfaceDesc.ddpfPixelFormat.dwRGBBitCount) {
 		case 8: {
 			MxU8* surface = (MxU8*) p_desc->lpSurface + p_right + (p_bottom * p_desc->lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-			MxLong length = -2 * p_width + p_desc->lPitch;
 			while (p_height--) {
-				MxU8* surfaceBefore = surface;
-
-				for (MxS32 i = 0; p_width > i; i++) {
-					*surface++ = *data;
-					*surface++ = *data++;
-				}
+				CopyRowDoubled8(surface, data, p_width);
+				memcpy(surface + p_desc->lPitch, surface, 2 * p_width);
 
 				data += stride;
-				surface += length;
-
-				memcpy(surface, surfaceBefore, 2 * p_width);
-				surface += p_desc->lPitch;
+				surface += 2 * p_desc->lPitch;
 			}
 			break;
 		}
 		case 16: {
 			MxU8* surface = (MxU8*) p_desc->lpSurface + (2 * p_right) + (p_bottom * p_desc->lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
-
-			MxS32 length = -4 * p_width + p_desc->lPitch;
-			MxS32 height = p_height;
-			MxS32 width = p_width;
-			MxS32 copyWidth = width * 4;
-			MxU16* p16bitPal = m_16bitPal;
-
-			MxS32 i;
-			if (!stride && !length) {
-				while (height--) {
-					MxU8* surfaceBefore = surface;
-
-					for (i = 0; i < width; i++) {
-						MxU16 element = p16bitPal[*data];
-						*(MxU16*) surface = element;
-						surface += 2;
-						*(MxU16*) surface = element;
-
-						data++;
-						surface += 2;
-					}
-
-					memcpy(surface, surfaceBefore, copyWidth);
-					surface += p_desc->lPitch;
-				}
-			}
-			else {
-				while (height--) {
-					MxU8* surfaceBefore = surface;
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-					for (i = 0; i < width; i++) {
-						MxU16 element = p16bitPal[*data];
-						*(MxU16*) surface = element;
-						surface += 2;
-						*(MxU16*) surface = element;
+			while (p_height--) {
+				ExpandRowDoubled16((MxU16*) surface, data, p_width, m_16bitPal);
+				memcpy(surface + p_desc->lPitch, surface, 4 * p_width);
 
-						data++;
-						surface += 2;
-					}
+				data += stride;
+				surface += 2 * p_desc->lPitch;
+			}
+			break;
+		}
+		case 32: {
+			MxU8* surface = (MxU8*) p_desc->lpSurface + (4 * p_right) + (p_bottom * p_desc->lPitch);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-					data += stride;
-					surface += length;
+			while (p_height--) {
+				ExpandRowDoubled32((MxU32*) surface, data, p_width, m_32bitPal);
+				memcpy(surface + p_desc->lPitch, surface, 8 * p_width);
 
-					memcpy(surface, surfaceBefore, p_width * 4);
-					surface += p_desc->lPitch;
-				}
+				data += stride;
+				surface += 2 * p_desc->lPitch;
 			}
 			break;
 		}
@@ -1285,15 +1388,23 @@ void MxDisplaySurface::VTable0x24(
 		}
 		case 16: {
 			MxU8* surface = (MxU8*) p_desc->lpSurface + (2 * p_right) + (p_bottom * p_desc->lPitch);
-			MxLong stride = -p_width + GetAdjustedStride(p_bitmap);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
-			MxLong length = -2 * p_width + p_desc->lPitch;
-			for (MxS32 i = 0; i < p_height; i++) {
-				for (MxS32 j = 0; j < p_width; j++) {
-					*(MxU16*) surface = m_16bitPal[*data++];
-					surface += 2;
-				}
+			MxLong length = p_desc->lPitch;
+			while (p_height--) {
+				ExpandRow16((MxU16*) surface, data, p_width, m_16bitPal);
+				data += stride;
+				surface += length;
+			}
+			break;
+		}
+		case 32: {
+			MxU8* surface = (MxU8*) p_desc->lpSurface + (4 * p_right) + (p_bottom * p_desc->lPitch);
+			MxLong stride = GetAdjustedStride(p_bitmap);
 
+			MxLong length = p_desc->lPitch;
+			while (p_height--) {
+				ExpandRow32((MxU32*) surface, data, p_width, m_32bitPal);
 				data += stride;
 				surface += length;
 			}
@@ -1346,15 +1457,10 @@ void MxDisplaySurface::VTable0x2c(
 			DrawTransparentRLE(src, dest, p_bitmap->GetBmiHeader()->biSizeImage, p_width, p_height, p_desc->lPitch, 8);
 		}
 		else {
-			MxLong srcSkip = GetAdjustedStride(p_bitmap) - p_width;
-			MxLong destSkip = destStride - p_width;
+			MxLong srcStride = GetAdjustedStride(p_bitmap);
 
-			for (MxS32 i = 0; i < p_height; i++, src += srcSkip, dest += destSkip) {
-				for (MxS32 j = 0; j < p_width; j++, src++, dest++) {
-					if (*src) {
-						*dest = *src;
-					}
-				}
+			for (MxS32 i = 0; i < p_height; i++, src += srcStride, dest += destStride) {
+				CopyRowTransparent8(dest, src, p_width);
 			}
 		}
 		break;
@@ -1368,15 +1474,25 @@ void MxDisplaySurface::VTable0x2c(
 		}
 		else {
 			MxLong srcStride = GetAdjustedStride(p_bitmap);
-			MxLong srcSkip = srcStride - p_width;
-			MxLong destSkip = destStride - 2 * p_width;
 
-			for (MxS32 i = 0; i < p_height; i++, src += srcSkip, dest += destSkip) {
-				for (MxS32 j = 0; j < p_width; j++, src++, dest += 2) {
-					if (*src != 0) {
-						*(MxU16*) dest = m_16bitPal[*src];
-					}
-				}
+			for (MxS32 i = 0; i < p_height; i++, src += srcStride, dest += destStride) {
+				ExpandRowTransparent16((MxU16*) dest, src, p_width, m_16bitPal);
+			}
+		}
+		break;
+	}
+	case 32: {
+		MxLong destStride = p_desc->lPitch;
+		MxU8* dest = (MxU8*) p_desc->lpSurface + (4 * p_right) + (p_bottom * p_desc->lPitch);
+
+		if (p_RLE) {
+			DrawTransparentRLE(src, dest, p_bitmap->GetBmiHeader()->biSizeImage, p_width, p_height, p_desc->lPitch, 32);
+		}
+		else {
+			MxLong srcStride = GetAdjustedStride(p_bitmap);
+
+			for (MxS32 i = 0; i < p_height; i++, src += srcStride, dest += destStride) {
+				ExpandRowTransparent32((MxU32*) dest, src, p_width, m_32bitPal);
 			}
 		}
 		break;
@@ -1402,7 +1518,7 @@ LPDIRECTDRAWSURFACE MxDisplaySurface::FUN_100bc8b0(MxS32 p_width, MxS32 p_height
 		return NULL;
 	}
 
-	if (surfaceDesc.ddpfPixelFormat.dwRGBBitCount != 16) {
+	if (surfaceDesc.ddpfPixelFormat.dwRGBBitCount != 16 && surfaceDesc.ddpfPixelFormat.dwRGBBitCount != 32) {
 		return NULL;
 	}
 
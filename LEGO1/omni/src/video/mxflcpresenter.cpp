@@ -29,7 +29,7 @@ MxFlcPresenter::~MxFlcPresenter()
 void MxFlcPresenter::LoadHeader(MxStreamChunk* p_chunk)
 {
 	m_flcHeader = (FLIC_HEADER*) new MxU8[p_chunk->GetLength()];
-	memcpy(m_flcHeader, p_chunk->GetData(), p_chunk->GetLength());
+	p_chunk->CopyData((MxU8*) m_flcHeader);
 }
 
 // FUNCTION: LEGO1 0x100b34d0
@@ -56,21 +56,35 @@ void MxFlcPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	data += rectCount * sizeof(MxRect32);
 
 	MxBool decodedColorMap;
+	RECT bounds;
 	DecodeFLCFrame(
 		&m_frameBitmap->GetBitmapInfo()->m_bmiHeader,
 		m_frameBitmap->GetImage(),
 		m_flcHeader,
 		(FLIC_FRAME*) data,
-		&decodedColorMap
+		&decodedColorMap,
+		&bounds
 	);
 
 	if (((MxDSMediaAction*) m_action)->GetPaletteManagement() && decodedColorMap) {
 		RealizePalette();
 	}
 
+	// Unless the palette changed, only the part of each stored rect the decoder wrote to needs repainting
+	MxRect32 changed(bounds.left, bounds.top, bounds.right - 1, bounds.bottom - 1);
+
 	for (MxS32 i = 0; i < rectCount; i++) {
 		MxRect32 rect = UnalignedRead<MxRect32>(rects);
 		rects += sizeof(MxRect32);
+
+		if (!decodedColorMap) {
+			rect &= changed;
+
+			if (rect.GetLeft() > rect.GetRight() || rect.GetTop() > rect.GetBottom()) {
+				continue;
+			}
+		}
+
 		rect += m_location;
 		MVideoManager()->InvalidateRect(rect);
 	}
@@ -0,0 +1,364 @@
+#include "mxpaletteblit.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MXPALETTEBLIT_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MXPALETTEBLIT_NEON
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define MXPALETTEBLIT_WASM
+#endif
+
+// AVX2 is picked at run time, so builds for baseline x86 still use it where the CPU has it
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <SDL2/SDL_cpuinfo.h>
+#include <immintrin.h>
+#define MXPALETTEBLIT_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+#define MXPALETTEBLIT_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define MXPALETTEBLIT_AVX2_TARGET
+#endif
+#endif
+
+#if defined(MXPALETTEBLIT_SSE2) || defined(MXPALETTEBLIT_WASM) ||                                                \
+	(defined(MXPALETTEBLIT_NEON) && defined(__aarch64__))
+#define MXPALETTEBLIT_CLASSIFY
+#endif
+
+#ifdef MXPALETTEBLIT_CLASSIFY
+enum {
+	c_mixedBlock,
+	c_transparentBlock,
+	c_opaqueBlock
+};
+
+// Classifies the next 16 source pixels, so fully transparent runs can be skipped
+// and fully opaque runs expanded without per-pixel tests.
+static inline MxS32 ClassifyBlock(const MxU8* p_src)
+{
+#if defined(MXPALETTEBLIT_SSE2)
+	__m128i src = _mm_loadu_si128((const __m128i*) p_src);
+	MxS32 mask = _mm_movemask_epi8(_mm_cmpeq_epi8(src, _mm_setzero_si128()));
+	return mask == 0xffff ? c_transparentBlock : mask == 0 ? c_opaqueBlock : c_mixedBlock;
+#elif defined(MXPALETTEBLIT_WASM)
+	v128_t src = wasm_v128_load(p_src);
+	MxU32 mask = wasm_i8x16_bitmask(wasm_i8x16_eq(src, wasm_i8x16_splat(0)));
+	return mask == 0xffff ? c_transparentBlock : mask == 0 ? c_opaqueBlock : c_mixedBlock;
+#else
+	uint8x16_t src = vld1q_u8(p_src);
+	return vmaxvq_u8(src) == 0 ? c_transparentBlock : vminvq_u8(src) != 0 ? c_opaqueBlock : c_mixedBlock;
+#endif
+}
+#endif
+
+template <class T>
+static inline void ExpandRow(T* p_dest, const MxU8* p_src, MxS32 p_count, const T* p_palette)
+{
+	MxS32 i = 0;
+
+	for (; i + 4 <= p_count; i += 4) {
+		p_dest[i] = p_palette[p_src[i]];
+		p_dest[i + 1] = p_palette[p_src[i + 1]];
+		p_dest[i + 2] = p_palette[p_src[i + 2]];
+		p_dest[i + 3] = p_palette[p_src[i + 3]];
+	}
+
+	for (; i < p_count; i++) {
+		p_dest[i] = p_palette[p_src[i]];
+	}
+}
+
+#ifdef MXPALETTEBLIT_AVX2
+static MxBool HasAVX2()
+{
+	static const MxBool hasAVX2 = SDL_HasAVX2();
+	return hasAVX2;
+}
+
+// Looks up 16 pixels. The 16-bit palette is gathered 32 bits at a time, which reads one entry
+// past the looked-up one, hence the padding entry the palette must have.
+MXPALETTEBLIT_AVX2_TARGET static inline __m256i Gather16(const MxU8* p_src, const MxU16* p_palette)
+{
+	__m256i mask = _mm256_set1_epi32(0xffff);
+	__m256i low = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) p_src));
+	__m256i high = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) (p_src + 8)));
+	low = _mm256_and_si256(_mm256_i32gather_epi32((const int*) p_palette, low, 2), mask);
+	high = _mm256_and_si256(_mm256_i32gather_epi32((const int*) p_palette, high, 2), mask);
+
+	// Packing works within 128-bit lanes; reorder the quadwords back into pixel order
+	return _mm256_permute4x64_epi64(_mm256_packus_epi32(low, high), 0xd8);
+}
+
+// Looks up 8 pixels
+MXPALETTEBLIT_AVX2_TARGET static inline __m256i Gather32(const MxU8* p_src, const MxU32* p_palette)
+{
+	__m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) p_src));
+	return _mm256_i32gather_epi32((const int*) p_palette, indices, 4);
+}
+
+MXPALETTEBLIT_AVX2_TARGET static MxS32 ExpandRow16AVX2(
+	MxU16* p_dest,
+	const MxU8* p_src,
+	MxS32 p_count,
+	const MxU16* p_palette
+)
+{
+	MxS32 i = 0;
+
+	for (; i + 16 <= p_count; i += 16) {
+		_mm256_storeu_si256((__m256i*) (p_dest + i), Gather16(p_src + i, p_palette));
+	}
+
+	return i;
+}
+
+MXPALETTEBLIT_AVX2_TARGET static MxS32 ExpandRowDoubled16AVX2(
+	MxU16* p_dest,
+	const MxU8* p_src,
+	MxS32 p_count,
+	const MxU16* p_palette
+)
+{
+	MxS32 i = 0;
+
+	for (; i + 16 <= p_count; i += 16) {
+		__m256i colors = Gather16(p_src + i, p_palette);
+		__m256i low = _mm256_unpacklo_epi16(colors, colors);
+		__m256i high = _mm256_unpackhi_epi16(colors, colors);
+		_mm256_storeu_si256((__m256i*) (p_dest + 2 * i), _mm256_permute2x128_si256(low, high, 0x20));
+		_mm256_storeu_si256((__m256i*) (p_dest + 2 * i + 16), _mm256_permute2x128_si256(low, high, 0x31));
+	}
+
+	return i;
+}
+
+MXPALETTEBLIT_AVX2_TARGET static MxS32 ExpandRow32AVX2(
+	MxU32* p_dest,
+	const MxU8* p_src,
+	MxS32 p_count,
+	const MxU32* p_palette
+)
+{
+	MxS32 i = 0;
+
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_si256((__m256i*) (p_dest + i), Gather32(p_src + i, p_palette));
+	}
+
+	return i;
+}
+
+MXPALETTEBLIT_AVX2_TARGET static MxS32 ExpandRowDoubled32AVX2(
+	MxU32* p_dest,
+	const MxU8* p_src,
+	MxS32 p_count,
+	const MxU32* p_palette
+)
+{
+	MxS32 i = 0;
+
+	for (; i + 8 <= p_count; i += 8) {
+		__m256i colors = Gather32(p_src + i, p_palette);
+		__m256i low = _mm256_unpacklo_epi32(colors, colors);
+		__m256i high = _mm256_unpackhi_epi32(colors, colors);
+		_mm256_storeu_si256((__m256i*) (p_dest + 2 * i), _mm256_permute2x128_si256(low, high, 0x20));
+		_mm256_storeu_si256((__m256i*) (p_dest + 2 * i + 8), _mm256_permute2x128_si256(low, high, 0x31));
+	}
+
+	return i;
+}
+#endif
+
+void ExpandRow16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	MxS32 i = 0;
+
+#ifdef MXPALETTEBLIT_AVX2
+	if (HasAVX2()) {
+		i = ExpandRow16AVX2(p_dest, p_src, p_count, p_palette);
+	}
+#endif
+
+	ExpandRow(p_dest + i, p_src + i, p_count - i, p_palette);
+}
+
+void ExpandRow32(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette)
+{
+	MxS32 i = 0;
+
+#ifdef MXPALETTEBLIT_AVX2
+	if (HasAVX2()) {
+		i = ExpandRow32AVX2(p_dest, p_src, p_count, p_palette);
+	}
+#endif
+
+	ExpandRow(p_dest + i, p_src + i, p_count - i, p_palette);
+}
+
+// Opaque blocks of the transparent expansion go through the fastest plain expansion
+static inline void ExpandBlock(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	ExpandRow16(p_dest, p_src, p_count, p_palette);
+}
+
+static inline void ExpandBlock(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette)
+{
+	ExpandRow32(p_dest, p_src, p_count, p_palette);
+}
+
+template <class T>
+static inline void ExpandRowTransparent(T* p_dest, const MxU8* p_src, MxS32 p_count, const T* p_palette)
+{
+	MxS32 i = 0;
+
+#ifdef MXPALETTEBLIT_CLASSIFY
+	for (; i + 16 <= p_count; i += 16) {
+		switch (ClassifyBlock(p_src + i)) {
+		case c_transparentBlock:
+			break;
+		case c_opaqueBlock:
+			ExpandBlock(p_dest + i, p_src + i, 16, p_palette);
+			break;
+		default:
+			for (MxS32 j = i; j < i + 16; j++) {
+				if (p_src[j] != 0) {
+					p_dest[j] = p_palette[p_src[j]];
+				}
+			}
+			break;
+		}
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		if (p_src[i] != 0) {
+			p_dest[i] = p_palette[p_src[i]];
+		}
+	}
+}
+
+template <class T>
+static inline void ExpandRowDoubled(T* p_dest, const MxU8* p_src, MxS32 p_count, const T* p_palette)
+{
+	for (MxS32 i = 0; i < p_count; i++) {
+		T color = p_palette[p_src[i]];
+		p_dest[2 * i] = color;
+		p_dest[2 * i + 1] = color;
+	}
+}
+
+void CopyRowTransparent8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count)
+{
+	MxS32 i = 0;
+
+#if defined(MXPALETTEBLIT_SSE2)
+	for (; i + 16 <= p_count; i += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i*) (p_src + i));
+		__m128i dest = _mm_loadu_si128((const __m128i*) (p_dest + i));
+		__m128i transparent = _mm_cmpeq_epi8(src, _mm_setzero_si128());
+		dest = _mm_or_si128(_mm_and_si128(transparent, dest), _mm_andnot_si128(transparent, src));
+		_mm_storeu_si128((__m128i*) (p_dest + i), dest);
+	}
+#elif defined(MXPALETTEBLIT_NEON)
+	for (; i + 16 <= p_count; i += 16) {
+		uint8x16_t src = vld1q_u8(p_src + i);
+		uint8x16_t dest = vld1q_u8(p_dest + i);
+		vst1q_u8(p_dest + i, vbslq_u8(vceqq_u8(src, vdupq_n_u8(0)), dest, src));
+	}
+#elif defined(MXPALETTEBLIT_WASM)
+	for (; i + 16 <= p_count; i += 16) {
+		v128_t src = wasm_v128_load(p_src + i);
+		v128_t dest = wasm_v128_load(p_dest + i);
+		wasm_v128_store(p_dest + i, wasm_v128_bitselect(dest, src, wasm_i8x16_eq(src, wasm_i8x16_splat(0))));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		if (p_src[i] != 0) {
+			p_dest[i] = p_src[i];
+		}
+	}
+}
+
+void CopyRowDoubled8(MxU8* p_dest, const MxU8* p_src, MxS32 p_count)
+{
+	MxS32 i = 0;
+
+#if defined(MXPALETTEBLIT_SSE2)
+	for (; i + 16 <= p_count; i += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i*) (p_src + i));
+		_mm_storeu_si128((__m128i*) (p_dest + 2 * i), _mm_unpacklo_epi8(src, src));
+		_mm_storeu_si128((__m128i*) (p_dest + 2 * i + 16), _mm_unpackhi_epi8(src, src));
+	}
+#elif defined(MXPALETTEBLIT_NEON)
+	for (; i + 16 <= p_count; i += 16) {
+		uint8x16_t src = vld1q_u8(p_src + i);
+		uint8x16x2_t doubled = vzipq_u8(src, src);
+		vst1q_u8(p_dest + 2 * i, doubled.val[0]);
+		vst1q_u8(p_dest + 2 * i + 16, doubled.val[1]);
+	}
+#elif defined(MXPALETTEBLIT_WASM)
+	for (; i + 16 <= p_count; i += 16) {
+		v128_t src = wasm_v128_load(p_src + i);
+		wasm_v128_store(
+			p_dest + 2 * i,
+			wasm_i8x16_shuffle(src, src, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7)
+		);
+		wasm_v128_store(
+			p_dest + 2 * i + 16,
+			wasm_i8x16_shuffle(src, src, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15)
+		);
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		p_dest[2 * i] = p_src[i];
+		p_dest[2 * i + 1] = p_src[i];
+	}
+}
+
+void ExpandRowTransparent16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	ExpandRowTransparent(p_dest, p_src, p_count, p_palette);
+}
+
+void ExpandRowDoubled16(MxU16* p_dest, const MxU8* p_src, MxS32 p_count, const MxU16* p_palette)
+{
+	MxS32 i = 0;
+
+#ifdef MXPALETTEBLIT_AVX2
+	if (HasAVX2()) {
+		i = ExpandRowDoubled16AVX2(p_dest, p_src, p_count, p_palette);
+	}
+#endif
+
+	ExpandRowDoubled(p_dest + 2 * i, p_src + i, p_count - i, p_palette);
+}
+
+void ExpandRowTransparent32(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette)
+{
+	ExpandRowTransparent(p_dest, p_src, p_count, p_palette);
+}
+
+void ExpandRowDoubled32(MxU32* p_dest, const MxU8* p_src, MxS32 p_count, const MxU32* p_palette)
+{
+	MxS32 i = 0;
+
+#ifdef MXPALETTEBLIT_AVX2
+	if (HasAVX2()) {
+		i = ExpandRowDoubled32AVX2(p_dest, p_src, p_count, p_palette);
+	}
+#endif
+
+	ExpandRowDoubled(p_dest + 2 * i, p_src + i, p_count - i, p_palette);
+}
+
+void ConvertRow16To32(MxU32* p_dest, const MxU16* p_src, MxS32 p_count, const MxU32* p_low, const MxU32* p_high)
+{
+	for (MxS32 i = 0; i < p_count; i++) {
+		p_dest[i] = p_low[p_src[i] & 0xff] | p_high[p_src[i] >> 8];
+	}
+}
@@ -1,12 +1,41 @@
 #include "mxsmk.h"
 
 #include "mxbitmap.h"
+#include "mxsmkdecoder.h"
 
 #include <string.h>
 
 DECOMP_SIZE_ASSERT(SmackTag, 0x390);
 DECOMP_SIZE_ASSERT(MxSmk, 0x6b8);
 
+// Decodes through the stream's own libsmacker state, which LoadFrame leaves to the worker
+// while frames are queued
+class MxSmkStreamDecoder : public MxSmkDecoder {
+public:
+	MxSmkStreamDecoder(smk p_smk, MxU32 p_videoSize)
+	{
+		m_smk = p_smk;
+		m_videoSize = p_videoSize;
+	}
+
+	~MxSmkStreamDecoder() override { Stop(); }
+
+protected:
+	void Decode(MxSmkFrame& p_frame) override
+	{
+		p_frame.m_paletteChanged = MxSmk::DecodeFrame(m_smk, p_frame.m_chunk, p_frame.m_frame);
+		memcpy(p_frame.m_video, smk_get_video(m_smk), m_videoSize);
+
+		if (p_frame.m_paletteChanged) {
+			memcpy(p_frame.m_palette, smk_get_palette(m_smk), sizeof(p_frame.m_palette));
+		}
+	}
+
+private:
+	smk m_smk;
+	MxU32 m_videoSize;
+};
+
 // FUNCTION: LEGO1 0x100c5a90
 // FUNCTION: BETA10 0x10151e70
 MxResult MxSmk::LoadHeader(MxU8* p_data, MxU32 p_length, MxSmk* p_mxSmk)
@@ -25,11 +54,48 @@ MxResult MxSmk::LoadHeader(MxU8* p_data, MxU32 p_length, MxSmk* p_mxSmk)
 // FUNCTION: BETA10 0x10152298
 void MxSmk::Destroy(MxSmk* p_mxSmk)
 {
+	delete p_mxSmk->m_decoder;
+	p_mxSmk->m_decoder = NULL;
+
 	if (p_mxSmk->m_smk != NULL) {
 		smk_close(p_mxSmk->m_smk);
 	}
 }
 
+// Starts decoding ahead on a worker thread. Without it, LoadFrame decodes each frame itself.
+MxResult MxSmk::CreateDecoder(MxSmk* p_mxSmk)
+{
+	unsigned long w, h;
+	smk_info_video(p_mxSmk->m_smk, &w, &h, NULL);
+
+	MxSmkDecoder* decoder = new MxSmkStreamDecoder(p_mxSmk->m_smk, w * h);
+
+	if (decoder->Create(w * h) != SUCCESS) {
+		delete decoder;
+		return FAILURE;
+	}
+
+	p_mxSmk->m_decoder = decoder;
+	return SUCCESS;
+}
+
+// Decodes the next frame of the stream from p_chunkData. Returns whether its palette changed.
+MxBool MxSmk::DecodeFrame(smk p_smk, MxU8* p_chunkData, MxU32 p_currentFrame)
+{
+	smk_set_chunk(p_smk, p_currentFrame, p_chunkData);
+
+	if (p_currentFrame == 0) {
+		smk_first(p_smk);
+	}
+	else {
+		smk_next(p_smk);
+	}
+
+	unsigned char frameType;
+	smk_info_all(p_smk, NULL, NULL, &frameType, NULL);
+	return frameType & 1;
+}
+
 // FUNCTION: LEGO1 0x100c5db0
 // FUNCTION: BETA10 0x10152391
 MxResult MxSmk::LoadFrame(
@@ -46,24 +112,23 @@ MxResult MxSmk::LoadFrame(
 
 	unsigned long w, h;
 	smk_info_video(p_mxSmk->m_smk, &w, &h, NULL);
-	smk_set_chunk(p_mxSmk->m_smk, p_currentFrame, p_chunkData);
 
-	if (p_currentFrame == 0) {
-		smk_first(p_mxSmk->m_smk);
+	MxSmkFrame* frame = p_mxSmk->m_decoder ? p_mxSmk->m_decoder->Wait(p_chunkData, p_currentFrame) : NULL;
+	const unsigned char* video;
+	const unsigned char* palette;
+
+	if (frame) {
+		video = frame->m_video;
+		palette = frame->m_palette;
+		p_paletteChanged = frame->m_paletteChanged;
 	}
 	else {
-		smk_next(p_mxSmk->m_smk);
+		p_paletteChanged = DecodeFrame(p_mxSmk->m_smk, p_chunkData, p_currentFrame);
+		video = smk_get_video(p_mxSmk->m_smk);
+		palette = smk_get_palette(p_mxSmk->m_smk);
 	}
 
-	memcpy(p_bitmapData, smk_get_video(p_mxSmk->m_smk), w * h);
-
-	unsigned char frameType;
-	smk_info_all(p_mxSmk->m_smk, NULL, NULL, &frameType, NULL);
-	p_paletteChanged = frameType & 1;
-
 	if (p_paletteChanged) {
-		const unsigned char* palette = smk_get_palette(p_mxSmk->m_smk);
-
 		for (MxU32 i = 0; i < 256; i++) {
 			p_bitmapInfo->m_bmiColors[i].rgbBlue = palette[i * 3 + 2];
 			p_bitmapInfo->m_bmiColors[i].rgbGreen = palette[i * 3 + 1];
@@ -71,8 +136,102 @@ MxResult MxSmk::LoadFrame(
 		}
 	}
 
-	// [library:libsmacker] Calculate changed rects
-	MxRect32* newRect = new MxRect32(0, 0, w - 1, h - 1);
-	p_list->Append(newRect);
+	if (p_currentFrame == 0 || p_paletteChanged) {
+		memcpy(p_bitmapData, video, w * h);
+
+		MxRect32* newRect = new MxRect32(0, 0, w - 1, h - 1);
+		p_list->Append(newRect);
+	}
+	else {
+		CopyChangedBlocks(p_bitmapData, video, w, h, p_list);
+	}
+
+	if (frame) {
+		p_mxSmk->m_decoder->Release();
+	}
+
 	return SUCCESS;
 }
+
+// Copies the 4x4 blocks of p_src that differ from the previous frame in p_dest and appends
+// their bounds to p_list. Runs of changed blocks in a band of four rows are merged with an
+// identical run in the band above, so static backgrounds produce no rects at all.
+void MxSmk::CopyChangedBlocks(MxU8* p_dest, const MxU8* p_src, MxS32 p_width, MxS32 p_height, MxRect32List* p_list)
+{
+	MxS32 blocks = (p_width + 3) / 4;
+	MxRect32** previous = new MxRect32*[blocks];
+	MxRect32** current = new MxRect32*[blocks];
+	MxS32 previousCount = 0;
+
+	for (MxS32 top = 0; top < p_height; top += 4) {
+		MxS32 rows = p_height - top < 4 ? p_height - top : 4;
+		MxS32 currentCount = 0;
+		MxS32 p = 0;
+		MxS32 left = 0;
+
+		while (left < p_width) {
+			if (!BlockChanged(p_dest, p_src, p_width, left, top, rows)) {
+				left += 4;
+				continue;
+			}
+
+			MxS32 right = left + 4;
+			while (right < p_width && BlockChanged(p_dest, p_src, p_width, right, top, rows)) {
+				right += 4;
+			}
+
+			if (right > p_width) {
+				right = p_width;
+			}
+
+			for (MxS32 y = top; y < top + rows; y++) {
+				memcpy(p_dest + y * p_width + left, p_src + y * p_width + left, right - left);
+			}
+
+			while (p < previousCount && previous[p]->GetLeft() < left) {
+				p++;
+			}
+
+			MxRect32* rect;
+			if (p < previousCount && previous[p]->GetLeft() == left && previous[p]->GetRight() == right - 1) {
+				rect = previous[p];
+				rect->SetBottom(top + rows - 1);
+			}
+			else {
+				rect = new MxRect32(left, top, right - 1, top + rows - 1);
+				p_list->Append(rect);
+			}
+
+			current[currentCount++] = rect;
+			left = right;
+		}
+
+		MxRect32** swap = previous;
+		previous = current;
+		current = swap;
+		previousCount = currentCount;
+	}
+
+	delete[] previous;
+	delete[] current;
+}
+
+MxBool MxSmk::BlockChanged(
+	const MxU8* p_dest,
+	const MxU8* p_src,
+	MxS32 p_width,
+	MxS32 p_left,
+	MxS32 p_top,
+	MxS32 p_rows
+)
+{
+	MxS32 length = p_width - p_left < 4 ? p_width - p_left : 4;
+
+	for (MxS32 y = p_top; y < p_top + p_rows; y++) {
+		if (memcmp(p_dest + y * p_width + p_left, p_src + y * p_width + p_left, length)) {
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
@@ -0,0 +1,211 @@
+#include "mxsmkdecoder.h"
+
+#include "profiler.h"
+
+#include <string.h>
+
+static MxBool g_decodeAhead = FALSE;
+
+MxSmkDecoder::MxSmkDecoder()
+{
+	m_head = 0;
+	m_count = 0;
+	m_decodeIndex = 0;
+	SDL_AtomicSet(&m_remainingWork, FALSE);
+
+	for (MxU32 i = 0; i < MXSMK_RING_SIZE; i++) {
+		m_frames[i].m_source = NULL;
+		m_frames[i].m_frame = 0;
+		m_frames[i].m_chunk = NULL;
+		m_frames[i].m_chunkCapacity = 0;
+		m_frames[i].m_video = NULL;
+		m_frames[i].m_paletteChanged = FALSE;
+	}
+}
+
+MxSmkDecoder::~MxSmkDecoder()
+{
+	Stop();
+	ClearTaken();
+
+	for (MxU32 i = 0; i < MXSMK_RING_SIZE; i++) {
+		delete[] m_frames[i].m_chunk;
+		delete[] m_frames[i].m_video;
+	}
+}
+
+MxResult MxSmkDecoder::Create(MxU32 p_videoSize)
+{
+	for (MxU32 i = 0; i < MXSMK_RING_SIZE; i++) {
+		m_frames[i].m_video = new MxU8[p_videoSize];
+	}
+
+	if (m_workSemaphore.Init(0, MXSMK_RING_SIZE + 1) != SUCCESS ||
+		m_readySemaphore.Init(0, MXSMK_RING_SIZE) != SUCCESS) {
+		return FAILURE;
+	}
+
+	SDL_AtomicSet(&m_remainingWork, TRUE);
+
+	if (Start(0x1000, 0) != SUCCESS) {
+		SDL_AtomicSet(&m_remainingWork, FALSE);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+MxResult MxSmkDecoder::Run()
+{
+	PROFILE_THREAD("MxSmkDecoder");
+
+	while (TRUE) {
+		m_workSemaphore.Wait();
+
+		if (!SDL_AtomicGet(&m_remainingWork)) {
+			break;
+		}
+
+		{
+			PROFILE_ZONE("MxSmkDecoder::Decode");
+			Decode(m_frames[m_decodeIndex]);
+		}
+
+		m_decodeIndex = (m_decodeIndex + 1) % MXSMK_RING_SIZE;
+		m_readySemaphore.Release();
+	}
+
+	return MxThread::Run();
+}
+
+// Stops the worker once it has finished the frame it is decoding, if any
+void MxSmkDecoder::Stop()
+{
+	if (SDL_AtomicGet(&m_remainingWork)) {
+		SDL_AtomicSet(&m_remainingWork, FALSE);
+		m_workSemaphore.Release();
+		Terminate();
+	}
+}
+
+// Queues the frame in p_chunk for decoding. Returns TRUE if the frame is queued, also if it
+// already was, and FALSE if the ring is full.
+MxBool MxSmkDecoder::Queue(const MxU8* p_chunk, MxU32 p_length, MxU32 p_frame)
+{
+	for (MxU32 i = 0; i < m_count; i++) {
+		if (m_frames[(m_head + i) % MXSMK_RING_SIZE].m_source == p_chunk) {
+			return TRUE;
+		}
+	}
+
+	if (m_count == MXSMK_RING_SIZE || !SDL_AtomicGet(&m_remainingWork)) {
+		return FALSE;
+	}
+
+	// The slot is free: its frame was taken, so the worker is done with it
+	MxSmkFrame& frame = m_frames[(m_head + m_count) % MXSMK_RING_SIZE];
+
+	if (frame.m_chunkCapacity < p_length) {
+		delete[] frame.m_chunk;
+		frame.m_chunk = new MxU8[p_length];
+		frame.m_chunkCapacity = p_length;
+	}
+
+	memcpy(frame.m_chunk, p_chunk, p_length);
+	frame.m_source = p_chunk;
+	frame.m_frame = p_frame;
+
+	m_count++;
+	m_workSemaphore.Release();
+	return TRUE;
+}
+
+// Waits for the next queued frame and returns it, to be handed back with Release. Returns NULL
+// if nothing is queued, or if the next queued frame is not the one asked for. The caller then
+// decodes the frame itself, on the state of the last frame taken.
+MxSmkFrame* MxSmkDecoder::Wait(const MxU8* p_chunk, MxU32 p_frame)
+{
+	if (!m_count) {
+		return NULL;
+	}
+
+	MxSmkFrame& frame = m_frames[m_head];
+
+	if (frame.m_source != p_chunk || frame.m_frame != p_frame) {
+		Rewind();
+		return NULL;
+	}
+
+	PROFILE_ZONE("MxSmkDecoder::Wait");
+	m_readySemaphore.Wait();
+	return &frame;
+}
+
+// Hands the frame from Wait back. Its chunk is kept for Rewind.
+void MxSmkDecoder::Release()
+{
+	MxSmkFrame& frame = m_frames[m_head];
+
+	if (frame.m_frame == 0) {
+		ClearTaken();
+	}
+
+	MxSmkTakenFrame taken;
+	taken.m_chunk = frame.m_chunk;
+	taken.m_frame = frame.m_frame;
+	m_taken.push_back(taken);
+
+	frame.m_chunk = NULL;
+	frame.m_chunkCapacity = 0;
+	m_head = (m_head + 1) % MXSMK_RING_SIZE;
+	m_count--;
+}
+
+// Waits until the worker is idle and drops every queued frame
+void MxSmkDecoder::Flush()
+{
+	while (m_count) {
+		m_readySemaphore.Wait();
+		m_head = (m_head + 1) % MXSMK_RING_SIZE;
+		m_count--;
+	}
+}
+
+// Stops decoding ahead and brings the decoder state back to the last frame taken. The worker
+// decoded the frames queued after it, so the frames taken since frame 0 are decoded over again.
+void MxSmkDecoder::Rewind()
+{
+	Flush();
+	Stop();
+
+	if (!m_taken.empty() && m_taken[0].m_frame == 0) {
+		MxSmkFrame replay = m_frames[m_head];
+
+		for (MxU32 i = 0; i < m_taken.size(); i++) {
+			replay.m_chunk = m_taken[i].m_chunk;
+			replay.m_frame = m_taken[i].m_frame;
+			Decode(replay);
+		}
+	}
+
+	ClearTaken();
+}
+
+void MxSmkDecoder::ClearTaken()
+{
+	for (MxU32 i = 0; i < m_taken.size(); i++) {
+		delete[] m_taken[i].m_chunk;
+	}
+
+	m_taken.clear();
+}
+
+void MxSmkDecoder::SetDecodeAhead(MxBool p_decodeAhead)
+{
+	g_decodeAhead = p_decodeAhead;
+}
+
+MxBool MxSmkDecoder::GetDecodeAhead()
+{
+	return g_decodeAhead;
+}
@@ -2,8 +2,10 @@
 
 #include "decomp.h"
 #include "mxdsmediaaction.h"
+#include "mxdssubscriber.h"
 #include "mxmisc.h"
 #include "mxpalette.h"
+#include "mxsmkdecoder.h"
 #include "mxvideomanager.h"
 
 #include <smacker.h>
@@ -64,6 +66,12 @@ void MxSmkPresenter::CreateBitmap()
 
 	m_frameBitmap = new MxBitmap;
 	m_frameBitmap->SetSize(w, h, NULL, FALSE);
+
+	// Looping actions may drop chunks without loading them. The decoder would rewind and stop
+	// decoding ahead at the first one, so these decode on load from the start.
+	if (MxSmkDecoder::GetDecodeAhead() && !m_mxSmk.m_decoder && !(m_action->GetFlags() & MxDSAction::c_looping)) {
+		MxSmk::CreateDecoder(&m_mxSmk);
+	}
 }
 
 // FUNCTION: LEGO1 0x100b3a00
@@ -77,6 +85,10 @@ void MxSmkPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	m_currentFrame++;
 	VTable0x88();
 
+	if (m_mxSmk.m_decoder) {
+		DecodeAhead(p_chunk);
+	}
+
 	MxRect32List rects(TRUE);
 	MxSmk::LoadFrame(bitmapInfo, bitmapData, &m_mxSmk, chunkData, paletteChanged, m_currentFrame - 1, &rects);
 
@@ -95,6 +107,26 @@ void MxSmkPresenter::LoadFrame(MxStreamChunk* p_chunk)
 	}
 }
 
+// Queues p_chunk, which is loaded now, and the chunks pending after it, so the worker decodes them
+// while their frames wait for their time
+void MxSmkPresenter::DecodeAhead(MxStreamChunk* p_chunk)
+{
+	MxSmkDecoder* decoder = m_mxSmk.m_decoder;
+
+	if (!decoder->Queue(p_chunk->GetData(), p_chunk->GetLength(), m_currentFrame - 1) || !m_subscriber) {
+		return;
+	}
+
+	for (MxU32 i = 0; i < MXSMK_RING_SIZE - 1; i++) {
+		MxStreamChunk* chunk = m_subscriber->PeekData(i);
+
+		if (!chunk || chunk->GetChunkFlags() & (DS_CHUNK_END_OF_STREAM | DS_CHUNK_BIT3) ||
+			!decoder->Queue(chunk->GetData(), chunk->GetLength(), m_currentFrame + i)) {
+			break;
+		}
+	}
+}
+
 // FUNCTION: LEGO1 0x100b4260
 void MxSmkPresenter::VTable0x88()
 {
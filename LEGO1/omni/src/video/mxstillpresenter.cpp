@@ -42,7 +42,7 @@ void MxStillPresenter::LoadHeader(MxStreamChunk* p_chunk)
 
 	MxU8* data = new MxU8[p_chunk->GetLength()];
 	m_bitmapInfo = (MxBITMAPINFO*) data;
-	memcpy(m_bitmapInfo, p_chunk->GetData(), p_chunk->GetLength());
+	p_chunk->CopyData((MxU8*) m_bitmapInfo);
 }
 
 // FUNCTION: LEGO1 0x100b9d10
@@ -70,7 +70,7 @@ void MxStillPresenter::NextFrame()
 // FUNCTION: LEGO1 0x100b9dd0
 void MxStillPresenter::LoadFrame(MxStreamChunk* p_chunk)
 {
-	memcpy(m_frameBitmap->GetImage(), p_chunk->GetData(), p_chunk->GetLength());
+	p_chunk->CopyData(m_frameBitmap->GetImage());
 
 	// MxRect32 rect(m_location, MxSize32(GetWidth(), GetHeight()));
 	MxS32 height = GetHeight() - 1;
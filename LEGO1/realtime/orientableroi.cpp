@@ -1,11 +1,17 @@
 #include "orientableroi.h"
 
 #include "decomp.h"
+#include "profiler.h"
 
 #include <vec.h>
 
 DECOMP_SIZE_ASSERT(OrientableROI, 0xdc)
 
+#ifdef ISLE_PROFILER
+unsigned int g_worldTransformCount = 0;
+unsigned int g_worldBoundsCount = 0;
+#endif
+
 // FUNCTION: LEGO1 0x100a4420
 OrientableROI::OrientableROI()
 {
@@ -17,6 +23,7 @@ OrientableROI::OrientableROI()
 	IDENTMAT4(m_local2world);
 
 	m_parentROI = NULL;
+	m_unk0xd8 = 0;
 	SetNeedsWorldDataUpdate(TRUE);
 }
 
@@ -110,6 +117,7 @@ void OrientableROI::SetLocal2World(const Matrix4& p_local2world)
 // FUNCTION: LEGO1 0x100a5910
 void OrientableROI::UpdateWorldData()
 {
+	m_unk0xd8 &= ~c_worldBoundsDirty;
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 }
@@ -118,6 +126,7 @@ void OrientableROI::UpdateWorldData()
 void OrientableROI::SetLocal2WorldWithWorldDataUpdate(const Matrix4& p_transform)
 {
 	m_local2world = p_transform;
+	m_unk0xd8 &= ~c_worldBoundsDirty;
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 }
@@ -127,6 +136,7 @@ void OrientableROI::UpdateWorldDataWithTransform(const Matrix4& p_transform)
 {
 	MxMatrix l_matrix(m_local2world);
 	m_local2world.Product(p_transform, l_matrix);
+	m_unk0xd8 &= ~c_worldBoundsDirty;
 	UpdateWorldBoundingVolumes();
 	UpdateWorldVelocity();
 }
@@ -136,8 +146,14 @@ void OrientableROI::UpdateWorldDataWithTransformAndChildren(const Matrix4& p_tra
 {
 	MxMatrix l_matrix(m_local2world);
 	m_local2world.Product(l_matrix, p_transform);
-	UpdateWorldBoundingVolumes();
-	UpdateWorldVelocity();
+#ifdef ISLE_PROFILER
+	g_worldTransformCount++;
+#endif
+
+	// Bounding volumes (and, in ViewROI, the geometry transform) are only derived
+	// from m_local2world, so defer them until they are read or the view manager
+	// resolves them before rendering.
+	m_unk0xd8 |= c_worldBoundsDirty | c_worldTransformDirty;
 
 	// iterate over comps
 	if (comp) {
@@ -148,6 +164,29 @@ void OrientableROI::UpdateWorldDataWithTransformAndChildren(const Matrix4& p_tra
 	}
 }
 
+void OrientableROI::ResolveWorldBoundingVolumes() const
+{
+	if (m_unk0xd8 & c_worldBoundsDirty) {
+		OrientableROI* roi = const_cast<OrientableROI*>(this);
+		roi->m_unk0xd8 &= ~c_worldBoundsDirty;
+		roi->UpdateWorldBoundingVolumes();
+		roi->UpdateWorldVelocity();
+#ifdef ISLE_PROFILER
+		g_worldBoundsCount++;
+#endif
+	}
+}
+
+#ifdef ISLE_PROFILER
+void OrientableROI::RecordWorldDataCounts()
+{
+	PROFILE_COUNTER("ROI world transforms", g_worldTransformCount);
+	PROFILE_COUNTER("ROI world bounds", g_worldBoundsCount);
+	g_worldTransformCount = 0;
+	g_worldBoundsCount = 0;
+}
+#endif
+
 // FUNCTION: LEGO1 0x100a5a30
 void OrientableROI::SetWorldVelocity(const Vector3& p_world_velocity)
 {
@@ -188,17 +227,20 @@ void CalcWorldBoundingVolumes(
 // FUNCTION: LEGO1 0x100a5d80
 const float* OrientableROI::GetWorldVelocity() const
 {
+	ResolveWorldBoundingVolumes();
 	return m_world_velocity.GetData();
 }
 
 // FUNCTION: LEGO1 0x100a5d90
 const BoundingBox& OrientableROI::GetWorldBoundingBox() const
 {
+	ResolveWorldBoundingVolumes();
 	return m_world_bounding_box;
 }
 
 // FUNCTION: LEGO1 0x100a5da0
 const BoundingSphere& OrientableROI::GetWorldBoundingSphere() const
 {
+	ResolveWorldBoundingVolumes();
 	return m_world_bounding_sphere;
 }
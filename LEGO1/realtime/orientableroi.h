@@ -17,7 +17,10 @@ class OrientableROI : public ROI {
 public:
 	enum {
 		c_bit1 = 0x01,
-		c_bit2 = 0x02
+		c_bit2 = 0x02,
+		c_worldBoundsDirty = 0x04,
+		c_worldTransformDirty = 0x08,
+		c_worldTransformQueued = 0x10
 	};
 
 	OrientableROI();
@@ -42,6 +45,13 @@ class OrientableROI : public ROI {
 	void GetLocalTransform(Matrix4& p_transform);
 	void SetLocal2World(const Matrix4& p_local2world);
 	void SetWorldVelocity(const Vector3& p_world_velocity);
+	void ResolveWorldBoundingVolumes() const;
+
+#ifdef ISLE_PROFILER
+	// Records the world matrices and bounding volumes computed since the last call as
+	// profiler counters. Called once per frame by the view manager.
+	static void RecordWorldDataCounts();
+#endif
 
 	// FUNCTION: BETA10 0x1000fbf0
 	const Matrix4& GetLocal2World() const { return m_local2world; }
@@ -60,6 +70,8 @@ class OrientableROI : public ROI {
 
 	void SetParentROI(OrientableROI* p_parentROI) { m_parentROI = p_parentROI; }
 
+	BOOL IsWorldTransformDirty() const { return (m_unk0xd8 & c_worldTransformDirty) != 0; }
+
 	// FUNCTION: BETA10 0x10168800
 	void SetNeedsWorldDataUpdate(BOOL p_needsWorldDataUpdate)
 	{
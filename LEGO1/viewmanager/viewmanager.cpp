@@ -1,6 +1,7 @@
 #include "viewmanager.h"
 
 #include "mxdirectx/mxstopwatch.h"
+#include "profiler.h"
 #include "tgl/d3drm/impl.h"
 #include "viewlod.h"
 
@@ -97,6 +98,7 @@ void ViewManager::Remove(ViewROI* p_roi)
 	for (CompoundObject::iterator it = rois.begin(); it != rois.end(); it++) {
 		if (*it == p_roi) {
 			rois.erase(it);
+			roi_names.Remove(p_roi);
 
 			if (p_roi->GetUnknown0xe0() >= 0) {
 				RemoveROIDetailFromScene(p_roi);
@@ -126,6 +128,7 @@ void ViewManager::RemoveAll(ViewROI* p_roi)
 		}
 
 		rois.erase(rois.begin(), rois.end());
+		roi_names.Clear();
 	}
 	else {
 		if (p_roi->GetUnknown0xe0() >= 0) {
@@ -222,6 +225,8 @@ void ViewManager::RemoveROIDetailFromScene(ViewROI* p_roi)
 // FUNCTION: LEGO1 0x100a66f0
 inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, int p_und)
 {
+	p_roi->ResolveWorldData();
+
 	if (!p_roi->GetVisibility() && p_und != -2) {
 		ManageVisibilityAndDetailRecursively(p_roi, -2);
 	}
@@ -276,12 +281,16 @@ inline void ViewManager::ManageVisibilityAndDetailRecursively(ViewROI* p_roi, in
 // FUNCTION: LEGO1 0x100a6930
 void ViewManager::Update(float p_previousRenderTime, float)
 {
+	PROFILE_ZONE("ViewManager::Update");
 	MxStopWatch stopWatch;
 	stopWatch.Start();
 
 	prev_render_time = p_previousRenderTime;
 	flags |= c_bit1;
 
+	// Includes ROIs in subtrees that the visibility pass below skips
+	ViewROI::FlushWorldTransforms();
+
 	if (flags & c_bit3) {
 		CalculateFrustumTransformations();
 	}
@@ -295,6 +304,10 @@ void ViewManager::Update(float p_previousRenderTime, float)
 
 	stopWatch.Stop();
 	g_elapsedSeconds = stopWatch.ElapsedSeconds();
+
+#ifdef ISLE_PROFILER
+	OrientableROI::RecordWorldDataCounts();
+#endif
 }
 
 inline int ViewManager::CalculateFrustumTransformations()
@@ -493,6 +506,8 @@ ViewROI* ViewManager::Pick(Tgl::View* p_view, unsigned int x, unsigned int y)
 	TglImpl::ViewImpl* view = (TglImpl::ViewImpl*) p_view;
 	IDirect3DRMViewport* d3drm = view->ImplementationData();
 
+	ViewROI::FlushWorldTransforms();
+
 	if (d3drm->Pick(x, y, &picked) != D3DRM_OK) {
 		return NULL;
 	}
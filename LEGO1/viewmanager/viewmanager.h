@@ -5,6 +5,7 @@
 #include "lego1_export.h"
 #include "realtime/realtimeview.h"
 #include "viewroi.h"
+#include "viewroinameindex.h"
 
 #ifdef MINIWIN
 #include "miniwin/d3drm.h"
@@ -34,6 +35,8 @@ class ViewManager {
 	void SetPOVSource(const OrientableROI* point_of_view);
 	float ProjectedSize(const BoundingSphere& p_bounding_sphere);
 	ViewROI* Pick(Tgl::View* p_view, unsigned int x, unsigned int y);
+	ViewROI* FindROI(const char* p_name) { return roi_names.Find(p_name); }
+	void RenameROI(ViewROI* p_roi, const char* p_oldName) { roi_names.Rename(p_roi, p_oldName); }
 	void SetResolution(int width, int height);
 	void SetFrustrum(float fov, float front, float back);
 	inline void ManageVisibilityAndDetailRecursively(ViewROI* p_roi, int p_und);
@@ -48,7 +51,11 @@ class ViewManager {
 	const CompoundObject& GetROIs() { return rois; }
 
 	// FUNCTION: BETA10 0x100e1260
-	void Add(ViewROI* p_roi) { rois.push_back(p_roi); }
+	void Add(ViewROI* p_roi)
+	{
+		rois.push_back(p_roi);
+		roi_names.Add(p_roi);
+	}
 
 	// SYNTHETIC: LEGO1 0x100a6000
 	// ViewManager::`scalar deleting destructor'
@@ -73,6 +80,8 @@ class ViewManager {
 	IDirect3DRM2* d3drm;            // 0x1b0
 	IDirect3DRMFrame2* frame;       // 0x1b4
 	float seconds_allowed;          // 0x1b8
+
+	ViewROINameIndex roi_names;
 };
 
 // TEMPLATE: LEGO1 0x10022030
@@ -4,11 +4,14 @@
 
 #include <vec.h>
 
-DECOMP_SIZE_ASSERT(ViewROI, 0xe4)
+DECOMP_SIZE_ASSERT(ViewROI, 0xe8)
 
 // GLOBAL: LEGO1 0x101013d8
 unsigned char g_lightSupport = FALSE;
 
+// ROIs whose geometry transform was deferred since the last flush
+vector<ViewROI*> g_queuedWorldTransforms;
+
 // FUNCTION: LEGO1 0x100a9eb0
 float ViewROI::IntrinsicImportance() const
 {
@@ -30,14 +33,13 @@ const Tgl::Group* ViewROI::GetGeometry() const
 // FUNCTION: LEGO1 0x100a9ee0
 void ViewROI::UpdateWorldDataWithTransformAndChildren(const Matrix4& parent2world)
 {
+	// The geometry transformation is marked dirty here and pushed to the
+	// renderer by FlushWorldTransforms() or ResolveWorldData().
 	OrientableROI::UpdateWorldDataWithTransformAndChildren(parent2world);
 
-	if (geometry) {
-		Tgl::FloatMatrix4 matrix;
-		Matrix4 in(matrix);
-		SETMAT4(in, m_local2world);
-		Tgl::Result result = geometry->SetTransformation(matrix);
-		// assert(Tgl::Succeeded(result));
+	if (!(m_unk0xd8 & c_worldTransformQueued)) {
+		m_unk0xd8 |= c_worldTransformQueued;
+		g_queuedWorldTransforms.push_back(this);
 	}
 }
 
@@ -45,6 +47,8 @@ void ViewROI::UpdateWorldDataWithTransformAndChildren(const Matrix4& parent2worl
 void ViewROI::UpdateWorldDataWithTransform(const Matrix4& p_transform)
 {
 	OrientableROI::UpdateWorldDataWithTransform(p_transform);
+	m_unk0xd8 &= ~c_worldTransformDirty;
+
 	if (geometry) {
 		Tgl::FloatMatrix4 matrix;
 		Matrix4 in(matrix);
@@ -57,6 +61,8 @@ void ViewROI::UpdateWorldDataWithTransform(const Matrix4& p_transform)
 void ViewROI::SetLocal2WorldWithWorldDataUpdate(const Matrix4& p_transform)
 {
 	OrientableROI::SetLocal2WorldWithWorldDataUpdate(p_transform);
+	m_unk0xd8 &= ~c_worldTransformDirty;
+
 	if (geometry) {
 		Tgl::FloatMatrix4 matrix;
 		Matrix4 in(matrix);
@@ -69,6 +75,8 @@ void ViewROI::SetLocal2WorldWithWorldDataUpdate(const Matrix4& p_transform)
 void ViewROI::UpdateWorldData()
 {
 	OrientableROI::UpdateWorldData();
+	m_unk0xd8 &= ~c_worldTransformDirty;
+
 	if (geometry) {
 		Tgl::FloatMatrix4 matrix;
 		Matrix4 in(matrix);
@@ -77,6 +85,50 @@ void ViewROI::UpdateWorldData()
 	}
 }
 
+void ViewROI::ResolveWorldData()
+{
+	ResolveWorldBoundingVolumes();
+	ResolveWorldTransform();
+}
+
+void ViewROI::ResolveWorldTransform()
+{
+	if (m_unk0xd8 & c_worldTransformDirty) {
+		m_unk0xd8 &= ~c_worldTransformDirty;
+
+		if (geometry) {
+			Tgl::FloatMatrix4 matrix;
+			Matrix4 in(matrix);
+			SETMAT4(in, m_local2world);
+			geometry->SetTransformation(matrix);
+		}
+	}
+}
+
+void ViewROI::FlushWorldTransforms()
+{
+	for (size_t i = 0; i < g_queuedWorldTransforms.size(); i++) {
+		ViewROI* roi = g_queuedWorldTransforms[i];
+		roi->m_unk0xd8 &= ~c_worldTransformQueued;
+		roi->ResolveWorldTransform();
+	}
+
+	g_queuedWorldTransforms.clear();
+}
+
+void ViewROI::UnqueueWorldTransform()
+{
+	for (size_t i = 0; i < g_queuedWorldTransforms.size(); i++) {
+		if (g_queuedWorldTransforms[i] == this) {
+			g_queuedWorldTransforms[i] = g_queuedWorldTransforms.back();
+			g_queuedWorldTransforms.pop_back();
+			break;
+		}
+	}
+
+	m_unk0xd8 &= ~c_worldTransformQueued;
+}
+
 // FUNCTION: LEGO1 0x100aa500
 unsigned char ViewROI::SetLightSupport(unsigned char p_lightSupport)
 {
@@ -13,7 +13,7 @@
 */
 
 // VTABLE: LEGO1 0x100dbe70
-// SIZE 0xe4
+// SIZE 0xe8
 class ViewROI : public OrientableROI {
 public:
 	ViewROI(Tgl::Renderer* pRenderer, ViewLODList* lodList)
@@ -21,6 +21,7 @@ class ViewROI : public OrientableROI {
 		SetLODList(lodList);
 		geometry = pRenderer->CreateGroup();
 		m_unk0xe0 = -1;
+		m_name = NULL;
 	}
 
 	// FUNCTION: LEGO1 0x100a9e20
@@ -29,6 +30,10 @@ class ViewROI : public OrientableROI {
 		// SetLODList() will decrease refCount of LODList
 		SetLODList(0);
 		delete geometry;
+
+		if (m_unk0xd8 & c_worldTransformQueued) {
+			UnqueueWorldTransform();
+		}
 	}
 
 	void SetLODList(ViewLODList* lodList)
@@ -56,16 +61,31 @@ class ViewROI : public OrientableROI {
 	virtual Tgl::Group* GetGeometry();                                           // vtable+0x30
 	virtual const Tgl::Group* GetGeometry() const;                               // vtable+0x34
 
+	void ResolveWorldData();
+	void ResolveWorldTransform();
+
+	// Pushes the pending world transforms of all ROIs moved since the last flush to the
+	// renderer. Called before the renderer draws or picks.
+	static void FlushWorldTransforms();
+
 	int GetUnknown0xe0() { return m_unk0xe0; }
 	void SetUnknown0xe0(int p_unk0xe0) { m_unk0xe0 = p_unk0xe0; }
 
+	// Name used by ViewManager::FindROI. Plain ViewROIs are unnamed.
+	const char* GetName() const { return m_name; }
+
 	static unsigned char SetLightSupport(unsigned char p_lightSupport);
 
 protected:
 	void UpdateWorldDataWithTransformAndChildren(const Matrix4& parent2world) override; // vtable+0x28
 
+	void UnqueueWorldTransform();
+
 	Tgl::Group* geometry; // 0xdc
 	int m_unk0xe0;        // 0xe0
+
+	// Owned and set by LegoROI
+	char* m_name; // 0xe4
 };
 
 // SYNTHETIC: LEGO1 0x100aa250
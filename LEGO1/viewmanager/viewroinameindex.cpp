@@ -0,0 +1,106 @@
+#include "viewroinameindex.h"
+
+#include "mxutilities.h"
+#include "viewroi.h"
+
+#include <SDL2/SDL_stdinc.h>
+
+// Unnamed ROIs share the key of the empty name, which Find never looks up.
+unsigned int ViewROINameIndex::HashName(const char* p_name)
+{
+	return HashStringNoCase(p_name != NULL ? p_name : "");
+}
+
+void ViewROINameIndex::Add(ViewROI* p_roi)
+{
+	m_buckets[HashName(p_roi->GetName())].push_back(Entry(m_sequence++, p_roi));
+}
+
+void ViewROINameIndex::Remove(ViewROI* p_roi)
+{
+	unordered_map<unsigned int, Bucket>::iterator bucket = m_buckets.find(HashName(p_roi->GetName()));
+
+	if (bucket == m_buckets.end()) {
+		return;
+	}
+
+	Bucket& entries = bucket->second;
+
+	for (Bucket::iterator it = entries.begin(); it != entries.end(); it++) {
+		if (it->second == p_roi) {
+			entries.erase(it);
+			break;
+		}
+	}
+
+	if (entries.empty()) {
+		m_buckets.erase(bucket);
+	}
+}
+
+// Moves p_roi to the bucket of its new name, keeping each bucket in list order.
+// ROIs that are not in the index are ignored.
+void ViewROINameIndex::Rename(ViewROI* p_roi, const char* p_oldName)
+{
+	unsigned int oldKey = HashName(p_oldName);
+	unsigned int newKey = HashName(p_roi->GetName());
+
+	if (oldKey == newKey) {
+		return;
+	}
+
+	unordered_map<unsigned int, Bucket>::iterator bucket = m_buckets.find(oldKey);
+
+	if (bucket == m_buckets.end()) {
+		return;
+	}
+
+	Bucket& oldEntries = bucket->second;
+	Bucket* newEntries = NULL;
+
+	for (Bucket::iterator it = oldEntries.begin(); it != oldEntries.end();) {
+		if (it->second == p_roi) {
+			if (newEntries == NULL) {
+				newEntries = &m_buckets[newKey];
+			}
+
+			Bucket::iterator pos = newEntries->begin();
+
+			while (pos != newEntries->end() && pos->first < it->first) {
+				pos++;
+			}
+
+			newEntries->insert(pos, *it);
+			it = oldEntries.erase(it);
+		}
+		else {
+			it++;
+		}
+	}
+
+	if (oldEntries.empty()) {
+		m_buckets.erase(oldKey);
+	}
+}
+
+// Returns the first ROI added with a case-insensitively matching name
+ViewROI* ViewROINameIndex::Find(const char* p_name) const
+{
+	if (p_name == NULL || *p_name == '\0') {
+		return NULL;
+	}
+
+	unordered_map<unsigned int, Bucket>::const_iterator bucket = m_buckets.find(HashName(p_name));
+
+	if (bucket != m_buckets.end()) {
+		for (Bucket::const_iterator it = bucket->second.begin(); it != bucket->second.end(); it++) {
+			const char* name = it->second->GetName();
+
+			if (name != NULL && !SDL_strcasecmp(name, p_name)) {
+				return it->second;
+			}
+		}
+	}
+
+	return NULL;
+}
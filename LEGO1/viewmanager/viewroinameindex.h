@@ -0,0 +1,30 @@
+#ifndef VIEWROINAMEINDEX_H
+#define VIEWROINAMEINDEX_H
+
+#include "mxstl/stlcompat.h"
+
+class ViewROI;
+
+// Hash index of ROIs by name, used by ViewManager::FindROI. Each bucket keeps its ROIs
+// in the order they were added, so Find returns the first match in the manager's list.
+class ViewROINameIndex {
+public:
+	ViewROINameIndex() : m_sequence(0) {}
+
+	void Add(ViewROI* p_roi);
+	void Remove(ViewROI* p_roi);
+	void Rename(ViewROI* p_roi, const char* p_oldName);
+	void Clear() { m_buckets.clear(); }
+	ViewROI* Find(const char* p_name) const;
+
+private:
+	typedef pair<unsigned int, ViewROI*> Entry;
+	typedef vector<Entry> Bucket;
+
+	static unsigned int HashName(const char* p_name);
+
+	unordered_map<unsigned int, Bucket> m_buckets;
+	unsigned int m_sequence;
+};
+
+#endif // VIEWROINAMEINDEX_H
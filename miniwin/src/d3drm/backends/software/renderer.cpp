@@ -3,6 +3,7 @@
 #include "ddsurface_impl.h"
 #include "mathutils.h"
 #include "miniwin.h"
+#include "profiler.h"
 
 #include <SDL2/SDL.h>
 #include <algorithm>
@@ -477,6 +478,7 @@ void Direct3DRMSoftwareRenderer::SubmitDraw(
 	const Appearance& appearance
 )
 {
+	PROFILE_ZONE("Direct3DRMSoftwareRenderer::SubmitDraw");
 	D3DRMMATRIX4D mvMatrix;
 	MultiplyMatrix(mvMatrix, worldMatrix, m_viewMatrix);
 
@@ -494,6 +496,7 @@ void Direct3DRMSoftwareRenderer::SubmitDraw(
 
 HRESULT Direct3DRMSoftwareRenderer::FinalizeFrame()
 {
+	PROFILE_ZONE("Direct3DRMSoftwareRenderer::FinalizeFrame");
 	SDL_UnlockSurface(DDBackBuffer);
 
 	return DD_OK;
@@ -5,6 +5,7 @@
 #include "ddraw_impl.h"
 #include "mathutils.h"
 #include "miniwin.h"
+#include "profiler.h"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_stdinc.h>
@@ -338,6 +339,7 @@ void Direct3DRMViewportImpl::CollectMeshesFromFrame(IDirect3DRMFrame* frame, D3D
 
 HRESULT Direct3DRMViewportImpl::RenderScene()
 {
+	PROFILE_ZONE("Direct3DRMViewportImpl::RenderScene");
 	m_backgroundColor = static_cast<Direct3DRMFrameImpl*>(m_rootFrame)->m_backgroundColor;
 
 	// Compute view-projection matrix
@@ -0,0 +1,436 @@
+#ifndef FLICREFERENCE_H
+#define FLICREFERENCE_H
+
+// The FLIC pixel chunk decoders as they were before DecodeFLCFrame resolved each row once, on
+// the per-pixel WritePixel helpers flic.cpp still exports, and generators for random chunks of
+// each type. Shared by flictest and flicbenchmark.
+
+#include "flic.h"
+#include "mxstl/stlcompat.h"
+
+#include <string.h>
+
+void WritePixel(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, short p_column, short p_row, byte p_pixel);
+void WritePixels(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	short p_column,
+	short p_row,
+	BYTE* p_data,
+	short p_count
+);
+void WritePixelRun(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	short p_column,
+	short p_row,
+	byte p_pixel,
+	short p_count
+);
+void WritePixelPairs(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	short p_column,
+	short p_row,
+	WORD p_pixel,
+	short p_count
+);
+
+static unsigned int g_seed = 1;
+
+static unsigned int Random(unsigned int p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static void ReferenceDecodeBrun(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader
+)
+{
+	short width = p_flcHeader->width;
+	short height = p_flcHeader->height;
+	BYTE* data = p_data;
+	BYTE* offset = ((p_bitmapHeader->biWidth + 3) & -4) * (height - 1) + p_pixelData;
+
+	short line = height;
+	short width2 = width;
+
+	while (--line >= 0) {
+		short column = 0;
+		data++;
+		char count = 0;
+		while ((column += count) < width2) {
+			count = *data++;
+
+			short i;
+			if (count >= 0) {
+				for (i = 0; i < count; i++) {
+					*offset++ = *data;
+				}
+
+				data++;
+			}
+			else {
+				count = -count;
+				for (i = 0; i < count; i++) {
+					*offset++ = *data++;
+				}
+			}
+		}
+
+		offset -= (((p_bitmapHeader->biWidth + 3) & -4) + width);
+	}
+}
+
+static void ReferenceDecodeLC(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader
+)
+{
+	short xofs = 0;
+	short yofs = 0;
+	short* word_data = (short*) p_data;
+	BYTE* data = (BYTE*) word_data + 4;
+	short row = p_flcHeader->height - (*word_data + yofs) - 1;
+
+	word_data++;
+	short lines = *word_data;
+
+	while (--lines >= 0) {
+		short column = xofs;
+		BYTE packets = *data++;
+
+		while (packets > 0) {
+			column += *data++; // skip byte
+			char type = *((char*) data++);
+
+			if (type < 0) {
+				type = -type;
+				WritePixelRun(p_bitmapHeader, p_pixelData, column, row, *data++, type);
+				column += type;
+				packets = packets - 1;
+			}
+			else {
+				WritePixels(p_bitmapHeader, p_pixelData, column, row, data, type);
+				data += type;
+				column += type;
+				packets = packets - 1;
+			}
+		}
+
+		row--;
+	}
+}
+
+static void ReferenceDecodeSS2(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader
+)
+{
+	short xofs = 0;
+	short yofs = 0;
+
+	short width = p_flcHeader->width;
+	short token = 0;
+
+	short xmax = xofs + width - 1;
+
+	union {
+		BYTE* byte;
+		WORD* word;
+	} data = {p_data};
+
+	// The first word in the data following the chunk header contains the number of lines in the chunk.
+	// The line count does not include skipped lines.
+	short lines = *(short*) data.word++;
+
+	short row = p_flcHeader->height - yofs - 1;
+
+	goto start_packet;
+
+skip_lines:
+	row += token;
+
+start_packet:
+	token = *(short*) data.word++;
+
+	if (token >= 0) {
+		goto column_loop;
+	}
+
+	if ((unsigned short) token & 0x4000) {
+		goto skip_lines;
+	}
+
+	WritePixel(p_bitmapHeader, p_pixelData, xmax, row, token);
+	token = *(short*) data.word++;
+
+	if (!token) {
+		row--;
+		if (--lines > 0) {
+			goto start_packet;
+		}
+		return;
+	}
+	else {
+
+	column_loop:
+		short column = xofs;
+
+	column_loop_inner:
+		column += *data.byte++;
+		short type = *(char*) data.byte++;
+		type += type;
+
+		if (type >= 0) {
+			WritePixels(p_bitmapHeader, p_pixelData, column, row, data.byte, type);
+			column += type;
+			data.byte += type;
+			if (--token != 0) {
+				goto column_loop_inner;
+			}
+			row--;
+			if (--lines > 0) {
+				goto start_packet;
+			}
+			return;
+		}
+
+		type = -type;
+		WORD* p_pixel = data.word++;
+		WritePixelPairs(p_bitmapHeader, p_pixelData, column, row, *p_pixel, type >> 1);
+		column += type;
+		if (--token != 0) {
+			goto column_loop_inner;
+		}
+		row--;
+		if (--lines > 0) {
+			goto start_packet;
+		}
+		return;
+	}
+}
+
+static void ReferenceDecodeBlack(LPBITMAPINFOHEADER p_bitmapHeader, BYTE* p_pixelData, FLIC_HEADER* p_flcHeader)
+{
+	short height = p_flcHeader->height;
+	short width = p_flcHeader->width;
+
+	for (short i = height - 1; i >= 0; i--) {
+		WritePixelPairs(p_bitmapHeader, p_pixelData, 0, i, 0, width / 2);
+
+		if (width & 1) {
+			WritePixel(p_bitmapHeader, p_pixelData, width - 1, i, 0);
+		}
+	}
+}
+
+static void ReferenceDecodeCopy(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	BYTE* p_data,
+	FLIC_HEADER* p_flcHeader
+)
+{
+	short height = p_flcHeader->height;
+	short width = p_flcHeader->width;
+
+	for (short i = height - 1; i >= 0; i--) {
+		WritePixels(p_bitmapHeader, p_pixelData, 0, i, p_data, width);
+		p_data += width;
+	}
+}
+
+static void ReferenceDecodeFLCFrame(
+	LPBITMAPINFOHEADER p_bitmapHeader,
+	BYTE* p_pixelData,
+	FLIC_HEADER* p_flcHeader,
+	FLIC_FRAME* p_flcFrame
+)
+{
+	BYTE* subchunks = (BYTE*) (p_flcFrame + 1);
+
+	for (short subchunk = 0; subchunk < (short) p_flcFrame->chunks; subchunk++) {
+		FLIC_CHUNK* chunk = (FLIC_CHUNK*) subchunks;
+		subchunks += chunk->size;
+
+		switch (chunk->type) {
+		case FLI_CHUNK_SS2:
+			ReferenceDecodeSS2(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			break;
+		case FLI_CHUNK_LC:
+			ReferenceDecodeLC(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			break;
+		case FLI_CHUNK_BLACK:
+			ReferenceDecodeBlack(p_bitmapHeader, p_pixelData, p_flcHeader);
+			break;
+		case FLI_CHUNK_BRUN:
+			ReferenceDecodeBrun(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			break;
+		case FLI_CHUNK_COPY:
+			ReferenceDecodeCopy(p_bitmapHeader, p_pixelData, (BYTE*) (chunk + 1), p_flcHeader);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void AppendWord(vector<BYTE>& p_data, WORD p_word)
+{
+	p_data.push_back(p_word & 0xff);
+	p_data.push_back(p_word >> 8);
+}
+
+// Lines of runs and literals that cover each line exactly, as BRUN requires
+static void AppendBrun(vector<BYTE>& p_data, short p_width, short p_height)
+{
+	for (short line = 0; line < p_height; line++) {
+		p_data.push_back(0);
+
+		for (short column = 0; column < p_width;) {
+			short count = 1 + Random(p_width - column < 127 ? p_width - column : 127);
+
+			if (Random(2)) {
+				p_data.push_back(count);
+				p_data.push_back(Random(256));
+			}
+			else {
+				p_data.push_back(-count);
+				for (short i = 0; i < count; i++) {
+					p_data.push_back(Random(256));
+				}
+			}
+
+			column += count;
+		}
+	}
+}
+
+// Lines from a random first line, with packets that may skip past the right edge
+static void AppendLC(vector<BYTE>& p_data, short p_width, short p_height)
+{
+	short first = Random(p_height);
+	short lines = Random(p_height - first + 1);
+
+	AppendWord(p_data, first);
+	AppendWord(p_data, lines);
+
+	for (short line = 0; line < lines; line++) {
+		BYTE packets = Random(5);
+		p_data.push_back(packets);
+
+		for (BYTE packet = 0; packet < packets; packet++) {
+			p_data.push_back(Random(p_width / 2 + 1));
+			char type = Random(41) - 20;
+			p_data.push_back(type);
+
+			if (type < 0) {
+				p_data.push_back(Random(256));
+			}
+			else {
+				for (char i = 0; i < type; i++) {
+					p_data.push_back(Random(256));
+				}
+			}
+		}
+	}
+}
+
+// Lines with skipped lines and last-pixel words between them, which may run off the bottom
+static void AppendSS2(vector<BYTE>& p_data, short p_width, short p_height)
+{
+	short lines = 1 + Random(p_height);
+	AppendWord(p_data, lines);
+
+	for (short line = 0; line < lines; line++) {
+		if (Random(4) == 0) {
+			AppendWord(p_data, -(short) (1 + Random(3)));
+		}
+
+		short packets = Random(4);
+
+		if (Random(4) == 0) {
+			AppendWord(p_data, 0x8000 | Random(256));
+		}
+		else if (packets == 0) {
+			packets = 1;
+		}
+
+		AppendWord(p_data, packets);
+
+		for (short packet = 0; packet < packets; packet++) {
+			p_data.push_back(Random(p_width / 2 + 1));
+			char type = Random(21) - 10;
+			p_data.push_back(type);
+
+			if (type < 0) {
+				AppendWord(p_data, Random(0x10000));
+			}
+			else {
+				for (short i = 0; i < type * 2; i++) {
+					p_data.push_back(Random(256));
+				}
+			}
+		}
+	}
+}
+
+static void AppendCopy(vector<BYTE>& p_data, short p_width, short p_height)
+{
+	for (int i = 0; i < p_width * p_height; i++) {
+		p_data.push_back(Random(256));
+	}
+}
+
+// Builds a frame of p_count pixel chunks of the given types, with slack after it for decoders
+// that read a word past the end
+static void BuildFrame(vector<BYTE>& p_frame, const WORD* p_types, WORD p_count, short p_width, short p_height)
+{
+	p_frame.assign(sizeof(FLIC_FRAME), 0);
+
+	for (WORD i = 0; i < p_count; i++) {
+		vector<BYTE> data;
+
+		switch (p_types[i]) {
+		case FLI_CHUNK_BRUN:
+			AppendBrun(data, p_width, p_height);
+			break;
+		case FLI_CHUNK_LC:
+			AppendLC(data, p_width, p_height);
+			break;
+		case FLI_CHUNK_SS2:
+			AppendSS2(data, p_width, p_height);
+			break;
+		case FLI_CHUNK_COPY:
+			AppendCopy(data, p_width, p_height);
+			break;
+		default:
+			break;
+		}
+
+		DWORD size = sizeof(FLIC_CHUNK) + data.size();
+		for (int b = 0; b < 4; b++) {
+			p_frame.push_back((size >> (b * 8)) & 0xff);
+		}
+
+		AppendWord(p_frame, p_types[i]);
+		p_frame.insert(p_frame.end(), data.begin(), data.end());
+	}
+
+	FLIC_FRAME* frame = (FLIC_FRAME*) &p_frame[0];
+	frame->size = p_frame.size();
+	frame->type = FLI_CHUNK_FRAME;
+	frame->chunks = p_count;
+	p_frame.resize(p_frame.size() + 64);
+}
+
+#endif // FLICREFERENCE_H
@@ -0,0 +1,130 @@
+// Decodes random BRUN, LC, SS2, COPY and BLACK frames with DecodeFLCFrame and with the
+// decoders it replaced, into bitmaps the size of the frame, smaller than it (so lines are
+// clipped) and larger than it. Both must leave the same bytes behind, and every byte
+// DecodeFLCFrame changes must lie inside the bounds it reports.
+
+#include "flicreference.h"
+#include "mxtypes.h"
+
+#include <stdio.h>
+
+#define FRAMES 20000
+#define MAX_SIZE 80
+#define GUARD 1024
+
+struct Bitmap {
+	BITMAPINFOHEADER m_header;
+	RGBQUAD m_palette[256];
+};
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestFrame(
+	const WORD* p_types,
+	WORD p_count,
+	short p_width,
+	short p_height,
+	LONG p_bitmapWidth,
+	LONG p_bitmapHeight
+)
+{
+	vector<BYTE> frame;
+	BuildFrame(frame, p_types, p_count, p_width, p_height);
+
+	FLIC_HEADER header;
+	memset(&header, 0, sizeof(header));
+	header.width = p_width;
+	header.height = p_height;
+
+	Bitmap bitmap;
+	memset(&bitmap, 0, sizeof(bitmap));
+	bitmap.m_header.biSize = sizeof(BITMAPINFOHEADER);
+	bitmap.m_header.biWidth = p_bitmapWidth;
+	bitmap.m_header.biHeight = p_bitmapHeight;
+
+	// The bytes after the bitmap catch writes past its last row
+	LONG stride = (p_bitmapWidth + 3) & -4;
+	vector<BYTE> before(stride * p_bitmapHeight + GUARD);
+
+	for (size_t i = 0; i < before.size(); i++) {
+		before[i] = Random(256);
+	}
+
+	vector<BYTE> expected = before;
+	vector<BYTE> actual = before;
+	BYTE decodedColorMap;
+	RECT bounds;
+
+	ReferenceDecodeFLCFrame(&bitmap.m_header, &expected[0], &header, (FLIC_FRAME*) &frame[0]);
+	DecodeFLCFrame(&bitmap.m_header, &actual[0], &header, (FLIC_FRAME*) &frame[0], &decodedColorMap, &bounds);
+	CHECK(actual == expected);
+
+	for (size_t i = 0; i < actual.size(); i++) {
+		if (actual[i] != before[i]) {
+			// Bounds are top-down, bitmap rows bottom-up
+			LONG row = i / stride;
+			LONG column = i % stride;
+			LONG top = p_bitmapHeight - 1 - row;
+
+			CHECK(row < p_bitmapHeight);
+			CHECK(column >= bounds.left && column < bounds.right);
+			CHECK(top >= bounds.top && top < bounds.bottom);
+		}
+	}
+
+	return TRUE;
+}
+
+// A bitmap dimension the same as the frame's, smaller or larger
+static LONG RandomBitmapSize(short p_size, MxBool p_clip)
+{
+	switch (Random(3)) {
+	case 0:
+		return p_clip ? 1 + Random(p_size) : p_size;
+	case 1:
+		return p_size + Random(MAX_SIZE);
+	default:
+		return p_size;
+	}
+}
+
+static MxBool TestRandom()
+{
+	static const WORD g_types[] = {FLI_CHUNK_BRUN, FLI_CHUNK_LC, FLI_CHUNK_SS2, FLI_CHUNK_COPY, FLI_CHUNK_BLACK};
+	MxU32 clipped = 0;
+
+	for (MxU32 i = 0; i < FRAMES; i++) {
+		WORD types[2];
+		WORD count = 1 + Random(2);
+		MxBool brun = FALSE;
+
+		for (WORD c = 0; c < count; c++) {
+			types[c] = g_types[Random(5)];
+			brun = brun || types[c] == FLI_CHUNK_BRUN;
+		}
+
+		// BRUN writes whole frame lines unclipped, so its bitmap is never smaller than the frame
+		short width = 1 + Random(MAX_SIZE);
+		short height = 1 + Random(MAX_SIZE);
+		LONG bitmapWidth = RandomBitmapSize(width, !brun);
+		LONG bitmapHeight = RandomBitmapSize(height, !brun);
+
+		clipped += bitmapWidth < width || bitmapHeight < height;
+		CHECK(TestFrame(types, count, width, height, bitmapWidth, bitmapHeight));
+	}
+
+	printf("%u frames, %u clipped\n", FRAMES, clipped);
+	return TRUE;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestRandom();
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
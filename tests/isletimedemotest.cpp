@@ -0,0 +1,190 @@
+// Checks that a timedemo replay hands each recorded input event back on the frame it was
+// recorded on, that recorded navigation key states, releases included, reach
+// LegoInputManager on their frame in place of the live keyboard, and that a recording keeps to
+// real time. Prints the per-frame timing summary of the replay, standard deviation included.
+
+#include "isletimedemo.h"
+#include "legoinputmanager.h"
+#include "mxmisc.h"
+#include "mxtimer.h"
+
+#include <SDL2/SDL_events.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+
+#define RECORD_PATH "isletimedemotest.txt"
+#define CSV_PATH "isletimedemotest.csv"
+#define KEYS_PATH "isletimedemotest-keys.txt"
+#define FRAMES 60
+#define EVENTS 64
+
+static MxTimer* g_timer;
+static const Uint8* g_keyboardState;
+
+MxTimer* Timer()
+{
+	return g_timer;
+}
+
+void LegoInputManager::SetKeyboardStateOverride(const Uint8* p_keyboardState)
+{
+	g_keyboardState = p_keyboardState;
+}
+
+struct Event {
+	MxU32 m_frame;
+	Uint32 m_type;
+	MxS32 m_x;
+};
+
+static Event g_events[EVENTS];
+static MxU32 g_numEvents;
+
+static void AddEvent(MxU32 p_frame, SDL_Event& p_event)
+{
+	if (g_numEvents < EVENTS) {
+		g_events[g_numEvents].m_frame = p_frame;
+		g_events[g_numEvents].m_type = p_event.type;
+		g_events[g_numEvents].m_x = p_event.type == SDL_MOUSEMOTION ? p_event.motion.x : p_event.button.x;
+		g_numEvents++;
+	}
+}
+
+// What SDL_AppIterate and IsleApp::Tick do for one frame
+static void RunFrame(MxU32 p_frame)
+{
+	SDL_Event event;
+
+	while (IsleTimedemo_NextEvent(&event)) {
+		AddEvent(p_frame, event);
+	}
+
+	while (!IsleTimedemo_Step()) {
+		SDL_Delay(1);
+	}
+
+	// Frames of 0, 1 and 2 ms, for a summary with some spread
+	IsleTimedemo_BeginFrame();
+	SDL_Delay(p_frame % 3);
+	IsleTimedemo_EndFrame();
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestRoundTrip()
+{
+	Event recorded[EVENTS];
+	MxU32 numRecorded = 0;
+
+	IsleTimedemo_SetRecordPath(RECORD_PATH);
+	CHECK(IsleTimedemo_Start());
+	Uint64 start = SDL_GetTicks();
+
+	for (MxU32 frame = 0; frame < FRAMES; frame++) {
+		if (frame % 7 == 3) {
+			SDL_Event event;
+			SDL_zero(event);
+			event.type = frame % 2 ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEMOTION;
+			event.button.x = event.motion.x = frame;
+
+			CHECK(!IsleTimedemo_Event(&event));
+			recorded[numRecorded].m_frame = frame;
+			recorded[numRecorded].m_type = event.type;
+			recorded[numRecorded].m_x = frame;
+			numRecorded++;
+		}
+
+		RunFrame(frame);
+	}
+
+	IsleTimedemo_Finish();
+
+	// One step of real time per frame, less the first one, which is due at once
+	Uint64 elapsed = SDL_GetTicks() - start;
+	CHECK(elapsed >= (FRAMES - 1) * 16);
+	printf("%u recorded frames took %u ms\n", FRAMES, (MxU32) elapsed);
+
+	IsleTimedemo_SetRecordPath(NULL);
+	IsleTimedemo_SetReplayPath(RECORD_PATH);
+	IsleTimedemo_SetCsvPath(CSV_PATH);
+	CHECK(IsleTimedemo_Start());
+	g_numEvents = 0;
+
+	for (MxU32 frame = 0; !IsleTimedemo_Finished(); frame++) {
+		CHECK(frame <= FRAMES);
+		RunFrame(frame);
+	}
+
+	IsleTimedemo_Finish();
+
+	CHECK(g_numEvents == numRecorded);
+
+	for (MxU32 i = 0; i < numRecorded; i++) {
+		CHECK(g_events[i].m_frame == recorded[i].m_frame);
+		CHECK(g_events[i].m_type == recorded[i].m_type);
+		CHECK(g_events[i].m_x == recorded[i].m_x);
+	}
+
+	return TRUE;
+}
+
+static MxBool TestKeys()
+{
+	FILE* file = fopen(KEYS_PATH, "w");
+	CHECK(file);
+
+	// Up from frame 2, up and left on frame 5, everything released from frame 6, then a click.
+	// The times are those of the frame before the step, as IsleTimedemo_Step records them.
+	fprintf(file, "32 keys 2\n");
+	fprintf(file, "80 keys 34\n");
+	fprintf(file, "96 keys 0\n");
+	fprintf(file, "96 down 1 1 50 60\n");
+	fprintf(file, "160 end\n");
+	fclose(file);
+
+	IsleTimedemo_SetReplayPath(KEYS_PATH);
+	CHECK(IsleTimedemo_Start());
+	CHECK(g_keyboardState != NULL);
+	g_numEvents = 0;
+
+	for (MxU32 frame = 0; frame <= 10; frame++) {
+		SDL_Event event;
+
+		while (IsleTimedemo_NextEvent(&event)) {
+			AddEvent(frame, event);
+		}
+
+		CHECK(g_keyboardState[SDL_SCANCODE_UP] == (frame >= 2 && frame < 6));
+		CHECK(g_keyboardState[SDL_SCANCODE_LEFT] == (frame == 5));
+		CHECK(!g_keyboardState[SDL_SCANCODE_DOWN]);
+		CHECK(IsleTimedemo_Step());
+	}
+
+	CHECK(IsleTimedemo_Finished());
+	IsleTimedemo_Finish();
+	CHECK(g_keyboardState == NULL);
+
+	CHECK(g_numEvents == 1);
+	CHECK(g_events[0].m_frame == 6 && g_events[0].m_type == SDL_MOUSEBUTTONDOWN && g_events[0].m_x == 50);
+	return TRUE;
+}
+
+int main(int, char**)
+{
+	g_timer = new MxTimer();
+
+	MxBool result = TestRoundTrip();
+	result = TestKeys() && result;
+
+	remove(RECORD_PATH);
+	remove(CSV_PATH);
+	remove(KEYS_PATH);
+	delete g_timer;
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
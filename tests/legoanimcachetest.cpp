@@ -0,0 +1,147 @@
+// Checks LegoAnimCache against the rules presenters rely on: a tree is lent to one presenter at
+// a time and comes back with its playback state reset, a different chunk length misses, idle
+// trees are evicted least recently used first, and trees still lent out survive Clear. Then
+// times Acquire and Release with a few and with thousands of cached actions.
+
+#include "anim/legoanim.h"
+#include "legoanimcache.h"
+#include "mxomni.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+
+// LegoAnim pulls in LegoFile, whose paths MxString maps through these. The test opens no files.
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+static LegoAnim* NewAnim()
+{
+	LegoAnim* anim = new LegoAnim();
+	LegoTreeNode* root = new LegoTreeNode();
+	LegoTreeNode* child = new LegoTreeNode();
+	root->SetData(new LegoAnimNodeData());
+	child->SetData(new LegoAnimNodeData());
+	root->SetNumChildren(1);
+	root->SetChildren(new LegoTreeNode*[1]);
+	root->SetChild(0, child);
+	anim->SetRoot(root);
+	return anim;
+}
+
+static LegoAnimNodeData* ChildData(LegoAnim* p_anim)
+{
+	return (LegoAnimNodeData*) p_anim->GetRoot()->GetChild(0)->GetData();
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestRules()
+{
+	LegoAnimCache cache(3000);
+
+	// A miss, then the parsed tree is added while its presenter still plays it
+	CHECK(cache.Acquire("\\lego\\scripts\\isle\\isle", 10, 1000) == NULL);
+	LegoAnim* anim = NewAnim();
+	CHECK(cache.Add("\\lego\\scripts\\isle\\isle", 10, 1000, anim));
+	CHECK(cache.Acquire("\\lego\\scripts\\isle\\isle", 10, 1000) == NULL);
+
+	// Handed back with playback state, and lent again reset. Atom names compare without case.
+	ChildData(anim)->SetTranslationIndex(7);
+	ChildData(anim)->SetUnknown0x20(3);
+	CHECK(cache.Release(anim));
+	CHECK(!cache.Release(anim));
+	CHECK(cache.Acquire("\\lego\\scripts\\isle\\isle", 10, 999) == NULL);
+	CHECK(cache.Acquire("\\LEGO\\SCRIPTS\\ISLE\\ISLE", 10, 1000) == anim);
+	CHECK(ChildData(anim)->GetTranslationIndex() == 0 && ChildData(anim)->GetUnknown0x20() == 0);
+	CHECK(cache.Release(anim));
+
+	// Not cached, so the caller deletes it
+	LegoAnim* other = NewAnim();
+	CHECK(!cache.Release(other));
+	delete other;
+
+	// Over the limit, the least recently released idle tree goes first
+	LegoAnim* second = NewAnim();
+	LegoAnim* third = NewAnim();
+	CHECK(cache.Add("\\lego\\scripts\\isle\\isle", 11, 1000, second));
+	CHECK(cache.Add("\\lego\\scripts\\isle\\isle", 12, 1000, third));
+	CHECK(cache.Release(second));
+	CHECK(cache.GetCount() == 3 && cache.GetSize() == 3000);
+	CHECK(cache.Acquire("\\lego\\scripts\\isle\\isle", 10, 1000) == anim);
+	CHECK(cache.Release(anim));
+	CHECK(cache.Release(third));
+	cache.SetLimit(2000);
+	CHECK(cache.GetCount() == 2 && cache.Acquire("\\lego\\scripts\\isle\\isle", 11, 1000) == NULL);
+
+	// Clear spares the lent tree, which its presenter hands back later
+	CHECK(cache.Acquire("\\lego\\scripts\\isle\\isle", 12, 1000) == third);
+	cache.Clear();
+	CHECK(cache.GetCount() == 1 && cache.GetSize() == 1000);
+	CHECK(cache.Release(third));
+	return TRUE;
+}
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+#define LOOKUPS 200000
+
+// Nanoseconds per Acquire and Release with p_count cached actions spread over eight scripts
+static double TimeLookup(MxU32 p_count)
+{
+	static const char* g_scripts[] = {
+		"\\lego\\scripts\\isle\\isle",
+		"\\lego\\scripts\\act2\\act2main",
+		"\\lego\\scripts\\act3\\act3",
+		"\\lego\\scripts\\garage\\garage",
+		"\\lego\\scripts\\hospital\\hospital",
+		"\\lego\\scripts\\police\\police",
+		"\\lego\\scripts\\race\\carrace",
+		"\\lego\\scripts\\infocntr\\infomain",
+	};
+
+	LegoAnimCache cache(0xffffffff);
+
+	for (MxU32 i = 0; i < p_count; i++) {
+		LegoAnim* anim = NewAnim();
+		cache.Add(g_scripts[i % 8], i / 8, 100, anim);
+		cache.Release(anim);
+	}
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < LOOKUPS; i++) {
+		MxU32 index = Random(p_count);
+		LegoAnim* anim = cache.Acquire(g_scripts[index % 8], index / 8, 100);
+
+		if (anim == NULL || !cache.Release(anim)) {
+			return -1;
+		}
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency() / LOOKUPS;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestRules();
+
+	double few = TimeLookup(16);
+	double many = TimeLookup(4096);
+	printf("Acquire and Release: %.0f ns with 16 cached actions, %.0f ns with 4096\n", few, many);
+	result = result && few >= 0 && many >= 0;
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+// Checks that animation frames evaluated on an MxJobPool, the way LegoAnimPresenter::PrepareFrames
+// does, match evaluating them one after another on the calling thread bit for bit, at times that
+// jump back and forth so that the key index hints cached in each node are exercised. Then times
+// a frame for a growing number of actors with and without workers.
+
+#include "anim/legoanim.h"
+#include "misc/legostorage.h"
+#include "mxjobpool.h"
+#include "mxomni.h"
+
+#include <SDL2/SDL_cpuinfo.h>
+#include <SDL2/SDL_timer.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// LegoStorage maps file names through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define ACTORS 64
+#define DEPTH 3
+#define FRAMES 2000
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static float RandomFloat(float p_min, float p_max)
+{
+	return p_min + (p_max - p_min) * Random(10001) / 10000.0F;
+}
+
+template <class T>
+static void Put(LegoStorage& p_storage, T p_value)
+{
+	p_storage.Write(&p_value, sizeof(p_value));
+}
+
+// Writes a node with a random set of keys in the format LegoAnimNodeData::Read expects
+static LegoAnimNodeData* CreateNode()
+{
+	LegoGrowableMemory storage;
+	MxU32 numKeys, i;
+	LegoS32 time;
+
+	Put<LegoU32>(storage, 0);
+
+	numKeys = Random(12);
+	Put<LegoU16>(storage, numKeys);
+	for (i = 0, time = 0; i < numKeys; i++) {
+		time += 1 + Random(200);
+		Put<LegoS32>(storage, time | (1 << 24));
+		Put(storage, RandomFloat(-5, 5));
+		Put(storage, RandomFloat(-5, 5));
+		Put(storage, RandomFloat(-5, 5));
+	}
+
+	numKeys = Random(12);
+	Put<LegoU16>(storage, numKeys);
+	for (i = 0, time = 0; i < numKeys; i++) {
+		float angle = RandomFloat(-1, 1), x = RandomFloat(-1, 1), y = RandomFloat(-1, 1), z = RandomFloat(-1, 1);
+		float length = sqrt(angle * angle + x * x + y * y + z * z);
+
+		time += 1 + Random(200);
+		Put<LegoS32>(storage, time | ((Random(5) ? 1 : 0) << 24));
+		Put(storage, angle / length);
+		Put(storage, x / length);
+		Put(storage, y / length);
+		Put(storage, z / length);
+	}
+
+	numKeys = Random(3);
+	Put<LegoU16>(storage, numKeys);
+	for (i = 0, time = 0; i < numKeys; i++) {
+		time += 1 + Random(400);
+		Put<LegoS32>(storage, time);
+		Put(storage, RandomFloat(0.5F, 2));
+		Put(storage, RandomFloat(0.5F, 2));
+		Put(storage, RandomFloat(0.5F, 2));
+	}
+
+	numKeys = Random(4);
+	Put<LegoU16>(storage, numKeys);
+	for (i = 0, time = 0; i < numKeys; i++) {
+		time += 1 + Random(400);
+		Put<LegoS32>(storage, time);
+		Put<LegoU8>(storage, Random(2));
+	}
+
+	LegoU32 size;
+	LegoU8* buffer = storage.Detach(size);
+	LegoMemory memory(buffer, size);
+	LegoAnimNodeData* data = new LegoAnimNodeData();
+
+	if (data->Read(&memory) != SUCCESS) {
+		delete data;
+		data = NULL;
+	}
+
+	delete[] buffer;
+	return data;
+}
+
+static LegoTreeNode* CreateTree(MxS32 p_depth, MxU32& p_numNodes)
+{
+	LegoTreeNode* node = new LegoTreeNode();
+	node->SetData(CreateNode());
+	p_numNodes++;
+
+	MxU32 numChildren = p_depth > 0 ? 1 + Random(3) : 0;
+	node->SetNumChildren(numChildren);
+
+	if (numChildren) {
+		node->SetChildren(new LegoTreeNode*[numChildren]);
+
+		for (MxU32 i = 0; i < numChildren; i++) {
+			node->SetChild(i, CreateTree(p_depth - 1, p_numNodes));
+		}
+	}
+
+	return node;
+}
+
+struct Actor {
+	LegoTree m_tree;
+	LegoAnimFrameNode* m_frame;
+	MxU32 m_numNodes;
+	LegoTime m_time;
+};
+
+static void EvaluateActor(void* p_actor)
+{
+	Actor* actor = (Actor*) p_actor;
+	LegoAnim::EvaluateFrame(actor->m_tree.GetRoot(), actor->m_time, actor->m_frame);
+}
+
+// Two identical sets of actors, each node with its own cached key indices
+static void CreateActors(Actor* p_serial, Actor* p_pooled)
+{
+	for (MxU32 i = 0; i < ACTORS; i++) {
+		unsigned int seed = g_seed;
+		Actor* actors[] = {&p_serial[i], &p_pooled[i]};
+
+		for (MxU32 j = 0; j < 2; j++) {
+			g_seed = seed;
+			actors[j]->m_numNodes = 0;
+			actors[j]->m_tree.SetRoot(CreateTree(DEPTH, actors[j]->m_numNodes));
+			actors[j]->m_frame = new LegoAnimFrameNode[actors[j]->m_numNodes];
+		}
+	}
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestPooled(Actor* p_serial, Actor* p_pooled, MxS32 p_workers)
+{
+	MxJobPool pool;
+	CHECK(pool.Create(p_workers) == SUCCESS);
+
+	for (MxU32 frame = 0; frame < FRAMES; frame++) {
+		LegoTime time = frame % 7 ? frame * 3 : Random(3000);
+
+		for (MxU32 i = 0; i < ACTORS; i++) {
+			p_pooled[i].m_time = time + i;
+			pool.AddJob(EvaluateActor, &p_pooled[i]);
+		}
+
+		pool.RunJobs();
+
+		for (MxU32 i = 0; i < ACTORS; i++) {
+			p_serial[i].m_time = time + i;
+			EvaluateActor(&p_serial[i]);
+
+			for (MxU32 j = 0; j < p_serial[i].m_numNodes; j++) {
+				CHECK(!memcmp(p_serial[i].m_frame[j].m_local, p_pooled[i].m_frame[j].m_local, sizeof(float[4][4])));
+				CHECK(p_serial[i].m_frame[j].m_visible == p_pooled[i].m_frame[j].m_visible);
+			}
+		}
+	}
+
+	pool.Destroy();
+	return TRUE;
+}
+
+// Microseconds per frame to evaluate p_actors actors on p_workers workers
+static double TimeFrames(Actor* p_actors, MxU32 p_numActors, MxS32 p_workers)
+{
+	MxJobPool pool;
+	pool.Create(p_workers);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 frame = 0; frame < FRAMES; frame++) {
+		for (MxU32 i = 0; i < p_numActors; i++) {
+			p_actors[i].m_time = frame * 5 % 4000;
+			pool.AddJob(EvaluateActor, &p_actors[i]);
+		}
+
+		pool.RunJobs();
+	}
+
+	double us = (SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency() / FRAMES;
+	pool.Destroy();
+	return us;
+}
+
+int main(int, char**)
+{
+	static Actor g_serial[ACTORS];
+	static Actor g_pooled[ACTORS];
+	MxBool result = TRUE;
+	MxU32 numNodes = 0;
+
+	CreateActors(g_serial, g_pooled);
+
+	for (MxU32 i = 0; i < ACTORS; i++) {
+		numNodes += g_serial[i].m_numNodes;
+	}
+
+	for (MxS32 workers = 0; workers <= 3; workers++) {
+		result = TestPooled(g_serial, g_pooled, workers) && result;
+	}
+
+	printf("%u actors, %u nodes, %d CPUs\n", ACTORS, numNodes, SDL_GetCPUCount());
+
+	for (MxU32 actors = 1; actors <= ACTORS; actors *= 4) {
+		printf("%2u actors:", actors);
+
+		for (MxS32 workers = 0; workers <= 3; workers++) {
+			printf(" %d workers %.1f us%s", workers, TimeFrames(g_pooled, actors, workers), workers < 3 ? "," : "\n");
+		}
+	}
+
+	for (MxU32 i = 0; i < ACTORS; i++) {
+		delete[] g_serial[i].m_frame;
+		delete[] g_pooled[i].m_frame;
+	}
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
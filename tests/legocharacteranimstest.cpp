@@ -0,0 +1,217 @@
+// Checks LegoCharacterAnims::Find against the scan of the whole anim range that
+// LegoAnimationManager::FUN_10062110 did before, over random anim tables, ranges, flag masks
+// and vehicle filters, and LegoCharacterPrefixes against the name comparison
+// GetCharacterIndex did, for every two-character ASCII prefix. Then times both queries. Built with
+// miniwin, which the animation manager header reaches through legomain.h.
+
+#include "legoanimationmanager.h"
+#include "legocharacteranims.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// The names of g_characters, in order. "studs" and "st" share a prefix.
+static const char* g_names[] = {"pepper", "mama", "papa", "nick", "laura", "brickstr", "studs", "rhoda",
+								"valerie", "snap", "pt", "mg", "bu", "ml", "nu", "na",
+								"cl", "en", "re", "ro", "d1", "d2", "d3", "d4",
+								"l1", "l2", "l3", "l4", "l5", "l6", "b1", "b2",
+								"b3", "b4", "cm", "gd", "rd", "pg", "bd", "sy",
+								"gn", "df", "bs", "lt", "st", "bm", "jk"};
+
+#define NUM_CHARACTERS (sizeof(g_names) / sizeof(g_names[0]))
+#define TABLES 2000
+#define QUERIES 200
+#define MAX_ANIMS 300
+#define TIMED_QUERIES 200000
+
+static unsigned int g_seed = 1;
+static MxU32 g_sink;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+// The comparison GetCharacterIndex did before the prefix table
+static MxS8 LinearCharacterIndex(const char* p_name)
+{
+	for (MxS8 i = 0; i < (MxS8) NUM_CHARACTERS; i++) {
+		if (!SDL_strncasecmp(p_name, g_names[i], 2)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// The scan FUN_10062110 did before the anims were bucketed by character
+static MxU16 LinearFind(
+	const AnimInfo* p_anims,
+	MxS8 p_index,
+	MxS32 p_vehicleId,
+	MxU16 p_first,
+	MxU16 p_last,
+	MxU8 p_flags,
+	MxBool p_inVehicle
+)
+{
+	for (MxU16 i = p_first; i <= p_last; i++) {
+		if (p_anims[i].m_characterIndex == p_index && p_anims[i].m_unk0x0c & p_flags && p_anims[i].m_unk0x29) {
+			if (p_vehicleId >= 0) {
+				MxBool found = FALSE;
+
+				for (MxS32 j = 0; j < (MxS32) sizeOfArray(p_anims[i].m_unk0x2a); j++) {
+					if (p_anims[i].m_unk0x2a[j] == p_vehicleId) {
+						found = TRUE;
+						break;
+					}
+				}
+
+				if (p_inVehicle != found) {
+					continue;
+				}
+			}
+
+			MxU16 result = i;
+			MxU16 unk0x22 = p_anims[i].m_unk0x22;
+
+			for (i = i + 1; i <= p_last; i++) {
+				if (p_anims[i].m_characterIndex == p_index && p_anims[i].m_unk0x0c & p_flags &&
+					p_anims[i].m_unk0x29 && p_anims[i].m_unk0x22 < unk0x22) {
+					result = i;
+					unk0x22 = p_anims[i].m_unk0x22;
+				}
+			}
+
+			return result;
+		}
+	}
+
+	return 0;
+}
+
+// Anims of a handful of characters or none, so buckets hold many anims and m_unk0x22 ties
+static void RandomAnims(AnimInfo* p_anims, MxU16 p_count)
+{
+	memset(p_anims, 0, sizeof(AnimInfo) * p_count);
+
+	for (MxU16 i = 0; i < p_count; i++) {
+		p_anims[i].m_characterIndex = Random(8) == 0 ? -1 : Random(6) * 7;
+		p_anims[i].m_unk0x0c = Random(16);
+		p_anims[i].m_unk0x29 = Random(3) != 0;
+		p_anims[i].m_unk0x22 = Random(6);
+
+		for (MxS32 j = 0; j < (MxS32) sizeOfArray(p_anims[i].m_unk0x2a); j++) {
+			p_anims[i].m_unk0x2a[j] = Random(7) - 1;
+		}
+	}
+}
+
+static MxS8 RandomCharacter()
+{
+	return Random(8) == 0 ? -1 : Random(7) * 7;
+}
+
+static MxBool TestPrefixes()
+{
+	LegoCharacterPrefixes prefixes;
+
+	for (MxS8 i = 0; i < (MxS8) NUM_CHARACTERS; i++) {
+		prefixes.Add(g_names[i], i);
+	}
+
+	// Every pair of ASCII characters, which takes in the empty and one-character names, and
+	// the names themselves in other case
+	char name[4] = {0, 0, 'x', 0};
+
+	for (MxU32 first = 0; first < 0x80; first++) {
+		for (MxU32 second = 0; second < 0x80; second++) {
+			name[0] = first;
+			name[1] = second;
+			CHECK(prefixes.Find(name) == LinearCharacterIndex(name));
+		}
+	}
+
+	CHECK(prefixes.Find("STUDS") == 6 && prefixes.Find("st") == 6);
+	CHECK(prefixes.Find("Laura") == 4 && prefixes.Find("zz") == -1 && prefixes.Find("") == -1);
+	return TRUE;
+}
+
+static MxBool TestRandom()
+{
+	static AnimInfo anims[MAX_ANIMS];
+	MxU32 found = 0;
+
+	for (MxU32 table = 0; table < TABLES; table++) {
+		MxU16 count = 1 + Random(MAX_ANIMS);
+		RandomAnims(anims, count);
+
+		LegoCharacterAnims characterAnims;
+		characterAnims.Build(anims, count, NUM_CHARACTERS);
+
+		for (MxU32 query = 0; query < QUERIES; query++) {
+			MxU16 first = Random(count);
+			MxU16 last = first + Random(count - first);
+			MxS8 index = RandomCharacter();
+			MxS32 vehicleId = Random(3) == 0 ? -1 : Random(6);
+			MxU8 flags = Random(16);
+			MxBool inVehicle = Random(2);
+
+			MxU16 result = characterAnims.Find(anims, index, vehicleId, first, last, flags, inVehicle);
+			CHECK(result == LinearFind(anims, index, vehicleId, first, last, flags, inVehicle));
+			found += result != 0;
+		}
+	}
+
+	printf("%u queries, %u found\n", TABLES * QUERIES, found);
+	CHECK(found > TABLES * QUERIES / 4);
+	return TRUE;
+}
+
+// Microseconds per query over a full table of MAX_ANIMS
+static double Time(MxBool p_index)
+{
+	static AnimInfo anims[MAX_ANIMS];
+	RandomAnims(anims, MAX_ANIMS);
+
+	LegoCharacterAnims characterAnims;
+	characterAnims.Build(anims, MAX_ANIMS, NUM_CHARACTERS);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < TIMED_QUERIES; i++) {
+		MxS8 index = RandomCharacter();
+		MxU8 flags = 1 << Random(4);
+
+		if (p_index) {
+			g_sink += characterAnims.Find(anims, index, -1, 0, MAX_ANIMS - 1, flags, FALSE);
+		}
+		else {
+			g_sink += LinearFind(anims, index, -1, 0, MAX_ANIMS - 1, flags, FALSE);
+		}
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency() / TIMED_QUERIES;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestPrefixes();
+	result = TestRandom() && result;
+
+	double scan = Time(FALSE);
+	double index = Time(TRUE);
+	printf("%u anims, per query: scan %.3f us, index %.3f us\n", MAX_ANIMS, scan, index);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
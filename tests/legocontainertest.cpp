@@ -0,0 +1,325 @@
+// Checks that textures with the same size, palette and pixels share one surface and renderer
+// texture when sharing is on, and that any difference or a texture presenter's texture keeps its
+// own. Then clears containers of shared textures and checks that no texture goes while the
+// renderer texture it shares still points at it. Then times loading a set of textures with
+// repeats, shared and not, and reports their surface memory. Built with miniwin, whose surfaces
+// and textures stand in for the video manager's.
+
+#include "misc.h"
+#include "misc/legocontainer.h"
+#include "misc/legoimage.h"
+#include "misc/legotexture.h"
+#include "mxomni.h"
+
+#include <SDL2/SDL_timer.h>
+#include <map>
+#include <stdio.h>
+
+// LegoStorage maps paths through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define TEXTURES 600
+#define PATTERNS 150
+#define SIZE 64
+#define GROUPS 40
+
+static LPDIRECTDRAW g_directDraw;
+static IDirect3DRM* g_direct3DRM;
+
+// Every texture alive, and whether it has its own surface
+static std::map<LegoTextureInfo*, LegoBool> g_textureInfos;
+static LegoU32 g_dangling;
+static LegoU32 g_handedOver;
+
+static unsigned int g_seed = 1;
+
+static LegoU32 Random(LegoU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+// legotextureinfo.cpp reaches the surfaces through the video manager, which this test goes
+// without
+LegoVideoManager* VideoManager()
+{
+	return NULL;
+}
+
+LegoTextureInfo::LegoTextureInfo()
+{
+	m_name = NULL;
+	m_surface = NULL;
+	m_palette = NULL;
+	m_texture = NULL;
+	g_textureInfos[this] = FALSE;
+}
+
+LegoTextureInfo::~LegoTextureInfo()
+{
+	// A texture still sharing the renderer texture must now be the one its app data points at
+	for (std::map<LegoTextureInfo*, LegoBool>::iterator it = g_textureInfos.begin(); it != g_textureInfos.end();
+		 it++) {
+		if (it->first != this && it->first->m_texture == m_texture && m_texture != NULL) {
+			if ((LegoTextureInfo*) m_texture->GetAppData() == this) {
+				g_dangling++;
+			}
+			else if (g_textureInfos[this]) {
+				g_handedOver++;
+			}
+
+			break;
+		}
+	}
+
+	g_textureInfos.erase(this);
+	delete[] m_name;
+
+	if (m_palette) {
+		m_palette->Release();
+	}
+
+	if (m_surface) {
+		m_surface->Release();
+	}
+
+	if (m_texture) {
+		m_texture->Release();
+	}
+}
+
+// What LegoTextureInfo::Create does, less the video manager
+LegoTextureInfo* LegoTextureInfo::Create(const char* p_name, LegoTexture* p_texture)
+{
+	LegoTextureInfo* textureInfo = new LegoTextureInfo();
+	LegoImage* image = p_texture->GetImage();
+
+	textureInfo->m_name = new char[strlen(p_name) + 1];
+	strcpy(textureInfo->m_name, p_name);
+	g_textureInfos[textureInfo] = TRUE;
+
+	DDSURFACEDESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+	desc.dwFlags = DDSD_PIXELFORMAT | DDSD_WIDTH | DDSD_HEIGHT | DDSD_CAPS;
+	desc.dwWidth = image->GetWidth();
+	desc.dwHeight = image->GetHeight();
+	desc.ddsCaps.dwCaps = DDSCAPS_TEXTURE | DDSCAPS_SYSTEMMEMORY;
+	desc.ddpfPixelFormat.dwSize = sizeof(desc.ddpfPixelFormat);
+	desc.ddpfPixelFormat.dwFlags = DDPF_RGB | DDPF_PALETTEINDEXED8;
+	desc.ddpfPixelFormat.dwRGBBitCount = 8;
+
+	if (g_directDraw->CreateSurface(&desc, &textureInfo->m_surface, NULL) != DD_OK) {
+		delete textureInfo;
+		return NULL;
+	}
+
+	memset(&desc, 0, sizeof(desc));
+	desc.dwSize = sizeof(desc);
+
+	if (textureInfo->m_surface->Lock(NULL, &desc, DDLOCK_SURFACEMEMORYPTR, NULL) != DD_OK) {
+		delete textureInfo;
+		return NULL;
+	}
+
+	for (LegoU32 i = 0; i < desc.dwHeight; i++) {
+		memcpy((LegoU8*) desc.lpSurface + i * desc.lPitch, image->GetBits() + i * desc.dwWidth, desc.dwWidth);
+	}
+
+	textureInfo->m_surface->Unlock(desc.lpSurface);
+
+	PALETTEENTRY entries[256];
+	memset(entries, 0, sizeof(entries));
+
+	for (LegoU32 i = 0; i < image->GetCount(); i++) {
+		entries[i].peRed = image->GetPalette()->colors[i].r;
+		entries[i].peGreen = image->GetPalette()->colors[i].g;
+		entries[i].peBlue = image->GetPalette()->colors[i].b;
+	}
+
+	if (g_directDraw->CreatePalette(DDPCAPS_ALLOW256 | DDPCAPS_8BIT, entries, &textureInfo->m_palette, NULL) !=
+			DD_OK ||
+		textureInfo->m_surface->SetPalette(textureInfo->m_palette) != DD_OK ||
+		g_direct3DRM->CreateTextureFromSurface(textureInfo->m_surface, &textureInfo->m_texture) != D3DRM_OK) {
+		delete textureInfo;
+		return NULL;
+	}
+
+	textureInfo->m_texture->SetAppData((LPD3DRM_APPDATA) textureInfo);
+	return textureInfo;
+}
+
+// A p_width by p_height texture of pattern p_pattern, in palette p_palette
+static LegoTexture* MakeTexture(LegoU32 p_width, LegoU32 p_height, LegoU32 p_pattern, LegoU32 p_palette)
+{
+	LegoTexture* texture = new LegoTexture();
+	LegoImage* image = new LegoImage(p_width, p_height);
+	SDL_Palette* palette = SDL_AllocPalette(16);
+
+	for (LegoU32 i = 0; i < 16; i++) {
+		palette->colors[i].r = i * 16;
+		palette->colors[i].g = p_palette;
+		palette->colors[i].b = 255 - i;
+	}
+
+	LegoU8* bits = (LegoU8*) image->GetBits();
+
+	for (LegoU32 i = 0; i < p_width * p_height; i++) {
+		bits[i] = (i * 7 + p_pattern * 13 + i / (p_pattern + 1)) % 16;
+	}
+
+	delete texture->GetImage();
+	image->SetPalette(palette);
+	texture->SetImage(image);
+	return texture;
+}
+
+static void FreeTexture(LegoTexture* p_texture)
+{
+	SDL_FreePalette(p_texture->GetImage()->GetPalette());
+	delete p_texture;
+}
+
+// Creates p_name from a texture made of the rest, the way the part and model presenters do
+static LegoTextureInfo* Create(
+	LegoTextureContainer& p_container,
+	const char* p_name,
+	LegoU32 p_width,
+	LegoU32 p_pattern,
+	LegoU32 p_palette,
+	LegoBool p_share
+)
+{
+	LegoTexture* texture = MakeTexture(p_width, SIZE, p_pattern, p_palette);
+	LegoTextureInfo* textureInfo = p_container.Create(p_name, texture, p_share);
+	FreeTexture(texture);
+	return textureInfo;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static LegoBool TestShare()
+{
+	LegoTextureContainer container;
+	container.SetOwnership(FALSE);
+	LegoTextureContainer::SetShareIdentical(TRUE);
+
+	LegoTextureInfo* a = Create(container, "a", SIZE, 1, 0, TRUE);
+	LegoTextureInfo* b = Create(container, "b", SIZE, 1, 0, TRUE);
+	LegoTextureInfo* c = Create(container, "c", SIZE, 2, 0, TRUE);
+	LegoTextureInfo* d = Create(container, "d", SIZE, 1, 1, TRUE);
+	LegoTextureInfo* e = Create(container, "e", SIZE / 2, 1, 0, TRUE);
+	LegoTextureInfo* f = Create(container, "f", SIZE, 1, 0, FALSE);
+	CHECK(a && b && c && d && e && f);
+
+	CHECK(container.Get("b") == b && !strcmp(b->m_name, "b"));
+	CHECK(b->m_surface == a->m_surface && b->m_palette == a->m_palette && b->m_texture == a->m_texture);
+	CHECK((LegoTextureInfo*) a->m_texture->GetAppData() == a);
+	CHECK(c->m_surface != a->m_surface && d->m_surface != a->m_surface);
+	CHECK(e->m_surface != a->m_surface && f->m_surface != a->m_surface);
+	CHECK(container.GetSurfaceCount() == 5 && container.GetSharedCount() == 1);
+	CHECK(container.GetSharedBytes() == SIZE * SIZE);
+
+	LegoTextureContainer::SetShareIdentical(FALSE);
+	LegoTextureInfo* g = Create(container, "g", SIZE, 1, 0, TRUE);
+	CHECK(g && g->m_surface != a->m_surface);
+
+	container.Clear();
+	CHECK(g_dangling == 0);
+	CHECK(g_textureInfos.empty());
+	return TRUE;
+}
+
+static LegoBool TestClear()
+{
+	LegoTextureContainer::SetShareIdentical(TRUE);
+
+	// Groups of three, in many containers, for Clear to delete textures in every order
+	for (LegoU32 round = 0; round < 20; round++) {
+		LegoTextureContainer container;
+		container.SetOwnership(FALSE);
+
+		for (LegoU32 i = 0; i < GROUPS * 3; i++) {
+			char name[32];
+			SDL_snprintf(name, sizeof(name), "tex%u_%u", round, i);
+			CHECK(Create(container, name, SIZE, i % GROUPS, 0, TRUE));
+		}
+
+		CHECK(container.GetSharedCount() == GROUPS * 2);
+		container.Clear();
+	}
+
+	LegoTextureContainer::SetShareIdentical(FALSE);
+	CHECK(g_dangling == 0);
+	CHECK(g_handedOver > 0);
+	CHECK(g_textureInfos.empty());
+	return TRUE;
+}
+
+// Milliseconds to create TEXTURES textures over PATTERNS distinct ones
+static double Time(LegoBool p_share, LegoU32& p_surfaceBytes, LegoU32& p_sharedBytes)
+{
+	LegoTexture* textures[PATTERNS];
+	LegoTextureContainer container;
+	container.SetOwnership(FALSE);
+	LegoTextureContainer::SetShareIdentical(p_share);
+
+	for (LegoU32 i = 0; i < PATTERNS; i++) {
+		textures[i] = MakeTexture(SIZE, SIZE, i, 0);
+	}
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (LegoU32 i = 0; i < TEXTURES; i++) {
+		char name[32];
+		SDL_snprintf(name, sizeof(name), "texture%u", i);
+		container.Create(name, textures[i < PATTERNS ? i : Random(PATTERNS)], TRUE);
+	}
+
+	double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+	p_surfaceBytes = container.GetSurfaceBytes();
+	p_sharedBytes = container.GetSharedBytes();
+	container.Clear();
+
+	for (LegoU32 i = 0; i < PATTERNS; i++) {
+		FreeTexture(textures[i]);
+	}
+
+	LegoTextureContainer::SetShareIdentical(FALSE);
+	return ms;
+}
+
+int main(int, char**)
+{
+	DirectDrawCreate(NULL, &g_directDraw, NULL);
+	Direct3DRMCreate(&g_direct3DRM);
+
+	LegoBool result = TestShare();
+	result = TestClear() && result;
+
+	LegoU32 surfaceBytes, sharedBytes;
+	double own = Time(FALSE, surfaceBytes, sharedBytes);
+	printf("%u textures, each its own: %.2f ms, %u bytes of surfaces\n", TEXTURES, own, surfaceBytes);
+	double shared = Time(TRUE, surfaceBytes, sharedBytes);
+	printf(
+		"%u textures over %u distinct, shared: %.2f ms, %u bytes of surfaces, %u bytes saved\n",
+		TEXTURES,
+		PATTERNS,
+		shared,
+		surfaceBytes,
+		sharedBytes
+	);
+
+	g_direct3DRM->Release();
+	g_directDraw->Release();
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
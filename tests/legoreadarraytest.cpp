@@ -0,0 +1,253 @@
+// Checks that the animation keys and vertices read with LegoStorage::ReadArray match a read per
+// field, the way LegoAnim and LegoVertex read them before, from memory and from a file. Then
+// times both readers on a key stream the size of a long animation.
+
+#include "anim/legoanim.h"
+#include "misc/legostorage.h"
+#include "mxomni.h"
+#include "shape/legovertex.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// LegoFile maps its paths through MxString, which looks them up in these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define KEYS_PATH "legoreadarraytest.ani"
+
+// Per key type, so the stream holds KEYS translation, rotation and scale keys and KEYS vertices
+#define KEYS 20000
+#define RUNS 20
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static LegoFloat RandomFloat()
+{
+	return (LegoFloat) Random(20001) / 1000.0F - 10.0F;
+}
+
+static void WriteFloat(LegoStorage* p_storage, LegoFloat p_value)
+{
+	p_storage->Write(&p_value, sizeof(p_value));
+}
+
+static void WriteKeys(LegoStorage* p_storage)
+{
+	for (MxU32 i = 0; i < KEYS; i++) {
+		LegoS32 timeAndFlags = (LegoS32) (i * 33) | (Random(8) << 24);
+
+		p_storage->Write(&timeAndFlags, sizeof(timeAndFlags));
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+
+		p_storage->Write(&timeAndFlags, sizeof(timeAndFlags));
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+
+		p_storage->Write(&timeAndFlags, sizeof(timeAndFlags));
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+		WriteFloat(p_storage, RandomFloat());
+	}
+}
+
+// What one key or vertex read to, whichever reader filled it
+struct Values {
+	LegoS32 m_timeAndFlags[3];
+	LegoFloat m_floats[13];
+};
+
+static MxBool ReadFieldByField(LegoStorage* p_storage, Values* p_values)
+{
+	for (MxU32 i = 0; i < KEYS; i++) {
+		Values& values = p_values[i];
+		LegoFloat* floats = values.m_floats;
+
+		for (MxU32 k = 0; k < 3; k++) {
+			if (p_storage->Read(&values.m_timeAndFlags[k], sizeof(LegoS32)) != SUCCESS) {
+				return FALSE;
+			}
+
+			for (MxU32 j = 0; j < (k == 1 ? 4 : 3); j++) {
+				if (p_storage->Read(floats++, sizeof(LegoFloat)) != SUCCESS) {
+					return FALSE;
+				}
+			}
+		}
+
+		for (MxU32 j = 0; j < 3; j++) {
+			if (p_storage->Read(floats++, sizeof(LegoFloat)) != SUCCESS) {
+				return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+static MxBool ReadKeys(LegoStorage* p_storage, Values* p_values)
+{
+	LegoTranslationKey translation;
+	LegoRotationKey rotation;
+	LegoScaleKey scale;
+	LegoVertex vertex;
+
+	for (MxU32 i = 0; i < KEYS; i++) {
+		if (translation.Read(p_storage) != SUCCESS || rotation.Read(p_storage) != SUCCESS ||
+			scale.Read(p_storage) != SUCCESS || vertex.Read(p_storage) != SUCCESS) {
+			return FALSE;
+		}
+
+		Values& values = p_values[i];
+		values.m_timeAndFlags[0] = (LegoS32) translation.GetTime();
+		values.m_timeAndFlags[1] = (LegoS32) rotation.GetTime();
+		values.m_timeAndFlags[2] = (LegoS32) scale.GetTime();
+
+		LegoFloat* floats = values.m_floats;
+		*floats++ = translation.GetX();
+		*floats++ = translation.GetY();
+		*floats++ = translation.GetZ();
+		*floats++ = rotation.GetAngle();
+		*floats++ = rotation.GetX();
+		*floats++ = rotation.GetY();
+		*floats++ = rotation.GetZ();
+		*floats++ = scale.GetX();
+		*floats++ = scale.GetY();
+		*floats++ = scale.GetZ();
+		*floats++ = vertex.GetX();
+		*floats++ = vertex.GetY();
+		*floats++ = vertex.GetZ();
+	}
+
+	return TRUE;
+}
+
+// The keys split off the flags and derive their own from the values, so only the time is compared
+static MxBool Compare(Values* p_fields, Values* p_keys)
+{
+	for (MxU32 i = 0; i < KEYS; i++) {
+		for (MxU32 k = 0; k < 3; k++) {
+			if ((p_fields[i].m_timeAndFlags[k] & 0xffffff) != p_keys[i].m_timeAndFlags[k]) {
+				return FALSE;
+			}
+		}
+
+		if (memcmp(p_fields[i].m_floats, p_keys[i].m_floats, sizeof(p_fields[i].m_floats))) {
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+typedef MxBool (*Reader)(LegoStorage*, Values*);
+
+// Milliseconds for one pass over the stream in memory
+static double TimeMemory(Reader p_reader, MxU8* p_buffer, MxU32 p_size, Values* p_values)
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < RUNS; i++) {
+		LegoMemory memory(p_buffer, p_size);
+		p_reader(&memory, p_values);
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / RUNS;
+}
+
+// Milliseconds for one pass over the stream in a file
+static double TimeFile(Reader p_reader, Values* p_values)
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < RUNS; i++) {
+		LegoFile file;
+		file.Open(KEYS_PATH, LegoFile::c_read);
+		p_reader(&file, p_values);
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / RUNS;
+}
+
+static MxBool Test()
+{
+	MxU32 size = KEYS * (3 * sizeof(LegoS32) + 13 * sizeof(LegoFloat));
+	MxU8* buffer = new MxU8[size];
+	Values* fields = new Values[KEYS];
+	Values* keys = new Values[KEYS];
+
+	LegoMemory memory(buffer, size);
+	WriteKeys(&memory);
+
+	{
+		LegoFile file;
+		CHECK(file.Open(KEYS_PATH, LegoFile::c_write) == SUCCESS);
+		CHECK(file.Write(buffer, size) == SUCCESS);
+	}
+
+	LegoMemory fieldMemory(buffer, size);
+	LegoMemory keyMemory(buffer, size);
+	CHECK(ReadFieldByField(&fieldMemory, fields));
+	CHECK(ReadKeys(&keyMemory, keys));
+	CHECK(Compare(fields, keys));
+
+	// Through LegoFile too, and a read at the end fails instead of running past it
+	LegoFile file;
+	CHECK(file.Open(KEYS_PATH, LegoFile::c_read) == SUCCESS);
+	CHECK(ReadKeys(&file, keys));
+	CHECK(Compare(fields, keys));
+	LegoTranslationKey translation;
+	CHECK(translation.Read(&file) != SUCCESS);
+
+	double fieldMemoryMs = TimeMemory(ReadFieldByField, buffer, size, fields);
+	double keyMemoryMs = TimeMemory(ReadKeys, buffer, size, keys);
+	double fieldFileMs = TimeFile(ReadFieldByField, fields);
+	double keyFileMs = TimeFile(ReadKeys, keys);
+
+	printf(
+		"%u keys of each type and vertices, %u bytes: field by field %.3f ms, ReadArray %.3f ms from memory; "
+		"%.3f ms and %.3f ms from a file\n",
+		KEYS,
+		size,
+		fieldMemoryMs,
+		keyMemoryMs,
+		fieldFileMs,
+		keyFileMs
+	);
+
+	remove(KEYS_PATH);
+	delete[] keys;
+	delete[] fields;
+	delete[] buffer;
+	return TRUE;
+}
+
+int main(int, char**)
+{
+	MxBool result = Test();
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
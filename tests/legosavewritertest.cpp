@@ -0,0 +1,168 @@
+// Checks LegoSaveWriter: queued saves land on disk in order with no temp files left over, a reader
+// polling the target while saves replace it always finds one complete save, and a failed write
+// is reported by the next Write or Flush exactly once. Then times the caller's side of a save
+// against writing the file synchronously.
+
+#include "legosavewriter.h"
+#include "mxomni.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// LegoSaveWriter keeps paths in MxStrings, which map paths through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define SAVE_PATH "legosavewritertest.gs"
+#define TEMP_PATH "legosavewritertest.gs.tmp"
+#define MISSING_PATH "legosavewritertest-missing/save.gs"
+
+// About the size of a slot file
+#define SAVE_SIZE 0x4000
+#define SAVES 200
+
+static LegoU8* CreateSave(LegoU8 p_value)
+{
+	LegoU8* data = new LegoU8[SAVE_SIZE];
+	memset(data, p_value, SAVE_SIZE);
+	return data;
+}
+
+// Returns the value every byte of the save holds, or -1 if it is missing, short or mixed
+static MxS32 ReadSave()
+{
+	static LegoU8 g_buffer[SAVE_SIZE + 1];
+	FILE* file = fopen(SAVE_PATH, "rb");
+
+	if (!file) {
+		return -1;
+	}
+
+	size_t size = fread(g_buffer, 1, sizeof(g_buffer), file);
+	fclose(file);
+
+	if (size != SAVE_SIZE) {
+		return -1;
+	}
+
+	for (MxU32 i = 1; i < SAVE_SIZE; i++) {
+		if (g_buffer[i] != g_buffer[0]) {
+			return -1;
+		}
+	}
+
+	return g_buffer[0];
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestQueue()
+{
+	LegoSaveWriter writer;
+
+	for (MxU32 i = 0; i < SAVES; i++) {
+		CHECK(writer.Write(SAVE_PATH, CreateSave(i), SAVE_SIZE) == SUCCESS);
+	}
+
+	CHECK(writer.Flush() == SUCCESS);
+	CHECK(ReadSave() == (SAVES - 1) % 256);
+	CHECK(fopen(TEMP_PATH, "rb") == NULL);
+	return TRUE;
+}
+
+static MxBool TestReplace()
+{
+	LegoSaveWriter writer;
+	MxU32 reads = 0;
+
+	CHECK(writer.Write(SAVE_PATH, CreateSave(1), SAVE_SIZE) == SUCCESS);
+	CHECK(writer.Flush() == SUCCESS);
+
+	for (MxU32 i = 0; i < SAVES; i++) {
+		CHECK(writer.Write(SAVE_PATH, CreateSave(1 + i % 2), SAVE_SIZE) == SUCCESS);
+
+		// Poll while the writer thread works through the queue
+		for (MxU32 j = 0; j < 10; j++, reads++) {
+			MxS32 value = ReadSave();
+			CHECK(value == 1 || value == 2);
+		}
+	}
+
+	CHECK(writer.Flush() == SUCCESS);
+	printf("%u reads during %u replacing saves found a complete save\n", reads, SAVES);
+	return TRUE;
+}
+
+static MxBool TestFailure()
+{
+	LegoSaveWriter writer;
+
+	CHECK(writer.Write(MISSING_PATH, CreateSave(3), SAVE_SIZE) == SUCCESS);
+	CHECK(writer.Flush() == FAILURE);
+	CHECK(writer.Flush() == SUCCESS);
+
+	// Reported by the next Write if the failed one is done by then, else by the Flush
+	CHECK(writer.Write(MISSING_PATH, CreateSave(3), SAVE_SIZE) == SUCCESS);
+	MxResult write = writer.Write(SAVE_PATH, CreateSave(4), SAVE_SIZE);
+	MxResult flush = writer.Flush();
+	CHECK((write == FAILURE) != (flush == FAILURE));
+	CHECK(writer.Flush() == SUCCESS);
+	CHECK(ReadSave() == 4);
+	return TRUE;
+}
+
+static void Time()
+{
+	Uint64 queued = 0, synchronous = 0;
+
+	{
+		LegoSaveWriter writer;
+
+		for (MxU32 i = 0; i < SAVES; i++) {
+			LegoU8* data = CreateSave(i);
+			Uint64 start = SDL_GetPerformanceCounter();
+			writer.Write(SAVE_PATH, data, SAVE_SIZE);
+			queued += SDL_GetPerformanceCounter() - start;
+
+			// Saves come minutes apart, so each one finds the writer idle
+			writer.Flush();
+		}
+	}
+
+	for (MxU32 i = 0; i < SAVES; i++) {
+		LegoU8* data = CreateSave(i);
+		Uint64 start = SDL_GetPerformanceCounter();
+		FILE* file = fopen(TEMP_PATH, "wb");
+		fwrite(data, 1, SAVE_SIZE, file);
+		fclose(file);
+		rename(TEMP_PATH, SAVE_PATH);
+		synchronous += SDL_GetPerformanceCounter() - start;
+		delete[] data;
+	}
+
+	printf(
+		"Caller's time per %u byte save: queued %.3f ms, written synchronously %.3f ms\n",
+		SAVE_SIZE,
+		queued * 1000.0 / SDL_GetPerformanceFrequency() / SAVES,
+		synchronous * 1000.0 / SDL_GetPerformanceFrequency() / SAVES
+	);
+}
+
+int main(int, char**)
+{
+	MxBool result = TestQueue();
+	result = TestReplace() && result;
+	result = TestFailure() && result;
+	Time();
+	remove(SAVE_PATH);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+// Checks that entity lookups through LegoWorldIndex return what the linear search of the
+// entity list that LegoWorld::Find used to do returns, while entities are added, removed
+// and renamed, and times both.
+
+#include "legoworldindex.h"
+#include "mxcore.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+
+class TestEntity : public MxCore {
+public:
+	TestEntity() : m_name(NULL) {}
+
+	// NULL stands for an entity without an ROI
+	const char* m_name;
+};
+
+// Few names in mixed case, so several entities share a name and buckets hold more than one
+static const char* g_names[] = {"pepper", "Pepper", "mama", "papa", "nick", "laura", "infoman", "brickstr",
+								"studs", "rhoda", "valerie", "snap", "pt", "mg", "bu", "ml",
+								"nu", "na", "cl", "en", "re", "ro", "d1", "d2"};
+
+#define NUM_NAMES (sizeof(g_names) / sizeof(g_names[0]))
+#define MAX_ENTITIES 512
+
+// The entity list and the two indices, maintained the way LegoWorld maintains them
+class TestWorld {
+public:
+	TestWorld() : m_count(0) {}
+
+	void Add(TestEntity* p_entity)
+	{
+		m_entities[m_count++] = p_entity;
+		m_atomIndex.Add(p_entity->GetId(), p_entity);
+		UpdateEntityName(p_entity);
+	}
+
+	void Remove(int p_index)
+	{
+		TestEntity* entity = m_entities[p_index];
+
+		for (int i = p_index; i < m_count - 1; i++) {
+			m_entities[i] = m_entities[i + 1];
+		}
+
+		m_count--;
+		m_atomIndex.Remove(entity);
+		m_nameIndex.Remove(entity);
+	}
+
+	void UpdateEntityName(TestEntity* p_entity)
+	{
+		if (!m_atomIndex.Contains(p_entity)) {
+			return;
+		}
+
+		if (p_entity->m_name) {
+			m_nameIndex
+				.Add(LegoWorldIndex::HashName(p_entity->m_name), p_entity, m_atomIndex.GetOrder(p_entity));
+		}
+		else {
+			m_nameIndex.Remove(p_entity);
+		}
+	}
+
+	TestEntity* Find(const char* p_name)
+	{
+		const LegoWorldIndex::Bucket* bucket = m_nameIndex.Find(LegoWorldIndex::HashName(p_name));
+
+		if (bucket) {
+			for (LegoWorldIndex::Bucket::const_iterator it = bucket->begin(); it != bucket->end(); it++) {
+				TestEntity* entity = (TestEntity*) *it;
+
+				if (entity->m_name && !SDL_strcasecmp(entity->m_name, p_name)) {
+					return entity;
+				}
+			}
+		}
+
+		return NULL;
+	}
+
+	TestEntity* FindLinear(const char* p_name)
+	{
+		for (int i = 0; i < m_count; i++) {
+			if (m_entities[i]->m_name && !SDL_strcasecmp(m_entities[i]->m_name, p_name)) {
+				return m_entities[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	TestEntity* m_entities[MAX_ENTITIES];
+	int m_count;
+	LegoWorldIndex m_atomIndex;
+	LegoWorldIndex m_nameIndex;
+};
+
+static unsigned int g_seed = 1;
+
+static int Random(int p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static const char* RandomName()
+{
+	return Random(8) ? g_names[Random(NUM_NAMES)] : NULL;
+}
+
+#define STEPS 200000
+
+static int TestDifferential()
+{
+	TestWorld world;
+	int lookups = 0, mismatches = 0;
+
+	for (int step = 0; step < STEPS; step++) {
+		switch (Random(8)) {
+		case 0:
+		case 1:
+			if (world.m_count < MAX_ENTITIES / 2) {
+				TestEntity* entity = new TestEntity;
+				entity->m_name = RandomName();
+				world.Add(entity);
+			}
+			break;
+		case 2:
+			if (world.m_count) {
+				int index = Random(world.m_count);
+				TestEntity* entity = world.m_entities[index];
+				world.Remove(index);
+				delete entity;
+			}
+			break;
+		case 3:
+		case 4:
+			// An ROI renamed or replaced after the entity was added
+			if (world.m_count) {
+				TestEntity* entity = world.m_entities[Random(world.m_count)];
+				entity->m_name = RandomName();
+				world.UpdateEntityName(entity);
+			}
+			break;
+		default: {
+			const char* name = g_names[Random(NUM_NAMES)];
+			lookups++;
+
+			if (world.Find(name) != world.FindLinear(name)) {
+				mismatches++;
+			}
+			break;
+		}
+		}
+	}
+
+	// A final sweep over every name
+	for (int i = 0; i < (int) NUM_NAMES; i++) {
+		lookups++;
+
+		if (world.Find(g_names[i]) != world.FindLinear(g_names[i])) {
+			mismatches++;
+		}
+	}
+
+	printf("differential: %d steps, %d lookups, %d mismatches\n", STEPS, lookups, mismatches);
+
+	for (int i = 0; i < world.m_count; i++) {
+		delete world.m_entities[i];
+	}
+
+	return mismatches == 0;
+}
+
+#define LOOKUPS 100000
+
+// Times lookups in a world the size of the Isle, where most names are unique
+static void TimeLookups(int p_entities)
+{
+	TestWorld world;
+	static char names[MAX_ENTITIES][16];
+
+	for (int i = 0; i < p_entities; i++) {
+		TestEntity* entity = new TestEntity;
+		SDL_snprintf(names[i], sizeof(names[i]), "entity%d", i);
+		entity->m_name = names[i];
+		world.Add(entity);
+	}
+
+	TestEntity* found = NULL;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		found = world.Find(names[i % p_entities]);
+	}
+
+	Uint64 middle = SDL_GetPerformanceCounter();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		found = world.FindLinear(names[i % p_entities]);
+	}
+
+	Uint64 end = SDL_GetPerformanceCounter();
+	double scale = 1000000000.0 / SDL_GetPerformanceFrequency() / LOOKUPS;
+
+	printf(
+		"%d entities: indexed %.1f ns, linear %.1f ns per lookup%s\n",
+		p_entities,
+		(middle - start) * scale,
+		(end - middle) * scale,
+		found ? "" : " (not found)"
+	);
+
+	for (int i = 0; i < world.m_count; i++) {
+		delete world.m_entities[i];
+	}
+}
+
+int main(int, char**)
+{
+	int result = TestDifferential();
+
+	TimeLookups(32);
+	TimeLookups(256);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
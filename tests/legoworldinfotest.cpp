@@ -0,0 +1,365 @@
+// Checks LegoWorldInfo on a synthetic inf.dta: records parsed into its block match a field by
+// field parse, survive a round trip through the cache file, and a cache whose source changed,
+// was truncated or has an offset out of the block is rejected. Then times loading a world the
+// way LoadWorldInfo used to (a file read per field and a new[] per name), parsing from one read
+// into the block, and loading the cache.
+
+#include "legoanimationmanager.h"
+#include "legoworldinfo.h"
+#include "misc/legostorage.h"
+#include "mxomni.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// LegoFile maps its paths through MxString, which looks them up in these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define SOURCE_PATH "legoworldinfotest.dta"
+#define CACHE_PATH "legoworldinfotest.cache"
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static void WriteName(LegoStorage* p_storage)
+{
+	MxU8 length = 3 + Random(12);
+	p_storage->Write(&length, sizeof(length));
+
+	for (MxU8 i = 0; i < length; i++) {
+		char c = 'a' + Random(26);
+		p_storage->Write(&c, 1);
+	}
+}
+
+static void WriteBytes(LegoStorage* p_storage, MxU32 p_count)
+{
+	for (MxU32 i = 0; i < p_count; i++) {
+		MxU8 b = Random(256);
+		p_storage->Write(&b, 1);
+	}
+}
+
+// An inf.dta in the version 3 layout with p_animCount records of up to eight models
+static MxU32 WriteSource(MxU16 p_animCount)
+{
+	LegoFile file;
+	file.Open(SOURCE_PATH, LegoFile::c_write);
+
+	MxU32 version = 3;
+	file.Write(&version, sizeof(version));
+	file.Write(&p_animCount, sizeof(p_animCount));
+
+	for (MxU16 i = 0; i < p_animCount; i++) {
+		WriteName(&file);
+		WriteBytes(&file, 4 + 2 + 4 + 4 * sizeof(float));
+
+		MxU8 modelCount = Random(9);
+		file.Write(&modelCount, sizeof(modelCount));
+
+		for (MxU8 j = 0; j < modelCount; j++) {
+			WriteName(&file);
+			WriteBytes(&file, 1 + 9 * sizeof(float) + 1);
+		}
+	}
+
+	LegoU32 size;
+	file.GetPosition(size);
+	return size;
+}
+
+static MxBool ReadModel(LegoStorage* p_storage, ModelInfo* p_info, LegoWorldInfo* p_block)
+{
+	MxU8 length;
+
+	if (p_storage->Read(&length, sizeof(length)) != SUCCESS) {
+		return FALSE;
+	}
+
+	p_info->m_name = p_block ? (char*) p_block->Alloc(length + 1) : new char[length + 1];
+	p_info->m_name[length] = 0;
+	return p_storage->Read(p_info->m_name, length) == SUCCESS &&
+		   p_storage->Read(&p_info->m_unk0x04, sizeof(MxU8)) == SUCCESS &&
+		   p_storage->Read(p_info->m_location, 3 * sizeof(float)) == SUCCESS &&
+		   p_storage->Read(p_info->m_direction, 3 * sizeof(float)) == SUCCESS &&
+		   p_storage->Read(p_info->m_up, 3 * sizeof(float)) == SUCCESS &&
+		   p_storage->Read(&p_info->m_unk0x2c, sizeof(MxU8)) == SUCCESS;
+}
+
+// Parses the records following the header into p_anims, one read per field as ReadAnimInfo and
+// ReadModelInfo do. Names and models come from p_block if given, the way they allocate now, or
+// from new[] as they used to.
+static MxBool ReadAnims(LegoStorage* p_storage, AnimInfo* p_anims, MxU16 p_animCount, LegoWorldInfo* p_block)
+{
+	for (MxU16 i = 0; i < p_animCount; i++) {
+		AnimInfo* info = &p_anims[i];
+		MxU8 length;
+
+		if (p_storage->Read(&length, sizeof(length)) != SUCCESS) {
+			return FALSE;
+		}
+
+		info->m_name = p_block ? (char*) p_block->Alloc(length + 1) : new char[length + 1];
+		info->m_name[length] = 0;
+
+		if (p_storage->Read(info->m_name, length) != SUCCESS ||
+			p_storage->Read(&info->m_objectId, sizeof(MxU32)) != SUCCESS ||
+			p_storage->Read(&info->m_location, sizeof(MxS16)) != SUCCESS ||
+			p_storage->Read(&info->m_unk0x0a, sizeof(MxU8)) != SUCCESS ||
+			p_storage->Read(&info->m_unk0x0b, sizeof(MxU8)) != SUCCESS ||
+			p_storage->Read(&info->m_unk0x0c, sizeof(MxU8)) != SUCCESS ||
+			p_storage->Read(&info->m_unk0x0d, sizeof(MxU8)) != SUCCESS ||
+			p_storage->Read(info->m_unk0x10, sizeof(info->m_unk0x10)) != SUCCESS ||
+			p_storage->Read(&info->m_modelCount, sizeof(MxU8)) != SUCCESS) {
+			return FALSE;
+		}
+
+		if (p_block) {
+			info->m_models = (ModelInfo*) p_block->Alloc(info->m_modelCount * sizeof(ModelInfo));
+		}
+		else {
+			info->m_models = new ModelInfo[info->m_modelCount];
+			memset(info->m_models, 0, info->m_modelCount * sizeof(ModelInfo));
+		}
+
+		for (MxU8 j = 0; j < info->m_modelCount; j++) {
+			if (!ReadModel(p_storage, &info->m_models[j], p_block)) {
+				return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+static void DeleteAnims(AnimInfo* p_anims, MxU16 p_animCount)
+{
+	for (MxU16 i = 0; i < p_animCount; i++) {
+		delete[] p_anims[i].m_name;
+
+		for (MxU8 j = 0; j < p_anims[i].m_modelCount; j++) {
+			delete[] p_anims[i].m_models[j].m_name;
+		}
+
+		delete[] p_anims[i].m_models;
+	}
+
+	delete[] p_anims;
+}
+
+// The way LoadWorldInfo used to load a world
+static AnimInfo* LoadFieldByField(MxU16& p_animCount)
+{
+	LegoFile file;
+	MxU32 version;
+
+	if (file.Open(SOURCE_PATH, LegoFile::c_read) != SUCCESS || file.Read(&version, sizeof(version)) != SUCCESS ||
+		file.Read(&p_animCount, sizeof(p_animCount)) != SUCCESS) {
+		return NULL;
+	}
+
+	AnimInfo* anims = new AnimInfo[p_animCount];
+	memset(anims, 0, p_animCount * sizeof(AnimInfo));
+
+	if (!ReadAnims(&file, anims, p_animCount, NULL)) {
+		DeleteAnims(anims, p_animCount);
+		return NULL;
+	}
+
+	return anims;
+}
+
+// The way LoadWorldInfo loads a world on a cache miss
+static LegoWorldInfo* LoadIntoBlock(MxU32 p_size)
+{
+	MxU8* image = new MxU8[p_size];
+	LegoMemory storage(image, p_size);
+	LegoFile file;
+	LegoWorldInfo* info = new LegoWorldInfo();
+	MxU32 version;
+	MxU16 animCount;
+
+	if (file.Open(SOURCE_PATH, LegoFile::c_read) != SUCCESS || file.Read(image, p_size) != SUCCESS ||
+		storage.Read(&version, sizeof(version)) != SUCCESS || storage.Read(&animCount, sizeof(animCount)) != SUCCESS ||
+		info->Create(&storage, animCount) != SUCCESS || !ReadAnims(&storage, info->GetAnims(), animCount, info)) {
+		delete info;
+		info = NULL;
+	}
+
+	delete[] image;
+	return info;
+}
+
+static MxBool Equal(AnimInfo* p_a, AnimInfo* p_b, MxU16 p_animCount)
+{
+	for (MxU16 i = 0; i < p_animCount; i++) {
+		AnimInfo& a = p_a[i];
+		AnimInfo& b = p_b[i];
+
+		if (strcmp(a.m_name, b.m_name) || a.m_objectId != b.m_objectId || a.m_location != b.m_location ||
+			a.m_unk0x0a != b.m_unk0x0a || a.m_unk0x0b != b.m_unk0x0b || a.m_unk0x0c != b.m_unk0x0c ||
+			a.m_unk0x0d != b.m_unk0x0d || memcmp(a.m_unk0x10, b.m_unk0x10, sizeof(a.m_unk0x10)) ||
+			a.m_modelCount != b.m_modelCount) {
+			return FALSE;
+		}
+
+		for (MxU8 j = 0; j < a.m_modelCount; j++) {
+			ModelInfo& c = a.m_models[j];
+			ModelInfo& d = b.m_models[j];
+
+			if (strcmp(c.m_name, d.m_name) || c.m_unk0x04 != d.m_unk0x04 ||
+				memcmp(c.m_location, d.m_location, sizeof(c.m_location)) ||
+				memcmp(c.m_direction, d.m_direction, sizeof(c.m_direction)) ||
+				memcmp(c.m_up, d.m_up, sizeof(c.m_up)) || c.m_unk0x2c != d.m_unk0x2c) {
+				return FALSE;
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+// Overwrites p_size bytes of the cache at p_offset, or truncates it there if p_data is NULL
+static MxU32 CacheSize()
+{
+	FILE* file = fopen(CACHE_PATH, "rb");
+	fseek(file, 0, SEEK_END);
+	MxU32 size = ftell(file);
+	fclose(file);
+	return size;
+}
+
+static void DamageCache(MxU32 p_offset, const void* p_data, MxU32 p_size)
+{
+	long size = CacheSize();
+	FILE* file = fopen(CACHE_PATH, "rb");
+	MxU8* data = new MxU8[size];
+	fread(data, 1, size, file);
+	fclose(file);
+
+	if (p_data) {
+		memcpy(data + p_offset, p_data, p_size);
+	}
+	else {
+		size = p_offset;
+	}
+
+	file = fopen(CACHE_PATH, "wb");
+	fwrite(data, 1, size, file);
+	fclose(file);
+	delete[] data;
+}
+
+#define ANIMS 600
+
+static MxBool TestCache()
+{
+	MxU32 size = WriteSource(ANIMS);
+	MxU16 animCount;
+	AnimInfo* reference = LoadFieldByField(animCount);
+	CHECK(reference != NULL && animCount == ANIMS);
+
+	LegoWorldInfo* info = LoadIntoBlock(size);
+	CHECK(info != NULL && info->GetAnimCount() == ANIMS && Equal(reference, info->GetAnims(), ANIMS));
+	CHECK(info->Alloc(1) == NULL);
+	CHECK(info->WriteCache(CACHE_PATH, size, 1234) == SUCCESS);
+	CHECK(Equal(reference, info->GetAnims(), ANIMS));
+	delete info;
+
+	info = new LegoWorldInfo();
+	CHECK(info->ReadCache(CACHE_PATH, size, 1234) == SUCCESS);
+	CHECK(info->GetAnimCount() == ANIMS && Equal(reference, info->GetAnims(), ANIMS));
+	printf("%d records: %u bytes in one block\n", ANIMS, info->GetSize());
+
+	// The source changed
+	CHECK(info->ReadCache(CACHE_PATH, size, 1235) == FAILURE);
+	CHECK(info->ReadCache(CACHE_PATH, size + 1, 1234) == FAILURE);
+
+	// A name offset out of the block. The block, starting with the AnimInfo array, follows the header.
+	MxU32 headerSize = CacheSize() - info->GetSize();
+	size_t offset = 0x7fffffff;
+	DamageCache(headerSize, &offset, sizeof(offset));
+	CHECK(info->ReadCache(CACHE_PATH, size, 1234) == FAILURE);
+
+	// Truncated
+	DamageCache(headerSize + 100, NULL, 0);
+	CHECK(info->ReadCache(CACHE_PATH, size, 1234) == FAILURE);
+
+	// A failed read leaves the records as they were
+	CHECK(Equal(reference, info->GetAnims(), ANIMS));
+	delete info;
+	DeleteAnims(reference, animCount);
+	return TRUE;
+}
+
+#define LOADS 50
+
+static void TimeLoads()
+{
+	MxU32 size = WriteSource(ANIMS);
+	LegoWorldInfo* info = LoadIntoBlock(size);
+	info->WriteCache(CACHE_PATH, size, 1234);
+	delete info;
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	for (MxU32 i = 0; i < LOADS; i++) {
+		MxU16 animCount;
+		AnimInfo* anims = LoadFieldByField(animCount);
+		DeleteAnims(anims, animCount);
+	}
+
+	Uint64 fieldByField = SDL_GetPerformanceCounter() - start;
+
+	start = SDL_GetPerformanceCounter();
+	for (MxU32 i = 0; i < LOADS; i++) {
+		delete LoadIntoBlock(size);
+	}
+
+	Uint64 block = SDL_GetPerformanceCounter() - start;
+
+	start = SDL_GetPerformanceCounter();
+	for (MxU32 i = 0; i < LOADS; i++) {
+		info = new LegoWorldInfo();
+		info->ReadCache(CACHE_PATH, size, 1234);
+		delete info;
+	}
+
+	Uint64 cache = SDL_GetPerformanceCounter() - start;
+	double scale = 1000.0 / SDL_GetPerformanceFrequency() / LOADS;
+
+	printf(
+		"%d records, %u bytes: field by field %.3f ms, one read into the block %.3f ms, from the cache %.3f ms\n",
+		ANIMS,
+		size,
+		fieldByField * scale,
+		block * scale,
+		cache * scale
+	);
+}
+
+int main(int, char**)
+{
+	MxBool result = TestCache();
+	TimeLoads();
+
+	remove(SOURCE_PATH);
+	remove(CACHE_PATH);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,292 @@
+// Checks ModelDb on a synthetic WORLD.WDB index: every world, part and model matches what
+// ReadModelDbWorlds reads, equal names share one pooled copy, a truncated index is rejected and
+// payload lookups stay in the file. Then times and counts the heap allocations of loading the
+// index the way LegoWorldPresenter used to (ReadModelDbWorlds on the file) and with ModelDb.
+
+#include "modeldb/modeldb.h"
+#include "mxomni.h"
+
+#include <SDL2/SDL_timer.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ModelDbPart names are MxStrings, which map paths through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+static MxU32 g_allocations = 0;
+
+void* operator new(size_t p_size)
+{
+	g_allocations++;
+	void* result = malloc(p_size ? p_size : 1);
+
+	if (result == NULL) {
+		throw std::bad_alloc();
+	}
+
+	return result;
+}
+
+void* operator new[](size_t p_size)
+{
+	return operator new(p_size);
+}
+
+void operator delete(void* p_ptr) noexcept
+{
+	free(p_ptr);
+}
+
+void operator delete[](void* p_ptr) noexcept
+{
+	free(p_ptr);
+}
+
+void operator delete(void* p_ptr, size_t) noexcept
+{
+	free(p_ptr);
+}
+
+void operator delete[](void* p_ptr, size_t) noexcept
+{
+	free(p_ptr);
+}
+
+#define WDB_PATH "modeldbtest.wdb"
+
+// Roughly the shape of the shipped index: a dozen worlds, each with a couple of hundred parts
+// drawn from a shared set, and a few dozen models under a handful of presenters
+#define WORLDS 12
+#define PARTS 200
+#define MODELS 60
+#define RUNS 20
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static void WriteName(FILE* p_file, const char* p_name)
+{
+	MxU32 length = strlen(p_name) + 1;
+	fwrite(&length, sizeof(length), 1, p_file);
+	fwrite(p_name, length, 1, p_file);
+}
+
+static void WriteU32(FILE* p_file, MxU32 p_value)
+{
+	fwrite(&p_value, sizeof(p_value), 1, p_file);
+}
+
+// Writes the index and returns its size; the payloads it points at are not needed
+static MxU32 WriteIndex()
+{
+	static const char* g_presenters[] = {
+		"LegoModelPresenter",
+		"LegoActorPresenter",
+		"LegoEntityPresenter",
+	};
+
+	FILE* file = fopen(WDB_PATH, "wb");
+	char name[32];
+
+	WriteU32(file, WORLDS);
+
+	for (MxU32 i = 0; i < WORLDS; i++) {
+		sprintf(name, "WORLD%02u", i);
+		WriteName(file, name);
+		WriteU32(file, PARTS);
+
+		for (MxU32 j = 0; j < PARTS; j++) {
+			sprintf(name, "part%03u", Random(PARTS * 2));
+			WriteName(file, name);
+			WriteU32(file, 100 + Random(10000));
+			WriteU32(file, Random(0x100000));
+		}
+
+		WriteU32(file, MODELS);
+
+		for (MxU32 j = 0; j < MODELS; j++) {
+			sprintf(name, "model%03u", Random(MODELS * 4));
+			WriteName(file, name);
+			WriteU32(file, 100 + Random(10000));
+			WriteU32(file, Random(0x100000));
+			WriteName(file, g_presenters[Random(3)]);
+
+			for (MxU32 k = 0; k < 9; k++) {
+				float f = (float) Random(2000) / 10.0F;
+				fwrite(&f, sizeof(f), 1, file);
+			}
+
+			MxU8 unk0x34 = Random(2);
+			fwrite(&unk0x34, sizeof(unk0x34), 1, file);
+		}
+	}
+
+	MxU32 size = ftell(file);
+	fclose(file);
+	return size;
+}
+
+static MxU8* ReadImage(MxU32 p_size)
+{
+	MxU8* data = new MxU8[p_size];
+	FILE* file = fopen(WDB_PATH, "rb");
+	fread(data, 1, p_size, file);
+	fclose(file);
+	return data;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool Compare(ModelDbWorld* p_worlds, MxS32 p_numWorlds, ModelDb& p_db)
+{
+	CHECK(p_db.GetNumWorlds() == p_numWorlds);
+
+	for (MxS32 i = 0; i < p_numWorlds; i++) {
+		ModelDbWorldEntry* world = p_db.FindWorld(p_worlds[i].m_worldName);
+		CHECK(world != NULL && !strcmp(world->m_worldName, p_worlds[i].m_worldName));
+		CHECK(world->m_numParts == p_worlds[i].m_partList->GetNumElements());
+
+		ModelDbPartListCursor cursor(p_worlds[i].m_partList);
+		ModelDbPart* part;
+		MxS32 j = 0;
+
+		while (cursor.Next(part)) {
+			ModelDbPartEntry& entry = world->m_parts[j++];
+			CHECK(!strcmp(entry.m_roiName, part->m_roiName.GetData()));
+			CHECK(entry.m_partDataLength == part->m_partDataLength);
+			CHECK(entry.m_partDataOffset == part->m_partDataOffset);
+		}
+
+		CHECK(world->m_numModels == p_worlds[i].m_numModels);
+
+		for (j = 0; j < world->m_numModels; j++) {
+			ModelDbModel& model = world->m_models[j];
+			ModelDbModel& expected = p_worlds[i].m_models[j];
+			CHECK(!strcmp(model.m_modelName, expected.m_modelName));
+			CHECK(!strcmp(model.m_presenterName, expected.m_presenterName));
+			CHECK(model.m_modelDataLength == expected.m_modelDataLength);
+			CHECK(model.m_modelDataOffset == expected.m_modelDataOffset);
+			CHECK(!memcmp(model.m_location, expected.m_location, sizeof(model.m_location)));
+			CHECK(!memcmp(model.m_direction, expected.m_direction, sizeof(model.m_direction)));
+			CHECK(!memcmp(model.m_up, expected.m_up, sizeof(model.m_up)));
+			CHECK(model.m_unk0x34 == expected.m_unk0x34);
+		}
+	}
+
+	return TRUE;
+}
+
+static MxBool TestIndex(MxU32 p_size)
+{
+	SDL_IOStream* file = SDL_RWFromFile(WDB_PATH, "rb");
+	ModelDbWorld* worlds;
+	MxS32 numWorlds;
+	CHECK(ReadModelDbWorlds(file, worlds, numWorlds) == SUCCESS);
+	SDL_RWclose(file);
+
+	ModelDb db;
+	CHECK(db.Read(ReadImage(p_size), p_size) == SUCCESS);
+	CHECK(db.GetIndexEnd() == p_size);
+	CHECK(Compare(worlds, numWorlds, db));
+	FreeModelDbWorlds(worlds, numWorlds);
+
+	// One pooled copy per distinct name, across worlds
+	ModelDbWorldEntry* a = db.FindWorld("world00");
+	ModelDbWorldEntry* b = db.FindWorld("WORLD01");
+	CHECK(a != NULL && b != NULL && db.FindWorld("WORLD99") == NULL);
+	CHECK(a->m_models[0].m_presenterName == b->m_models[0].m_presenterName ||
+		  strcmp(a->m_models[0].m_presenterName, b->m_models[0].m_presenterName));
+
+	for (MxS32 i = 0; i < a->m_numParts; i++) {
+		for (MxS32 j = 0; j < b->m_numParts; j++) {
+			CHECK(
+				(a->m_parts[i].m_roiName == b->m_parts[j].m_roiName) ==
+				!strcmp(a->m_parts[i].m_roiName, b->m_parts[j].m_roiName)
+			);
+		}
+	}
+
+	// Payload lookups stay inside the image
+	CHECK(db.GetData(0, p_size) != NULL);
+	CHECK(db.GetData(p_size, 0) != NULL);
+	CHECK(db.GetData(p_size - 4, 5) == NULL);
+	CHECK(db.GetData(0xfffffff0, 0x20) == NULL);
+
+	// A truncated index is rejected
+	ModelDb truncated;
+	CHECK(truncated.Read(ReadImage(p_size), p_size - 3) == FAILURE);
+	CHECK(truncated.FindWorld("WORLD00") == NULL);
+	return TRUE;
+}
+
+static MxBool TimeIndex(MxU32 p_size)
+{
+	MxU32 allocations = g_allocations;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < RUNS; i++) {
+		SDL_IOStream* file = SDL_RWFromFile(WDB_PATH, "rb");
+		ModelDbWorld* worlds;
+		MxS32 numWorlds;
+		CHECK(ReadModelDbWorlds(file, worlds, numWorlds) == SUCCESS);
+		SDL_RWclose(file);
+		FreeModelDbWorlds(worlds, numWorlds);
+	}
+
+	double fieldMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / RUNS;
+	MxU32 fieldAllocations = (g_allocations - allocations) / RUNS;
+
+	allocations = g_allocations;
+	start = SDL_GetPerformanceCounter();
+	MxU32 arenaSize = 0, poolSize = 0;
+
+	for (MxU32 i = 0; i < RUNS; i++) {
+		ModelDb db;
+		CHECK(db.Read(ReadImage(p_size), p_size) == SUCCESS);
+		arenaSize = db.GetArenaSize();
+		poolSize = db.GetPoolSize();
+	}
+
+	double arenaMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / RUNS;
+	MxU32 arenaAllocations = (g_allocations - allocations) / RUNS;
+
+	printf(
+		"%u worlds, %u parts, %u models, %u byte index: ReadModelDbWorlds %.3f ms and %u allocations, "
+		"ModelDb %.3f ms and %u allocations (%u byte arena, %u bytes of names)\n",
+		WORLDS,
+		WORLDS * PARTS,
+		WORLDS * MODELS,
+		p_size,
+		fieldMs,
+		fieldAllocations,
+		arenaMs,
+		arenaAllocations,
+		arenaSize,
+		poolSize
+	);
+	return TRUE;
+}
+
+int main(int, char**)
+{
+	MxU32 size = WriteIndex();
+	MxBool result = TestIndex(size) && TimeIndex(size);
+	remove(WDB_PATH);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
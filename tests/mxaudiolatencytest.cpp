@@ -0,0 +1,157 @@
+// Checks the audio latency MxAudioLatency measures against a simulated pull-mode device over
+// hours of play: callbacks that wake late by a random amount, a device clock running fast or
+// slow against the performance counter, and a stall long enough for the device to run dry.
+// The simulated device plays continuously and asks for a period when its queue falls to one
+// period; the error is the measured queue less the simulated one after each callback.
+
+#include "mxaudiolatency.h"
+
+#include <SDL2/SDL_timer.h>
+#include <math.h>
+#include <stdio.h>
+
+#define SAMPLE_RATE 44100
+#define PERIOD 1024
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+struct Result {
+	MxU32 m_callbacks;
+	double m_maxError;     // frames, after the first window
+	double m_meanError;    // frames, after the first window
+	double m_firstMinute;  // mean measured latency, ms
+	double m_lastMinute;   // mean measured latency, ms
+	MxU32 m_lateCallbacks;
+	MxU32 m_underruns;
+	MxU32 m_simulatedUnderruns;
+};
+
+// Plays p_hours with the device clock off by p_drift parts per million. Callbacks wake up to
+// p_jitterUS late. If p_stallAt is set, the callback at that second stalls for p_stallMS.
+static Result Simulate(double p_hours, double p_drift, MxU32 p_jitterUS, double p_stallAt, MxU32 p_stallMS)
+{
+	MxAudioLatency latency;
+	latency.Reset(SAMPLE_RATE);
+
+	Result result = {};
+	double frequency = (double) SDL_GetPerformanceFrequency();
+	double rate = SAMPLE_RATE * (1.0 + p_drift / 1000000.0);
+	double end = p_hours * 3600.0;
+	double sum = 0, first = 0, last = 0;
+	MxU32 measured = 0, firstCount = 0, lastCount = 0;
+	MxBool stalled = FALSE;
+
+	// Seconds on the performance counter, and frames queued on the device
+	double time = 1.0, queue = 0;
+
+	while (time < end) {
+		MxU32 frames = PERIOD;
+		latency.Mixed((Uint64) (time * frequency), frames);
+		queue += frames;
+		result.m_callbacks++;
+
+		double error = fabs((double) latency.GetQueuedFrames() - queue);
+		double ms = latency.GetQueuedFrames() * 1000.0 / SAMPLE_RATE;
+
+		if (time > 10.0 + 1.0 + 1.0) {
+			if (error > result.m_maxError) {
+				result.m_maxError = error;
+			}
+
+			sum += error;
+			measured++;
+		}
+
+		if (time < 61.0) {
+			first += ms;
+			firstCount++;
+		}
+		else if (time > end - 60.0) {
+			last += ms;
+			lastCount++;
+		}
+
+		// The device asks for more once it is down to a period, and the callback wakes late
+		double wait = queue > PERIOD ? (queue - PERIOD) / rate : 0;
+		wait += Random(p_jitterUS + 1) / 1000000.0;
+
+		if (p_stallAt > 0 && !stalled && time >= p_stallAt) {
+			wait += p_stallMS / 1000.0;
+			stalled = TRUE;
+		}
+
+		time += wait;
+		queue -= wait * rate;
+
+		if (queue < 0) {
+			// Ran dry, and picks up from the next period
+			queue = 0;
+			result.m_simulatedUnderruns++;
+		}
+	}
+
+	result.m_meanError = measured ? sum / measured : 0;
+	result.m_firstMinute = firstCount ? first / firstCount : 0;
+	result.m_lastMinute = lastCount ? last / lastCount : 0;
+	result.m_lateCallbacks = latency.GetLateCallbacks();
+	result.m_underruns = latency.GetUnderruns();
+	return result;
+}
+
+static MxBool Report(const char* p_name, const Result& p_result, MxU32 p_underruns, MxU32 p_lateCallbacks)
+{
+	// A tenth of a period of error at most, i.e. 2.3 ms
+	MxBool pass = p_result.m_maxError < PERIOD / 10 && p_result.m_underruns == p_underruns &&
+				  p_result.m_simulatedUnderruns == p_underruns && p_result.m_lateCallbacks == p_lateCallbacks;
+
+	printf(
+		"%s: %u callbacks, error mean %.1f max %.1f frames, latency first minute %.2f ms last minute %.2f ms, "
+		"%u late, %u underruns (%u simulated)\n",
+		p_name,
+		p_result.m_callbacks,
+		p_result.m_meanError,
+		p_result.m_maxError,
+		p_result.m_firstMinute,
+		p_result.m_lastMinute,
+		p_result.m_lateCallbacks,
+		p_result.m_underruns,
+		p_result.m_simulatedUnderruns
+	);
+	return pass;
+}
+
+#define HOURS 4.0
+
+int main(int, char**)
+{
+	MxBool result = TRUE;
+
+	result &= Report("steady", Simulate(HOURS, 0, 2000, 0, 0), 0, 0);
+	result &= Report("device 100 ppm fast", Simulate(HOURS, 100, 2000, 0, 0), 0, 0);
+	result &= Report("device 100 ppm slow", Simulate(HOURS, -100, 2000, 0, 0), 0, 0);
+	result &= Report("60 ms stall", Simulate(HOURS, 50, 2000, 3600.0, 60), 1, 1);
+
+	// Cost on the audio thread
+	MxAudioLatency latency;
+	latency.Reset(SAMPLE_RATE);
+	Uint64 period = SDL_GetPerformanceFrequency() * PERIOD / SAMPLE_RATE;
+	Uint64 now = SDL_GetPerformanceFrequency();
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < 1000000; i++) {
+		latency.Mixed(now, PERIOD);
+		now += period;
+	}
+
+	double ns = (SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency() / 1000000;
+	printf("Mixed: %.1f ns per callback\n", ns);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,286 @@
+// Checks that a split chunk gathered in place reads back the same as one joined as its pieces
+// arrive, through both CopyData and GetData, that the buffers its pieces were read into are
+// referenced until the chunk is gone or joined, and that a piece from a buffer which is not a
+// stream buffer joins what was gathered so far. Then times delivering a split chunk to a
+// consumer that copies it, gathered in place and joined.
+
+#include "mxdiskstreamcontroller.h"
+#include "mxdsbuffer.h"
+#include "mxdssubscriber.h"
+#include "mxmisc.h"
+#include "mxomni.h"
+#include "mxstreamchunk.h"
+#include "mxtimer.h"
+#include "mxvariabletable.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// MxDSAction and friends map file names through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+MxLong MxTimer::g_lastTimeCalculated = 0;
+MxLong MxTimer::g_lastTimeTimerStarted = 0;
+
+// What mxdsbuffer.cpp and the actions reach beyond a buffer and its chunks. None of it is
+// called by these tests.
+MxOmni* MxOmni::GetInstance()
+{
+	return NULL;
+}
+MxAtomSet* AtomSet()
+{
+	return NULL;
+}
+MxStreamer* Streamer()
+{
+	return NULL;
+}
+MxTimer* Timer()
+{
+	return NULL;
+}
+MxVariableTable* VariableTable()
+{
+	return NULL;
+}
+const char* MxVariableTable::GetVariable(const char*)
+{
+	return NULL;
+}
+MxResult MxDSSubscriber::AddData(MxStreamChunk*, MxBool)
+{
+	return FAILURE;
+}
+MxDSSubscriber* MxDSSubscriberList::Find(MxU32, MxS16)
+{
+	return NULL;
+}
+void MxDiskStreamController::FUN_100c7cb0(MxDSStreamingAction*)
+{
+}
+void MxDiskStreamController::InsertToList74(MxDSBuffer*)
+{
+}
+MxNextActionDataStart* MxStreamController::FindNextActionDataStartFromStreamingAction(MxDSStreamingAction*)
+{
+	return NULL;
+}
+MxResult MxStreamController::InsertActionToList54(MxDSAction*)
+{
+	return FAILURE;
+}
+
+#define HEADER_SIZE (8 + 0x0e)
+#define PAYLOAD 0x30000
+#define ROUNDS 200
+
+static unsigned int g_seed = 1;
+
+static MxU8 Random()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return g_seed >> 16;
+}
+
+// A split chunk's payload cut into pieces as a stream buffer of p_bufferSize would, each piece
+// in a buffer of its own behind the bytes of the chunks before it
+class SplitChunk {
+public:
+	SplitChunk(MxU32 p_length, MxU32 p_bufferSize, MxU32 p_offset)
+	{
+		m_length = p_length;
+		m_payload = new MxU8[p_length];
+		m_numPieces = 0;
+
+		for (MxU32 i = 0; i < p_length; i++) {
+			m_payload[i] = Random();
+		}
+
+		for (MxU32 done = 0; done < p_length; m_numPieces++) {
+			MxU32 room = p_bufferSize - (m_numPieces ? 0 : p_offset) - HEADER_SIZE;
+			MxU32 length = SDL_min(room, p_length - done);
+			MxU8* data = new MxU8[p_bufferSize];
+
+			memset(data, 0, p_bufferSize);
+			m_data[m_numPieces] = data + (m_numPieces ? 0 : p_offset);
+			WritePiece(m_data[m_numPieces], m_payload + done, length);
+
+			m_buffers[m_numPieces] = new MxDSBuffer();
+			m_buffers[m_numPieces]->SetBufferPointer(data, p_bufferSize);
+			m_buffers[m_numPieces]->SetMode(MxDSBuffer::e_chunk);
+			done += length;
+		}
+	}
+
+	~SplitChunk()
+	{
+		for (MxU32 i = 0; i < m_numPieces; i++) {
+			delete[] m_buffers[i]->GetBuffer();
+			m_buffers[i]->SetMode(MxDSBuffer::e_preallocated);
+			delete m_buffers[i];
+		}
+
+		delete[] m_payload;
+	}
+
+	void WritePiece(MxU8* p_data, MxU8* p_payload, MxU32 p_length)
+	{
+		MxU32 size = 0x0e + p_length;
+		MxU16 flags = DS_CHUNK_SPLIT;
+		MxU32 objectId = 7;
+		MxLong time = 100;
+
+		memcpy(p_data, "MxCh", 4);
+		memcpy(p_data + 4, &size, 4);
+		memcpy(p_data + 8, &flags, 2);
+		memcpy(p_data + 0x0a, &objectId, 4);
+		memcpy(p_data + 0x0e, &time, 4);
+		memcpy(p_data + 0x12, &m_length, 4);
+		memcpy(p_data + HEADER_SIZE, p_payload, p_length);
+	}
+
+	// Gathers the pieces the way MxDSBuffer::ParseChunk and FUN_100c67b0 do
+	MxDSBuffer* Gather(MxBool p_inPlace)
+	{
+		MxDSBuffer* buffer = new MxDSBuffer();
+
+		if (p_inPlace) {
+			if (buffer->StartPieces(m_buffers[0], m_data[0]) != SUCCESS) {
+				return NULL;
+			}
+		}
+		else if (buffer->AllocateBuffer(HEADER_SIZE + m_length, MxDSBuffer::e_allocate) != SUCCESS ||
+				 buffer->CalcBytesRemaining(m_data[0]) != SUCCESS) {
+			return NULL;
+		}
+
+		for (MxU32 i = 1; i < m_numPieces; i++) {
+			if (buffer->AddPiece(m_buffers[i], m_data[i]) != SUCCESS) {
+				return NULL;
+			}
+		}
+
+		return buffer->GetBytesRemaining() == 0 ? buffer : NULL;
+	}
+
+	MxU32 m_length;
+	MxU8* m_payload;
+	MxU32 m_numPieces;
+	MxU8* m_data[8];
+	MxDSBuffer* m_buffers[8];
+};
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestGather(MxBool p_inPlace, MxBool p_join)
+{
+	SplitChunk split(PAYLOAD, 0x10000, 0x1234);
+	MxDSBuffer::ChunkStats before, after;
+	MxDSBuffer::GetChunkStats(before);
+
+	MxDSBuffer* buffer = split.Gather(p_inPlace);
+	CHECK(buffer);
+	CHECK(buffer->HasPieces() == p_inPlace);
+
+	for (MxU32 i = 0; i < split.m_numPieces; i++) {
+		CHECK(split.m_buffers[i]->GetRefCount() == (p_inPlace ? 1 : 0));
+	}
+
+	MxStreamChunk* chunk = new MxStreamChunk();
+	CHECK(chunk->ReadChunk(buffer, buffer->GetBuffer()) == SUCCESS);
+	CHECK(chunk->GetLength() == PAYLOAD);
+	CHECK(chunk->GetObjectId() == 7);
+
+	MxU8* copy = new MxU8[PAYLOAD];
+	chunk->CopyData(copy);
+	CHECK(!memcmp(copy, split.m_payload, PAYLOAD));
+	delete[] copy;
+
+	if (p_join) {
+		CHECK(!memcmp(chunk->GetData(), split.m_payload, PAYLOAD));
+		CHECK(!buffer->HasPieces());
+		CHECK(split.m_buffers[0]->GetRefCount() == 0);
+	}
+
+	// Joining as the pieces arrive copies the header along with the first piece
+	MxDSBuffer::GetChunkStats(after);
+	CHECK(after.m_bytesCopied - before.m_bytesCopied == (p_inPlace ? (p_join ? PAYLOAD : 0) : HEADER_SIZE + PAYLOAD));
+
+	delete chunk;
+	CHECK(!buffer->HasRef());
+
+	for (MxU32 i = 0; i < split.m_numPieces; i++) {
+		CHECK(split.m_buffers[i]->GetRefCount() == 0);
+	}
+
+	delete buffer;
+	return TRUE;
+}
+
+static MxBool TestJoinMidway()
+{
+	SplitChunk split(PAYLOAD, 0x10000, 0x100);
+	CHECK(split.m_numPieces >= 3);
+
+	// The last piece comes from a buffer that is refilled after parsing
+	split.m_buffers[split.m_numPieces - 1]->SetMode(MxDSBuffer::e_allocate);
+
+	MxDSBuffer* buffer = split.Gather(TRUE);
+	split.m_buffers[split.m_numPieces - 1]->SetMode(MxDSBuffer::e_chunk);
+	CHECK(buffer);
+	CHECK(!buffer->HasPieces());
+	CHECK(split.m_buffers[0]->GetRefCount() == 0);
+
+	MxStreamChunk* chunk = new MxStreamChunk();
+	CHECK(chunk->ReadChunk(buffer, buffer->GetBuffer()) == SUCCESS);
+	CHECK(!memcmp(chunk->GetData(), split.m_payload, PAYLOAD));
+
+	delete chunk;
+	delete buffer;
+	return TRUE;
+}
+
+// Microseconds to gather a split chunk and copy it out, as MxStillPresenter or
+// MxWavePresenter do
+static double Time(MxBool p_inPlace)
+{
+	SplitChunk split(PAYLOAD, 0x10000, 0x1234);
+	MxU8* dest = new MxU8[PAYLOAD];
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < ROUNDS; i++) {
+		MxDSBuffer* buffer = split.Gather(p_inPlace);
+		MxStreamChunk* chunk = new MxStreamChunk();
+		chunk->ReadChunk(buffer, buffer->GetBuffer());
+		chunk->CopyData(dest);
+		delete chunk;
+		delete buffer;
+	}
+
+	double us = (SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency() / ROUNDS;
+	delete[] dest;
+	return us;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestGather(TRUE, FALSE);
+	result = TestGather(TRUE, TRUE) && result;
+	result = TestGather(FALSE, FALSE) && result;
+	result = TestJoinMidway() && result;
+
+	double joined = Time(FALSE);
+	double inPlace = Time(TRUE);
+	printf("%u byte split chunk copied out: joined %.1f us, gathered in place %.1f us\n", PAYLOAD, joined, inPlace);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
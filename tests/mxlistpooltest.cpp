@@ -0,0 +1,169 @@
+// Checks that only list types opted in through MxListPooled take their entries from
+// MxListNodePool, that an opted-in list stops reaching the heap once its slabs are warm, and
+// that Trim frees the slabs of a size class only once all of its nodes are back. Then times
+// appending and emptying a list with pooled and heap entries.
+
+#include "mxlist.h"
+
+#include <SDL2/SDL_timer.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ENTRIES 1000
+#define ROUNDS 2000
+
+struct Pooled {};
+struct Unpooled {};
+
+template <>
+struct MxListPooled<Pooled*> {
+	enum {
+		value = TRUE
+	};
+};
+
+static MxU32 g_news = 0;
+static MxU32 g_deletes = 0;
+
+void* operator new(size_t p_size)
+{
+	g_news++;
+	void* p = malloc(p_size ? p_size : 1);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void* p_ptr) noexcept
+{
+	if (p_ptr) {
+		g_deletes++;
+	}
+	free(p_ptr);
+}
+
+void operator delete(void* p_ptr, size_t) noexcept
+{
+	operator delete(p_ptr);
+}
+
+template <class T>
+class TestList : public MxList<T*> {
+public:
+	void Fill(MxU32 p_count)
+	{
+		for (MxU32 i = 0; i < p_count; i++) {
+			this->Append((T*) (size_t) (i + 1));
+		}
+	}
+};
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestOptIn()
+{
+	MxListNodePool::Stats before, after;
+	TestList<Unpooled> list;
+
+	MxListNodePool::GetStats(before);
+	MxU32 news = g_news;
+	list.Fill(ENTRIES);
+	CHECK(g_news - news == ENTRIES);
+	list.DeleteAll();
+
+	MxListNodePool::GetStats(after);
+	CHECK(after.m_allocations == before.m_allocations);
+	return TRUE;
+}
+
+static MxBool TestWarm()
+{
+	MxListNodePool::Stats before, after;
+	TestList<Pooled> list;
+
+	list.Fill(ENTRIES);
+	list.DeleteAll();
+
+	MxListNodePool::GetStats(before);
+	MxU32 news = g_news;
+
+	for (MxU32 i = 0; i < 10; i++) {
+		list.Fill(ENTRIES);
+		list.DeleteAll();
+	}
+
+	MxListNodePool::GetStats(after);
+	CHECK(g_news == news);
+	CHECK(after.m_allocations - before.m_allocations == 10 * ENTRIES);
+	CHECK(after.m_hits - before.m_hits == 10 * ENTRIES);
+	CHECK(after.m_slabs == before.m_slabs);
+	return TRUE;
+}
+
+static MxBool TestTrim()
+{
+	MxListNodePool::Stats stats;
+	TestList<Pooled> list;
+
+	list.Fill(ENTRIES);
+	MxListNodePool::GetStats(stats);
+	MxU32 slabs = stats.m_slabs;
+
+	// The slabs of a class with live nodes stay
+	MxU32 deletes = g_deletes;
+	CHECK(MxListNodePool::Trim() == 0);
+	CHECK(g_deletes == deletes);
+
+	list.DeleteAll();
+	MxU32 freed = MxListNodePool::Trim();
+	CHECK(freed == (ENTRIES + MxListNodePool::c_slabNodes - 1) / MxListNodePool::c_slabNodes);
+	CHECK(g_deletes - deletes == freed);
+	CHECK(MxListNodePool::Trim() == 0);
+
+	// And the pool starts over
+	list.Fill(1);
+	MxListNodePool::GetStats(stats);
+	CHECK(stats.m_slabs == slabs + 1);
+	list.DeleteAll();
+	CHECK(MxListNodePool::Trim() == 1);
+	return TRUE;
+}
+
+// Nanoseconds per entry to append ENTRIES entries and empty the list again
+template <class T>
+static double Time()
+{
+	TestList<T> list;
+	list.Fill(ENTRIES);
+	list.DeleteAll();
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < ROUNDS; i++) {
+		list.Fill(ENTRIES);
+		list.DeleteAll();
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency() / ROUNDS / ENTRIES;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestOptIn();
+	result = TestWarm() && result;
+	result = TestTrim() && result;
+
+	double heap = Time<Unpooled>();
+	double pooled = Time<Pooled>();
+	printf("Append and remove per entry: heap %.1f ns, pooled %.1f ns\n", heap, pooled);
+	MxListNodePool::Trim();
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
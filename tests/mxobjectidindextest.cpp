@@ -0,0 +1,409 @@
+// Checks the object id indexed lists of MxStreamController against the linear scans they
+// replace: MxIndexedDSObjectList against MxDSObjectList, and MxDSSubscriberList and
+// MxNextActionDataStartList against plain lists searched front to back. Random pushes, pops,
+// finds and erases over a few object ids and instances cover the -1 object id, the -2 and -3
+// instance wildcards and which of several matches is returned, and the lists must hold the
+// same entries in the same order after every step.
+
+#include "mxdsbuffer.h"
+#include "mxdsobject.h"
+#include "mxdssubscriber.h"
+#include "mxnextactiondatastart.h"
+#include "mxomni.h"
+#include "mxstreamcontroller.h"
+#include "mxtimer.h"
+#include "mxvariabletable.h"
+
+#include <stdio.h>
+
+// MxDSObject and the actions map file names through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+MxLong MxTimer::g_lastTimeCalculated = 0;
+MxLong MxTimer::g_lastTimeTimerStarted = 0;
+
+// What the actions and the controller reach beyond the lists. None of it is called by these
+// tests.
+MxOmni* MxOmni::GetInstance()
+{
+	return NULL;
+}
+MxAtomSet* AtomSet()
+{
+	return NULL;
+}
+MxTimer* Timer()
+{
+	return NULL;
+}
+MxVariableTable* VariableTable()
+{
+	return NULL;
+}
+const char* MxVariableTable::GetVariable(const char*)
+{
+	return NULL;
+}
+MxU8 MxDSBuffer::ReleaseRef(MxDSChunk*)
+{
+	return 0;
+}
+void MxDSBuffer::AddRef(MxDSChunk*)
+{
+}
+void MxDSBuffer::CopyPieces(MxU8*)
+{
+}
+MxU8* MxDSBuffer::JoinPieces()
+{
+	return NULL;
+}
+
+#define ROUNDS 200
+#define STEPS 3000
+#define OBJECT_IDS 12
+#define INSTANCES 4
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+// Exposes the list a controller keeps its subscribers in
+class TestController : public MxStreamController {
+public:
+	MxDSSubscriberList& GetSubscribers() { return m_subscribers; }
+};
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxDSObject* NewObject(MxU32 p_objectId, MxS16 p_unk0x24)
+{
+	MxDSObject* object = new MxDSObject();
+	object->SetObjectId(p_objectId);
+	object->SetUnknown24(p_unk0x24);
+	return object;
+}
+
+// An object id or -1, and an instance or one of the -2 and -3 wildcards
+static void RandomQuery(MxDSObject& p_query)
+{
+	p_query.SetObjectId(Random(8) == 0 ? -1 : Random(OBJECT_IDS));
+
+	switch (Random(6)) {
+	case 0:
+		p_query.SetUnknown24(-2);
+		break;
+	case 1:
+		p_query.SetUnknown24(-3);
+		break;
+	default:
+		p_query.SetUnknown24(Random(INSTANCES));
+		break;
+	}
+}
+
+template <class T>
+static MxBool SameOrder(list<T>& p_list, list<T>& p_reference)
+{
+	if (p_list.size() != p_reference.size()) {
+		return FALSE;
+	}
+
+	typename list<T>::iterator it = p_list.begin();
+	typename list<T>::iterator ref = p_reference.begin();
+
+	for (; it != p_list.end(); it++, ref++) {
+		if (*it != *ref) {
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+static MxBool TestObjectRules()
+{
+	MxIndexedDSObjectList objects;
+	MxDSObject* a = NewObject(5, 0);
+	MxDSObject* b = NewObject(7, 1);
+	MxDSObject* c = NewObject(5, 1);
+	MxDSObject* d = NewObject(5, 2);
+	MxDSObject query;
+
+	objects.PushBack(a);
+	objects.PushBack(b);
+	objects.PushBack(c);
+	objects.PushBack(d);
+
+	// -1 matches any object id, in list order
+	query.SetObjectId(-1);
+	query.SetUnknown24(1);
+	CHECK(objects.Find(&query) == b);
+
+	// -2 matches any instance and returns the first object with the id
+	query.SetObjectId(5);
+	query.SetUnknown24(-2);
+	CHECK(objects.Find(&query) == a);
+
+	// -3 matches any instance and returns the last object with the id
+	query.SetUnknown24(-3);
+	CHECK(objects.Find(&query) == d);
+
+	query.SetUnknown24(3);
+	CHECK(objects.Find(&query) == NULL);
+
+	// FindAndErase with -3 erases the object it returns. MxDSObjectList erases end() here.
+	query.SetUnknown24(-3);
+	CHECK(objects.FindAndErase(&query) == d);
+	CHECK(objects.size() == 3 && objects.back() == c);
+	CHECK(objects.FindAndErase(&query) == c);
+	CHECK(objects.size() == 2 && objects.front() == a && objects.back() == b);
+
+	// An object whose id changes while it is listed still leaves the index when popped
+	MxDSObject* object;
+	a->SetObjectId(9);
+	CHECK(objects.PopFront(object) && object == a);
+	query.SetObjectId(5);
+	query.SetUnknown24(-2);
+	CHECK(objects.Find(&query) == NULL);
+	query.SetObjectId(9);
+	CHECK(objects.Find(&query) == NULL);
+
+	CHECK(objects.PopFront(object) && object == b);
+	CHECK(!objects.PopFront(object));
+
+	delete a;
+	delete b;
+	delete c;
+	delete d;
+	return TRUE;
+}
+
+// MxDSObjectList is the unindexed scan. Its FindAndErase erases end() for -3, so the object
+// found is erased by hand instead.
+static MxDSObject* ReferenceFindAndErase(MxDSObjectList& p_reference, MxDSObject* p_query)
+{
+	MxDSObject* found = p_reference.Find(p_query);
+
+	if (found) {
+		p_reference.remove(found);
+	}
+
+	return found;
+}
+
+static MxBool TestObjectsRandom()
+{
+	MxU32 found = 0;
+
+	for (MxU32 round = 0; round < ROUNDS; round++) {
+		MxIndexedDSObjectList objects;
+		MxDSObjectList reference;
+		list<MxDSObject*> all;
+		MxDSObject query;
+
+		for (MxU32 step = 0; step < STEPS; step++) {
+			RandomQuery(query);
+
+			switch (Random(5)) {
+			case 0:
+			case 1: {
+				MxDSObject* object = NewObject(Random(OBJECT_IDS), Random(INSTANCES));
+				objects.PushBack(object);
+				reference.PushBack(object);
+				all.push_back(object);
+				break;
+			}
+			case 2: {
+				MxDSObject *object, *expected;
+				MxBool popped = objects.PopFront(object);
+				CHECK(popped == reference.PopFront(expected));
+				CHECK(!popped || object == expected);
+				break;
+			}
+			case 3: {
+				MxDSObject* object = objects.Find(&query);
+				CHECK(object == reference.Find(&query));
+				found += object != NULL;
+				break;
+			}
+			default: {
+				MxDSObject* object = objects.FindAndErase(&query);
+				CHECK(object == ReferenceFindAndErase(reference, &query));
+				found += object != NULL;
+				break;
+			}
+			}
+
+			CHECK(SameOrder<MxDSObject*>(objects, reference));
+		}
+
+		for (list<MxDSObject*>::iterator it = all.begin(); it != all.end(); it++) {
+			delete *it;
+		}
+	}
+
+	printf("%u object steps, %u found\n", ROUNDS * STEPS, found);
+	return TRUE;
+}
+
+// The scan MxDSSubscriberList::Find did before the index
+static MxDSSubscriber* LinearFind(list<MxDSSubscriber*>& p_reference, MxDSObject* p_object)
+{
+	for (list<MxDSSubscriber*>::iterator it = p_reference.begin(); it != p_reference.end(); it++) {
+		if (p_object->GetObjectId() == -1 || p_object->GetObjectId() == (*it)->GetObjectId()) {
+			if (p_object->GetUnknown24() == -2 || p_object->GetUnknown24() == (*it)->GetUnknown48()) {
+				return *it;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static MxBool TestSubscribersRandom()
+{
+	MxU32 found = 0;
+
+	for (MxU32 round = 0; round < ROUNDS; round++) {
+		TestController controller;
+		MxDSSubscriberList& subscribers = controller.GetSubscribers();
+		list<MxDSSubscriber*> reference;
+		MxDSObject query;
+
+		for (MxU32 step = 0; step < STEPS; step++) {
+			RandomQuery(query);
+
+			switch (Random(4)) {
+			case 0:
+			case 1: {
+				// Create adds the subscriber to the controller
+				MxDSSubscriber* subscriber = new MxDSSubscriber();
+				CHECK(subscriber->Create(&controller, Random(OBJECT_IDS), Random(INSTANCES)) == SUCCESS);
+				reference.push_back(subscriber);
+				break;
+			}
+			case 2: {
+				MxDSSubscriber* subscriber = subscribers.Find(&query);
+				CHECK(subscriber == LinearFind(reference, &query));
+				found += subscriber != NULL;
+
+				if (query.GetObjectId() != -1 && query.GetUnknown24() >= 0) {
+					CHECK(subscribers.Find(query.GetObjectId(), query.GetUnknown24()) == subscriber);
+				}
+				break;
+			}
+			default:
+				if (!reference.empty()) {
+					// Deleting a subscriber removes it from the controller
+					list<MxDSSubscriber*>::iterator it = reference.begin();
+					for (MxU32 i = Random(reference.size()); i; i--) {
+						it++;
+					}
+
+					delete *it;
+					reference.erase(it);
+				}
+				break;
+			}
+
+			CHECK(SameOrder<MxDSSubscriber*>(subscribers, reference));
+		}
+	}
+
+	printf("%u subscriber steps, %u found\n", ROUNDS * STEPS, found);
+	return TRUE;
+}
+
+static MxBool TestNextActionsRandom()
+{
+	MxU32 found = 0;
+
+	for (MxU32 round = 0; round < ROUNDS; round++) {
+		MxNextActionDataStartList nextActions;
+		list<MxNextActionDataStart*> reference;
+
+		for (MxU32 step = 0; step < STEPS; step++) {
+			MxU32 objectId = Random(OBJECT_IDS);
+			MxS16 value = Random(3) == 0 ? -2 : Random(INSTANCES);
+
+			switch (Random(4)) {
+			case 0:
+			case 1: {
+				MxNextActionDataStart* data = new MxNextActionDataStart(objectId, Random(INSTANCES), 0);
+				nextActions.PushBack(data);
+				reference.push_back(data);
+				break;
+			}
+			case 2: {
+				// Find takes no wildcard, FindAndErase takes -2 for any instance
+				list<MxNextActionDataStart*>::iterator it;
+				for (it = reference.begin(); it != reference.end(); it++) {
+					if (objectId == (*it)->GetObjectId() && (value == -2 || value == (*it)->GetUnknown24())) {
+						break;
+					}
+				}
+
+				MxNextActionDataStart* expected = it != reference.end() ? *it : NULL;
+
+				if (value != -2) {
+					CHECK(nextActions.Find(objectId, value) == expected);
+				}
+
+				MxNextActionDataStart* data = nextActions.FindAndErase(objectId, value);
+				CHECK(data == expected);
+
+				if (data) {
+					reference.erase(it);
+					delete data;
+					found++;
+				}
+				break;
+			}
+			default:
+				if (!nextActions.empty()) {
+					MxNextActionDataStartList::iterator it = nextActions.begin();
+					for (MxU32 i = Random(nextActions.size()); i; i--) {
+						it++;
+					}
+
+					MxNextActionDataStart* data = *it;
+					nextActions.erase(it);
+					reference.remove(data);
+					delete data;
+				}
+				break;
+			}
+
+			CHECK(SameOrder<MxNextActionDataStart*>(nextActions, reference));
+		}
+
+		for (list<MxNextActionDataStart*>::iterator it = reference.begin(); it != reference.end(); it++) {
+			delete *it;
+		}
+	}
+
+	printf("%u next action steps, %u found\n", ROUNDS * STEPS, found);
+	return TRUE;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestObjectRules();
+	result = TestObjectsRandom() && result;
+	result = TestSubscribersRandom() && result;
+	result = TestNextActionsRandom() && result;
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+// Checks the MxDisplaySurface row kernels pixel for pixel against plain scalar loops over random
+// rows of every width up to a few vectors, at every alignment, and times both.
+
+#include "mxpaletteblit.h"
+
+#include <SDL2/SDL_cpuinfo.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_WIDTH 200
+#define GUARD 16
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return g_seed >> 8;
+}
+
+// Rows with the given share of transparent pixels, in percent. Runs of one kind are common
+// in real bitmaps, so the rows alternate between runs.
+static void RandomRow(MxU8* p_row, MxS32 p_count, MxS32 p_transparent)
+{
+	MxS32 i = 0;
+
+	while (i < p_count) {
+		MxS32 run = 1 + Random() % 40;
+		MxBool transparent = (MxS32) (Random() % 100) < p_transparent;
+
+		for (; run && i < p_count; run--, i++) {
+			p_row[i] = transparent ? 0 : 1 + Random() % 255;
+		}
+	}
+}
+
+template <class T>
+static void ReferenceExpand(T* p_dest, const MxU8* p_src, MxS32 p_count, const T* p_palette)
+{
+	for (MxS32 i = 0; i < p_count; i++) {
+		p_dest[i] = p_palette[p_src[i]];
+	}
+}
+
+template <class T>
+static void ReferenceTransparent(T* p_dest, const MxU8* p_src, MxS32 p_count, const T* p_palette)
+{
+	for (MxS32 i = 0; i < p_count; i++) {
+		if (p_src[i]) {
+			p_dest[i] = p_palette[p_src[i]];
+		}
+	}
+}
+
+template <class T>
+static void ReferenceDoubled(T* p_dest, const MxU8* p_src, MxS32 p_count, const T* p_palette)
+{
+	for (MxS32 i = 0; i < p_count; i++) {
+		p_dest[2 * i] = p_dest[2 * i + 1] = p_palette[p_src[i]];
+	}
+}
+
+static MxU8 g_identity[256];
+
+static void ReferenceCopyTransparent(MxU8* p_dest, const MxU8* p_src, MxS32 p_count, const MxU8*)
+{
+	ReferenceTransparent(p_dest, p_src, p_count, g_identity);
+}
+
+static void ReferenceCopyDoubled(MxU8* p_dest, const MxU8* p_src, MxS32 p_count, const MxU8*)
+{
+	ReferenceDoubled(p_dest, p_src, p_count, g_identity);
+}
+
+static void CopyTransparent(MxU8* p_dest, const MxU8* p_src, MxS32 p_count, const MxU8*)
+{
+	CopyRowTransparent8(p_dest, p_src, p_count);
+}
+
+static void CopyDoubled(MxU8* p_dest, const MxU8* p_src, MxS32 p_count, const MxU8*)
+{
+	CopyRowDoubled8(p_dest, p_src, p_count);
+}
+
+// Runs a kernel and its reference over the same random destination and compares everything,
+// including guard pixels on both sides that neither may touch
+template <class T>
+static MxS32 Compare(
+	const char* p_name,
+	void (*p_kernel)(T*, const MxU8*, MxS32, const T*),
+	void (*p_reference)(T*, const MxU8*, MxS32, const T*),
+	const T* p_palette
+)
+{
+	static MxU8 src[MAX_WIDTH + GUARD];
+	static T dest[2 * MAX_WIDTH + 2 * GUARD], expected[2 * MAX_WIDTH + 2 * GUARD];
+	static const MxS32 transparency[] = {0, 10, 50, 90, 100};
+	MxS32 rows = 0, mismatches = 0;
+
+	for (MxS32 t = 0; t < (MxS32) (sizeof(transparency) / sizeof(transparency[0])); t++) {
+		for (MxS32 width = 0; width <= MAX_WIDTH; width++) {
+			for (MxS32 offset = 0; offset < 4; offset++) {
+				RandomRow(src + offset, width, transparency[t]);
+
+				for (MxS32 i = 0; i < (MxS32) (sizeof(dest) / sizeof(dest[0])); i++) {
+					dest[i] = expected[i] = (T) Random();
+				}
+
+				p_kernel(dest + GUARD + offset, src + offset, width, p_palette);
+				p_reference(expected + GUARD + offset, src + offset, width, p_palette);
+				rows++;
+
+				if (memcmp(dest, expected, sizeof(dest))) {
+					mismatches++;
+				}
+			}
+		}
+	}
+
+	printf("%-24s %6d rows, %d mismatches\n", p_name, rows, mismatches);
+	return mismatches;
+}
+
+// Converts RGB565 to XRGB8888 the way MxDisplaySurface does for a 32-bit surface
+static MxU32 Convert565(MxU16 p_color)
+{
+	MxU32 red = (p_color >> 11) & 0x1f;
+	MxU32 green = (p_color >> 5) & 0x3f;
+	MxU32 blue = p_color & 0x1f;
+
+	return (((red << 3) | (red >> 2)) << 16) | (((green << 2) | (green >> 4)) << 8) | ((blue << 3) | (blue >> 2));
+}
+
+// The byte tables must give the same color as converting the whole pixel, for every pixel
+static MxS32 CompareConvert()
+{
+	MxU32 low[256], high[256];
+	static MxU16 src[65536];
+	static MxU32 dest[65536];
+	MxS32 mismatches = 0;
+
+	for (MxS32 i = 0; i < 256; i++) {
+		low[i] = Convert565(i) | 0xff000000;
+		high[i] = Convert565(i << 8);
+	}
+
+	for (MxS32 i = 0; i < 65536; i++) {
+		src[i] = i;
+	}
+
+	ConvertRow16To32(dest, src, 65536, low, high);
+
+	for (MxS32 i = 0; i < 65536; i++) {
+		if (dest[i] != (Convert565(i) | 0xff000000)) {
+			mismatches++;
+		}
+	}
+
+	printf("%-24s %6d colors, %d mismatches\n", "ConvertRow16To32", 65536, mismatches);
+	return mismatches;
+}
+
+#define BENCH_WIDTH 640
+#define BENCH_ROWS 20000
+
+// Times a kernel and its reference on 640-pixel rows, 25% transparent
+template <class T>
+static void Time(
+	const char* p_name,
+	void (*p_kernel)(T*, const MxU8*, MxS32, const T*),
+	void (*p_reference)(T*, const MxU8*, MxS32, const T*),
+	const T* p_palette
+)
+{
+	static MxU8 src[BENCH_WIDTH];
+	static T dest[2 * BENCH_WIDTH];
+	RandomRow(src, BENCH_WIDTH, 25);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxS32 i = 0; i < BENCH_ROWS; i++) {
+		p_kernel(dest, src, BENCH_WIDTH, p_palette);
+	}
+
+	Uint64 middle = SDL_GetPerformanceCounter();
+
+	for (MxS32 i = 0; i < BENCH_ROWS; i++) {
+		p_reference(dest, src, BENCH_WIDTH, p_palette);
+	}
+
+	Uint64 end = SDL_GetPerformanceCounter();
+	double scale = 1000000000.0 / SDL_GetPerformanceFrequency() / BENCH_ROWS / BENCH_WIDTH;
+
+	printf("%-24s %.3f ns per pixel, scalar %.3f ns\n", p_name, (middle - start) * scale, (end - middle) * scale);
+}
+
+int main(int, char**)
+{
+	MxU16 palette16[PALETTE16_SIZE];
+	MxU32 palette32[256];
+	MxS32 mismatches = 0;
+
+	for (MxS32 i = 0; i < 256; i++) {
+		g_identity[i] = i;
+		palette16[i] = Random();
+		palette32[i] = Random() | (Random() << 24);
+	}
+
+	palette16[256] = 0;
+	printf("AVX2 %s\n", SDL_HasAVX2() ? "available" : "not available");
+
+	mismatches += Compare<MxU8>("CopyRowTransparent8", CopyTransparent, ReferenceCopyTransparent, NULL);
+	mismatches += Compare<MxU8>("CopyRowDoubled8", CopyDoubled, ReferenceCopyDoubled, NULL);
+	mismatches += Compare("ExpandRow16", ExpandRow16, ReferenceExpand<MxU16>, palette16);
+	mismatches += Compare("ExpandRowTransparent16", ExpandRowTransparent16, ReferenceTransparent<MxU16>, palette16);
+	mismatches += Compare("ExpandRowDoubled16", ExpandRowDoubled16, ReferenceDoubled<MxU16>, palette16);
+	mismatches += Compare("ExpandRow32", ExpandRow32, ReferenceExpand<MxU32>, palette32);
+	mismatches += Compare("ExpandRowTransparent32", ExpandRowTransparent32, ReferenceTransparent<MxU32>, palette32);
+	mismatches += Compare("ExpandRowDoubled32", ExpandRowDoubled32, ReferenceDoubled<MxU32>, palette32);
+	mismatches += CompareConvert();
+
+	Time<MxU8>("CopyRowTransparent8", CopyTransparent, ReferenceCopyTransparent, NULL);
+	Time<MxU8>("CopyRowDoubled8", CopyDoubled, ReferenceCopyDoubled, NULL);
+	Time("ExpandRow16", ExpandRow16, ReferenceExpand<MxU16>, palette16);
+	Time("ExpandRowTransparent16", ExpandRowTransparent16, ReferenceTransparent<MxU16>, palette16);
+	Time("ExpandRowDoubled16", ExpandRowDoubled16, ReferenceDoubled<MxU16>, palette16);
+	Time("ExpandRow32", ExpandRow32, ReferenceExpand<MxU32>, palette32);
+	Time("ExpandRowTransparent32", ExpandRowTransparent32, ReferenceTransparent<MxU32>, palette32);
+	Time("ExpandRowDoubled32", ExpandRowDoubled32, ReferenceDoubled<MxU32>, palette32);
+
+	printf("%s\n", mismatches ? "FAIL" : "PASS");
+	return mismatches ? 1 : 0;
+}
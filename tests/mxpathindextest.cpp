@@ -0,0 +1,282 @@
+// Checks MxPathIndex and MxString::MapPathToFilesystem against the linear suffix scan they
+// replace, over a synthetic tree of many thousands of mixed-case file names on HD and CD. The
+// names share directories and file names, some are suffixes of others and some differ only in
+// case, so HD-before-CD precedence and the first-in-list rule decide many of the queries. Then
+// times both over the same queries.
+
+#include "decomp.h"
+#include "mxomni.h"
+#include "mxpathindex.h"
+#include "mxstring.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+// MxString maps paths through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define HD_FILES 20000
+#define CD_FILES 8000
+#define QUERIES 50000
+#define TIMED_QUERIES 20000
+
+static unsigned int g_seed = 1;
+static std::string g_queries[TIMED_QUERIES];
+static MxS32 g_sink;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+// Sets the file lists MapPathToFilesystem resolves against, as SetHD and SetCD do after globbing
+class TestOmni : public MxOmni {
+public:
+	static void SetFiles(const vector<MxString>& p_hdFiles, const vector<MxString>& p_cdFiles)
+	{
+		g_hdFiles = p_hdFiles;
+		g_cdFiles = p_cdFiles;
+		g_hdIndex.Build(g_hdFiles);
+		g_cdIndex.Build(g_cdFiles);
+	}
+};
+
+static std::string RandomCase(std::string p_str)
+{
+	for (size_t i = 0; i < p_str.size(); i++) {
+		p_str[i] = Random(2) ? SDL_toupper((MxU8) p_str[i]) : SDL_tolower((MxU8) p_str[i]);
+	}
+
+	return p_str;
+}
+
+// A path of one to three parts from small sets, so names often end alike
+static std::string RandomName()
+{
+	static const char* g_dirs[] = {"lego", "scripts", "isle", "act2", "act3", "build", "data", "Media", "garage"};
+	static const char* g_files[] = {"isle", "jetski", "racecar", "hospital", "police", "pizza", "copter", "intro"};
+	static const char* g_extensions[] = {".si", ".smk", ".gs", ".wdb", ".flc", ""};
+
+	std::string name;
+
+	for (MxU32 parts = Random(3); parts; parts--) {
+		name += g_dirs[Random(sizeOfArray(g_dirs))];
+		name += '/';
+	}
+
+	name += g_files[Random(sizeOfArray(g_files))];
+
+	if (Random(4) == 0) {
+		char number[16];
+		SDL_snprintf(number, sizeof(number), "%u", Random(2000));
+		name += number;
+	}
+
+	name += g_extensions[Random(sizeOfArray(g_extensions))];
+	return RandomCase(name);
+}
+
+static vector<MxString> RandomFiles(MxU32 p_count)
+{
+	vector<MxString> files;
+
+	for (MxU32 i = 0; i < p_count; i++) {
+		files.push_back(MxString(RandomName().c_str()));
+	}
+
+	return files;
+}
+
+// The scan MapPathToFilesystem did before the index: the first name that is a case-insensitive
+// suffix of the path
+static MxS32 LinearFind(const vector<MxString>& p_files, const char* p_path, size_t p_length)
+{
+	for (size_t k = 0; k < p_files.size(); k++) {
+		const MxString& file = p_files[k];
+
+		for (size_t i = p_length, j = file.GetLength(); i != 0 && j != 0; i--, j--) {
+			if (SDL_tolower(p_path[i - 1]) != SDL_tolower(file.GetData()[j - 1])) {
+				break;
+			}
+			else if (j == 1) {
+				return (MxS32) k;
+			}
+		}
+	}
+
+	return -1;
+}
+
+// What MapPathToFilesystem made of p_path with the scan
+static std::string LinearMap(std::string p_path)
+{
+	for (size_t i = 0; i < p_path.size(); i++) {
+		if (p_path[i] == '\\') {
+			p_path[i] = '/';
+		}
+	}
+
+	const vector<MxString>* lists[] = {&MxOmni::GetHDFiles(), &MxOmni::GetCDFiles()};
+
+	for (MxU32 l = 0; l < sizeOfArray(lists); l++) {
+		MxS32 index = LinearFind(*lists[l], p_path.c_str(), p_path.size());
+
+		if (index != -1) {
+			const MxString& file = (*lists[l])[index];
+			p_path.replace(p_path.size() - file.GetLength(), file.GetLength(), file.GetData());
+			break;
+		}
+	}
+
+	return p_path;
+}
+
+// A path to look up: a name from either list or a new one, in other case, behind a prefix and
+// with Windows separators now and then
+static std::string RandomQuery()
+{
+	std::string name;
+
+	switch (Random(4)) {
+	case 0:
+		name = MxOmni::GetHDFiles()[Random(HD_FILES)].GetData();
+		break;
+	case 1:
+		name = MxOmni::GetCDFiles()[Random(CD_FILES)].GetData();
+		break;
+	default:
+		name = RandomName();
+		break;
+	}
+
+	name = RandomCase(name);
+
+	if (Random(2)) {
+		name = (Random(2) ? "\\LEGO\\" : "/data/") + name;
+	}
+
+	if (Random(3) == 0) {
+		for (size_t i = 0; i < name.size(); i++) {
+			if (name[i] == '/') {
+				name[i] = '\\';
+			}
+		}
+	}
+
+	return name;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestRules()
+{
+	vector<MxString> hd, cd;
+	hd.push_back("Lego/Scripts/ISLE.si");
+	hd.push_back("isle.SI");
+	hd.push_back("scripts/isle.si");
+	cd.push_back("act2/ISLE.SI");
+	cd.push_back("JETSKI.SI");
+	TestOmni::SetFiles(hd, cd);
+
+	// The first name in the list wins over a longer or shorter match after it
+	CHECK(MxOmni::GetHDIndex().Find("x/lego/scripts/isle.si", 22) == 0);
+	CHECK(MxOmni::GetHDIndex().Find("x/scripts/isle.si", 17) == 1);
+	CHECK(MxOmni::GetHDIndex().Find("isle.s", 6) == -1);
+
+#if !defined(SDL_PLATFORM_WINDOWS)
+	// HD comes before CD, which is only tried when HD has no match
+	char path[64];
+	strcpy(path, "\\lego\\act2\\isle.si");
+	MxString::MapPathToFilesystem(path);
+	CHECK(!strcmp(path, "/lego/act2/isle.SI"));
+
+	strcpy(path, "\\lego\\jetski.si");
+	MxString::MapPathToFilesystem(path);
+	CHECK(!strcmp(path, "/lego/JETSKI.SI"));
+
+	strcpy(path, "\\lego\\racecar.si");
+	MxString::MapPathToFilesystem(path);
+	CHECK(!strcmp(path, "/lego/racecar.si"));
+#endif
+
+	return TRUE;
+}
+
+static MxBool TestRandom()
+{
+	TestOmni::SetFiles(RandomFiles(HD_FILES), RandomFiles(CD_FILES));
+	MxU32 hdMatches = 0, cdMatches = 0;
+
+	for (MxU32 i = 0; i < QUERIES; i++) {
+		std::string query = RandomQuery();
+
+		MxS32 hd = LinearFind(MxOmni::GetHDFiles(), query.c_str(), query.size());
+		MxS32 cd = LinearFind(MxOmni::GetCDFiles(), query.c_str(), query.size());
+		CHECK(MxOmni::GetHDIndex().Find(query.c_str(), query.size()) == hd);
+		CHECK(MxOmni::GetCDIndex().Find(query.c_str(), query.size()) == cd);
+
+		hdMatches += hd != -1;
+		cdMatches += hd == -1 && cd != -1;
+
+#if !defined(SDL_PLATFORM_WINDOWS)
+		char path[256];
+		SDL_strlcpy(path, query.c_str(), sizeof(path));
+		MxString::MapPathToFilesystem(path);
+		CHECK(LinearMap(query) == path);
+#endif
+	}
+
+	printf("%u queries: %u resolved on HD, %u on CD\n", QUERIES, hdMatches, cdMatches);
+	CHECK(hdMatches > QUERIES / 10 && cdMatches > QUERIES / 100);
+	return TRUE;
+}
+
+// Microseconds per lookup of g_queries on HD then CD, through the scan or the index
+static double Time(MxBool p_index)
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < TIMED_QUERIES; i++) {
+		const char* query = g_queries[i].c_str();
+		size_t length = g_queries[i].size();
+
+		if (p_index) {
+			MxS32 index = MxOmni::GetHDIndex().Find(query, length);
+			g_sink += index != -1 ? index : MxOmni::GetCDIndex().Find(query, length);
+		}
+		else {
+			MxS32 index = LinearFind(MxOmni::GetHDFiles(), query, length);
+			g_sink += index != -1 ? index : LinearFind(MxOmni::GetCDFiles(), query, length);
+		}
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency() / TIMED_QUERIES;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestRules();
+	result = TestRandom() && result;
+
+	for (MxU32 i = 0; i < TIMED_QUERIES; i++) {
+		g_queries[i] = RandomQuery();
+	}
+
+	double scan = Time(FALSE);
+	double index = Time(TRUE);
+	printf("%u HD and %u CD files, per lookup: scan %.2f us, index %.2f us\n", HD_FILES, CD_FILES, scan, index);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
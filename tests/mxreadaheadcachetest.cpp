@@ -0,0 +1,382 @@
+// Checks MxReadAheadCache over a file of random bytes: that a request is served from a buffer
+// read ahead only at the same offset and for no more bytes than it holds, with the file's bytes,
+// that the least recently used buffers go once the byte limit is passed, that an aborted read
+// ahead caches nothing and stops after the slice in flight, and that one cut short by the end of
+// the file seeks back so the next read from the file is right. Then streams the file the way
+// MxDiskStreamProvider does, mostly in order with a jump now and then, and reports the hit rate
+// and the time per request with and without reading ahead.
+
+#include "mxdiskstreamcontroller.h"
+#include "mxdsbuffer.h"
+#include "mxdssource.h"
+#include "mxdssubscriber.h"
+#include "mxmisc.h"
+#include "mxomni.h"
+#include "mxreadaheadcache.h"
+#include "mxstreamchunk.h"
+#include "mxtimer.h"
+#include "mxvariabletable.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// MxDSAction and friends map file names through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+MxLong MxTimer::g_lastTimeCalculated = 0;
+MxLong MxTimer::g_lastTimeTimerStarted = 0;
+
+// What mxdsbuffer.cpp and the actions reach beyond a buffer and its chunks. None of it is
+// called by these tests.
+MxOmni* MxOmni::GetInstance()
+{
+	return NULL;
+}
+MxAtomSet* AtomSet()
+{
+	return NULL;
+}
+MxStreamer* Streamer()
+{
+	return NULL;
+}
+MxTimer* Timer()
+{
+	return NULL;
+}
+MxVariableTable* VariableTable()
+{
+	return NULL;
+}
+const char* MxVariableTable::GetVariable(const char*)
+{
+	return NULL;
+}
+MxResult MxDSSubscriber::AddData(MxStreamChunk*, MxBool)
+{
+	return FAILURE;
+}
+MxDSSubscriber* MxDSSubscriberList::Find(MxU32, MxS16)
+{
+	return NULL;
+}
+void MxDiskStreamController::FUN_100c7cb0(MxDSStreamingAction*)
+{
+}
+void MxDiskStreamController::InsertToList74(MxDSBuffer*)
+{
+}
+MxNextActionDataStart* MxStreamController::FindNextActionDataStartFromStreamingAction(MxDSStreamingAction*)
+{
+	return NULL;
+}
+MxResult MxStreamController::InsertActionToList54(MxDSAction*)
+{
+	return FAILURE;
+}
+
+#define FILE_PATH "mxreadaheadcachetest.si"
+#define BUFFER_SIZE 0x10000
+// Ten and a half buffers, so the last read ahead runs off the end
+#define FILE_SIZE (10 * BUFFER_SIZE + BUFFER_SIZE / 2)
+#define LIMIT (3 * BUFFER_SIZE)
+#define REQUESTS 20000
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxU8 g_contents[FILE_SIZE];
+
+// A file read the way MxDSFile reads one: a short read fails and leaves the position where it
+// was, though the file has moved on
+class TestFile : public MxDSSource {
+public:
+	TestFile() : m_file(NULL), m_reads(0), m_bytesRead(0) {}
+	~TestFile() override { Close(); }
+
+	MxLong Open(MxULong) override
+	{
+		m_file = fopen(FILE_PATH, "rb");
+		m_position = 0;
+		return m_file ? SUCCESS : FAILURE;
+	}
+
+	MxLong Close() override
+	{
+		if (m_file) {
+			fclose(m_file);
+			m_file = NULL;
+		}
+
+		m_position = -1;
+		return SUCCESS;
+	}
+
+	MxResult Read(unsigned char* p_buf, MxULong p_nbytes) override
+	{
+		m_reads++;
+
+		MxULong read = fread(p_buf, 1, p_nbytes, m_file);
+		m_bytesRead += read;
+
+		if (read != p_nbytes) {
+			return FAILURE;
+		}
+
+		m_position += p_nbytes;
+		return SUCCESS;
+	}
+
+	MxLong Seek(MxLong p_offset, SDL_IOWhence) override
+	{
+		m_position = fseek(m_file, p_offset, SEEK_SET) == 0 ? ftell(m_file) : -1;
+		return m_position == -1 ? FAILURE : SUCCESS;
+	}
+
+	MxULong GetBufferSize() override { return BUFFER_SIZE; }
+	MxULong GetStreamBuffersNum() override { return 0; }
+
+	// Where the next read really comes from
+	MxLong GetFilePosition() { return ftell(m_file); }
+
+	MxU32 m_reads;
+	MxU32 m_bytesRead;
+
+private:
+	FILE* m_file;
+};
+
+static MxBool Never(void*)
+{
+	return FALSE;
+}
+
+// Asks to abort once the TestFile p_data has made g_readsBeforeAbort reads
+static MxU32 g_readsBeforeAbort;
+
+static MxBool AbortAfterReads(void* p_data)
+{
+	return ((TestFile*) p_data)->m_reads >= g_readsBeforeAbort;
+}
+
+static MxBool Matches(MxDSBuffer* p_buffer, MxU32 p_offset)
+{
+	return p_buffer->GetUnknown14() == p_offset &&
+		   !memcmp(p_buffer->GetBuffer(), g_contents + p_offset, p_buffer->GetWriteOffset());
+}
+
+static MxBool TestHits(TestFile& p_file)
+{
+	MxReadAheadCache cache;
+	MxDSBuffer buffer;
+	buffer.AllocateBuffer(BUFFER_SIZE, MxDSBuffer::e_allocate);
+
+	CHECK(!cache.ReadFromCache(&buffer, 0));
+	CHECK(cache.ReadAhead(&p_file, BUFFER_SIZE, BUFFER_SIZE, LIMIT, Never, NULL));
+	CHECK(p_file.GetPosition() == 2 * BUFFER_SIZE && p_file.GetFilePosition() == 2 * BUFFER_SIZE);
+	CHECK(!cache.ReadAhead(&p_file, BUFFER_SIZE, BUFFER_SIZE, LIMIT, Never, NULL));
+	CHECK(cache.GetCount() == 1 && cache.GetSize() == BUFFER_SIZE);
+
+	CHECK(!cache.ReadFromCache(&buffer, 0));
+	CHECK(!cache.ReadFromCache(&buffer, BUFFER_SIZE + 1));
+	CHECK(cache.ReadFromCache(&buffer, BUFFER_SIZE) && Matches(&buffer, BUFFER_SIZE));
+
+	// A shorter request is served from the front of the buffer, a longer one is not
+	MxDSBuffer small;
+	small.AllocateBuffer(BUFFER_SIZE / 4, MxDSBuffer::e_allocate);
+	CHECK(cache.ReadFromCache(&small, BUFFER_SIZE) && Matches(&small, BUFFER_SIZE));
+
+	MxDSBuffer large;
+	large.AllocateBuffer(2 * BUFFER_SIZE, MxDSBuffer::e_allocate);
+	CHECK(!cache.ReadFromCache(&large, BUFFER_SIZE));
+
+	// Nothing over the limit or empty is read
+	MxU32 reads = p_file.m_reads;
+	CHECK(!cache.ReadAhead(&p_file, 0, LIMIT + 1, LIMIT, Never, NULL));
+	CHECK(!cache.ReadAhead(&p_file, 0, 0, LIMIT, Never, NULL));
+	CHECK(p_file.m_reads == reads && cache.GetCount() == 1);
+
+	cache.Clear();
+	CHECK(cache.GetCount() == 0 && cache.GetSize() == 0 && !cache.ReadFromCache(&buffer, BUFFER_SIZE));
+	return TRUE;
+}
+
+static MxBool TestEviction(TestFile& p_file)
+{
+	MxReadAheadCache cache;
+	MxDSBuffer buffer;
+	buffer.AllocateBuffer(BUFFER_SIZE, MxDSBuffer::e_allocate);
+
+	for (MxU32 i = 0; i < 3; i++) {
+		CHECK(cache.ReadAhead(&p_file, i * BUFFER_SIZE, BUFFER_SIZE, LIMIT, Never, NULL));
+	}
+
+	CHECK(cache.GetCount() == 3 && cache.GetSize() == LIMIT);
+
+	// Serving the first makes the second the least recently used
+	CHECK(cache.ReadFromCache(&buffer, 0));
+	CHECK(cache.ReadAhead(&p_file, 3 * BUFFER_SIZE, BUFFER_SIZE, LIMIT, Never, NULL));
+	CHECK(cache.GetCount() == 3 && cache.GetSize() == LIMIT);
+	CHECK(!cache.ReadFromCache(&buffer, BUFFER_SIZE));
+	CHECK(cache.ReadFromCache(&buffer, 0) && Matches(&buffer, 0));
+	CHECK(cache.ReadFromCache(&buffer, 2 * BUFFER_SIZE) && Matches(&buffer, 2 * BUFFER_SIZE));
+	CHECK(cache.ReadFromCache(&buffer, 3 * BUFFER_SIZE) && Matches(&buffer, 3 * BUFFER_SIZE));
+
+	// A buffer as large as the limit pushes out all the others
+	CHECK(cache.ReadAhead(&p_file, 4 * BUFFER_SIZE, LIMIT, LIMIT, Never, NULL));
+	CHECK(cache.GetCount() == 1 && cache.GetSize() == LIMIT);
+	return TRUE;
+}
+
+static MxBool TestAbort(TestFile& p_file)
+{
+	MxReadAheadCache cache;
+	MxDSBuffer buffer;
+	buffer.AllocateBuffer(BUFFER_SIZE, MxDSBuffer::e_allocate);
+
+	// Asked before anything is read, nothing is
+	g_readsBeforeAbort = p_file.m_reads;
+	CHECK(!cache.ReadAhead(&p_file, 0, BUFFER_SIZE, LIMIT, AbortAfterReads, &p_file));
+	CHECK(p_file.m_reads == g_readsBeforeAbort);
+
+	// Asked during the first slice, the read stops when it is done
+	g_readsBeforeAbort = p_file.m_reads + 1;
+	MxU32 bytesRead = p_file.m_bytesRead;
+	CHECK(!cache.ReadAhead(&p_file, 5 * BUFFER_SIZE, BUFFER_SIZE, LIMIT, AbortAfterReads, &p_file));
+	CHECK(p_file.m_bytesRead - bytesRead == MxReadAheadCache::c_sliceSize);
+	CHECK(cache.GetCount() == 0 && cache.GetSize() == 0 && !cache.ReadFromCache(&buffer, 5 * BUFFER_SIZE));
+
+	// The source is left where it says it is, so a request read after is right
+	CHECK(p_file.GetPosition() == p_file.GetFilePosition());
+	CHECK(MxReadAheadCache::ReadFromFile(&p_file, &buffer, p_file.GetPosition()));
+	CHECK(Matches(&buffer, 5 * BUFFER_SIZE + MxReadAheadCache::c_sliceSize));
+	return TRUE;
+}
+
+static MxBool TestEndOfFile(TestFile& p_file)
+{
+	MxReadAheadCache cache;
+	MxU32 offset = 10 * BUFFER_SIZE;
+
+	CHECK(!cache.ReadAhead(&p_file, offset, BUFFER_SIZE, LIMIT, Never, NULL));
+	CHECK(cache.GetCount() == 0 && cache.GetSize() == 0);
+	CHECK(p_file.GetPosition() == offset && p_file.GetFilePosition() == offset);
+
+	// The last request of the file is as long as what is left of it. The position says it is
+	// already there, so it is read without a seek.
+	MxDSBuffer buffer;
+	buffer.AllocateBuffer(FILE_SIZE - offset, MxDSBuffer::e_allocate);
+	CHECK(MxReadAheadCache::ReadFromFile(&p_file, &buffer, offset) && Matches(&buffer, offset));
+	return TRUE;
+}
+
+// Streams REQUESTS buffers, each from the one after the last with a jump one time in eight,
+// reading ahead the one after each like MxDiskStreamProvider does when p_limit is not zero. A
+// request now and then arrives in the middle of a read ahead. Returns the microseconds per
+// request, from the request until its buffer is filled.
+static MxBool Stream(TestFile& p_file, MxU32 p_limit, MxU32& p_hits, double& p_latency)
+{
+	MxReadAheadCache cache;
+	MxDSBuffer buffer;
+	buffer.AllocateBuffer(BUFFER_SIZE, MxDSBuffer::e_allocate);
+
+	MxU32 lastOffset = FILE_SIZE - BUFFER_SIZE;
+	MxU32 offset = 0;
+	Uint64 ticks = 0;
+	p_hits = 0;
+
+	for (MxU32 i = 0; i < REQUESTS; i++) {
+		Uint64 start = SDL_GetPerformanceCounter();
+		MxBool hit = cache.ReadFromCache(&buffer, offset);
+
+		if (!hit) {
+			CHECK(MxReadAheadCache::ReadFromFile(&p_file, &buffer, offset));
+		}
+
+		ticks += SDL_GetPerformanceCounter() - start;
+		CHECK(Matches(&buffer, offset));
+		p_hits += hit;
+
+		MxU32 next = offset + BUFFER_SIZE;
+		g_readsBeforeAbort = Random(4) == 0 ? p_file.m_reads + 1 : 0xffffffff;
+
+		if (p_limit && next + BUFFER_SIZE <= FILE_SIZE) {
+			cache.ReadAhead(&p_file, next, BUFFER_SIZE, p_limit, AbortAfterReads, &p_file);
+			CHECK(p_file.GetPosition() == p_file.GetFilePosition());
+		}
+
+		offset = Random(8) == 0 || next > lastOffset ? Random(lastOffset / 0x1000) * 0x1000 : next;
+	}
+
+	p_latency = ticks * 1000000.0 / SDL_GetPerformanceFrequency() / REQUESTS;
+	return TRUE;
+}
+
+static MxBool TestStream(TestFile& p_file)
+{
+	MxU32 hits;
+	MxU32 direct;
+	double cached;
+	double uncached;
+
+	CHECK(Stream(p_file, 0, direct, uncached) && direct == 0);
+	CHECK(Stream(p_file, LIMIT, hits, cached));
+
+	printf(
+		"%u requests of %u bytes: hit rate %.1f%%, per request %.2f us read ahead, %.2f us not\n",
+		REQUESTS,
+		BUFFER_SIZE,
+		hits * 100.0 / REQUESTS,
+		cached,
+		uncached
+	);
+
+	// About three in four follow the last, and one in four of their read aheads is aborted
+	CHECK(hits > REQUESTS / 3);
+	return TRUE;
+}
+
+int main(int, char**)
+{
+	for (MxU32 i = 0; i < FILE_SIZE; i++) {
+		g_contents[i] = Random(0x100);
+	}
+
+	FILE* out = fopen(FILE_PATH, "wb");
+
+	if (!out || fwrite(g_contents, 1, FILE_SIZE, out) != FILE_SIZE) {
+		printf("failed: could not write %s\n", FILE_PATH);
+		return 1;
+	}
+
+	fclose(out);
+
+	MxBool result;
+	{
+		TestFile file;
+		result = file.Open(0) == SUCCESS;
+		result = result && TestHits(file);
+		result = result && TestEviction(file);
+		result = result && TestAbort(file);
+		result = result && TestEndOfFile(file);
+		result = result && TestStream(file);
+	}
+
+	remove(FILE_PATH);
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
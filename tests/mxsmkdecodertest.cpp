@@ -0,0 +1,345 @@
+// Checks that frames decoded ahead by MxSmkDecoder match decoding each frame when it is loaded,
+// byte for byte, while chunks arrive at random and are freed after loading. Then drops a chunk
+// that was queued, as a looping action may, and checks that the frames loaded after it still
+// match a serial decode. Then times the work left on the presenter's thread with and without
+// decoding ahead.
+
+#include "mxsmkdecoder.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+#define WIDTH 640
+#define HEIGHT 480
+#define VIDEO_SIZE (WIDTH * HEIGHT)
+
+// Stands in for libsmacker. Every frame is a delta on the previous one, so a frame decoded out of
+// order, twice or from another chunk comes out different. Frame 0 starts over, as smk_first does.
+// Chunks start with their length.
+class TestStream {
+public:
+	TestStream() { memset(m_video, 0, sizeof(m_video)); }
+
+	MxBool Decode(const MxU8* p_chunk, MxU32 p_frame)
+	{
+		MxU32 length;
+		memcpy(&length, p_chunk, sizeof(length));
+		const MxU8* data = p_chunk + sizeof(length);
+
+		if (p_frame == 0) {
+			memset(m_video, 0, sizeof(m_video));
+		}
+
+		for (MxU32 i = 0, j = 0; i < VIDEO_SIZE; i++) {
+			m_video[i] = (MxU8) (m_video[i] * 31 + data[j] + p_frame);
+
+			if (++j == length) {
+				j = 0;
+			}
+		}
+
+		if (data[0] & 1) {
+			for (MxU32 i = 0; i < sizeof(m_palette); i++) {
+				m_palette[i] = (MxU8) (data[i % length] + i);
+			}
+
+			return TRUE;
+		}
+
+		return FALSE;
+	}
+
+	MxU8 m_video[VIDEO_SIZE];
+	MxU8 m_palette[256 * 3];
+};
+
+class TestDecoder : public MxSmkDecoder {
+public:
+	~TestDecoder() override { Stop(); }
+
+	TestStream m_stream;
+
+protected:
+	void Decode(MxSmkFrame& p_frame) override
+	{
+		p_frame.m_paletteChanged = m_stream.Decode(p_frame.m_chunk, p_frame.m_frame);
+		memcpy(p_frame.m_video, m_stream.m_video, VIDEO_SIZE);
+
+		if (p_frame.m_paletteChanged) {
+			memcpy(p_frame.m_palette, m_stream.m_palette, sizeof(p_frame.m_palette));
+		}
+	}
+};
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+#define MAX_CHUNK 4096
+#define MAX_PENDING 16
+
+static MxU8* NewChunk()
+{
+	MxU32 length = 1 + Random(MAX_CHUNK);
+	MxU8* chunk = new MxU8[sizeof(length) + length];
+	memcpy(chunk, &length, sizeof(length));
+
+	for (MxU32 i = 0; i < length; i++) {
+		chunk[sizeof(length) + i] = Random(256);
+	}
+
+	return chunk;
+}
+
+static MxU32 ChunkLength(const MxU8* p_chunk)
+{
+	MxU32 length;
+	memcpy(&length, p_chunk, sizeof(length));
+	return sizeof(length) + length;
+}
+
+// The streamer's pending chunks and a presenter loading them in order, the way MxSmkPresenter
+// and MxSmk::LoadFrame use the decoder
+class TestPresenter {
+public:
+	TestPresenter(TestDecoder* p_decoder) : m_decoder(p_decoder), m_pendingCount(0), m_currentFrame(0) {}
+
+	~TestPresenter()
+	{
+		for (MxU32 i = 0; i < m_pendingCount; i++) {
+			delete[] m_pending[i];
+		}
+	}
+
+	void Deliver(MxU32 p_count)
+	{
+		while (p_count-- && m_pendingCount < MAX_PENDING) {
+			m_pending[m_pendingCount++] = NewChunk();
+		}
+	}
+
+	// Frees the next pending chunk without loading it
+	void Drop()
+	{
+		delete[] m_pending[0];
+		m_pendingCount--;
+		memmove(m_pending, m_pending + 1, m_pendingCount * sizeof(m_pending[0]));
+		m_currentFrame++;
+	}
+
+	// Loads the next pending chunk into p_video and p_palette. Returns whether the frame came
+	// from the ring.
+	MxBool LoadFrame(MxU8* p_video, MxU8* p_palette, MxBool& p_paletteChanged)
+	{
+		MxU8* chunk = m_pending[0];
+		m_pendingCount--;
+		memmove(m_pending, m_pending + 1, m_pendingCount * sizeof(m_pending[0]));
+		m_currentFrame++;
+
+		if (m_decoder->Queue(chunk, ChunkLength(chunk), m_currentFrame - 1)) {
+			for (MxU32 i = 0; i < MXSMK_RING_SIZE - 1 && i < m_pendingCount; i++) {
+				if (!m_decoder->Queue(m_pending[i], ChunkLength(m_pending[i]), m_currentFrame + i)) {
+					break;
+				}
+			}
+		}
+
+		MxSmkFrame* frame = m_decoder->Wait(chunk, m_currentFrame - 1);
+
+		if (frame) {
+			p_paletteChanged = frame->m_paletteChanged;
+			memcpy(p_video, frame->m_video, VIDEO_SIZE);
+
+			if (p_paletteChanged) {
+				memcpy(p_palette, frame->m_palette, 256 * 3);
+			}
+
+			m_decoder->Release();
+		}
+		else {
+			p_paletteChanged = m_decoder->m_stream.Decode(chunk, m_currentFrame - 1);
+			memcpy(p_video, m_decoder->m_stream.m_video, VIDEO_SIZE);
+
+			if (p_paletteChanged) {
+				memcpy(p_palette, m_decoder->m_stream.m_palette, 256 * 3);
+			}
+		}
+
+		// The stream frees its chunk once loaded, and its memory is reused
+		memset(chunk, 0xcd, ChunkLength(chunk));
+		delete[] chunk;
+		return frame != NULL;
+	}
+
+	TestDecoder* m_decoder;
+	MxU8* m_pending[MAX_PENDING];
+	MxU32 m_pendingCount;
+	MxU32 m_currentFrame;
+};
+
+#define FRAMES 600
+
+static MxBool TestDifferential()
+{
+	static MxU8 video[VIDEO_SIZE], palette[256 * 3];
+	TestStream* reference = new TestStream;
+	TestDecoder* decoder = new TestDecoder;
+	MxU32 mismatches = 0, fromRing = 0;
+
+	if (decoder->Create(VIDEO_SIZE) != SUCCESS) {
+		printf("differential: failed to start the decoder\n");
+		return FALSE;
+	}
+
+	TestPresenter* presenter = new TestPresenter(decoder);
+
+	for (MxU32 frame = 0; frame < FRAMES; frame++) {
+		// Chunks arrive in bursts, sometimes only the one about to be loaded
+		presenter->Deliver(presenter->m_pendingCount ? Random(3) : 1 + Random(4));
+
+		// The reference decodes a copy of the same chunk when it is loaded
+		MxU32 length = ChunkLength(presenter->m_pending[0]);
+		MxU8* chunk = new MxU8[length];
+		memcpy(chunk, presenter->m_pending[0], length);
+
+		MxBool paletteChanged;
+		if (presenter->LoadFrame(video, palette, paletteChanged)) {
+			fromRing++;
+		}
+
+		MxBool referenceChanged = reference->Decode(chunk, frame);
+		delete[] chunk;
+
+		if (paletteChanged != referenceChanged || memcmp(video, reference->m_video, VIDEO_SIZE) ||
+			(paletteChanged && memcmp(palette, reference->m_palette, sizeof(palette)))) {
+			mismatches++;
+		}
+	}
+
+	printf("differential: %d frames, %u from the ring, %u mismatches\n", FRAMES, fromRing, mismatches);
+
+	// A chunk other than the queued one stops decoding ahead and is left to the caller
+	MxU8* other = NewChunk();
+	MxBool stopped = decoder->GetQueued() > 0 && decoder->Wait(other, presenter->m_currentFrame) == NULL &&
+					 decoder->GetQueued() == 0 && !decoder->Queue(other, ChunkLength(other), presenter->m_currentFrame);
+	printf("unexpected chunk: %s\n", stopped ? "stopped" : "not stopped");
+	delete[] other;
+
+	delete decoder;
+	delete presenter;
+	delete reference;
+	return mismatches == 0 && fromRing > 0 && stopped;
+}
+
+#define DROP_FRAME 50
+
+static MxBool TestDrop()
+{
+	static MxU8 video[VIDEO_SIZE], palette[256 * 3];
+	TestStream* reference = new TestStream;
+	TestDecoder* decoder = new TestDecoder;
+	MxU32 mismatches = 0, fromRing = 0, afterDrop = 0;
+
+	if (decoder->Create(VIDEO_SIZE) != SUCCESS) {
+		printf("drop: failed to start the decoder\n");
+		return FALSE;
+	}
+
+	TestPresenter* presenter = new TestPresenter(decoder);
+	presenter->Deliver(MAX_PENDING);
+
+	for (MxU32 frame = 0; frame < FRAMES; frame++) {
+		if (frame == DROP_FRAME) {
+			// The dropped chunk and those after it are decoded ahead already
+			if (decoder->GetQueued() < 2) {
+				printf("drop: chunk to drop not queued\n");
+				return FALSE;
+			}
+
+			presenter->Drop();
+			continue;
+		}
+
+		presenter->Deliver(MAX_PENDING);
+
+		MxU32 length = ChunkLength(presenter->m_pending[0]);
+		MxU8* chunk = new MxU8[length];
+		memcpy(chunk, presenter->m_pending[0], length);
+
+		MxBool paletteChanged;
+		MxBool ring = presenter->LoadFrame(video, palette, paletteChanged);
+		MxBool referenceChanged = reference->Decode(chunk, frame);
+		delete[] chunk;
+
+		fromRing += ring;
+		afterDrop += ring && frame > DROP_FRAME;
+
+		if (paletteChanged != referenceChanged || memcmp(video, reference->m_video, VIDEO_SIZE) ||
+			(paletteChanged && memcmp(palette, reference->m_palette, sizeof(palette)))) {
+			mismatches++;
+		}
+	}
+
+	printf(
+		"drop: %d frames, %u from the ring, %u of them after the drop, %u mismatches\n",
+		FRAMES,
+		fromRing,
+		afterDrop,
+		mismatches
+	);
+
+	delete decoder;
+	delete presenter;
+	delete reference;
+	return mismatches == 0 && fromRing >= DROP_FRAME - 1 && afterDrop == 0;
+}
+
+#define TIMED_FRAMES 200
+
+// Times the presenter's thread per frame. Between frames it sleeps, as the game's frame limiter
+// does while the next frame's time has not come.
+static double TimeLoad(MxBool p_decodeAhead)
+{
+	static MxU8 video[VIDEO_SIZE], palette[256 * 3];
+	TestDecoder* decoder = new TestDecoder;
+	TestPresenter* presenter = new TestPresenter(decoder);
+	Uint64 loading = 0;
+
+	if (p_decodeAhead) {
+		decoder->Create(VIDEO_SIZE);
+	}
+
+	presenter->Deliver(MAX_PENDING);
+
+	for (MxU32 frame = 0; frame < TIMED_FRAMES; frame++) {
+		MxBool paletteChanged;
+		Uint64 start = SDL_GetPerformanceCounter();
+		presenter->LoadFrame(video, palette, paletteChanged);
+		loading += SDL_GetPerformanceCounter() - start;
+
+		presenter->Deliver(1);
+		SDL_Delay(4);
+	}
+
+	delete decoder;
+	delete presenter;
+	return loading * 1000000.0 / SDL_GetPerformanceFrequency() / TIMED_FRAMES;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestDifferential();
+	result = TestDrop() && result;
+
+	double sync = TimeLoad(FALSE);
+	double ahead = TimeLoad(TRUE);
+	printf("%dx%d, per frame on the presenter's thread: decoded on load %.1f us, ahead %.1f us\n", WIDTH, HEIGHT, sync, ahead);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
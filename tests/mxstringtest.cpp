@@ -0,0 +1,174 @@
+// Checks MxString against std::string over random constructs, copies, concatenations, appends and
+// assignments, including from the string's own buffer, across the inline and heap sizes and up to
+// the 0xffff characters an MxU16 length holds. Then times a mix of short-name operations and
+// counts their heap allocations.
+
+#include "decomp.h"
+#include "mxomni.h"
+#include "mxstring.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+// MxString maps paths through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define CASES 200000
+#define ROUNDS 2000000
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+// Mostly around the inline size, now and then empty or long
+static std::string RandomString()
+{
+	static const MxU32 g_lengths[] = {0, 1, 8, 30, 31, 32, 33, 64, 200};
+	std::string str(g_lengths[Random(sizeOfArray(g_lengths))] + Random(3), ' ');
+
+	for (size_t i = 0; i < str.size(); i++) {
+		str[i] = 'a' + Random(26);
+	}
+
+	return str;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+#define CHECK_EQUAL(p_mx, p_std)                                                                                       \
+	CHECK((p_mx).GetLength() == (p_std).size() && !strcmp((p_mx).GetData(), (p_std).c_str()))
+
+static MxBool TestRandom()
+{
+	MxString mx[4];
+	std::string ref[4];
+
+	for (MxU32 i = 0; i < CASES; i++) {
+		MxU32 a = Random(4), b = Random(4);
+		std::string str = RandomString();
+
+		switch (Random(7)) {
+		case 0:
+			mx[a] = MxString(str.c_str());
+			ref[a] = str;
+			break;
+		case 1:
+			mx[a] = MxString(mx[b]);
+			ref[a] = ref[b];
+			break;
+		case 2: {
+			MxU32 c = Random(4);
+			mx[a] = mx[b] + mx[c];
+			ref[a] = ref[b] + ref[c];
+			break;
+		}
+		case 3:
+			mx[a] = mx[a] + str.c_str();
+			ref[a] = ref[a] + str;
+			break;
+		case 4:
+			mx[a] += str.c_str();
+			ref[a] += str;
+			break;
+		case 5:
+			// Appending and assigning a string's own data
+			mx[a] += mx[a].GetData();
+			ref[a] += std::string(ref[a]);
+			mx[b] = mx[b].GetData() + ref[b].size() / 2;
+			ref[b] = ref[b].substr(ref[b].size() / 2);
+			break;
+		case 6:
+			mx[a] = str.c_str();
+			ref[a] = str;
+			mx[a] = mx[a];
+			break;
+		}
+
+		// Keep the strings from growing without end
+		for (MxU32 j = 0; j < 4; j++) {
+			if (ref[j].size() > 1000) {
+				mx[j] = "";
+				ref[j].clear();
+			}
+		}
+
+		CHECK_EQUAL(mx[a], ref[a]);
+		CHECK_EQUAL(mx[b], ref[b]);
+	}
+
+	return TRUE;
+}
+
+static MxBool TestConcat()
+{
+	MxString a("inline"), b("and a string too long to be stored inline");
+	CHECK(!strcmp((a + b).GetData(), "inlineand a string too long to be stored inline"));
+	CHECK(!strcmp((b + "!").GetData(), "and a string too long to be stored inline!"));
+	CHECK(!strcmp(MxString("truncated", 5).GetData(), "trunc"));
+	return TRUE;
+}
+
+// 0xffff characters, the most an MxU16 length holds
+static MxBool TestLong()
+{
+	std::string str(0xfffe, 'x');
+	str[0x8000] = 'y';
+
+	MxString mx(str.c_str());
+	CHECK_EQUAL(mx, str);
+
+	MxString copy(mx);
+	CHECK_EQUAL(copy, str);
+
+	copy = mx + "z";
+	CHECK_EQUAL(copy, str + "z");
+
+	copy = MxString(copy.GetData(), 0xffff);
+	CHECK_EQUAL(copy, str + "z");
+	return TRUE;
+}
+
+// Nanoseconds per round of building a short path the way the presenters do
+static double Time(MxU32& p_allocations)
+{
+	MxU32 allocations = MxString::GetHeapAllocations();
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < ROUNDS; i++) {
+		MxString name("\\lego\\scripts\\");
+		MxString copy(name);
+		copy += "isle";
+		name = copy + ".si";
+		copy = name;
+	}
+
+	p_allocations = MxString::GetHeapAllocations() - allocations;
+	return (SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency() / ROUNDS;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestRandom();
+	result = TestConcat() && result;
+	result = TestLong() && result;
+
+	MxU32 allocations;
+	double ns = Time(allocations);
+	printf("%u rounds of short-name operations: %.1f ns each, %u heap allocations\n", ROUNDS, ns, allocations);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+// Runs the screen transitions offscreen and checks them against golden images: a hash of the
+// frame after every tick at 640x480. The 8 and 16-bit dissolve, mosaic and wipe-down goldens were
+// taken from the original fixed-size transitions; the windows goldens and the 24 and 32-bit ones
+// from these kernels (the original windows transition blanked the row below the surface on its
+// first tick and its right edge was only right at 8 bits). Also checks that at other sizes and depths
+// every clearing transition blacks out the whole surface and never writes past a row, then
+// times each transition's ticks at 1920x1080 and 32 bits.
+
+#include "decomp.h"
+#include "mxtransitionspans.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bytes past each row's pixels, which no transition may touch
+#define PADDING 16
+#define GUARD 0xa5
+
+enum {
+	c_dissolve,
+	c_mosaic,
+	c_wipeDown,
+	c_windows,
+	c_numTransitions
+};
+
+static const char* g_names[] = {"dissolve", "mosaic", "wipe-down", "windows"};
+
+struct Golden {
+	MxS32 m_bytesPerPixel;
+	MxU32 m_hashes[c_numTransitions];
+};
+
+static const Golden g_goldens[] = {
+	{1, {0xf2361a30, 0x70d84f63, 0xc4545981, 0x3f900a41}},
+	{2, {0x679292ef, 0xf650f113, 0xf9242d68, 0xa99c0979}},
+	{3, {0x17d04f9c, 0x28cb14f6, 0x427c8351, 0xa49013ef}},
+	{4, {0xb3d05c1e, 0xbe19daba, 0x594decfe, 0x1e72b319}},
+};
+
+class Surface {
+public:
+	Surface(MxS32 p_width, MxS32 p_height, MxS32 p_bytesPerPixel)
+	{
+		m_surface.m_width = p_width;
+		m_surface.m_height = p_height;
+		m_surface.m_bytesPerPixel = p_bytesPerPixel;
+		m_surface.m_pitch = p_width * p_bytesPerPixel + PADDING;
+		m_surface.m_pixels = new MxU8[m_surface.m_pitch * p_height];
+	}
+	~Surface() { delete[] m_surface.m_pixels; }
+
+	// Nonzero pixels from an LCG, and the guard value past every row
+	void Fill(unsigned int p_seed)
+	{
+		for (MxS32 y = 0; y < m_surface.m_height; y++) {
+			MxU8* line = m_surface.m_pixels + y * m_surface.m_pitch;
+
+			for (MxS32 i = 0; i < m_surface.m_pitch; i++) {
+				p_seed = p_seed * 1103515245 + 12345;
+				line[i] = i < m_surface.m_width * m_surface.m_bytesPerPixel ? 1 + ((p_seed >> 16) % 255) : GUARD;
+			}
+		}
+	}
+
+	// Chains the FNV-1a hash of the visible pixels onto p_hash
+	MxU32 Hash(MxU32 p_hash)
+	{
+		for (MxS32 y = 0; y < m_surface.m_height; y++) {
+			MxU8* line = m_surface.m_pixels + y * m_surface.m_pitch;
+
+			for (MxS32 i = 0; i < m_surface.m_width * m_surface.m_bytesPerPixel; i++) {
+				p_hash ^= line[i];
+				p_hash *= 16777619u;
+			}
+		}
+
+		return p_hash;
+	}
+
+	MxBool IsBlack()
+	{
+		for (MxS32 y = 0; y < m_surface.m_height; y++) {
+			MxU8* line = m_surface.m_pixels + y * m_surface.m_pitch;
+
+			for (MxS32 i = 0; i < m_surface.m_width * m_surface.m_bytesPerPixel; i++) {
+				if (line[i]) {
+					return FALSE;
+				}
+			}
+		}
+
+		return TRUE;
+	}
+
+	MxBool IsGuarded()
+	{
+		for (MxS32 y = 0; y < m_surface.m_height; y++) {
+			MxU8* line = m_surface.m_pixels + y * m_surface.m_pitch;
+
+			for (MxS32 i = m_surface.m_width * m_surface.m_bytesPerPixel; i < m_surface.m_pitch; i++) {
+				if (line[i] != GUARD) {
+					return FALSE;
+				}
+			}
+		}
+
+		return TRUE;
+	}
+
+	const MxTransitionSurface& Get() { return m_surface; }
+
+private:
+	MxTransitionSurface m_surface;
+};
+
+// Runs every tick of p_transition the way MxTransitionManager does, with rand seeded at 1.
+// Returns the chained hash of the frames if p_hash, else 0.
+static MxU32 Run(Surface& p_surface, MxS32 p_transition, MxBool p_hash)
+{
+	const MxTransitionSurface& surface = p_surface.Get();
+	vector<MxU16> order, shift;
+	MxU32 hash = 2166136261u;
+	MxS32 tick;
+
+	srand(1);
+
+	switch (p_transition) {
+	case c_dissolve:
+		ShuffleTransitionColumns(order, shift, surface.m_width, surface.m_height);
+		for (tick = 0; tick < DISSOLVE_TICKS; tick++) {
+			DissolveTick(surface, &order[0], &shift[0], tick);
+			hash = p_hash ? p_surface.Hash(hash) : 0;
+		}
+		break;
+	case c_mosaic:
+		ShuffleTransitionColumns(order, shift, MOSAIC_COLUMNS, MOSAIC_ROWS);
+		for (tick = 0; tick < MOSAIC_TICKS; tick++) {
+			MosaicTick(surface, &order[0], &shift[0], tick);
+			hash = p_hash ? p_surface.Hash(hash) : 0;
+		}
+		break;
+	case c_wipeDown:
+		for (tick = 0; tick < WIPE_DOWN_TICKS; tick++) {
+			WipeDownTick(surface, tick);
+			hash = p_hash ? p_surface.Hash(hash) : 0;
+		}
+		break;
+	case c_windows:
+		for (tick = 0; tick < WINDOWS_TICKS; tick++) {
+			WindowsTick(surface, tick);
+			hash = p_hash ? p_surface.Hash(hash) : 0;
+		}
+		break;
+	}
+
+	return hash;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestGoldens()
+{
+	MxBool result = TRUE;
+
+	for (MxU32 i = 0; i < sizeOfArray(g_goldens); i++) {
+		Surface surface(640, 480, g_goldens[i].m_bytesPerPixel);
+
+		for (MxS32 j = 0; j < c_numTransitions; j++) {
+			surface.Fill(7);
+			MxU32 hash = Run(surface, j, TRUE);
+
+			if (hash != g_goldens[i].m_hashes[j]) {
+				printf(
+					"failed: %s at %d bits is 0x%08x, golden 0x%08x\n",
+					g_names[j],
+					g_goldens[i].m_bytesPerPixel * 8,
+					hash,
+					g_goldens[i].m_hashes[j]
+				);
+				result = FALSE;
+			}
+
+			CHECK(surface.IsGuarded());
+		}
+	}
+
+	return result;
+}
+
+static MxBool TestSizes()
+{
+	static const MxS32 g_sizes[][2] = {{1366, 768}, {800, 600}, {320, 200}, {1920, 1080}};
+
+	for (MxU32 i = 0; i < sizeOfArray(g_sizes); i++) {
+		for (MxS32 bytesPerPixel = 1; bytesPerPixel <= 4; bytesPerPixel++) {
+			Surface surface(g_sizes[i][0], g_sizes[i][1], bytesPerPixel);
+
+			for (MxS32 j = 0; j < c_numTransitions; j++) {
+				surface.Fill(7);
+				Run(surface, j, FALSE);
+				CHECK(j == c_mosaic || surface.IsBlack());
+				CHECK(surface.IsGuarded());
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+static MxBool TestFill()
+{
+	MxU8 buffer[4 * 67 + PADDING];
+	MxU8 color[4] = {0x12, 0x34, 0x56, 0x78};
+
+	for (MxS32 bytesPerPixel = 1; bytesPerPixel <= 4; bytesPerPixel++) {
+		for (MxS32 count = 0; count <= 67; count++) {
+			memset(buffer, GUARD, sizeof(buffer));
+			FillTransitionSpan(buffer, count, bytesPerPixel, color);
+
+			for (MxS32 k = 0; k < count * bytesPerPixel; k++) {
+				CHECK(buffer[k] == color[k % bytesPerPixel]);
+			}
+
+			CHECK(buffer[count * bytesPerPixel] == GUARD);
+		}
+	}
+
+	return TRUE;
+}
+
+// Milliseconds per tick of each transition at 1920x1080 and 32 bits
+static void Time()
+{
+	static const MxS32 g_ticks[] = {DISSOLVE_TICKS, MOSAIC_TICKS, WIPE_DOWN_TICKS, WINDOWS_TICKS};
+	Surface surface(1920, 1080, 4);
+
+	printf("Per tick at 1920x1080x32:");
+
+	for (MxS32 j = 0; j < c_numTransitions; j++) {
+		surface.Fill(7);
+		Uint64 start = SDL_GetPerformanceCounter();
+		Run(surface, j, FALSE);
+		double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / g_ticks[j];
+		printf(" %s %.3f ms%s", g_names[j], ms, j + 1 < c_numTransitions ? "," : "\n");
+	}
+}
+
+int main(int, char**)
+{
+	MxBool result = TestFill();
+	result = TestGoldens() && result;
+	result = TestSizes() && result;
+	Time();
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// Checks MxVariableTable against a std::map over random sets, replacements and gets of mixed-case
+// keys, enough of them for the table to grow several times, and that keys are found whatever
+// their case. Then times lookups with one update in four over a table of script variables.
+
+#include "mxomni.h"
+#include "mxvariabletable.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+// MxString maps paths through these
+vector<MxString> MxOmni::g_hdFiles;
+vector<MxString> MxOmni::g_cdFiles;
+MxPathIndex MxOmni::g_hdIndex;
+MxPathIndex MxOmni::g_cdIndex;
+
+#define KEYS 2000
+#define CASES 1000000
+#define VARIABLES 400
+#define LOOKUPS 2000000
+
+static unsigned int g_seed = 1;
+
+static MxU32 Random(MxU32 p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+// Key p_index, in random case
+static std::string Key(MxU32 p_index)
+{
+	char key[32];
+	SDL_snprintf(key, sizeof(key), "variable_%u", p_index);
+
+	for (char* c = key; *c; c++) {
+		if (Random(2)) {
+			*c = SDL_toupper((MxU8) *c);
+		}
+	}
+
+	return key;
+}
+
+static std::string Upper(std::string p_key)
+{
+	for (size_t i = 0; i < p_key.size(); i++) {
+		p_key[i] = SDL_toupper((MxU8) p_key[i]);
+	}
+
+	return p_key;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestRandom()
+{
+	MxVariableTable table;
+	std::map<std::string, std::string> ref;
+
+	for (MxU32 i = 0; i < CASES; i++) {
+		std::string key = Key(Random(KEYS));
+		char value[16];
+		SDL_snprintf(value, sizeof(value), "%u", i);
+
+		switch (Random(3)) {
+		case 0:
+			table.SetVariable(key.c_str(), value);
+			ref[Upper(key)] = value;
+			break;
+		case 1:
+			// Replaces the variable object itself
+			table.SetVariable(new MxVariable(key.c_str(), value));
+			ref[Upper(key)] = value;
+			break;
+		case 2: {
+			std::map<std::string, std::string>::iterator it = ref.find(Upper(key));
+			CHECK(!strcmp(table.GetVariable(key.c_str()), it != ref.end() ? it->second.c_str() : ""));
+			break;
+		}
+		}
+	}
+
+	for (std::map<std::string, std::string>::iterator it = ref.begin(); it != ref.end(); it++) {
+		CHECK(!strcmp(table.GetVariable(it->first.c_str()), it->second.c_str()));
+	}
+
+	CHECK(table.GetVariable("variable_")[0] == '\0');
+	return TRUE;
+}
+
+// Milliseconds for LOOKUPS gets with a set every fourth
+static double Time()
+{
+	MxVariableTable table;
+	std::string keys[VARIABLES];
+
+	for (MxU32 i = 0; i < VARIABLES; i++) {
+		keys[i] = Key(i);
+		table.SetVariable(keys[i].c_str(), "0");
+	}
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < LOOKUPS; i++) {
+		const char* key = keys[Random(VARIABLES)].c_str();
+
+		if (i % 4 == 0) {
+			table.SetVariable(key, "1");
+		}
+		else {
+			table.GetVariable(key);
+		}
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+int main(int, char**)
+{
+	MxBool result = TestRandom();
+
+	printf("%u lookups over %u variables, one update in four: %.1f ms\n", LOOKUPS, VARIABLES, Time());
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+// Checks that the deferred world data of OrientableROI matches the original eager
+// propagation bit for bit, and times both.
+
+#include "realtime/orientableroi.h"
+#include "realtime/realtime.h"
+
+#include <SDL2/SDL_timer.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vec.h>
+
+class TestROI : public OrientableROI {
+public:
+	TestROI(float p_radius)
+	{
+		m_sphere.Center()[0] = p_radius * 0.5f;
+		m_sphere.Center()[1] = -p_radius;
+		m_sphere.Center()[2] = p_radius * 0.25f;
+		m_sphere.Radius() = p_radius;
+	}
+
+	~TestROI() override
+	{
+		if (comp) {
+			for (CompoundObject::iterator it = comp->begin(); it != comp->end(); it++) {
+				delete *it;
+			}
+
+			delete comp;
+			comp = NULL;
+		}
+	}
+
+	float IntrinsicImportance() const override { return 0.5f; }
+
+	void UpdateWorldBoundingVolumes() override
+	{
+		CalcWorldBoundingVolumes(m_sphere, m_local2world, m_world_bounding_box, m_world_bounding_sphere);
+	}
+
+	void AddChild(TestROI* p_child)
+	{
+		if (!comp) {
+			comp = new CompoundObject;
+		}
+
+		comp->push_back(p_child);
+		p_child->SetParentROI(this);
+	}
+
+	BoundingSphere m_sphere;
+};
+
+// The propagation as it was before world data was deferred
+class EagerROI : public TestROI {
+public:
+	EagerROI(float p_radius) : TestROI(p_radius) {}
+
+	void UpdateWorldDataWithTransformAndChildren(const Matrix4& p_transform) override
+	{
+		MxMatrix l_matrix(m_local2world);
+		m_local2world.Product(l_matrix, p_transform);
+		UpdateWorldBoundingVolumes();
+		UpdateWorldVelocity();
+
+		if (comp) {
+			for (CompoundObject::iterator it = comp->begin(); it != comp->end(); it++) {
+				static_cast<OrientableROI*>(*it)->UpdateWorldDataWithTransformAndChildren(p_transform);
+			}
+		}
+	}
+};
+
+static unsigned int g_seed = 1;
+
+static float Random(float p_min, float p_max)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return p_min + (p_max - p_min) * ((g_seed >> 8) & 0xffff) / 65535.0f;
+}
+
+// Rotation about three axes plus a translation, built in float like the game's matrices
+static void RandomRigidMatrix(Matrix4& p_matrix)
+{
+	float a = Random(-3.14f, 3.14f), b = Random(-3.14f, 3.14f), c = Random(-3.14f, 3.14f);
+	float ca = cosf(a), sa = sinf(a), cb = cosf(b), sb = sinf(b), cc = cosf(c), sc = sinf(c);
+
+	p_matrix[0][0] = cb * cc;
+	p_matrix[0][1] = cb * sc;
+	p_matrix[0][2] = -sb;
+	p_matrix[1][0] = sa * sb * cc - ca * sc;
+	p_matrix[1][1] = sa * sb * sc + ca * cc;
+	p_matrix[1][2] = sa * cb;
+	p_matrix[2][0] = ca * sb * cc + sa * sc;
+	p_matrix[2][1] = ca * sb * sc - sa * cc;
+	p_matrix[2][2] = ca * cb;
+	p_matrix[3][0] = Random(-50.0f, 50.0f);
+	p_matrix[3][1] = Random(-5.0f, 5.0f);
+	p_matrix[3][2] = Random(-50.0f, 50.0f);
+	p_matrix[0][3] = p_matrix[1][3] = p_matrix[2][3] = 0.0f;
+	p_matrix[3][3] = 1.0f;
+}
+
+// Three levels like an animated character: body, limbs and their parts
+template <class T>
+static T* BuildTree(int p_limbs, int p_parts, T** p_nodes, int& p_count)
+{
+	T* root = new T(2.0f);
+	p_nodes[p_count++] = root;
+
+	for (int i = 0; i < p_limbs; i++) {
+		T* limb = new T(1.0f + i * 0.1f);
+		root->AddChild(limb);
+		p_nodes[p_count++] = limb;
+
+		for (int j = 0; j < p_parts; j++) {
+			T* part = new T(0.25f + j * 0.05f);
+			limb->AddChild(part);
+			p_nodes[p_count++] = part;
+		}
+	}
+
+	return root;
+}
+
+static int SameWorldData(OrientableROI* p_a, OrientableROI* p_b)
+{
+	const BoundingBox& boxA = p_a->GetWorldBoundingBox();
+	const BoundingBox& boxB = p_b->GetWorldBoundingBox();
+	const BoundingSphere& sphereA = p_a->GetWorldBoundingSphere();
+	const BoundingSphere& sphereB = p_b->GetWorldBoundingSphere();
+
+	return !memcmp(p_a->GetLocal2World()[0], p_b->GetLocal2World()[0], sizeof(float) * 16) &&
+		   !memcmp(boxA.Min().GetData(), boxB.Min().GetData(), sizeof(float) * 3) &&
+		   !memcmp(boxA.Max().GetData(), boxB.Max().GetData(), sizeof(float) * 3) &&
+		   !memcmp(sphereA.Center().GetData(), sphereB.Center().GetData(), sizeof(float) * 3) &&
+		   sphereA.Radius() == sphereB.Radius();
+}
+
+#define MAX_NODES 64
+#define FRAMES 20000
+
+// Moves both trees the way actors and animations do and compares every node each frame
+static int TestBitExact()
+{
+	TestROI* lazyNodes[MAX_NODES];
+	EagerROI* eagerNodes[MAX_NODES];
+	int lazyCount = 0, eagerCount = 0;
+	TestROI* lazy = BuildTree(6, 3, lazyNodes, lazyCount);
+	EagerROI* eager = BuildTree(6, 3, eagerNodes, eagerCount);
+	int mismatches = 0;
+
+	for (int frame = 0; frame < FRAMES; frame++) {
+		MxMatrix transform;
+		RandomRigidMatrix(transform);
+
+		switch (frame % 3) {
+		case 0:
+			lazy->UpdateTransformationRelativeToParent(transform);
+			eager->UpdateTransformationRelativeToParent(transform);
+			break;
+		case 1: {
+			int node = 1 + frame % (lazyCount - 1);
+			lazyNodes[node]->WrappedUpdateWorldData();
+			eagerNodes[node]->WrappedUpdateWorldData();
+			lazyNodes[node]->UpdateWorldDataWithTransformAndChildren(transform);
+			eagerNodes[node]->UpdateWorldDataWithTransformAndChildren(transform);
+			break;
+		}
+		case 2:
+			lazy->SetLocal2WorldWithWorldDataUpdate(transform);
+			eager->SetLocal2WorldWithWorldDataUpdate(transform);
+			break;
+		}
+
+		// Read back only some frames, so dirty data also accumulates over several updates
+		if (frame % 7 == 0 || frame == FRAMES - 1) {
+			for (int i = 0; i < lazyCount; i++) {
+				if (!SameWorldData(lazyNodes[i], eagerNodes[i])) {
+					mismatches++;
+				}
+			}
+		}
+	}
+
+	printf("bit-exact: %d frames, %d nodes, %d mismatches\n", FRAMES, lazyCount, mismatches);
+	delete lazy;
+	delete eager;
+	return mismatches == 0;
+}
+
+// Times a frame of animation on a character where only the root's bounds are read,
+// as the view manager does for characters outside the view
+template <class T>
+static double TimePropagation()
+{
+	T* nodes[MAX_NODES];
+	int count = 0;
+	T* root = BuildTree(6, 3, nodes, count);
+	MxMatrix transform;
+	RandomRigidMatrix(transform);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (int frame = 0; frame < FRAMES; frame++) {
+		for (int i = 1; i < count; i++) {
+			nodes[i]->UpdateWorldDataWithTransformAndChildren(transform);
+		}
+
+		root->UpdateTransformationRelativeToParent(transform);
+		root->GetWorldBoundingSphere();
+	}
+
+	Uint64 end = SDL_GetPerformanceCounter();
+	delete root;
+	return (end - start) * 1000000.0 / SDL_GetPerformanceFrequency() / FRAMES;
+}
+
+int main(int, char**)
+{
+	int result = TestBitExact();
+
+	printf(
+		"per frame, 25-node character: eager %.2f us, deferred %.2f us\n",
+		TimePropagation<EagerROI>(),
+		TimePropagation<TestROI>()
+	);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
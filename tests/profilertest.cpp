@@ -0,0 +1,148 @@
+// Checks that PROFILE_THREAD names a thread only the first time the thread passes it, however
+// often it runs, and that the trace holds every thread's zones under its name. Then times each
+// profiler macro and the per-call thread naming the audio callback used to do. Only built with
+// ISLE_PROFILER.
+
+#include "mxtypes.h"
+#include "profiler.h"
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_PATH "profilertest.json"
+#define THREADS 3
+#define CALLBACKS 1000
+#define ROUNDS 1000000
+
+static MxU32 g_sink;
+
+// Stands in for an audio callback, which the same thread runs over and over
+static void Callback()
+{
+	PROFILE_THREAD("Callback thread");
+	PROFILE_ZONE("Callback");
+}
+
+// Renames itself halfway, which sticks only if the callbacks after that leave the name alone
+static int CallbackThread(void*)
+{
+	for (MxU32 i = 0; i < CALLBACKS; i++) {
+		if (i == CALLBACKS / 2) {
+			Profiler_SetThreadName("Renamed thread");
+		}
+
+		Callback();
+	}
+
+	return 0;
+}
+
+// Counts the occurrences of p_needle in the file at p_path
+static MxU32 Count(const char* p_path, const char* p_needle)
+{
+	FILE* file = fopen(p_path, "r");
+	char line[512];
+	MxU32 count = 0;
+
+	while (file && fgets(line, sizeof(line), file)) {
+		for (char* match = strstr(line, p_needle); match; match = strstr(match + 1, p_needle)) {
+			count++;
+		}
+	}
+
+	if (file) {
+		fclose(file);
+	}
+
+	return count;
+}
+
+#define CHECK(p_condition)                                                                                             \
+	if (!(p_condition)) {                                                                                              \
+		printf("failed: %s (line %d)\n", #p_condition, __LINE__);                                                     \
+		return FALSE;                                                                                                  \
+	}
+
+static MxBool TestThreads()
+{
+	SDL_Thread* threads[THREADS];
+
+	for (MxU32 i = 0; i < THREADS; i++) {
+		threads[i] = SDL_CreateThread(CallbackThread, "profilertest", NULL);
+		CHECK(threads[i]);
+	}
+
+	for (MxU32 i = 0; i < THREADS; i++) {
+		SDL_WaitThread(threads[i], NULL);
+	}
+
+	CHECK(Profiler_WriteTrace(TRACE_PATH));
+	CHECK(Count(TRACE_PATH, "\"args\":{\"name\":\"Renamed thread\"}") == THREADS);
+	CHECK(Count(TRACE_PATH, "Callback thread") == 0);
+	CHECK(Count(TRACE_PATH, "\"name\":\"Callback\",\"ph\":\"X\"") == THREADS * CALLBACKS);
+	return TRUE;
+}
+
+// Nanoseconds per pass of Function
+template <void (*Function)()>
+static double Time()
+{
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (MxU32 i = 0; i < ROUNDS; i++) {
+		Function();
+	}
+
+	return (SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency() / ROUNDS;
+}
+
+static void Empty()
+{
+	g_sink++;
+}
+
+static void Zone()
+{
+	PROFILE_ZONE("Zone");
+	g_sink++;
+}
+
+static void Counter()
+{
+	PROFILE_COUNTER("Counter", g_sink++);
+}
+
+static void Thread()
+{
+	PROFILE_THREAD("Main");
+	g_sink++;
+}
+
+static void SetThreadName()
+{
+	Profiler_SetThreadName("Main");
+	g_sink++;
+}
+
+int main(int, char**)
+{
+	MxBool result = TestThreads();
+
+	// What the calls cost beyond the loop around them
+	double empty = Time<Empty>();
+	printf(
+		"Per call: PROFILE_ZONE %.1f ns, PROFILE_COUNTER %.1f ns, PROFILE_THREAD %.1f ns, "
+		"Profiler_SetThreadName %.1f ns\n",
+		Time<Zone>() - empty,
+		Time<Counter>() - empty,
+		Time<Thread>() - empty,
+		Time<SetThreadName>() - empty
+	);
+
+	remove(TRACE_PATH);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
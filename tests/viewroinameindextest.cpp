@@ -0,0 +1,236 @@
+// Checks that ViewROINameIndex::Find returns what the linear search of the ROI list that
+// ViewManager::FindROI used to do returns, while ROIs are added, removed and renamed, and
+// times both.
+
+#include "viewmanager/viewroi.h"
+#include "viewmanager/viewroinameindex.h"
+
+#include <SDL2/SDL_stdinc.h>
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+// ViewROI only asks the renderer for its geometry group
+class TestRenderer : public Tgl::Renderer {
+public:
+	void* ImplementationDataPtr() override { return NULL; }
+	Tgl::Device* CreateDevice(const Tgl::DeviceDirectDrawCreateData&) override { return NULL; }
+	Tgl::Device* CreateDevice(const Tgl::DeviceDirect3DCreateData&) override { return NULL; }
+	Tgl::View* CreateView(const Tgl::Device*, const Tgl::Camera*, unsigned int, unsigned int, unsigned int, unsigned int)
+		override
+	{
+		return NULL;
+	}
+	Tgl::Camera* CreateCamera() override { return NULL; }
+	Tgl::Light* CreateLight(Tgl::LightType, float, float, float) override { return NULL; }
+	Tgl::Group* CreateGroup(const Tgl::Group*) override { return NULL; }
+	Tgl::MeshBuilder* CreateMeshBuilder() override { return NULL; }
+	Tgl::Texture* CreateTexture(int, int, int, const void*, int, int, const Tgl::PaletteEntry*) override
+	{
+		return NULL;
+	}
+	Tgl::Texture* CreateTexture() override { return NULL; }
+	Tgl::Result SetTextureDefaultShadeCount(unsigned int) override { return Tgl::Success; }
+	Tgl::Result SetTextureDefaultColorCount(unsigned int) override { return Tgl::Success; }
+};
+
+class TestROI : public ViewROI {
+public:
+	TestROI(Tgl::Renderer* p_renderer) : ViewROI(p_renderer, NULL) {}
+	~TestROI() override { delete[] SetName(NULL); }
+
+	void UpdateWorldBoundingVolumes() override {}
+
+	// Sets the name like LegoROI::SetName and returns the previous one, which the caller frees
+	char* SetName(const char* p_name)
+	{
+		char* oldName = m_name;
+		m_name = NULL;
+
+		if (p_name != NULL) {
+			m_name = new char[strlen(p_name) + 1];
+			strcpy(m_name, p_name);
+		}
+
+		return oldName;
+	}
+};
+
+// Few names in mixed case, so several ROIs share a name and buckets hold more than one
+static const char* g_names[] = {"pepper", "Pepper", "mama",  "papa", "nick", "laura", "infoman", "brickstr",
+								"studs",  "rhoda",  "valerie", "snap", "pt",   "mg",    "bu",      "ml",
+								"nu",     "na",     "cl",    "en",   "re",   "ro",    "d1",      "d2"};
+
+#define NUM_NAMES (sizeof(g_names) / sizeof(g_names[0]))
+#define MAX_ROIS 512
+
+// The manager's ROI list and its name index
+class TestManager {
+public:
+	TestManager() : m_count(0) {}
+
+	void Add(TestROI* p_roi)
+	{
+		m_rois[m_count++] = p_roi;
+		m_index.Add(p_roi);
+	}
+
+	void Remove(int p_index)
+	{
+		TestROI* roi = m_rois[p_index];
+
+		for (int i = p_index; i < m_count - 1; i++) {
+			m_rois[i] = m_rois[i + 1];
+		}
+
+		m_count--;
+		m_index.Remove(roi);
+	}
+
+	ViewROI* FindLinear(const char* p_name)
+	{
+		for (int i = 0; i < m_count; i++) {
+			if (m_rois[i]->GetName() && !SDL_strcasecmp(m_rois[i]->GetName(), p_name)) {
+				return m_rois[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	TestROI* m_rois[MAX_ROIS];
+	int m_count;
+	ViewROINameIndex m_index;
+};
+
+static unsigned int g_seed = 1;
+
+static int Random(int p_range)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xffff) % p_range;
+}
+
+static const char* RandomName()
+{
+	return Random(8) ? g_names[Random(NUM_NAMES)] : NULL;
+}
+
+#define STEPS 200000
+
+static int TestDifferential(Tgl::Renderer* p_renderer)
+{
+	TestManager manager;
+	int lookups = 0, mismatches = 0;
+
+	for (int step = 0; step < STEPS; step++) {
+		switch (Random(8)) {
+		case 0:
+		case 1:
+			if (manager.m_count < MAX_ROIS / 2) {
+				TestROI* roi = new TestROI(p_renderer);
+				delete[] roi->SetName(RandomName());
+				manager.Add(roi);
+			}
+			break;
+		case 2:
+			if (manager.m_count) {
+				int index = Random(manager.m_count);
+				TestROI* roi = manager.m_rois[index];
+				manager.Remove(index);
+				delete roi;
+			}
+			break;
+		case 3:
+		case 4:
+			if (manager.m_count) {
+				TestROI* roi = manager.m_rois[Random(manager.m_count)];
+				char* oldName = roi->SetName(RandomName());
+				manager.m_index.Rename(roi, oldName);
+				delete[] oldName;
+			}
+			break;
+		default: {
+			const char* name = g_names[Random(NUM_NAMES)];
+			lookups++;
+
+			if (manager.m_index.Find(name) != manager.FindLinear(name)) {
+				mismatches++;
+			}
+			break;
+		}
+		}
+	}
+
+	for (int i = 0; i < (int) NUM_NAMES; i++) {
+		lookups++;
+
+		if (manager.m_index.Find(g_names[i]) != manager.FindLinear(g_names[i])) {
+			mismatches++;
+		}
+	}
+
+	printf("differential: %d steps, %d lookups, %d mismatches\n", STEPS, lookups, mismatches);
+
+	for (int i = 0; i < manager.m_count; i++) {
+		delete manager.m_rois[i];
+	}
+
+	return mismatches == 0;
+}
+
+#define LOOKUPS 100000
+
+// Times lookups in a scene of p_rois uniquely named ROIs
+static void TimeLookups(Tgl::Renderer* p_renderer, int p_rois)
+{
+	TestManager manager;
+	char names[MAX_ROIS][16];
+
+	for (int i = 0; i < p_rois; i++) {
+		TestROI* roi = new TestROI(p_renderer);
+		SDL_snprintf(names[i], sizeof(names[i]), "roi%d", i);
+		roi->SetName(names[i]);
+		manager.Add(roi);
+	}
+
+	ViewROI* found = NULL;
+	Uint64 start = SDL_GetPerformanceCounter();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		found = manager.m_index.Find(names[i % p_rois]);
+	}
+
+	Uint64 middle = SDL_GetPerformanceCounter();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		found = manager.FindLinear(names[i % p_rois]);
+	}
+
+	Uint64 end = SDL_GetPerformanceCounter();
+	double scale = 1000000000.0 / SDL_GetPerformanceFrequency() / LOOKUPS;
+
+	printf(
+		"%d ROIs: indexed %.1f ns, linear %.1f ns per lookup%s\n",
+		p_rois,
+		(middle - start) * scale,
+		(end - middle) * scale,
+		found ? "" : " (not found)"
+	);
+
+	for (int i = 0; i < manager.m_count; i++) {
+		delete manager.m_rois[i];
+	}
+}
+
+int main(int, char**)
+{
+	TestRenderer renderer;
+	int result = TestDifferential(&renderer);
+
+	TimeLookups(&renderer, 64);
+	TimeLookups(&renderer, 400);
+
+	printf("%s\n", result ? "PASS" : "FAIL");
+	return result ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include "profiler.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_log.h>
+#include <SDL2/SDL_thread.h>
+#include <stdio.h>
+#include <string.h>
+
+// Events kept per thread, a power of two. Older events are overwritten.
+#define PROFILER_RING_SIZE 65536
+
+// Counter events have m_counter set and hold their value instead of an end time
+struct ProfilerEvent {
+	const char* m_name;
+	Uint64 m_start;
+	union {
+		Uint64 m_end;
+		Uint64 m_value;
+	};
+	Uint8 m_counter;
+};
+
+// Written only by its thread. m_count is the number of events ever recorded and publishes them to
+// the exporter. Rings are kept after their thread exits, so its events still export.
+struct ProfilerRing {
+	ProfilerEvent m_events[PROFILER_RING_SIZE];
+	SDL_atomic_t m_count;
+	SDL_threadID m_threadId;
+	const char* m_threadName;
+	ProfilerRing* m_next;
+};
+
+static SDL_SpinLock g_ringsLock;
+static ProfilerRing* g_rings;
+static thread_local ProfilerRing* g_threadRing;
+
+// Trace timestamps count from when the library was loaded
+static Uint64 g_origin = SDL_GetPerformanceCounter();
+
+static ProfilerRing* GetThreadRing()
+{
+	if (!g_threadRing) {
+		ProfilerRing* ring = new ProfilerRing;
+		SDL_AtomicSet(&ring->m_count, 0);
+		ring->m_threadId = SDL_ThreadID();
+		ring->m_threadName = NULL;
+
+		SDL_AtomicLock(&g_ringsLock);
+		ring->m_next = g_rings;
+		g_rings = ring;
+		SDL_AtomicUnlock(&g_ringsLock);
+
+		g_threadRing = ring;
+	}
+
+	return g_threadRing;
+}
+
+static void RecordEvent(const char* p_name, Uint64 p_start, Uint64 p_end, Uint8 p_counter)
+{
+	ProfilerRing* ring = GetThreadRing();
+	Uint32 count = SDL_AtomicGet(&ring->m_count);
+	ProfilerEvent& event = ring->m_events[count & (PROFILER_RING_SIZE - 1)];
+
+	event.m_name = p_name;
+	event.m_start = p_start;
+	event.m_end = p_end;
+	event.m_counter = p_counter;
+	SDL_AtomicSet(&ring->m_count, count + 1);
+}
+
+void Profiler_Record(const char* p_name, Uint64 p_start, Uint64 p_end)
+{
+	RecordEvent(p_name, p_start, p_end, 0);
+}
+
+void Profiler_RecordCounter(const char* p_name, Uint64 p_value)
+{
+	RecordEvent(p_name, SDL_GetPerformanceCounter(), p_value, 1);
+}
+
+void Profiler_SetThreadName(const char* p_name)
+{
+	GetThreadRing()->m_threadName = p_name;
+}
+
+// Copies the ring of a running thread. Returns how many of the copied events are intact; they end
+// at index p_end, modulo the ring size.
+static Uint32 SnapshotRing(ProfilerRing* p_ring, ProfilerEvent* p_events, Uint32& p_end)
+{
+	Uint32 before = SDL_AtomicGet(&p_ring->m_count);
+	memcpy(p_events, p_ring->m_events, sizeof(p_ring->m_events));
+	Uint32 after = SDL_AtomicGet(&p_ring->m_count);
+
+	// Events recorded during the copy, and the one being written when it ended, may have
+	// replaced the oldest ones we read
+	Sint64 first = (Sint64) after + 1 - PROFILER_RING_SIZE;
+
+	if (first < 0) {
+		first = 0;
+	}
+
+	p_end = before;
+	return before > first ? before - first : 0;
+}
+
+bool Profiler_WriteTrace(const char* p_path)
+{
+	FILE* file = fopen(p_path, "w");
+
+	if (!file) {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Profiler: failed to create '%s'", p_path);
+		return false;
+	}
+
+	SDL_AtomicLock(&g_ringsLock);
+	ProfilerRing* rings = g_rings;
+	SDL_AtomicUnlock(&g_ringsLock);
+
+	ProfilerEvent* events = new ProfilerEvent[PROFILER_RING_SIZE];
+	double ticksToMicroseconds = 1000000.0 / SDL_GetPerformanceFrequency();
+	Uint32 written = 0;
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+	for (ProfilerRing* ring = rings; ring; ring = ring->m_next) {
+		Uint32 end;
+		Uint32 count = SnapshotRing(ring, events, end);
+		unsigned long tid = (unsigned long) ring->m_threadId;
+
+		if (ring->m_threadName) {
+			fprintf(
+				file,
+				"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+				written++ ? ",\n" : "",
+				tid,
+				ring->m_threadName
+			);
+		}
+
+		for (Uint32 i = end - count; i != end; i++) {
+			ProfilerEvent& event = events[i & (PROFILER_RING_SIZE - 1)];
+
+			if (event.m_counter) {
+				fprintf(
+					file,
+					"%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"args\":{\"value\":%llu}}",
+					written++ ? ",\n" : "",
+					event.m_name,
+					tid,
+					(event.m_start - g_origin) * ticksToMicroseconds,
+					(unsigned long long) event.m_value
+				);
+				continue;
+			}
+
+			// Chrome traces count in microseconds; three decimals keep nanoseconds
+			fprintf(
+				file,
+				"%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+				written++ ? ",\n" : "",
+				event.m_name,
+				tid,
+				(event.m_start - g_origin) * ticksToMicroseconds,
+				(event.m_end - event.m_start) * ticksToMicroseconds
+			);
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+	delete[] events;
+
+	bool result = !ferror(file);
+	fclose(file);
+
+	if (result) {
+		SDL_Log("Profiler: wrote %u trace events to '%s'", written, p_path);
+	}
+	else {
+		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Profiler: failed to write '%s'", p_path);
+	}
+
+	return result;
+}
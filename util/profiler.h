@@ -0,0 +1,72 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Scoped zone profiler, compiled in with the ISLE_PROFILER CMake option. PROFILE_ZONE records the
+// time from its declaration to the end of the enclosing block into a ring buffer owned by the
+// calling thread. PROFILE_COUNTER records a value, such as a per-frame count, at the current time.
+// PROFILE_THREAD names the calling thread the first time each thread passes it, so it can sit in a
+// callback that a thread runs over and over.
+// Profiler_WriteTrace saves what the rings hold as Chrome trace-event JSON, which chrome://tracing
+// and Perfetto open. Without ISLE_PROFILER the macros expand to nothing.
+
+#ifdef ISLE_PROFILER
+
+#include <SDL2/SDL_timer.h>
+
+#ifdef PROFILER_DLL
+#ifdef _WIN32
+#define PROFILER_EXPORT __declspec(dllexport)
+#else
+#define PROFILER_EXPORT __attribute__((visibility("default")))
+#endif
+#else
+#ifdef _WIN32
+#define PROFILER_EXPORT __declspec(dllimport)
+#else
+#define PROFILER_EXPORT
+#endif
+#endif
+
+// p_name must outlive the profiler, in practice a string literal
+PROFILER_EXPORT void Profiler_Record(const char* p_name, Uint64 p_start, Uint64 p_end);
+PROFILER_EXPORT void Profiler_RecordCounter(const char* p_name, Uint64 p_value);
+PROFILER_EXPORT void Profiler_SetThreadName(const char* p_name);
+PROFILER_EXPORT bool Profiler_WriteTrace(const char* p_path);
+
+class ProfilerZone {
+public:
+	ProfilerZone(const char* p_name)
+	{
+		m_name = p_name;
+		m_start = SDL_GetPerformanceCounter();
+	}
+
+	~ProfilerZone() { Profiler_Record(m_name, m_start, SDL_GetPerformanceCounter()); }
+
+private:
+	const char* m_name;
+	Uint64 m_start;
+};
+
+class ProfilerThreadName {
+public:
+	ProfilerThreadName(const char* p_name) { Profiler_SetThreadName(p_name); }
+};
+
+#define PROFILE_CONCAT_(p_a, p_b) p_a##p_b
+#define PROFILE_CONCAT(p_a, p_b) PROFILE_CONCAT_(p_a, p_b)
+
+#define PROFILE_ZONE(p_name) ProfilerZone PROFILE_CONCAT(profilerZone, __LINE__)(p_name)
+#define PROFILE_COUNTER(p_name, p_value) Profiler_RecordCounter(p_name, p_value)
+#define PROFILE_THREAD(p_name)                                                                                         \
+	static thread_local ProfilerThreadName PROFILE_CONCAT(profilerThread, __LINE__)(p_name)
+
+#else
+
+#define PROFILE_ZONE(p_name)
+#define PROFILE_COUNTER(p_name, p_value)
+#define PROFILE_THREAD(p_name)
+
+#endif
+
+#endif // PROFILER_H